@@ -22,6 +22,7 @@
 #include <string>
 #include <map>
 
+#include <zutils/zSem.h>
 #include <zutils/zQueue.h>
 #include <zutils/zData.h>
 #include <zutils/zEvent.h>
@@ -89,7 +90,7 @@ private:
 // Typedef: AckMessageTable
 //**********************************************************************
 
-typedef std::map<std::string, zQueue<AckMessage> > AckMessageTable;
+typedef std::map<std::string, zQueue::Queue<AckMessage> > AckMessageTable;
 
 //**********************************************************************
 // Class: AckObserver
@@ -116,15 +117,16 @@ public:
 
 protected:
 
-  bool
-  EventHandler(zEvent::Notification* notification_);
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_);
 
 private:
 
+  zSem::Mutex _lock;
   AckMessageTable _ack_table;
 
   bool
-  EventHandler(zMessage::MessageNotification* notification_);
+  ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_);
 
 };
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZACKTRACKER_H__
+#define __ZACKTRACKER_H__
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zUuid.h>
+#include <zutils/zHashWheel.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+class AckMessage;
+
+//**********************************************************************
+// Class: AckHandler
+//**********************************************************************
+
+class AckHandler
+{
+
+public:
+
+  virtual
+  ~AckHandler()
+  {
+  }
+
+  // Called once per registration, with the ack or with NULL when none
+  //   arrived in time
+  virtual void
+  AckCompleted(const std::string& msg_id_, const AckMessage* ack_) = 0;
+
+};
+
+//**********************************************************************
+// Class: AckTracker
+//**********************************************************************
+
+// Table of messages waiting for an ack. Pending messages are kept in an open
+//   addressed hash table keyed by their binary id and expired by a hashed
+//   timer wheel turned by the tracker thread, so no caller blocks while
+//   waiting and each pending message costs a table entry and a wheel entry.
+//   Handlers are called without locks held, from the thread completing the
+//   ack or from the tracker thread on timeout.
+class AckTracker : public zThread::ThreadFunction
+{
+
+public:
+
+  AckTracker(const uint32_t tick_ms_ = 10, const size_t slots_ = 256);
+
+  virtual
+  ~AckTracker();
+
+  // Fails for ids that are not UUIDs and for ids already pending
+  bool
+  Register(const std::string& msg_id_, AckHandler* handler_, const uint32_t timeout_ms_);
+
+  // Forgets a pending message without calling its handler; fails once the
+  //   handler has been called
+  bool
+  Cancel(const std::string& msg_id_);
+
+  // Completes the message the ack answers; false if it was not pending
+  bool
+  Complete(const AckMessage& ack_);
+
+  size_t
+  Size() const;
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  struct entry
+  {
+    zUuid::Uuid::uuid id;
+    uint64_t expire;
+    AckHandler* handler;
+    bool used;
+  };
+
+  struct entry_hash
+  {
+    size_t
+    operator()(const entry& entry_) const
+    {
+      return (zUuid::Uuid::Hash(entry_.id));
+    }
+  };
+
+  struct entry_used
+  {
+    bool
+    operator()(const entry& entry_) const
+    {
+      return (entry_.used);
+    }
+  };
+
+  mutable zSem::Mutex _lock;
+  const uint32_t _tick_ms;
+  zHashWheel::HashTable<entry, entry_hash, entry_used> _table;
+  zHashWheel::TimerWheel<zUuid::Uuid::uuid> _wheel;
+  zSem::Semaphore _wake;
+  zThread::Thread _thread;
+
+  uint64_t
+  now() const;
+
+  size_t
+  find(const zUuid::Uuid::uuid& id_) const;
+
+  void
+  expire(const uint64_t tick_, std::vector<entry>& expired_);
+
+};
+
+}
+}
+
+#endif /* __ZACKTRACKER_H__ */
@@ -70,13 +70,13 @@ public:
 
 protected:
 
-  bool
-  EventHandler(zEvent::Notification* notification_);
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_);
 
 private:
 
   bool
-  EventHandler(zMessage::MessageNotification* notification_);
+  ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_);
 
 };
 
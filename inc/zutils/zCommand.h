@@ -199,7 +199,7 @@ public:
     ID_LAST
   };
 
-  CommandNotification();
+  CommandNotification(zEvent::Event& event_);
 
   virtual
   ~CommandNotification();
@@ -240,16 +240,46 @@ public:
 
 protected:
 
-  bool
-  EventHandler(zEvent::Notification* notification_);
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_);
 
 private:
 
   bool
-  EventHandler(zMessage::MessageNotification* notification_);
+  ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_);
 
   bool
-  EventHandler(CommandNotification* notification_);
+  ObserveEvent(SHARED_PTR(zCommand::CommandNotification) n_);
+
+};
+
+//**********************************************************************
+// Class: EventStatsCommand
+//**********************************************************************
+
+// Dumps zEvent dispatch and observer latency histograms; accepts the
+//   options "enable", "disable" and "reset"
+class EventStatsCommand : public Command
+{
+
+public:
+
+  static const std::string Name;
+  static const std::string EnableOption;
+  static const std::string DisableOption;
+  static const std::string ResetOption;
+
+  EventStatsCommand();
+
+  virtual
+  ~EventStatsCommand();
+
+  virtual bool
+  Execute(CommandData& data_);
+
+protected:
+
+private:
 
 };
 
@@ -18,6 +18,7 @@
 #define __ZCOMPATIBILITY_H__
 
 #include <stdint.h>
+#include <time.h>
 
 typedef int8_t s8;
 typedef int16_t s16;
@@ -48,6 +49,8 @@ typedef uint64_t u64;
 #define UNIQUE_PTR(p)   boost::interprocess::unique_ptr<p>
 #define SHARED_PTR(p)   boost::shared_ptr<p>
 #define STATIC_CAST(p)  boost::static_pointer_cast<p>
+#define ATOMIC_LOAD(p)  boost::atomic_load(&(p))
+#define ATOMIC_STORE(p,v) boost::atomic_store(&(p),(v))
 #define MOVE(p)         boost::move(p)
 #define FOREACH(a,b)    BOOST_FOREACH(a,b)
 
@@ -69,6 +72,8 @@ typedef uint64_t u64;
 #define UNIQUE_PTR(p)   std::unique_ptr<p>
 #define SHARED_PTR(p)   std::shared_ptr<p>
 #define STATIC_CAST(p)  std::static_pointer_cast<p>
+#define ATOMIC_LOAD(p)  std::atomic_load(&(p))
+#define ATOMIC_STORE(p,v) std::atomic_store(&(p),(v))
 #define MOVE(p)         std::move(p)
 #define FOREACH(a,b)    for (a : b)
 
@@ -78,4 +83,25 @@ typedef uint64_t u64;
 
 #endif
 
+namespace zUtils
+{
+
+// Monotonic clock readings, unaffected by changes to the wall clock; only
+//   differences between readings are meaningful
+inline uint64_t
+MonotonicNsecs()
+{
+  struct timespec ts = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t(ts.tv_sec) * 1000000000) + ts.tv_nsec);
+}
+
+inline uint64_t
+MonotonicMsecs()
+{
+  return (MonotonicNsecs() / 1000000);
+}
+
+}
+
 #endif /* __ZCOMPATIBILITY_H__ */
@@ -17,12 +17,19 @@
 #ifndef __ZCONFIG_H__
 #define __ZCONFIG_H__
 
+#include <stdint.h>
+
 #include <string>
+#include <vector>
+#include <list>
+#include <set>
+#include <map>
 
 #include <zutils/zCompatibility.h>
 #include <zutils/zSem.h>
 #include <zutils/zData.h>
 #include <zutils/zEvent.h>
+#include <zutils/zThread.h>
 
 namespace zUtils
 {
@@ -58,17 +65,26 @@ public:
 
   ConfigNotification(Configuration& config_, const ConfigNotification::ID id_);
 
+  ConfigNotification(Configuration& config_, const ConfigNotification::ID id_,
+      const std::vector<std::string>& paths_);
+
   virtual
   ~ConfigNotification();
 
   ConfigNotification::ID
   Id();
 
+  // Full paths of the subtrees changed by a commit, in sorted order; a
+  //   changed subtree is reported once, not once per changed value in it
+  const std::vector<std::string>&
+  ChangedPaths() const;
+
 protected:
 
 private:
 
   ConfigNotification::ID _id;
+  std::vector<std::string> _paths;
 
 };
 
@@ -192,7 +208,9 @@ class ConfigurationFileConnector : public ConfigConnector
 {
 public:
 
-  ConfigurationFileConnector(const std::string &filename_);
+  // Load() accepts either format; Store() writes the one given here
+  ConfigurationFileConnector(const std::string &filename_,
+      const zData::Data::FORMAT format_ = zData::Data::FORMAT_JSON);
 
   virtual
   ~ConfigurationFileConnector();
@@ -208,6 +226,165 @@ protected:
 private:
 
   std::string _filename;
+  zData::Data::FORMAT _format;
+
+};
+
+//**********************************************************************
+// Class: ConfigurationAtomicFileConnector
+//**********************************************************************
+
+// File connector that never leaves a partially written file behind: Store()
+//   writes a temporary file next to the target, syncs it and renames it over
+//   the target. Load() maps the file and parses it in place without copying.
+class ConfigurationAtomicFileConnector : public ConfigConnector
+{
+public:
+
+  ConfigurationAtomicFileConnector(const std::string &filename_,
+      const zData::Data::FORMAT format_ = zData::Data::FORMAT_JSON);
+
+  virtual
+  ~ConfigurationAtomicFileConnector();
+
+  virtual bool
+  Load(ConfigData &data_);
+
+  virtual bool
+  Store(ConfigData &data_);
+
+protected:
+
+private:
+
+  std::string _filename;
+  zData::Data::FORMAT _format;
+
+};
+
+//**********************************************************************
+// Class: ConfigurationReloadConnector
+//**********************************************************************
+
+// Atomic file connector that also reloads the configuration when the file
+//   changes on disk. Writes are detected with inotify on the file's directory,
+//   so files replaced by rename are followed too; a burst of writes reloads
+//   once, debounce_ms_ after the last one. Parsing and the commit run on the
+//   connector's thread through Configuration::Load(const ConfigData&).
+class ConfigurationReloadConnector :
+    public ConfigurationAtomicFileConnector,
+    public zThread::ThreadFunction
+{
+public:
+
+  ConfigurationReloadConnector(Configuration& config_, const std::string &filename_,
+      const uint32_t debounce_ms_ = 100,
+      const zData::Data::FORMAT format_ = zData::Data::FORMAT_JSON);
+
+  virtual
+  ~ConfigurationReloadConnector();
+
+  bool
+  Start();
+
+  bool
+  Stop();
+
+  // Number of times the file has been read back, whether or not it changed
+  //   or parsed; counted once the configuration has been notified
+  uint64_t
+  Reloads() const;
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  Configuration& _config;
+  std::string _dir;
+  std::string _name;
+  uint32_t _debounce;
+  int _inotify;
+  ATOMIC(uint64_t) _reloads;
+  zThread::Thread _thread;
+
+  void
+  reload();
+
+};
+
+//**********************************************************************
+// Class: ConfigWatcher
+//**********************************************************************
+
+// Index of observers watching configuration subtrees, kept as a trie of path
+//   components so a commit only visits the watchers on and below the paths it
+//   changed. A watcher is notified when a changed path is its prefix, above it
+//   or below it. Watchers with a debounce window are notified once, from the
+//   watcher thread, with every path changed by the commits inside the window.
+class ConfigWatcher : public zThread::ThreadFunction
+{
+
+public:
+
+  ConfigWatcher(Configuration& config_);
+
+  virtual
+  ~ConfigWatcher();
+
+  bool
+  Add(const ConfigPath& prefix_, zEvent::Observer* obs_, const uint32_t debounce_ms_ = 0);
+
+  bool
+  Remove(const ConfigPath& prefix_, zEvent::Observer* obs_);
+
+  size_t
+  Size() const;
+
+  void
+  Notify(const std::vector<std::string>& paths_);
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  struct watch
+  {
+    zEvent::Observer* obs;
+    uint32_t debounce;
+    uint64_t deadline;
+    std::set<std::string> pending;
+  };
+
+  struct node
+  {
+    std::map<std::string, SHARED_PTR(node)> children;
+    std::list<SHARED_PTR(watch)> watches;
+  };
+
+  Configuration& _config;
+
+  // Serializes deliveries with removal so an observer is never called after
+  //   it has been removed
+  zSem::Mutex _notify_lock;
+  mutable zSem::Mutex _lock;
+  node _root;
+  size_t _size;
+  std::list<SHARED_PTR(watch)> _armed;
+  zSem::Semaphore _wake;
+  zThread::Thread _thread;
+
+  void
+  collect(const node& node_, const std::string& path_,
+      std::map<SHARED_PTR(watch), std::set<std::string> >& matched_);
+
+  void
+  deliver(const SHARED_PTR(watch)& watch_, const std::set<std::string>& paths_);
 
 };
 
@@ -269,6 +446,12 @@ public:
   bool
   Load();
 
+  // Replaces the configuration with the given tree and commits it, staging
+  //   only the subtrees that changed. Observers see ID_LOAD and ID_POSTLOAD
+  //   around the commit, with the changed paths, unless nothing changed.
+  bool
+  Load(const ConfigData& data_);
+
   bool
   Store();
 
@@ -294,20 +477,15 @@ public:
   bool
   Get(ConfigPath path_, T& val_) const
   {
-    bool status = false;
-
-    // Begin critical section
-    if (this->_lock.Lock())
-    {
-      status = this->_working.GetValue<T>(path_.GetDataPath(), val_);
-      // End critical section
-      this->_lock.Unlock();
-    }
-
-    // Return status
-    return (status);
+    return (this->GetSnapshot()->GetValue<T>(path_.GetDataPath(), val_));
   }
 
+  // The committed configuration, published on every commit. Readers take it
+  //   without locking and see one consistent version for as long as they
+  //   hold it; all Get() calls read through it.
+  SHARED_PTR(const zData::Snapshot)
+  GetSnapshot() const;
+
   bool
   Put(const ConfigData& child_);
 
@@ -328,6 +506,7 @@ public:
     {
       if (this->_staging.PutValue<T>(path_.GetDataPath(), value_))
       {
+        this->stage(path_.GetDataPath());
         this->_modified = true;
         status = true;
       }
@@ -359,6 +538,7 @@ public:
     {
       if (this->_staging.AddValue<T>(path_.GetDataPath(), value_))
       {
+        this->stage(path_.GetDataPath());
         this->_modified = true;
         status = true;
       }
@@ -370,6 +550,15 @@ public:
     return (status);
   }
 
+  // Notifies the observer with ID_COMMIT and the paths changed by a commit
+  //   when they intersect the prefix; a debounce window coalesces the commits
+  //   inside it into one notification
+  bool
+  Watch(const ConfigPath& prefix_, zEvent::Observer* obs_, const uint32_t debounce_ms_ = 0);
+
+  bool
+  Unwatch(const ConfigPath& prefix_, zEvent::Observer* obs_);
+
   void
   Display(const std::string& prefix_ = std::string("")) const;
 
@@ -386,6 +575,25 @@ private:
   ConfigPath _path;
   ConfigData _staging;
   ConfigData _working;
+  SHARED_PTR(const zData::Snapshot) _snapshot;
+
+  // Paths written in staging since the last commit or restore
+  std::map<std::string, zData::DataPath> _changes;
+
+  // Created by the first watch; copies do not inherit watchers
+  ConfigWatcher* _watcher;
+
+  void
+  publish();
+
+  void
+  stage(const zData::DataPath& path_);
+
+  std::vector<std::string>
+  restage();
+
+  std::vector<std::string>
+  diff() const;
 
 };
 
@@ -17,8 +17,11 @@
 #ifndef __ZDATA_H__
 #define __ZDATA_H__
 
+#include <stdint.h>
+
 #include <string>
 #include <list>
+#include <vector>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -34,6 +37,9 @@ namespace zData
 
 namespace pt = boost::property_tree;
 
+class Document;
+class Snapshot;
+
 //**********************************************************************
 // Class: DataPath
 //**********************************************************************
@@ -124,6 +130,59 @@ private:
 
 };
 
+//**********************************************************************
+// Class: CompiledPath
+//**********************************************************************
+
+// Pre-split, immutable form of a DataPath for repeated lookups. The node it
+//   last resolved to is cached along with the tree generation it belongs to,
+//   so lookups on an unchanged tree skip the walk entirely. Safe to share
+//   between threads, but the cache holds a single tree; a path used on many
+//   trees belongs with each tree (e.g. as a member of its owner).
+class CompiledPath
+{
+
+  friend class Data;
+
+public:
+
+  explicit
+  CompiledPath(const DataPath& path_);
+
+  CompiledPath(const CompiledPath& other_);
+
+  virtual
+  ~CompiledPath();
+
+  const std::vector<std::string>&
+  Keys() const;
+
+  const std::string&
+  Path() const;
+
+protected:
+
+private:
+
+  std::vector<std::string> _keys;
+  std::string _path;
+
+  // Seqlock protected cache of the last resolved node
+  mutable ATOMIC(uint32_t) _seq;
+  mutable ATOMIC(uint64_t) _gen;
+  mutable ATOMIC(pt::ptree*) _node;
+
+  pt::ptree*
+  cached(const uint64_t gen_) const;
+
+  void
+  cache(const uint64_t gen_, pt::ptree* node_) const;
+
+  CompiledPath&
+  operator=(const CompiledPath& other_);
+
+};
+
 //**********************************************************************
 // Class: Data
 //**********************************************************************
@@ -131,8 +190,31 @@ private:
 class Data : public DataPath
 {
 
+  friend class Document;
+  friend class Snapshot;
+
 public:
 
+  // Encodings for persisting or transmitting data
+  enum FORMAT
+  {
+    FORMAT_ERR = -1,
+    FORMAT_NONE = 0,
+    FORMAT_JSON = 1,
+    FORMAT_BINARY = 2,
+    FORMAT_LAST
+  };
+
+  // Backing stores for the tree; the arena Document keeps values typed and
+  //   children contiguous, the property tree is the default
+  enum STORE
+  {
+    STORE_ERR = -1,
+    STORE_PTREE = 0,
+    STORE_DOCUMENT = 1,
+    STORE_LAST
+  };
+
   Data(const std::string& path_ = std::string(""));
 
   Data(const DataPath& path_);
@@ -173,6 +255,13 @@ public:
     return (*this);
   }
 
+  Data::STORE
+  GetStore() const;
+
+  // Converts the tree to the given store; copies keep their own store
+  bool
+  SetStore(const Data::STORE store_);
+
   bool
   Empty() const;
 
@@ -229,6 +318,38 @@ public:
 
     }
 
+  template<typename T>
+    bool
+    GetValue(const CompiledPath& src_, T &value_) const
+    {
+
+      bool status = false;
+
+      // Begin critical section
+      if (this->_lock.Lock())
+      {
+        if (this->_doc)
+        {
+          status = this->dget(src_._keys, value_);
+        }
+        else
+        {
+          pt::ptree* node = this->resolve(src_);
+          boost::optional<T> value;
+          if (node && (value = node->get_value_optional<T>()))
+          {
+            value_ = *value;
+            status = true;
+          }
+        }
+        this->_lock.Unlock();
+      }
+
+      // Return status
+      return (status);
+
+    }
+
   bool
   PutChild(const Data& child_);
 
@@ -257,6 +378,37 @@ public:
 
     }
 
+  template<typename T>
+    bool
+    PutValue(const CompiledPath& dst_, const T &value_)
+    {
+
+      bool status = false;
+
+      // Begin critical section
+      if (this->_lock.Lock())
+      {
+        if (this->_doc)
+        {
+          status = this->dput(dst_._keys, value_);
+        }
+        else
+        {
+          pt::ptree* node = this->create(dst_);
+          if (node)
+          {
+            node->put_value<T>(value_);
+            status = true;
+          }
+        }
+        this->_lock.Unlock();
+      }
+
+      // Return status
+      return (status);
+
+    }
+
   bool
   AddChild(const Data& child_);
 
@@ -288,6 +440,17 @@ public:
   bool
   Del(const DataPath& path_);
 
+  // Compares the subtrees at path_ without copying them; a path missing
+  //   from both compares equal
+  bool
+  Compare(const DataPath& path_, const Data& other_) const;
+
+  // Full paths of the smallest subtrees at or below path_ that differ from
+  //   other_, in tree order; objects are descended into, arrays and values
+  //   are reported whole
+  std::vector<std::string>
+  Diff(const DataPath& path_, const Data& other_) const;
+
   // Json utility functions
   std::string
   GetJson() const;
@@ -298,9 +461,23 @@ public:
   bool
   SetJson(const std::string &json_);
 
+  bool
+  SetJson(const char* json_, const size_t len_);
+
   void
   DisplayJson() const;
 
+  // Binary (MessagePack) utility functions
+
+  std::string
+  GetBinary() const;
+
+  bool
+  SetBinary(const std::string& bin_);
+
+  bool
+  SetBinary(const void* bin_, const size_t len_);
+
   // XML utility functions
 
   std::string
@@ -315,10 +492,52 @@ public:
 protected:
 
   mutable zSem::Mutex _lock;
-  pt::ptree _pt;
+
+  // Copies of a Data share one tree which is treated as immutable while
+  //   shared; the first write through a copy clones it (see tree()). Exactly
+  //   one of the property tree and the document is set (see SetStore()).
+  SHARED_PTR(pt::ptree) _pt;
+  SHARED_PTR(Document) _doc;
+
+  void
+  touch();
+
+  pt::ptree&
+  tree();
+
+  // Locks this and other_ in a fixed order
+  void
+  lock(const Data& other_) const;
+
+  void
+  unlock(const Data& other_) const;
 
 private:
 
+  // Changes whenever nodes of the tree may have been freed or moved;
+  //   values are unique across all Data objects
+  uint64_t _generation;
+
+  Document&
+  doc();
+
+  // Subtree at path_, converted into scratch_ when kept in a document;
+  //   NULL if missing
+  const pt::ptree*
+  child(const std::string& path_, pt::ptree& scratch_) const;
+
+  static std::vector<std::string>
+  keys(const std::string& path_);
+
+  bool
+  same(const Data& other_) const;
+
+  pt::ptree*
+  resolve(const CompiledPath& path_) const;
+
+  pt::ptree*
+  create(const CompiledPath& path_);
+
   bool
   get(const std::string &path_, pt::ptree &pt_) const;
 
@@ -327,11 +546,15 @@ private:
     get(const std::string &path_, T &value_) const
     {
       bool status = false;
-      if (!path_.empty())
+      if (!path_.empty() && this->_doc)
+      {
+        status = this->dget(Data::keys(path_), value_);
+      }
+      else if (!path_.empty())
       {
         try
         {
-          value_ = this->_pt.get<T>(path_);
+          value_ = this->_pt->get<T>(path_);
           status = true;
         }
         catch (pt::ptree_bad_path &e)
@@ -346,16 +569,24 @@ private:
   bool
   put(const std::string& path_, const pt::ptree &pt_);
 
+  // Copies the subtree at path_ in doc_, keeping its types in a document
+  bool
+  put(const std::string& path_, const Document& doc_);
+
   template<typename T>
     bool
     put(const std::string& path_, const T &value_)
     {
       bool status = false;
-      if (!path_.empty())
+      if (!path_.empty() && this->_doc)
+      {
+        status = this->dput(Data::keys(path_), value_);
+      }
+      else if (!path_.empty())
       {
         try
         {
-          this->_pt.put<T>(path_, value_);
+          this->tree().put<T>(path_, value_);
           status = true;
         }
         catch (pt::ptree_bad_path &e)
@@ -367,6 +598,13 @@ private:
       return (status);
     }
 
+  // Puts the root node of a decoded tree, taking the lock
+  bool
+  set(const pt::ptree& pt_);
+
+  bool
+  set(const Document& doc_);
+
   bool
   add(const std::string& path_, const pt::ptree &pt_);
 
@@ -398,6 +636,139 @@ private:
   bool
   del(const std::string &path_);
 
+  // Typed access to the document store; other types go through their
+  //   property tree string form
+
+  bool
+  dget(const std::vector<std::string>& keys_, bool& value_) const;
+
+  bool
+  dget(const std::vector<std::string>& keys_, int& value_) const;
+
+  bool
+  dget(const std::vector<std::string>& keys_, unsigned int& value_) const;
+
+  bool
+  dget(const std::vector<std::string>& keys_, long& value_) const;
+
+  bool
+  dget(const std::vector<std::string>& keys_, unsigned long& value_) const;
+
+  bool
+  dget(const std::vector<std::string>& keys_, double& value_) const;
+
+  bool
+  dget(const std::vector<std::string>& keys_, std::string& value_) const;
+
+  template<typename T>
+    bool
+    dget(const std::vector<std::string>& keys_, T& value_) const
+    {
+      bool status = false;
+      pt::ptree pt;
+      if (this->dget(keys_, pt.data()))
+      {
+        boost::optional<T> value = pt.get_value_optional<T>();
+        if (value)
+        {
+          value_ = *value;
+          status = true;
+        }
+      }
+      return (status);
+    }
+
+  bool
+  dput(const std::vector<std::string>& keys_, const bool& value_);
+
+  bool
+  dput(const std::vector<std::string>& keys_, const int& value_);
+
+  bool
+  dput(const std::vector<std::string>& keys_, const unsigned int& value_);
+
+  bool
+  dput(const std::vector<std::string>& keys_, const long& value_);
+
+  bool
+  dput(const std::vector<std::string>& keys_, const unsigned long& value_);
+
+  bool
+  dput(const std::vector<std::string>& keys_, const double& value_);
+
+  bool
+  dput(const std::vector<std::string>& keys_, const std::string& value_);
+
+  template<typename T>
+    bool
+    dset(const std::vector<std::string>& keys_, const T& value_);
+
+  template<typename T>
+    bool
+    dput(const std::vector<std::string>& keys_, const T& value_)
+    {
+      pt::ptree pt;
+      pt.put_value<T>(value_);
+      return (this->dput(keys_, pt.data()));
+    }
+
+};
+
+//**********************************************************************
+// Class: Snapshot
+//**********************************************************************
+
+// Read only view of a Data tree as it was when the snapshot was taken.
+//   The snapshot shares the tree and the Data copies it on its next write,
+//   so snapshots never change and any number of threads read them without
+//   locking; taking one locks the Data once.
+class Snapshot
+{
+
+public:
+
+  Snapshot();
+
+  Snapshot(const Data& data_);
+
+  virtual
+  ~Snapshot();
+
+  bool
+  Empty() const;
+
+  template<typename T>
+    bool
+    GetValue(const DataPath& src_, T &value_) const
+    {
+      bool status = false;
+      if (this->_pt)
+      {
+        boost::optional<T> value = this->_pt->get_optional<T>(src_.Path());
+        if (value)
+        {
+          value_ = *value;
+          status = true;
+        }
+      }
+      return (status);
+    }
+
+  bool
+  GetChild(const DataPath& src_, Data& child_) const;
+
+  bool
+  GetChild(const DataPath& src_, const DataPath& dst_, Data& child_) const;
+
+  std::string
+  GetJson() const;
+
+protected:
+
+private:
+
+  SHARED_PTR(const pt::ptree) _pt;
+
 };
 
 }
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZDATABINARY_H__
+#define __ZDATABINARY_H__
+
+#include <stdint.h>
+
+#include <string>
+
+#include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
+#include <zutils/zDataJson.h>
+
+namespace zUtils
+{
+namespace zData
+{
+
+// The binary form is MessagePack. Property trees are encoded exactly as their
+//   JSON form (objects as maps, arrays as arrays, values as strings) so the two
+//   convert into each other without loss; documents keep their value types.
+
+//**********************************************************************
+// Class: BinaryReader
+//**********************************************************************
+
+// Decodes MessagePack into the same callbacks as the JsonReader, so the
+//   PtreeJsonHandler and DocumentJsonHandler build trees from either form.
+//   Strings point into the caller's buffer; integers and floats are passed as
+//   the text the JSON form would carry.
+class BinaryReader
+{
+
+public:
+
+  static const unsigned int DefaultMaxDepth;
+
+  BinaryReader(const unsigned int depth_ = DefaultMaxDepth);
+
+  virtual
+  ~BinaryReader();
+
+  bool
+  Parse(const void* buf_, const size_t len_, JsonHandler& handler_);
+
+  bool
+  Parse(const std::string& buf_, JsonHandler& handler_);
+
+  size_t
+  ErrorOffset() const;
+
+  const std::string&
+  ErrorMessage() const;
+
+  // True if the buffer starts like a MessagePack map or array rather than
+  //   JSON text, which always starts with an ASCII character
+  static bool
+  Detect(const void* buf_, const size_t len_);
+
+protected:
+
+private:
+
+  unsigned int _max_depth;
+  const uint8_t* _begin;
+  const uint8_t* _cur;
+  const uint8_t* _end;
+  JsonHandler* _handler;
+  size_t _err_off;
+  std::string _err_msg;
+
+  bool
+  error(const char* msg_);
+
+  bool
+  value(const unsigned int depth_);
+
+  bool
+  number(const char* str_);
+
+};
+
+//**********************************************************************
+// Class: BinaryWriter
+//**********************************************************************
+
+// Serializes into a string used as a byte buffer, appending to its contents
+class BinaryWriter
+{
+
+public:
+
+  static bool
+  Write(const pt::ptree& pt_, std::string& out_);
+
+  static bool
+  Write(const Document& doc_, std::string& out_);
+
+protected:
+
+private:
+
+  BinaryWriter();
+
+};
+
+//**********************************************************************
+// Class: BinaryView
+//**********************************************************************
+
+// Read only access to an encoded buffer without decoding it. A view is a
+//   pointer to one encoded value; the buffer must outlive all views of it.
+//   Lookups walk the encoding, so decode once when reading many values.
+class BinaryView
+{
+
+public:
+
+  BinaryView();
+
+  BinaryView(const void* buf_, const size_t len_);
+
+  virtual
+  ~BinaryView();
+
+  bool
+  Valid() const;
+
+  Document::TYPE
+  GetType() const;
+
+  size_t
+  Size() const;
+
+  BinaryView
+  GetChild(const size_t index_) const;
+
+  bool
+  GetKey(const size_t index_, const char*& str_, size_t& len_) const;
+
+  BinaryView
+  Find(const std::string& key_) const;
+
+  BinaryView
+  Find(const DataPath& path_) const;
+
+  // Zero copy access to a string value
+  bool
+  GetValue(const char*& str_, size_t& len_) const;
+
+  bool
+  GetValue(bool& value_) const;
+
+  bool
+  GetValue(int64_t& value_) const;
+
+  bool
+  GetValue(double& value_) const;
+
+  bool
+  GetValue(std::string& value_) const;
+
+  template<typename T>
+    bool
+    GetValue(const DataPath& path_, T& value_) const
+    {
+      return (this->Find(path_).GetValue(value_));
+    }
+
+protected:
+
+private:
+
+  const uint8_t* _begin;
+  const uint8_t* _end;
+
+  BinaryView(const uint8_t* begin_, const uint8_t* end_);
+
+  const uint8_t*
+  body(size_t& count_) const;
+
+};
+
+}
+}
+
+#endif /* __ZDATABINARY_H__ */
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZDATADOCUMENT_H__
+#define __ZDATADOCUMENT_H__
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <zutils/zData.h>
+
+namespace zUtils
+{
+namespace zData
+{
+
+//**********************************************************************
+// Class: Document
+//**********************************************************************
+
+// Typed, arena allocated alternative to the property tree behind Data.
+//   All nodes live in one contiguous array and are referenced by index,
+//   the children of a node are stored contiguously, object keys are
+//   interned and strings are kept in a single character arena. Values keep
+//   their type so reads do not parse strings. Removed or replaced nodes are
+//   only reclaimed by Compact(). A Data object can keep its tree in a
+//   Document instead of a property tree (see Data::SetStore()).
+class Document
+{
+
+  friend class Data;
+
+public:
+
+  enum TYPE
+  {
+    TYPE_ERR = -1,
+    TYPE_NULL = 0,
+    TYPE_BOOL = 1,
+    TYPE_INT = 2,
+    TYPE_DOUBLE = 3,
+    TYPE_STRING = 4,
+    TYPE_ARRAY = 5,
+    TYPE_OBJECT = 6,
+    TYPE_LAST
+  };
+
+  typedef uint32_t Node;
+
+  static const Node NoNode;
+
+  Document();
+
+  Document(const Data& data_);
+
+  virtual
+  ~Document();
+
+  void
+  Clear();
+
+  void
+  Compact();
+
+  size_t
+  NodeCount() const;
+
+  // Navigation
+
+  Node
+  Root() const;
+
+  Document::TYPE
+  GetType(const Node node_) const;
+
+  std::string
+  GetKey(const Node node_) const;
+
+  size_t
+  Size(const Node node_) const;
+
+  Node
+  GetChild(const Node node_, const size_t index_) const;
+
+  Node
+  Find(const Node node_, const std::string& key_) const;
+
+  Node
+  Find(const DataPath& path_) const;
+
+  Node
+  Find(const std::vector<std::string>& keys_) const;
+
+  // Typed value access
+
+  bool
+  GetValue(const Node node_, bool& value_) const;
+
+  bool
+  GetValue(const Node node_, int& value_) const;
+
+  bool
+  GetValue(const Node node_, unsigned int& value_) const;
+
+  bool
+  GetValue(const Node node_, long& value_) const;
+
+  bool
+  GetValue(const Node node_, unsigned long& value_) const;
+
+  bool
+  GetValue(const Node node_, double& value_) const;
+
+  bool
+  GetValue(const Node node_, std::string& value_) const;
+
+  template<typename T>
+    bool
+    GetValue(const DataPath& path_, T& value_) const
+    {
+      return (this->GetValue(this->Find(path_), value_));
+    }
+
+  Node
+  SetValue(const Node node_, const bool value_);
+
+  Node
+  SetValue(const Node node_, const int64_t value_);
+
+  // Values beyond the signed range are kept as strings
+  Node
+  SetValue(const Node node_, const uint64_t value_);
+
+  Node
+  SetValue(const Node node_, const double value_);
+
+  Node
+  SetValue(const Node node_, const std::string& value_);
+
+  Node
+  SetNull(const Node node_);
+
+  Node
+  SetArray(const Node node_);
+
+  Node
+  SetObject(const Node node_);
+
+  template<typename T>
+    bool
+    PutValue(const DataPath& path_, const T& value_)
+    {
+      return (this->SetValue(this->Create(path_), this->cast(value_)) != NoNode);
+    }
+
+  // Structure
+
+  Node
+  Create(const Node node_, const std::string& key_);
+
+  Node
+  Create(const DataPath& path_);
+
+  Node
+  Create(const std::vector<std::string>& keys_);
+
+  Node
+  Append(const Node node_);
+
+  bool
+  Del(const Node node_, const std::string& key_);
+
+  bool
+  Del(const DataPath& path_);
+
+  // Replaces the subtree at node_ with a copy of from_ in src_
+  bool
+  Copy(const Node node_, const Document& src_, const Node from_);
+
+  // Property tree conversion
+
+  bool
+  FromPtree(const pt::ptree& pt_, const bool infer_ = true);
+
+  bool
+  ToPtree(pt::ptree& pt_) const;
+
+  // Replaces the subtree at node_
+  bool
+  FromPtree(const Node node_, const pt::ptree& pt_, const bool infer_ = true);
+
+  bool
+  ToPtree(const Node node_, pt::ptree& pt_) const;
+
+  bool
+  Load(const Data& data_, const bool infer_ = true);
+
+  bool
+  Store(Data& data_) const;
+
+protected:
+
+private:
+
+  struct node
+  {
+    uint8_t type;
+    uint32_t key;
+    union
+    {
+      bool b;
+      int64_t i;
+      double d;
+      struct
+      {
+        uint32_t off;
+        uint32_t len;
+      } str;
+      struct
+      {
+        uint32_t begin;
+        uint32_t count;
+        uint32_t cap;
+        // Node holding the value of an array or object, as a property
+        //   tree node can have both; zero if none
+        uint32_t text;
+      } kids;
+    } u;
+  };
+
+  std::vector<node> _nodes;
+  std::vector<Node> _kids;
+  std::vector<char> _chars;
+  std::vector<std::string> _keys;
+  std::unordered_map<std::string, uint32_t> _key_index;
+
+  // Arena size after the last compaction (see collect())
+  size_t _mark;
+
+  uint32_t
+  intern(const std::string& key_);
+
+  uint32_t
+  lookup(const std::string& key_) const;
+
+  Node
+  alloc(const uint32_t key_);
+
+  Node
+  reset(const Node node_, const TYPE type_);
+
+  Node
+  object(const Node node_);
+
+  Node
+  value(const Node node_);
+
+  void
+  collect();
+
+  bool
+  from(const Node node_, const pt::ptree& pt_, const bool infer_);
+
+  bool
+  to(const Node node_, pt::ptree& pt_) const;
+
+  Node
+  copy(const Document& src_, const Node node_, const uint32_t key_);
+
+  static bool
+  cast(const bool value_)
+  {
+    return (value_);
+  }
+
+  static int64_t
+  cast(const int value_)
+  {
+    return (value_);
+  }
+
+  static int64_t
+  cast(const unsigned int value_)
+  {
+    return (value_);
+  }
+
+  static int64_t
+  cast(const long value_)
+  {
+    return (value_);
+  }
+
+  static uint64_t
+  cast(const unsigned long value_)
+  {
+    return (value_);
+  }
+
+  static int64_t
+  cast(const long long value_)
+  {
+    return (value_);
+  }
+
+  static uint64_t
+  cast(const unsigned long long value_)
+  {
+    return (value_);
+  }
+
+  static double
+  cast(const double value_)
+  {
+    return (value_);
+  }
+
+  static std::string
+  cast(const std::string& value_)
+  {
+    return (value_);
+  }
+
+  static std::string
+  cast(const char* value_)
+  {
+    return (std::string(value_));
+  }
+
+};
+
+}
+}
+
+#endif /* __ZDATADOCUMENT_H__ */
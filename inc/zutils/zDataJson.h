@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZDATAJSON_H__
+#define __ZDATAJSON_H__
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
+
+namespace zUtils
+{
+namespace zData
+{
+
+//**********************************************************************
+// Class: JsonHandler
+//**********************************************************************
+
+// SAX style callbacks from the JsonReader; returning false stops parsing.
+//   Strings and numbers point into the reader's input or scratch buffer and
+//   are only valid for the duration of the call. Numbers are passed as their
+//   literal text so no precision is lost before the handler decides a type.
+class JsonHandler
+{
+
+public:
+
+  virtual
+  ~JsonHandler();
+
+  virtual bool
+  Null() = 0;
+
+  virtual bool
+  Bool(const bool value_) = 0;
+
+  virtual bool
+  Number(const char* str_, const size_t len_, const bool integer_) = 0;
+
+  virtual bool
+  String(const char* str_, const size_t len_) = 0;
+
+  virtual bool
+  Key(const char* str_, const size_t len_) = 0;
+
+  virtual bool
+  BeginObject() = 0;
+
+  virtual bool
+  EndObject() = 0;
+
+  virtual bool
+  BeginArray() = 0;
+
+  virtual bool
+  EndArray() = 0;
+
+};
+
+//**********************************************************************
+// Class: JsonReader
+//**********************************************************************
+
+// Single pass JSON parser working directly on a caller supplied buffer.
+//   String bodies are scanned 16 bytes at a time with SSE2 when available.
+class JsonReader
+{
+
+public:
+
+  static const unsigned int DefaultMaxDepth;
+
+  JsonReader(const unsigned int depth_ = DefaultMaxDepth);
+
+  virtual
+  ~JsonReader();
+
+  bool
+  Parse(const char* json_, const size_t len_, JsonHandler& handler_);
+
+  bool
+  Parse(const std::string& json_, JsonHandler& handler_);
+
+  size_t
+  ErrorOffset() const;
+
+  const std::string&
+  ErrorMessage() const;
+
+protected:
+
+private:
+
+  unsigned int _max_depth;
+  const char* _begin;
+  const char* _cur;
+  const char* _end;
+  JsonHandler* _handler;
+  std::string _scratch;
+  size_t _err_off;
+  std::string _err_msg;
+
+  bool
+  error(const char* msg_);
+
+  void
+  skip();
+
+  bool
+  value(const unsigned int depth_);
+
+  bool
+  object(const unsigned int depth_);
+
+  bool
+  array(const unsigned int depth_);
+
+  bool
+  string(const bool key_);
+
+  bool
+  number();
+
+  bool
+  literal(const char* str_, const size_t len_);
+
+  bool
+  escape();
+
+};
+
+//**********************************************************************
+// Class: JsonWriter
+//**********************************************************************
+
+// Serializes straight into a string buffer, appending to its contents.
+//   Property trees are written byte for byte as pt::write_json() does;
+//   documents keep their types.
+class JsonWriter
+{
+
+public:
+
+  static bool
+  Write(const pt::ptree& pt_, std::string& out_, const bool pretty_ = false);
+
+  static bool
+  Write(const Document& doc_, std::string& out_, const bool pretty_ = false);
+
+  static void
+  Escape(const char* str_, const size_t len_, std::string& out_);
+
+protected:
+
+private:
+
+  JsonWriter();
+
+};
+
+//**********************************************************************
+// Class: PtreeJsonHandler
+//**********************************************************************
+
+// Builds a property tree exactly as pt::read_json() does
+class PtreeJsonHandler : public JsonHandler
+{
+
+public:
+
+  PtreeJsonHandler(pt::ptree& pt_);
+
+  virtual
+  ~PtreeJsonHandler();
+
+  virtual bool
+  Null();
+
+  virtual bool
+  Bool(const bool value_);
+
+  virtual bool
+  Number(const char* str_, const size_t len_, const bool integer_);
+
+  virtual bool
+  String(const char* str_, const size_t len_);
+
+  virtual bool
+  Key(const char* str_, const size_t len_);
+
+  virtual bool
+  BeginObject();
+
+  virtual bool
+  EndObject();
+
+  virtual bool
+  BeginArray();
+
+  virtual bool
+  EndArray();
+
+protected:
+
+private:
+
+  pt::ptree& _pt;
+  std::vector<pt::ptree*> _stack;
+  std::vector<bool> _arrays;
+  std::string _key;
+
+  pt::ptree*
+  node();
+
+};
+
+//**********************************************************************
+// Class: DocumentJsonHandler
+//**********************************************************************
+
+// Builds a typed Document; integers that do not fit 64 bits become doubles
+class DocumentJsonHandler : public JsonHandler
+{
+
+public:
+
+  DocumentJsonHandler(Document& doc_);
+
+  virtual
+  ~DocumentJsonHandler();
+
+  virtual bool
+  Null();
+
+  virtual bool
+  Bool(const bool value_);
+
+  virtual bool
+  Number(const char* str_, const size_t len_, const bool integer_);
+
+  virtual bool
+  String(const char* str_, const size_t len_);
+
+  virtual bool
+  Key(const char* str_, const size_t len_);
+
+  virtual bool
+  BeginObject();
+
+  virtual bool
+  EndObject();
+
+  virtual bool
+  BeginArray();
+
+  virtual bool
+  EndArray();
+
+protected:
+
+private:
+
+  Document& _doc;
+  std::vector<Document::Node> _stack;
+  std::string _key;
+
+  Document::Node
+  node();
+
+};
+
+}
+}
+
+#endif /* __ZDATAJSON_H__ */
@@ -17,7 +17,11 @@
 #ifndef __EVENT_H__
 #define __EVENT_H__
 
+#include <stdint.h>
+
 #include <list>
+#include <map>
+#include <string>
 
 #include <zutils/zSem.h>
 #include <zutils/zQueue.h>
@@ -132,6 +136,126 @@ public:
   ObserveEvent(SHARED_PTR(zEvent::Notification) n_) = 0;
 };
 
+//**********************************************************************
+// Class: Histogram
+//**********************************************************************
+
+// Lock-free log-linear (HDR style) latency histogram. Values are in
+// nanoseconds and are kept to within 1/SubBuckets of their true value.
+class Histogram
+{
+
+public:
+
+  static const unsigned int SubBucketBits = 4;
+  static const unsigned int SubBuckets = (1 << SubBucketBits);
+  static const unsigned int MaxValueBits = 36; // ~68 seconds
+  static const unsigned int Buckets = ((MaxValueBits - SubBucketBits + 1) << SubBucketBits);
+
+  Histogram();
+
+  virtual
+  ~Histogram();
+
+  void
+  Record(const uint64_t value_);
+
+  uint64_t
+  Count() const;
+
+  uint64_t
+  Min() const;
+
+  uint64_t
+  Max() const;
+
+  uint64_t
+  Mean() const;
+
+  uint64_t
+  Percentile(const double pct_) const;
+
+  void
+  Reset();
+
+protected:
+
+private:
+
+  ATOMIC(uint64_t) _buckets[Buckets];
+  ATOMIC(uint64_t) _count;
+  ATOMIC(uint64_t) _sum;
+  ATOMIC(uint64_t) _min;
+  ATOMIC(uint64_t) _max;
+
+  Histogram(Histogram const &);
+
+  void
+  operator=(Histogram const &);
+
+};
+
+//**********************************************************************
+// Class: Statistics
+//**********************************************************************
+
+class Statistics
+{
+
+  friend class Event;
+  friend class Handler;
+
+public:
+
+  static Statistics&
+  Instance()
+  {
+    static Statistics instance;
+    return instance;
+  }
+
+  bool
+  IsEnabled() const;
+
+  void
+  Enable();
+
+  void
+  Disable();
+
+  Histogram&
+  GetEventHistogram(const Event::TYPE type_);
+
+  std::map<std::string, SHARED_PTR(Histogram)>
+  GetObserverHistograms();
+
+  std::string
+  Dump();
+
+  void
+  Reset();
+
+protected:
+
+  SHARED_PTR(Histogram)
+  attachObserver(Observer* obs_);
+
+private:
+
+  ATOMIC(bool) _enabled;
+  zSem::Mutex _lock;
+  Histogram _events[Event::TYPE_LAST];
+  std::map<Observer*, std::pair<std::string, SHARED_PTR(Histogram)> > _observers;
+
+  Statistics();
+
+  Statistics(Statistics const &);
+
+  void
+  operator=(Statistics const &);
+
+};
+
 //**********************************************************************
 // Class: Handler
 //**********************************************************************
@@ -170,6 +294,7 @@ private:
   zSem::Mutex _event_lock;
   std::list<Event *> _event_list;
   std::list<Observer*> _obs_list;
+  std::map<Observer*, SHARED_PTR(Histogram)> _obs_stats;
 
   Handler(Handler const &);
 
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZHASHWHEEL_H__
+#define __ZHASHWHEEL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+
+namespace zUtils
+{
+namespace zHashWheel
+{
+
+//**********************************************************************
+// Class: HashTable
+//**********************************************************************
+
+// Open addressed hash table with linear probing, for small records that
+//   carry their own key. HASH hashes the key of a record and USED tells
+//   occupied slots from free ones; a value initialized record is free.
+//   Erasing shifts records back instead of leaving tombstones. Positions
+//   are valid until the next insert or erase; Capacity() means none.
+//   Not thread safe.
+template<typename T, typename HASH, typename USED>
+  class HashTable
+  {
+
+  public:
+
+    HashTable(const size_t capacity_ = 64) :
+        _slots(HashTable::round(capacity_)), _size(0)
+    {
+    }
+
+    size_t
+    Size() const
+    {
+      return (this->_size);
+    }
+
+    size_t
+    Capacity() const
+    {
+      return (this->_slots.size());
+    }
+
+    T&
+    operator[](const size_t pos_)
+    {
+      return (this->_slots[pos_]);
+    }
+
+    const T&
+    operator[](const size_t pos_) const
+    {
+      return (this->_slots[pos_]);
+    }
+
+    bool
+    Used(const size_t pos_) const
+    {
+      return (this->_used(this->_slots[pos_]));
+    }
+
+    // Returns the position of the first record probed from hash_ that
+    //   match_ accepts
+    template<typename MATCH>
+      size_t
+      Find(const size_t hash_, const MATCH& match_) const
+      {
+        size_t mask = (this->_slots.size() - 1);
+        for (size_t pos = (hash_ & mask); this->_used(this->_slots[pos]); pos = ((pos + 1) & mask))
+        {
+          if (match_(this->_slots[pos]))
+          {
+            return (pos);
+          }
+        }
+        return (this->_slots.size());
+      }
+
+    // Duplicates are not checked for; grows at three quarters full
+    void
+    Insert(const T& record_)
+    {
+      if (((this->_size + 1) * 4) > (this->_slots.size() * 3))
+      {
+        this->grow();
+      }
+      size_t mask = (this->_slots.size() - 1);
+      size_t pos = (this->_hash(record_) & mask);
+      while (this->_used(this->_slots[pos]))
+      {
+        pos = ((pos + 1) & mask);
+      }
+      this->_slots[pos] = record_;
+      this->_size++;
+      return;
+    }
+
+    void
+    Erase(size_t pos_)
+    {
+      // Records after the hole shift back into it unless their home slot lies
+      //   between the hole and where they are, which keeps probes tombstone free
+      size_t mask = (this->_slots.size() - 1);
+      size_t next = pos_;
+      this->_slots[pos_] = T();
+      this->_size--;
+      for (;;)
+      {
+        next = ((next + 1) & mask);
+        if (!this->_used(this->_slots[next]))
+        {
+          break;
+        }
+        size_t home = (this->_hash(this->_slots[next]) & mask);
+        bool stays = (pos_ <= next) ? ((pos_ < home) && (home <= next)) : ((pos_ < home) || (home <= next));
+        if (!stays)
+        {
+          this->_slots[pos_] = this->_slots[next];
+          this->_slots[next] = T();
+          pos_ = next;
+        }
+      }
+      return;
+    }
+
+  protected:
+
+  private:
+
+    std::vector<T> _slots;
+    size_t _size;
+    HASH _hash;
+    USED _used;
+
+    static size_t
+    round(const size_t capacity_)
+    {
+      size_t size = 4;
+      while (size < capacity_)
+      {
+        size *= 2;
+      }
+      return (size);
+    }
+
+    void
+    grow()
+    {
+      std::vector<T> slots(this->_slots.size() * 2);
+      slots.swap(this->_slots);
+      this->_size = 0;
+      for (size_t i = 0; i < slots.size(); i++)
+      {
+        if (this->_used(slots[i]))
+        {
+          this->Insert(slots[i]);
+        }
+      }
+      return;
+    }
+
+  };
+
+//**********************************************************************
+// Class: TimerWheel
+//**********************************************************************
+
+// Hashed timer wheel of keys with deadlines in ticks. Timers are never
+//   cancelled; the owner skips those it no longer wants when they come due,
+//   typically by comparing the deadline with the one it keeps. Not thread
+//   safe.
+template<typename KEY>
+  class TimerWheel
+  {
+
+  public:
+
+    TimerWheel(const size_t slots_, const uint64_t tick_) :
+        _wheel(slots_ ? slots_ : 1), _tick(tick_)
+    {
+    }
+
+    void
+    Schedule(const KEY& key_, const uint64_t deadline_)
+    {
+      timer t = { key_, deadline_ };
+      this->_wheel[deadline_ % this->_wheel.size()].push_back(t);
+      return;
+    }
+
+    // Calls due_(key, deadline) for every timer due by tick_; due_ may
+    //   schedule timers again
+    template<typename DUE>
+      void
+      Turn(const uint64_t tick_, const DUE& due_)
+      {
+        // Visit the slot of every tick since the last turn, or each slot once when
+        //   the wheel has gone round; timers for later turns stay in their slot
+        uint64_t ticks = (tick_ - this->_tick);
+        if (ticks > this->_wheel.size())
+        {
+          ticks = this->_wheel.size();
+        }
+        for (uint64_t t = (tick_ - ticks + 1); t <= tick_; t++)
+        {
+          std::vector<timer>& slot = this->_wheel[t % this->_wheel.size()];
+          for (size_t i = 0; i < slot.size();)
+          {
+            if (slot[i].deadline > tick_)
+            {
+              i++;
+              continue;
+            }
+            timer due = slot[i];
+            slot[i] = slot.back();
+            slot.pop_back();
+            due_(due.key, due.deadline);
+          }
+        }
+        this->_tick = tick_;
+        return;
+      }
+
+  protected:
+
+  private:
+
+    struct timer
+    {
+      KEY key;
+      uint64_t deadline;
+    };
+
+    std::vector<std::vector<timer> > _wheel;
+    uint64_t _tick;
+
+  };
+
+}
+}
+
+#endif /* __ZHASHWHEEL_H__ */
@@ -71,13 +71,13 @@ public:
 
 protected:
 
-  bool
-  EventHandler(zEvent::Notification* notification_);
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_);
 
 private:
 
   bool
-  EventHandler(MessageNotification* notification_);
+  ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_);
 
 };
 
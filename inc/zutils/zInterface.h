@@ -249,6 +249,19 @@ private:
 
   SHARED_PTR(zConfig::ConfigData) _data;
 
+  // Compiled per instance so each caches lookups into its own tree
+  zData::CompiledPath _ifindex;
+  zData::CompiledPath _masterifindex;
+  zData::CompiledPath _ifname;
+  zData::CompiledPath _masterifname;
+  zData::CompiledPath _iftype;
+  zData::CompiledPath _mtu;
+  zData::CompiledPath _hwaddr;
+  zData::CompiledPath _ipaddr;
+  zData::CompiledPath _netmask;
+  zData::CompiledPath _adminstate;
+  zData::CompiledPath _promiscuousmode;
+
 };
 
 // ****************************************************************************
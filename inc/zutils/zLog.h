@@ -32,6 +32,7 @@
 #include <iostream>
 #include <sstream>
 #include <vector>
+#include <list>
 #include <map>
 
 #include <zutils/zCompatibility.h>
@@ -67,6 +68,39 @@ namespace zLog
 	  } \
   } while(false);
 
+// Logs a message with structured key/value fields attached using the builder
+//   interface, e.g. ZLOG_INFO_FIELDS("Link up", .Field("ifname", name).Field("mtu", mtu))
+#define ZLOG_LOGGER_FIELDS(l_,m_,f_) \
+  do { \
+    SHARED_PTR(zUtils::zLog::Message) msg = _zlogger.CreateMessage(l_); \
+    if (msg) { \
+      msg->SetFile(__FILE__); \
+      msg->SetLine(__LINE__); \
+      msg->AddMessage(m_); \
+      (*msg) f_; \
+      _zlogger.LogMessage(msg); \
+    } \
+  } while(false);
+
+// Logs at most 'n_' messages per 'p_' milliseconds from this call site; the
+// number of suppressed messages is periodically logged by the manager
+#define ZLOG_LOGGER_RATELIMIT(l_,n_,p_,m_) \
+  do { \
+    static zUtils::zLog::RateLimiter _zlimiter(_zlogger.GetModule(), (l_), (n_), (p_), __FILE__, __LINE__); \
+    if (_zlimiter.Allow()) { \
+      ZLOG_LOGGER(l_,m_) \
+    } \
+  } while(false);
+
+// Logs the first and then every 'n_'th message from this call site
+#define ZLOG_LOGGER_EVERY_N(l_,n_,m_) \
+  do { \
+    static zUtils::zLog::Sampler _zsampler((n_)); \
+    if (_zsampler.Allow()) { \
+      ZLOG_LOGGER(l_,m_) \
+    } \
+  } while(false);
+
 #ifdef DEBUG
 #define ZLOG_CRIT(x)    ZLOG_LOGGER(zUtils::zLog::Log::LEVEL_CRIT,(x))
 #define ZLOG_ERR(x)     ZLOG_LOGGER(zUtils::zLog::Log::LEVEL_ERROR,(x))
@@ -76,6 +110,21 @@ namespace zLog
 #define ZLOG_DEBUG1(x)   ZLOG_LOGGER(zUtils::zLog::Log::LEVEL_DEBUG1,(x))
 #define ZLOG_DEBUG2(x)   ZLOG_LOGGER(zUtils::zLog::Log::LEVEL_DEBUG2,(x))
 #define ZLOG_DEBUG3(x)   ZLOG_LOGGER(zUtils::zLog::Log::LEVEL_DEBUG3,(x))
+#define ZLOG_CRIT_RATELIMIT(n,p,x)    ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_CRIT,(n),(p),(x))
+#define ZLOG_ERR_RATELIMIT(n,p,x)     ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_ERROR,(n),(p),(x))
+#define ZLOG_WARN_RATELIMIT(n,p,x)    ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_WARN,(n),(p),(x))
+#define ZLOG_INFO_RATELIMIT(n,p,x)    ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_INFO,(n),(p),(x))
+#define ZLOG_DEBUG_RATELIMIT(n,p,x)   ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_DEBUG,(n),(p),(x))
+#define ZLOG_CRIT_EVERY_N(n,x)    ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_CRIT,(n),(x))
+#define ZLOG_ERR_EVERY_N(n,x)     ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_ERROR,(n),(x))
+#define ZLOG_WARN_EVERY_N(n,x)    ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_WARN,(n),(x))
+#define ZLOG_INFO_EVERY_N(n,x)    ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_INFO,(n),(x))
+#define ZLOG_DEBUG_EVERY_N(n,x)   ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_DEBUG,(n),(x))
+#define ZLOG_CRIT_FIELDS(x,f)     ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_CRIT,(x),f)
+#define ZLOG_ERR_FIELDS(x,f)      ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_ERROR,(x),f)
+#define ZLOG_WARN_FIELDS(x,f)     ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_WARN,(x),f)
+#define ZLOG_INFO_FIELDS(x,f)     ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_INFO,(x),f)
+#define ZLOG_DEBUG_FIELDS(x,f)    ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_DEBUG,(x),f)
 #else
 #define ZLOG_CRIT(x)    ZLOG_LOGGER(zUtils::zLog::Log::LEVEL_CRIT,(x))
 #define ZLOG_ERR(x)     ZLOG_LOGGER(zUtils::zLog::Log::LEVEL_ERROR,(x))
@@ -85,6 +134,21 @@ namespace zLog
 #define ZLOG_DEBUG1(x)
 #define ZLOG_DEBUG2(x)
 #define ZLOG_DEBUG3(x)
+#define ZLOG_CRIT_RATELIMIT(n,p,x)    ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_CRIT,(n),(p),(x))
+#define ZLOG_ERR_RATELIMIT(n,p,x)     ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_ERROR,(n),(p),(x))
+#define ZLOG_WARN_RATELIMIT(n,p,x)    ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_WARN,(n),(p),(x))
+#define ZLOG_INFO_RATELIMIT(n,p,x)    ZLOG_LOGGER_RATELIMIT(zUtils::zLog::Log::LEVEL_INFO,(n),(p),(x))
+#define ZLOG_DEBUG_RATELIMIT(n,p,x)
+#define ZLOG_CRIT_EVERY_N(n,x)    ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_CRIT,(n),(x))
+#define ZLOG_ERR_EVERY_N(n,x)     ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_ERROR,(n),(x))
+#define ZLOG_WARN_EVERY_N(n,x)    ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_WARN,(n),(x))
+#define ZLOG_INFO_EVERY_N(n,x)    ZLOG_LOGGER_EVERY_N(zUtils::zLog::Log::LEVEL_INFO,(n),(x))
+#define ZLOG_DEBUG_EVERY_N(n,x)
+#define ZLOG_CRIT_FIELDS(x,f)     ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_CRIT,(x),f)
+#define ZLOG_ERR_FIELDS(x,f)      ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_ERROR,(x),f)
+#define ZLOG_WARN_FIELDS(x,f)     ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_WARN,(x),f)
+#define ZLOG_INFO_FIELDS(x,f)     ZLOG_LOGGER_FIELDS(zUtils::zLog::Log::LEVEL_INFO,(x),f)
+#define ZLOG_DEBUG_FIELDS(x,f)
 #endif
 
 inline std::string
@@ -159,6 +223,8 @@ template<typename T>
 // Class: Connector
 //*****************************************************************************
 
+class Message;
+
 class Connector
 {
 
@@ -167,6 +233,11 @@ public:
   virtual void
   Logger(std::string msg_) = 0;
 
+  // Called by the manager for each message; the default formats a
+  //   tab-separated line and passes it to Logger()
+  virtual void
+  LogMessage(const SHARED_PTR(Message)& msg_);
+
 protected:
 
 private:
@@ -197,6 +268,219 @@ private:
 
 };
 
+//*****************************************************************************
+// Class: FileCompressor
+//*****************************************************************************
+
+class FileCompressor :
+    public zThread::ThreadFunction
+{
+
+public:
+
+  FileCompressor();
+
+  virtual
+  ~FileCompressor();
+
+  bool
+  Compress(const std::string& file_);
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  zQueue::Queue<std::string> _file_queue;
+  zThread::Thread _thread;
+
+};
+
+//*****************************************************************************
+// Class: BufferedFileConnector
+//*****************************************************************************
+
+class BufferedFileConnector :
+    public Connector,
+    public zThread::ThreadFunction,
+    public zThread::ThreadArg
+{
+
+public:
+
+  static const size_t DefaultFlushSize;
+  static const uint32_t DefaultFlushInterval; // milliseconds
+  static const size_t DefaultBufferLimit;
+  static const unsigned int DefaultRotateCount;
+
+  BufferedFileConnector(const std::string& logfile_);
+
+  virtual
+  ~BufferedFileConnector();
+
+  size_t
+  GetFlushSize();
+
+  bool
+  SetFlushSize(const size_t bytes_);
+
+  uint32_t
+  GetFlushInterval();
+
+  bool
+  SetFlushInterval(const uint32_t msec_);
+
+  size_t
+  GetBufferLimit();
+
+  bool
+  SetBufferLimit(const size_t bytes_);
+
+  size_t
+  GetRotateSize();
+
+  bool
+  SetRotateSize(const size_t bytes_);
+
+  uint32_t
+  GetRotateInterval();
+
+  bool
+  SetRotateInterval(const uint32_t sec_);
+
+  unsigned int
+  GetRotateCount();
+
+  bool
+  SetRotateCount(const unsigned int count_);
+
+  bool
+  GetCompress();
+
+  bool
+  SetCompress(const bool flag_);
+
+  uint64_t
+  GetDropped();
+
+  bool
+  Flush();
+
+  virtual void
+  Logger(std::string msg_);
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  std::string _path;
+  int _fd;
+  size_t _file_size;
+  time_t _file_opened;
+
+  // Producer side; only held long enough to append or swap a buffer
+  zSem::Mutex _buf_lock;
+  std::vector<std::string> _buf;
+  size_t _buf_bytes;
+  uint64_t _dropped;
+
+  // Writer side; serializes flushes and rotations
+  zSem::Mutex _write_lock;
+  std::vector<std::string> _pending;
+
+  size_t _flush_size;
+  uint32_t _flush_interval;
+  size_t _buf_limit;
+  size_t _rotate_size;
+  uint32_t _rotate_interval;
+  unsigned int _rotate_count;
+  bool _compress;
+
+  zSem::Semaphore _flush_sem;
+  zThread::Thread _thread;
+  FileCompressor _compressor;
+
+  bool
+  _open();
+
+  void
+  _close();
+
+  bool
+  _flush();
+
+  bool
+  _write(std::vector<std::string>& buf_);
+
+  bool
+  _rotate();
+
+};
+
+//*****************************************************************************
+// Class: JsonFileConnector
+//*****************************************************************************
+
+class JsonFileConnector :
+    public BufferedFileConnector
+{
+
+public:
+
+  JsonFileConnector(const std::string& logfile_);
+
+  virtual
+  ~JsonFileConnector();
+
+  virtual void
+  LogMessage(const SHARED_PTR(Message)& msg_);
+
+protected:
+
+private:
+
+};
+
+//*****************************************************************************
+// Class: UnixConnector
+//*****************************************************************************
+
+class UnixConnector :
+    public Connector
+{
+
+public:
+
+  UnixConnector(const std::string& path_);
+
+  virtual
+  ~UnixConnector();
+
+  uint64_t
+  GetDropped() const;
+
+  virtual void
+  Logger(std::string msg_);
+
+  virtual void
+  LogMessage(const SHARED_PTR(Message)& msg_);
+
+protected:
+
+private:
+
+  std::string _path;
+  int _fd;
+  bool _connected;
+  ATOMIC(uint64_t) _dropped;
+
+};
+
 //*****************************************************************************
 // Class: ConsoleConnector
 //*****************************************************************************
@@ -223,8 +507,6 @@ private:
 // Class: Log
 //*****************************************************************************
 
-class Message;
-
 class Log
 {
 
@@ -275,6 +557,9 @@ public:
   virtual
   ~Log();
 
+  const std::string&
+  GetModule() const;
+
   Log::LEVEL
   GetMaxLevel();
 
@@ -301,6 +586,77 @@ private:
 
 };
 
+//*****************************************************************************
+// Class: RateLimiter
+//*****************************************************************************
+
+class RateLimiter
+{
+
+  friend class Manager;
+
+public:
+
+  RateLimiter(const std::string& module_, const Log::LEVEL level_, const uint32_t count_,
+      const uint32_t period_, const std::string& file_, const unsigned int line_);
+
+  virtual
+  ~RateLimiter();
+
+  bool
+  Allow();
+
+  uint64_t
+  GetSuppressed() const;
+
+protected:
+
+  bool
+  report(const uint64_t now_);
+
+private:
+
+  std::string _module;
+  Log::LEVEL _level;
+  std::string _file;
+  unsigned int _line;
+
+  // Token bucket; tokens are scaled by the period so refill is integer math
+  MUTEX _lock;
+  uint64_t _count;
+  uint64_t _period;
+  uint64_t _tokens;
+  uint64_t _last;
+
+  ATOMIC(uint64_t) _suppressed;
+  uint64_t _reported;
+
+};
+
+//*****************************************************************************
+// Class: Sampler
+//*****************************************************************************
+
+class Sampler
+{
+
+public:
+
+  Sampler(const uint32_t n_);
+
+  virtual
+  ~Sampler();
+
+  bool
+  Allow();
+
+private:
+
+  uint32_t _n;
+  ATOMIC(uint64_t) _cnt;
+
+};
+
 //*****************************************************************************
 // Message Class
 //*****************************************************************************
@@ -310,6 +666,13 @@ class Message
 
 public:
 
+  struct KeyValue
+  {
+    std::string Key;
+    std::string Value;
+    bool Quoted;
+  };
+
   Message(const std::string& module_, const Log::LEVEL level_);
 
   ~Message();
@@ -350,10 +713,44 @@ public:
   void
   AddMessage(const std::string &str);
 
+  const std::vector<Message::KeyValue>&
+  GetFields() const;
+
+  Message&
+  Field(const std::string& key_, const std::string& value_);
+
+  Message&
+  Field(const std::string& key_, const char* value_);
+
+  Message&
+  Field(const std::string& key_, const int value_);
+
+  Message&
+  Field(const std::string& key_, const unsigned int value_);
+
+  Message&
+  Field(const std::string& key_, const long value_);
+
+  Message&
+  Field(const std::string& key_, const unsigned long value_);
+
+  Message&
+  Field(const std::string& key_, const double value_);
+
+  Message&
+  Field(const std::string& key_, const bool value_);
+
+  std::string
+  Str() const;
+
+  std::string
+  GetJson() const;
+
 protected:
 
 private:
 
+  std::vector<Message::KeyValue> _fields;
   std::string _module;
   Log::LEVEL _level;
   std::string _proc;
@@ -373,6 +770,7 @@ class Manager : public zThread::ThreadArg, public zThread::ThreadFunction
 {
 
   friend Log;
+  friend RateLimiter;
 
 public:
 
@@ -421,6 +819,15 @@ protected:
   void
   logMessage(const SHARED_PTR(zLog::Message)& message_);
 
+  bool
+  registerLimiter(RateLimiter* limiter_);
+
+  bool
+  unregisterLimiter(RateLimiter* limiter_);
+
+  void
+  reportLimiters();
+
   virtual void
   Run(zThread::ThreadArg *arg_);
 
@@ -432,6 +839,8 @@ private:
   std::map<std::string, Log::LEVEL> _max_level;
   std::map<std::string, int> _mod_refcnt;
   std::map<Log::LEVEL, Connector*> _conn;
+  std::list<RateLimiter*> _limiters;
+  uint64_t _limiters_reported;
 
   Manager();
 
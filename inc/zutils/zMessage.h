@@ -155,12 +155,24 @@ public:
   static zMessage::Message *
   Create(const std::string& json_);
 
+  // Accepts the JSON or the binary encoding, or a single frame
+  static zMessage::Message *
+  Create(const void* buf_, const size_t len_);
+
   static zMessage::Message *
   Create(const zData::Data& data_);
 
   static zMessage::Message *
   Create(const zMessage::Message& msg_);
 
+  // Pooled alternatives to Create; the message goes back to the pool when
+  //   the last handle is released (see MessagePool)
+  static SHARED_PTR(zMessage::Message)
+  Acquire(const zMessage::Message::TYPE& type_);
+
+  static SHARED_PTR(zMessage::Message)
+  Acquire(const zMessage::Message& msg_);
+
 };
 
 }
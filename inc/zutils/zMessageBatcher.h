@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZMESSAGEBATCHER_H__
+#define __ZMESSAGEBATCHER_H__
+
+#include <stdint.h>
+
+#include <string>
+#include <map>
+
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: BatchTransport
+//**********************************************************************
+
+class BatchTransport
+{
+
+public:
+
+  virtual
+  ~BatchTransport()
+  {
+  }
+
+  // Sends a buffer of one or more frames to the destination
+  virtual bool
+  TransmitBatch(const std::string& dst_, const std::string& buf_) = 0;
+
+};
+
+//**********************************************************************
+// Class: MessageBatcher
+//**********************************************************************
+
+// Coalesces messages bound for the same destination. Each message is framed
+//   (see MessageFrame) and appended to the destination's batch, which is sent
+//   once the next frame would not fit in the MTU or when the delay since its
+//   first message has passed. Frames larger than the MTU are sent alone.
+//   Receivers split batches back into messages from the frame lengths.
+class MessageBatcher : public zThread::ThreadFunction
+{
+
+public:
+
+  MessageBatcher(BatchTransport& transport_, const size_t mtu_ = 1400, const uint32_t delay_ms_ = 5);
+
+  virtual
+  ~MessageBatcher();
+
+  bool
+  Add(const zMessage::Message& msg_);
+
+  // Sends the pending batches now
+  bool
+  Flush();
+
+  size_t
+  GetMtu() const;
+
+  uint32_t
+  GetDelay() const;
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  struct batch
+  {
+    std::string buf;
+    uint64_t due;
+  };
+
+  mutable zSem::Mutex _lock;
+  BatchTransport& _transport;
+  const size_t _mtu;
+  const uint32_t _delay;
+  std::map<std::string, batch> _batches;
+  zSem::Semaphore _wake;
+  zThread::Thread _thread;
+
+};
+
+}
+}
+
+#endif /* __ZMESSAGEBATCHER_H__ */
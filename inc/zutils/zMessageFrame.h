@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZMESSAGEFRAME_H__
+#define __ZMESSAGEFRAME_H__
+
+#include <stdint.h>
+
+#include <string>
+
+#include <zutils/zData.h>
+#include <zutils/zSocket.h>
+#include <zutils/zMessage.h>
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: MessageFrame
+//**********************************************************************
+
+// Binary wire framing for messages. A frame is a fixed header followed by
+//   the destination and source addresses and the rest of the message in the
+//   binary data encoding; multi-byte fields are in network byte order.
+//
+//     0   magic "zM"      2
+//     2   version         1
+//     3   type            1
+//     4   id              16 (binary UUID)
+//     20  dst length      1
+//     21  src length      1
+//     22  reserved        2
+//     24  data length     4
+//     28  dst, src, data
+//
+//   Frames carry their length so a byte stream splits back into frames, and
+//   the header is read in place without decoding the data. A frame views the
+//   caller's buffer, which must outlive it.
+class MessageFrame
+{
+
+public:
+
+  static const size_t HeaderSize;
+
+  // Largest frame accepted; larger frames are neither encoded nor valid
+  static const size_t MaxSize;
+
+  MessageFrame(const void* buf_, const size_t len_);
+
+  MessageFrame(const zSocket::Buffer& buf_);
+
+  virtual
+  ~MessageFrame();
+
+  // True if the buffer holds at least one whole, well formed frame
+  bool
+  Valid() const;
+
+  size_t
+  Size() const;
+
+  Message::TYPE
+  GetType() const;
+
+  std::string
+  GetId() const;
+
+  std::string
+  GetDst() const;
+
+  std::string
+  GetSrc() const;
+
+  const uint8_t*
+  Data() const;
+
+  size_t
+  DataLength() const;
+
+  // Decodes the whole message; the caller owns the result
+  Message*
+  Decode() const;
+
+  // Decodes the whole message into msg_, which should be of the frame's type
+  bool
+  Decode(Message& msg_) const;
+
+  // Appends the framed message; fails for ids that are not UUIDs, for
+  //   addresses longer than 255 bytes and for frames over MaxSize
+  static bool
+  Encode(const Message& msg_, std::string& out_);
+
+  static bool
+  Detect(const void* buf_, const size_t len_);
+
+  // Length of the frame starting at buf_ as given by its header, or zero
+  //   until the whole header is available
+  static size_t
+  Length(const void* buf_, const size_t len_);
+
+  // True if the buffer starts a frame that is not yet complete but may still
+  //   become valid; false once it can never be, so a stream can be dropped
+  static bool
+  Partial(const void* buf_, const size_t len_);
+
+protected:
+
+private:
+
+  const uint8_t* _buf;
+  size_t _len;
+
+};
+
+}
+}
+
+#endif /* __ZMESSAGEFRAME_H__ */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZMESSAGEPOOL_H__
+#define __ZMESSAGEPOOL_H__
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <zutils/zCompatibility.h>
+#include <zutils/zSem.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: MessagePool
+//**********************************************************************
+
+// Recycles messages through a free list per message type. Acquired messages
+//   are handed out as shared handles; when the last handle goes away the
+//   message is reset to a blank message of its type and returned to its free
+//   list, up to the limit, instead of being deleted. Each acquired message
+//   carries a fresh id.
+class MessagePool
+{
+
+public:
+
+  static const size_t DefaultLimit;
+
+  static MessagePool&
+  Instance()
+  {
+    static MessagePool instance;
+    return (instance);
+  }
+
+  SHARED_PTR(zMessage::Message)
+  Acquire(const zMessage::Message::TYPE& type_);
+
+  // Messages of the type waiting for reuse
+  size_t
+  Free(const zMessage::Message::TYPE& type_) const;
+
+  size_t
+  GetLimit() const;
+
+  // Maximum messages kept per type; the free lists are trimmed to fit
+  bool
+  SetLimit(const size_t limit_);
+
+protected:
+
+private:
+
+  struct recycle
+  {
+    recycle(const zMessage::Message::TYPE type_) :
+        type(type_)
+    {
+    }
+
+    void
+    operator()(zMessage::Message* msg_) const
+    {
+      MessagePool::Instance().release(msg_, this->type);
+    }
+
+    zMessage::Message::TYPE type;
+  };
+
+  // Set once the pool is destroyed; handles released later, during static
+  //   destruction, delete their message instead
+  static ATOMIC(bool) _destroyed;
+
+  mutable zSem::Mutex _lock;
+  size_t _limit;
+  std::vector<zMessage::Message*> _free[zMessage::Message::TYPE_LAST];
+  zMessage::Message* _blank[zMessage::Message::TYPE_LAST];
+
+  void
+  release(zMessage::Message* msg_, const zMessage::Message::TYPE type_);
+
+  MessagePool();
+
+  MessagePool(MessagePool const&);
+
+  virtual
+  ~MessagePool();
+
+  void
+  operator=(MessagePool const&);
+
+};
+
+}
+}
+
+#endif /* __ZMESSAGEPOOL_H__ */
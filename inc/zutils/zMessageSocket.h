@@ -20,12 +20,17 @@
 #include <string>
 #include <map>
 
+#include <zutils/zSem.h>
 #include <zutils/zEvent.h>
 #include <zutils/zSocket.h>
 #include <zutils/zMessage.h>
 #include <zutils/zHelloMessage.h>
 #include <zutils/zByeMessage.h>
 #include <zutils/zAckMessage.h>
+#include <zutils/zAckTracker.h>
+#include <zutils/zReliableChannel.h>
+#include <zutils/zMessageBatcher.h>
+#include <zutils/zMessageTopic.h>
 
 namespace zUtils
 {
@@ -36,7 +41,8 @@ namespace zMessage
 // Class: MessageSocket
 //**********************************************************************
 
-class MessageSocket : public zEvent::Event, public zEvent::Observer
+class MessageSocket : public zEvent::Event, public zSocket::Observer, public ReliableTransport,
+    public BatchTransport
 {
 
 public:
@@ -67,22 +73,102 @@ public:
   bool
   Send(zMessage::Message &msg_);
 
+  // Sends and calls the handler once the ack arrives or the timeout passes,
+  //   without blocking the caller
+  bool
+  Send(zMessage::Message &msg_, AckHandler* handler_, const uint32_t timeout_ms_);
+
+  // Encoding of sent messages; received messages may use either
+  zData::Data::FORMAT
+  GetFormat() const;
+
+  bool
+  SetFormat(const zData::Data::FORMAT format_);
+
+  // Sends messages as binary frames (see MessageFrame); needed on stream
+  //   sockets, where received frames are reassembled per peer
+  bool
+  IsFramed() const;
+
+  bool
+  SetFramed(const bool framed_);
+
+  // Sends messages through a ReliableChannel, which retransmits, orders and
+  //   de-duplicates them for each peer; both ends must enable it. Only set
+  //   before the first Listen() or Connect(); fails after.
+  bool
+  IsReliable() const;
+
+  bool
+  SetReliable(const bool reliable_, const uint32_t window_ = 32);
+
+  // Coalesces messages to the same destination into one datagram of up to
+  //   mtu_ bytes, sent when full or delay_ms_ after its first message;
+  //   batching sends framed messages. Only set before the first Listen()
+  //   or Connect(); fails after.
+  bool
+  IsBatching() const;
+
+  bool
+  SetBatching(const bool batching_, const size_t mtu_ = 1400, const uint32_t delay_ms_ = 5);
+
+  // Publishes and subscribes by topic through a TopicChannel; subscriptions
+  //   are exchanged with peers on connect or on their first update, and
+  //   received publications reach observers only when subscribed to. Only
+  //   set before the first Listen() or Connect(); fails after.
+  bool
+  IsPubSub() const;
+
+  bool
+  SetPubSub(const bool pubsub_);
+
+  bool
+  Subscribe(const std::string& filter_);
+
+  bool
+  Unsubscribe(const std::string& filter_);
+
+  // Sends the message to every peer subscribed to the topic, encoded once;
+  //   returns the number of peers sent to. The message is left unchanged.
+  size_t
+  Publish(const std::string& topic_, const zMessage::Message& msg_);
+
 protected:
 
+  // Sends the message once
+  virtual bool
+  Transmit(zMessage::Message& msg_);
+
   virtual bool
-  EventHandler(zEvent::Notification* notification_);
+  TransmitBatch(const std::string& dst_, const std::string& buf_);
+
+  virtual bool
+  ObserveEvent(SHARED_PTR(zSocket::Notification) n_);
 
 private:
 
   bool
-  EventHandler(zSocket::Notification* notification_);
-
+  receive(SHARED_PTR(zSocket::Notification) n_);
+
+  zSocket::Socket*
+  lookup(const std::string& addr_);
+
+  zData::Data::FORMAT _format;
+  bool _framed;
+  // Used without the lock once sockets are registered (see _started)
+  ReliableChannel* _channel;
+  MessageBatcher* _batcher;
+  TopicChannel* _topics;
+  zSem::Mutex _lock; // guards _partial, _sock and _started
+  bool _started;
+  std::map<std::string, std::string> _partial;
   std::map<std::string, zSocket::Socket*> _sock;
-  zEvent::Handler _sock_handler;
+  zSocket::Handler _sock_handler;
   zEvent::Handler _msg_handler;
   HelloObserver _hello_obs;
   ByeObserver _bye_obs;
   AckObserver _ack_obs;
+  AckTracker _acks;
 
 };
 
@@ -107,7 +193,7 @@ public:
     ID_LAST
   };
 
-  MessageNotification(zMessage::MessageSocket *sock_);
+  MessageNotification(zMessage::MessageSocket& sock_);
 
   virtual
   ~MessageNotification();
@@ -121,9 +207,14 @@ public:
   zMessage::MessageSocket*
   Sock() const;
 
+  // Valid for the life of the notification
   zMessage::Message*
   GetMessage() const;
 
+  // Keeps the message beyond the notification
+  SHARED_PTR(zMessage::Message)
+  GetMessagePtr() const;
+
 protected:
 
   bool
@@ -133,13 +224,13 @@ protected:
   type(Message::TYPE type_);
 
   bool
-  message(zMessage::Message* msg_);
+  message(SHARED_PTR(zMessage::Message) msg_);
 
 private:
 
   MessageNotification::ID _id;
   Message::TYPE _type;
-  zMessage::Message* _msg;
+  SHARED_PTR(zMessage::Message) _msg;
 
 };
 
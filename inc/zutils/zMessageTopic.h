@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZMESSAGETOPIC_H__
+#define __ZMESSAGETOPIC_H__
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include <zutils/zSem.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+#include <zutils/zReliableChannel.h>
+#include <zutils/zMessageBatcher.h>
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: TopicTrie
+//**********************************************************************
+
+// Topic filters indexed by level. Topics are '/' separated levels; in a
+//   filter a '+' level matches any one level and a trailing '#' level
+//   matches any number of levels, none included. A match walks the trie
+//   once per level, following the literal, '+' and '#' children only.
+class TopicTrie
+{
+
+public:
+
+  TopicTrie();
+
+  virtual
+  ~TopicTrie();
+
+  bool
+  Add(const std::string& filter_, const std::string& sub_);
+
+  bool
+  Remove(const std::string& filter_, const std::string& sub_);
+
+  // Inserts each subscriber with a filter matching the topic
+  size_t
+  Match(const std::string& topic_, std::set<std::string>& subs_) const;
+
+  bool
+  Match(const std::string& topic_) const;
+
+  // Number of (filter, subscriber) pairs
+  size_t
+  Size() const;
+
+  static bool
+  ValidTopic(const std::string& topic_);
+
+  static bool
+  ValidFilter(const std::string& filter_);
+
+private:
+
+  struct node
+  {
+    std::map<std::string, node*> children;
+    std::set<std::string> subs;
+  };
+
+  TopicTrie(const TopicTrie& other_);
+
+  node _root;
+  size_t _size;
+
+  static void
+  clear(node& node_);
+
+  static void
+  match(const node& node_, const std::vector<std::string>& levels_, const size_t level_,
+      std::set<std::string>& subs_);
+
+};
+
+//**********************************************************************
+// Class: TopicChannel
+//**********************************************************************
+
+// Publish and subscribe by topic between peers. Each peer sends its whole
+//   set of subscriptions whenever it changes, so a lost update is made good
+//   by the next one, and answers the first update from a new peer with its
+//   own. A publication is encoded once as a frame (see MessageFrame) and the
+//   same buffer is sent to every peer with a matching filter; receivers
+//   match it against their own filters before delivering it. Publications
+//   are sent once, without acks or retransmission.
+class TopicChannel
+{
+
+public:
+
+  static const std::string TopicDataPath;
+  static const std::string SubsDataPath;
+
+  TopicChannel(ReliableTransport& transport_, BatchTransport& batch_);
+
+  virtual
+  ~TopicChannel();
+
+  bool
+  Subscribe(const std::string& filter_);
+
+  bool
+  Unsubscribe(const std::string& filter_);
+
+  // Exchanges subscriptions with the peer
+  bool
+  AddPeer(const std::string& addr_);
+
+  bool
+  RemovePeer(const std::string& addr_);
+
+  // Sends the message to each peer subscribed to the topic; returns the
+  //   number of peers sent to. The message is left unchanged.
+  size_t
+  Publish(const std::string& topic_, const zMessage::Message& msg_);
+
+  // Takes topic traffic from a peer. Subscription updates are consumed;
+  //   deliver_ is set for publications matching a local subscription.
+  //   Returns false for messages outside the channel.
+  bool
+  Receive(const zMessage::Message& msg_, bool& deliver_);
+
+  // Peers subscribed to the topic
+  size_t
+  Subscribers(const std::string& topic_) const;
+
+private:
+
+  TopicChannel(const TopicChannel& other_);
+
+  mutable zSem::Mutex _lock;
+  ReliableTransport& _transport;
+  BatchTransport& _batch;
+  std::set<std::string> _subs;
+  TopicTrie _local;
+  std::map<std::string, std::set<std::string> > _peers;
+  TopicTrie _remote;
+
+  zMessage::Message*
+  update(const std::string& dst_) const;
+
+  void
+  transmit(std::vector<zMessage::Message*>& out_);
+
+};
+
+}
+}
+
+#endif /* __ZMESSAGETOPIC_H__ */
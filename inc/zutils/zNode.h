@@ -19,13 +19,20 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 #include <map>
 #include <list>
 
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zUuid.h>
+#include <zutils/zHashWheel.h>
 #include <zutils/zData.h>
 #include <zutils/zQueue.h>
-#include <zutils/zTimer.h>
+#include <zutils/zEvent.h>
 #include <zutils/zMessage.h>
+#include <zutils/zMessageSocket.h>
+#include <zutils/zReliableChannel.h>
 
 namespace zUtils
 {
@@ -133,9 +140,27 @@ public:
     EVENT_LAST
   };
 
+  struct Change
+  {
+    Observer::EVENT event;
+    const zNode::Node *node;
+  };
+
+  // Changes of one batch counted by event
+  struct Summary
+  {
+    size_t total;
+    size_t events[Observer::EVENT_LAST];
+  };
+
   virtual void
   EventHandler(Observer::EVENT event_, const Node &node_) = 0;
 
+  // Takes every change of a table turn at once, in order; by default each
+  //   is handed to EventHandler. Nodes are only valid for the call.
+  virtual void
+  BatchHandler(const std::vector<Observer::Change> &changes_, const Observer::Summary &summary_);
+
 protected:
 
 private:
@@ -145,7 +170,17 @@ private:
 //**********************************************************************
 // zNode::Table Class
 //**********************************************************************
-class Table : private zTimer::TimerObserver
+
+// Nodes are kept in an open addressed hash table of small state records
+//   keyed by the binary node id (ids that are not UUIDs are keyed by a digest
+//   and confirmed against the node), each pointing at its node. A node not
+//   refreshed ages from online to tardy, stale and offline, two periods per
+//   step, and is retired and removed two periods after going offline. Each
+//   node has one deadline in a timer wheel turned every period, so a turn
+//   only visits the nodes due to change state. All changes of a turn reach
+//   observers as one batch of references to the table's nodes; nodes
+//   removed while a batch is out are freed once it is done.
+class Table : public zThread::ThreadFunction
 {
 public:
 
@@ -163,6 +198,13 @@ public:
   zNode::Node *
   Find(const std::string &id_);
 
+  // Marks the node online and starts its aging over
+  bool
+  Refresh(const std::string &id_);
+
+  size_t
+  Size() const;
+
   void
   Register(zNode::Observer *obsvr_);
 
@@ -172,23 +214,211 @@ public:
 protected:
 
   virtual void
-  TimerTick();
+  Run(zThread::ThreadArg *arg_);
 
 private:
 
+  struct record
+  {
+    zUuid::Uuid::uuid id;
+    uint64_t deadline;
+    zNode::Node *node;
+    uint8_t state;
+    bool digest;
+  };
+
+  struct record_hash
+  {
+    size_t
+    operator()(const record &record_) const
+    {
+      return (zUuid::Uuid::Hash(record_.id));
+    }
+  };
+
+  struct record_used
+  {
+    bool
+    operator()(const record &record_) const
+    {
+      return (record_.node != NULL);
+    }
+  };
+
   Table(const zNode::Table &other_);
 
   void
-  _notify(std::list<std::pair<zNode::Observer::EVENT, zNode::Node> > notifications_);
+  _notify(const std::vector<zNode::Observer::Change> &changes_);
+
+  mutable zSem::Mutex _lock;
+  const uint32_t _period;
+  zHashWheel::HashTable<record, record_hash, record_used> _table;
+  size_t _busy;
+  std::vector<zNode::Node *> _removed;
+  zHashWheel::TimerWheel<zUuid::Uuid::uuid> _wheel;
+  zSem::Semaphore _wake;
+  zThread::Thread _thread;
+
+  std::list<zNode::Observer *> _observers;
+
+  uint64_t
+  now() const;
+
+  static bool
+  key(const std::string &id_, zUuid::Uuid::uuid &key_);
+
+  size_t
+  find(const zUuid::Uuid::uuid &key_, const std::string &id_) const;
+
+  void
+  schedule(record &record_, const uint64_t tick_);
 
-  zSem::Mutex _lock;
+  void
+  expire(const uint64_t tick_, std::vector<zNode::Observer::Change> &changes_);
 
-  zTimer::Timer _timer;
+  void
+  retire(const std::vector<zNode::Observer::Change> &changes_);
 
-  std::list<zNode::Node> _nodeList;
-  std::map<std::string, zNode::Node *> _idMap;
+};
 
-  std::list<zNode::Observer *> _observers;
+//**********************************************************************
+// zNode::Gossip Class
+//**********************************************************************
+
+// SWIM style membership. Each period the next member in a shuffled round
+//   robin is pinged; if no ack arrives within half a period, a few other
+//   members are asked to ping it on our behalf, and without any ack by the
+//   end of the period it is suspected. A suspect that does not refute the
+//   suspicion by raising its incarnation within the suspicion timeout is
+//   declared dead. Membership changes ride along on the probe traffic, each
+//   repeated a number of times growing with the log of the member count, so
+//   every member sends a constant number of messages per period however
+//   large the cluster is.
+//
+// Members are kept in the node table: new members are added online and live
+//   members are refreshed every period, so suspects and dead members age
+//   through the usual observer events. The table period should be no
+//   shorter than the gossip period. Messages go out through the transport;
+//   the caller hands received messages to Receive.
+class Gossip : public zThread::ThreadFunction
+{
+public:
+
+  enum STATE
+  {
+    STATE_ERR = -1,
+    STATE_NONE = 0,
+    STATE_ALIVE = 1,
+    STATE_SUSPECT = 2,
+    STATE_DEAD = 3,
+    STATE_LAST
+  };
+
+  static const std::string GossipDataPath;
+
+  Gossip(zNode::Table &table_, zMessage::ReliableTransport &transport_, const zNode::Node &self_,
+      const uint32_t period_ = 200, const size_t indirect_ = 3, const uint32_t suspect_ = 5); // msecs, periods
+
+  virtual
+  ~Gossip();
+
+  // Contacts a known member and starts probing
+  bool
+  Join(const std::string &addr_);
+
+  // Tells a few members this node is leaving and stops probing
+  bool
+  Leave();
+
+  // Takes gossip traffic; false for other messages
+  bool
+  Receive(const zMessage::Message &msg_);
+
+  Gossip::STATE
+  GetState(const std::string &id_) const;
+
+  uint32_t
+  GetIncarnation() const;
+
+  // Members not known to be dead
+  size_t
+  Size() const;
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  struct member
+  {
+    std::string addr;
+    uint32_t inc;
+    Gossip::STATE state;
+    uint64_t since;
+  };
+
+  struct update
+  {
+    std::string id;
+    std::string addr;
+    uint32_t inc;
+    Gossip::STATE state;
+  };
+
+  struct relay
+  {
+    std::string addr;
+    uint32_t seq;
+    uint64_t expire;
+  };
+
+  Gossip(const zNode::Gossip &other_);
+
+  mutable zSem::Mutex _lock;
+  zNode::Table &_table;
+  zMessage::ReliableTransport &_transport;
+  const std::string _id;
+  const std::string _addr;
+  const uint32_t _period;
+  const size_t _indirect;
+  const uint32_t _suspect;
+  uint32_t _inc;
+  bool _left;
+  std::map<std::string, member> _members;
+  std::list<std::pair<std::string, uint32_t> > _updates;
+  std::vector<std::string> _order;
+  size_t _next;
+  std::string _target;
+  uint32_t _seq;
+  uint32_t _probe;
+  uint64_t _sent;
+  bool _acked;
+  bool _asked;
+  uint64_t _round;
+  std::map<uint32_t, relay> _relays;
+  unsigned int _seed;
+  zSem::Semaphore _wake;
+  zThread::Thread _thread;
+
+  zMessage::Message
+  message(const std::string &op_, const std::string &dst_, const uint32_t seq_);
+
+  void
+  apply(const update &update_, const uint64_t now_, std::vector<update> &joined_);
+
+  void
+  spread(const std::string &id_);
+
+  void
+  tick(const uint64_t now_, std::vector<zMessage::Message> &out_, std::vector<update> &live_);
+
+  void
+  enroll(const std::vector<update> &nodes_, const bool add_);
+
+  void
+  transmit(std::vector<zMessage::Message> &out_);
 
 };
 
@@ -198,8 +428,6 @@ private:
 class Message : public zMessage::Message
 {
 
-  static const std::string STR_NODE;
-
 public:
 
   Message(zMessage::Message::TYPE, zNode::Node &node_);
@@ -224,7 +452,7 @@ private:
 //**********************************************************************
 // zNode::Manager Class
 //**********************************************************************
-class Manager : public zNode::Node, private zMessage::MessageObserver, private zNode::Observer
+class Manager : public zNode::Node, public zEvent::Observer, private zNode::Observer
 {
 
 public:
@@ -234,11 +462,13 @@ public:
   virtual
   ~Manager();
 
+  // Takes node messages from the socket; announcements go to dst_, which
+  //   may be a broadcast address
   bool
-  AddMessageHandler(zMessage::MessageHandler *handler_);
+  AddMessageSocket(zMessage::MessageSocket *sock_, const std::string &dst_);
 
   bool
-  RemMessageHandler(zMessage::MessageHandler *handler_);
+  RemMessageSocket(zMessage::MessageSocket *sock_);
 
   bool
   Announce();
@@ -249,7 +479,7 @@ public:
 protected:
 
   virtual bool
-  MessageRecv(zMessage::MessageHandler &handler_, zMessage::Message &msg_);
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_);
 
   virtual void
   EventHandler(zNode::Observer::EVENT event_, const zNode::Node &node_);
@@ -258,19 +488,24 @@ private:
 
   Table _nodeTable;
 
-  std::list<zMessage::MessageHandler *> _messageHandlers;
+  zEvent::Handler _msgHandler;
+
+  std::list<std::pair<zMessage::MessageSocket *, std::string> > _messageSockets;
+
+  bool
+  ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_);
 
   bool
-  _helloMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_);
+  _send(zMessage::Message::TYPE type_);
 
   bool
-  _ackMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_);
+  _helloMsgHandler(zNode::Message &msg_);
 
   bool
-  _byeMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_);
+  _byeMsgHandler(zNode::Message &msg_);
 
   bool
-  _nodeMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_);
+  _nodeMsgHandler(zNode::Message &msg_);
 
 };
 
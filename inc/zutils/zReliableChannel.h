@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZRELIABLECHANNEL_H__
+#define __ZRELIABLECHANNEL_H__
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: ReliableTransport
+//**********************************************************************
+
+class ReliableTransport
+{
+
+public:
+
+  virtual
+  ~ReliableTransport()
+  {
+  }
+
+  // Sends one message to its destination, once
+  virtual bool
+  Transmit(zMessage::Message& msg_) = 0;
+
+};
+
+//**********************************************************************
+// Class: ReliableChannel
+//**********************************************************************
+
+// Reliable, ordered delivery of messages over an unreliable transport.
+//   Messages to each peer are numbered; the receiver releases them in order,
+//   drops duplicates and answers with one ack carrying the cumulative
+//   sequence and the blocks received beyond it. The sender keeps at most a
+//   window of messages in flight and retransmits those not acked within a
+//   timeout adapted from the measured round trip time, or as soon as later
+//   messages are acked around a gap. Each sender state carries a random
+//   channel id so a restarted peer is not mistaken for duplicates.
+class ReliableChannel : public zThread::ThreadFunction
+{
+
+public:
+
+  static const std::string ChanDataPath;
+  static const std::string SeqDataPath;
+  static const std::string CumAckDataPath;
+  static const std::string SackDataPath;
+
+  ReliableChannel(ReliableTransport& transport_, const uint32_t window_ = 32);
+
+  virtual
+  ~ReliableChannel();
+
+  // Queues the message for its destination; it is sent once the window allows
+  bool
+  Send(const zMessage::Message& msg_);
+
+  // Takes channel traffic from a peer. Acks are consumed; data is acked and
+  //   the messages now in order are appended to deliver_. Returns false for
+  //   messages outside the channel.
+  bool
+  Receive(const zMessage::Message& msg_, std::vector<SHARED_PTR(zMessage::Message)>& deliver_);
+
+  // Messages sent or queued for dst_ and not yet acked
+  size_t
+  Pending(const std::string& dst_) const;
+
+  uint32_t
+  GetRto(const std::string& dst_) const;
+
+protected:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_);
+
+private:
+
+  struct outgoing
+  {
+    zMessage::Message msg;
+    uint64_t sent;
+    uint32_t tries;
+    bool fast;
+  };
+
+  struct sender
+  {
+    std::string chan;
+    uint32_t next;
+    std::map<uint32_t, outgoing> flight;
+    std::list<zMessage::Message> queue;
+    uint32_t srtt;
+    uint32_t rttvar;
+    uint32_t rto;
+    uint32_t backoff;
+  };
+
+  struct receiver
+  {
+    std::string chan;
+    uint32_t next;
+    std::map<uint32_t, zMessage::Message> held;
+    bool ack;
+    uint64_t ack_due;
+  };
+
+  mutable zSem::Mutex _lock;
+  ReliableTransport& _transport;
+  const uint32_t _window;
+  std::map<std::string, sender> _senders;
+  std::map<std::string, receiver> _receivers;
+  zSem::Semaphore _wake;
+  zThread::Thread _thread;
+
+  void
+  fill(sender& sender_, const uint64_t now_, std::vector<zMessage::Message>& out_);
+
+  void
+  acked(sender& sender_, const uint32_t seq_, const uint64_t now_);
+
+  void
+  ack(const std::string& peer_, receiver& receiver_, std::vector<zMessage::Message>& out_);
+
+  int
+  poll(const uint64_t now_, std::vector<zMessage::Message>& out_);
+
+  void
+  transmit(std::vector<zMessage::Message>& out_);
+
+};
+
+}
+}
+
+#endif /* __ZRELIABLECHANNEL_H__ */
@@ -20,6 +20,7 @@
 #include <signal.h>
 
 #include <vector>
+#include <thread>
 
 #include <zutils/zEvent.h>
 
@@ -73,7 +74,7 @@ protected:
   Signal(const Signal::ID id_);
 
   bool
-  Notify(siginfo_t *info_);
+  Notify(siginfo_t *info_, const uint64_t count_ = 1);
 
 private:
 
@@ -109,16 +110,23 @@ public:
   uint64_t
   Count() const;
 
+  uint64_t
+  Coalesced() const;
+
 protected:
 
   void
   siginfo(const siginfo_t *info_);
 
+  void
+  coalesced(const uint64_t cnt_);
+
 private:
 
   Signal::ID _id;
-  const siginfo_t* _info;
+  siginfo_t _info;
   uint64_t _cnt;
+  uint64_t _coalesced;
 
 };
 
@@ -130,6 +138,14 @@ class Handler
 {
 public:
 
+  enum MODE
+  {
+    MODE_ERR = -1,
+    MODE_ASYNC = 0, // observers are notified from signal context
+    MODE_SIGNALFD = 1, // signals are blocked and read from a signalfd
+    MODE_LAST
+  };
+
   Handler();
 
   ~Handler();
@@ -141,7 +157,29 @@ public:
   UnregisterObserver (Signal::ID id_, zEvent::Observer *obs_);
 
   bool
-  Notify(Signal::ID id_, siginfo_t *info_);
+  Notify(Signal::ID id_, siginfo_t *info_, const uint64_t count_ = 1);
+
+  Handler::MODE
+  GetMode() const;
+
+  // Switching to MODE_SIGNALFD blocks the handled signals in the calling thread
+  //   (and so in all threads it creates afterwards); if 'reader_' is false the
+  //   caller is expected to poll GetFd() and call Dispatch() itself
+  bool
+  SetMode(const Handler::MODE mode_, const bool reader_ = true);
+
+  int
+  GetFd() const;
+
+  bool
+  Dispatch();
+
+  bool
+  Block(sigset_t *oldset_);
+
+  // Async-signal-safe hand off used by the signal handler in MODE_SIGNALFD
+  bool
+  Defer(const int sig_);
 
 protected:
 
@@ -149,6 +187,16 @@ private:
 
   Signal* _sigs[Signal::ID_LAST];
 
+  ATOMIC(int) _mode;
+  sigset_t _sigset;
+  int _sfd;
+  int _pipe[2];
+  std::thread* _reader;
+  zSem::Semaphore _exit;
+
+  void
+  _read();
+
 };
 
 //**********************************************************************
@@ -355,6 +355,11 @@ public:
   const Socket::SOCKET_TYPE
   GetType() const;
 
+  // True when reads may split or join the sender's writes; datagram
+  //   sockets keep each write whole
+  virtual bool
+  IsStream() const;
+
   virtual const Address&
   GetAddress() const;
 
@@ -18,10 +18,17 @@
 #define __ZUUID_H__
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
 
 #include <uuid/uuid.h>
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <array>
@@ -47,6 +54,32 @@ public:
     } u;
   };
 
+  enum VERSION
+  {
+    VERSION_ERR = -1,
+    VERSION_NONE = 0,
+    // Random
+    VERSION_4 = 4,
+    // Unix time in milliseconds followed by random bits; sorts by creation
+    VERSION_7 = 7,
+    VERSION_LAST
+  };
+
+  // Hash functor for use as a key in unordered containers
+  struct hash
+  {
+    size_t
+    operator()(const Uuid& uuid_) const
+    {
+      return (uuid_.Hash());
+    }
+
+    size_t
+    operator()(const Uuid::uuid& uuid_) const
+    {
+      return (Uuid::Hash(uuid_));
+    }
+  };
 
   Uuid() :
     _uuid { 0 }
@@ -54,6 +87,12 @@ public:
     this->Regenerate();
   }
 
+  Uuid(const Uuid::VERSION version_) :
+    _uuid { 0 }
+  {
+    this->Regenerate(version_);
+  }
+
   Uuid(const struct Uuid::uuid& uuid_) :
     _uuid { 0 }
   {
@@ -111,16 +150,17 @@ public:
     return (*this);
   }
 
+  // UUIDs order as big endian numbers, which is their byte order
   bool
   operator<(const Uuid& other) const
   {
-    return (uuid_compare(this->_uuid.u.uuid, other._uuid.u.uuid) < 0);
+    return (memcmp(this->_uuid.u.u8, other._uuid.u.u8, 16) < 0);
   }
 
   bool
   operator>(const Uuid& other_) const
   {
-    return (uuid_compare(this->_uuid.u.uuid, other_._uuid.u.uuid) > 0);
+    return (memcmp(this->_uuid.u.u8, other_._uuid.u.u8, 16) > 0);
   }
 
   bool
@@ -138,25 +178,25 @@ public:
   bool
   operator==(const struct Uuid::uuid& other_) const
   {
-    return (uuid_compare(this->_uuid.u.uuid, other_.u.uuid) == 0);
+    return (Uuid::Equal(this->_uuid, other_));
   }
 
   bool
   operator!=(const struct Uuid::uuid& other_) const
   {
-    return (uuid_compare(this->_uuid.u.uuid, other_.u.uuid) != 0);
+    return (!Uuid::Equal(this->_uuid, other_));
   }
 
   bool
   operator==(const Uuid& other_) const
   {
-    return (uuid_compare(this->_uuid.u.uuid, other_._uuid.u.uuid) == 0);
+    return (Uuid::Equal(this->_uuid, other_._uuid));
   }
 
   bool
   operator!=(const Uuid& other_) const
   {
-    return (uuid_compare(this->_uuid.u.uuid, other_._uuid.u.uuid) != 0);
+    return (!Uuid::Equal(this->_uuid, other_._uuid));
   }
 
   const uuid&
@@ -172,32 +212,265 @@ public:
     return (true);
   }
 
+  Uuid::VERSION
+  GetVersion() const
+  {
+    return (Uuid::VERSION(this->_uuid.u.u8[6] >> 4));
+  }
+
   std::string
   Str() const
   {
-    char c_str[256] = { 0 };
-    uuid_unparse(this->_uuid.u.uuid, c_str);
-    return (std::string(c_str));
+    char str[36];
+    Uuid::Format(this->_uuid, str);
+    return (std::string(str, sizeof(str)));
+  }
+
+  // Accepts the canonical form, in either case
+  bool
+  Parse(const std::string& str_)
+  {
+    return (Uuid::Parse(str_, this->_uuid));
+  }
+
+  size_t
+  Hash() const
+  {
+    return (Uuid::Hash(this->_uuid));
   }
 
   void
-  Regenerate()
+  Regenerate(const Uuid::VERSION version_ = Uuid::VERSION_4)
+  {
+    Uuid::Generate(this->_uuid, version_);
+  }
+
+  // New UUID in the canonical form
+  static std::string
+  Create(const Uuid::VERSION version_ = Uuid::VERSION_4)
+  {
+    return (Uuid(version_).Str());
+  }
+
+  // Random bits come from a per thread buffer refilled by a single getrandom
+  //   call, so most UUIDs are made without entering the kernel. Version 7
+  //   UUIDs made by one thread within the same millisecond count up in the
+  //   bits following the time so they still sort by creation.
+  static void
+  Generate(Uuid::uuid& uuid_, const Uuid::VERSION version_ = Uuid::VERSION_4)
+  {
+    Uuid::entropy& e = Uuid::state();
+    Uuid::fill(e, uuid_.u.u8, sizeof(uuid_.u.u8));
+
+    if (version_ == Uuid::VERSION_7)
+    {
+      struct timespec ts = { 0 };
+      clock_gettime(CLOCK_REALTIME, &ts);
+      uint64_t ms = ((uint64_t(ts.tv_sec) * 1000) + (ts.tv_nsec / 1000000));
+      if (ms <= e.ms)
+      {
+        // Counts on from the last UUID; borrows the next millisecond once
+        //   the counter is spent
+        ms = e.ms;
+        if (++e.seq > 0xfff)
+        {
+          e.seq = (uuid_.u.u8[7] & 0x3ff);
+          ms++;
+        }
+      }
+      else
+      {
+        // Starts low enough to leave room to count
+        e.seq = (((uuid_.u.u8[6] << 8) | uuid_.u.u8[7]) & 0x3ff);
+      }
+      e.ms = ms;
+      for (int i = 5; i >= 0; i--)
+      {
+        uuid_.u.u8[i] = uint8_t(ms);
+        ms >>= 8;
+      }
+      uuid_.u.u8[6] = uint8_t(e.seq >> 8);
+      uuid_.u.u8[7] = uint8_t(e.seq);
+      uuid_.u.u8[6] = ((uuid_.u.u8[6] & 0x0f) | 0x70);
+    }
+    else
+    {
+      uuid_.u.u8[6] = ((uuid_.u.u8[6] & 0x0f) | 0x40);
+    }
+
+    // RFC 4122 variant
+    uuid_.u.u8[8] = ((uuid_.u.u8[8] & 0x3f) | 0x80);
+  }
+
+  // Writes the 36 characters of the canonical form; str_ is not terminated
+  static void
+  Format(const Uuid::uuid& uuid_, char* str_)
+  {
+    static const char hex[] = "0123456789abcdef";
+    for (int i = 0; i < 16; i++)
+    {
+      if ((i == 4) || (i == 6) || (i == 8) || (i == 10))
+      {
+        *str_++ = '-';
+      }
+      *str_++ = hex[uuid_.u.u8[i] >> 4];
+      *str_++ = hex[uuid_.u.u8[i] & 0x0f];
+    }
+  }
+
+  static bool
+  Parse(const std::string& str_, Uuid::uuid& uuid_)
   {
-    uuid_generate(this->_uuid.u.uuid);
+    static const Uuid::hextable table;
+    const uint8_t* p = (const uint8_t*) str_.data();
+
+    if ((str_.size() != 36) || (p[8] != '-') || (p[13] != '-') || (p[18] != '-') || (p[23] != '-'))
+    {
+      return (false);
+    }
+
+    Uuid::uuid id;
+    for (int i = 0; i < 16; i++)
+    {
+      if ((i == 4) || (i == 6) || (i == 8) || (i == 10))
+      {
+        p++;
+      }
+      uint8_t hi = table.val[p[0]];
+      uint8_t lo = table.val[p[1]];
+      if ((hi | lo) & 0xf0)
+      {
+        return (false);
+      }
+      id.u.u8[i] = ((hi << 4) | lo);
+      p += 2;
+    }
+    uuid_ = id;
+    return (true);
+  }
+
+  static bool
+  Equal(const Uuid::uuid& a_, const Uuid::uuid& b_)
+  {
+    return ((a_.u.u64[0] == b_.u.u64[0]) && (a_.u.u64[1] == b_.u.u64[1]));
+  }
+
+  // Both halves are mixed in as version 7 UUIDs lead with the time
+  static size_t
+  Hash(const Uuid::uuid& uuid_)
+  {
+    uint64_t h = (uuid_.u.u64[0] ^ (uuid_.u.u64[1] * 0x9e3779b97f4a7c15ULL));
+    h ^= (h >> 32);
+    h *= 0xd6e8feb86659fd93ULL;
+    h ^= (h >> 32);
+    return (size_t(h));
   }
 
 protected:
 
 private:
 
+  struct hextable
+  {
+    hextable()
+    {
+      memset(this->val, 0xff, sizeof(this->val));
+      for (int i = 0; i < 10; i++)
+      {
+        this->val['0' + i] = i;
+      }
+      for (int i = 0; i < 6; i++)
+      {
+        this->val['a' + i] = (10 + i);
+        this->val['A' + i] = (10 + i);
+      }
+    }
+
+    uint8_t val[256];
+  };
+
+  struct entropy
+  {
+    uint8_t buf[512];
+    size_t off;
+    uint32_t gen;
+    uint64_t ms;
+    uint32_t seq;
+  };
+
   struct uuid _uuid;
 
+  static Uuid::entropy&
+  state()
+  {
+    static __thread Uuid::entropy e = { { 0 }, sizeof(e.buf), 0, 0, 0 };
+    return (e);
+  }
+
+  // Bumped in a forked child so it does not hand out its parent's bytes
+  static volatile uint32_t&
+  generation()
+  {
+    static volatile uint32_t gen = 1;
+    return (gen);
+  }
+
+  static void
+  forked()
+  {
+    Uuid::generation()++;
+  }
+
+  static void
+  atfork()
+  {
+    pthread_atfork(NULL, NULL, Uuid::forked);
+  }
+
+  static void
+  fill(Uuid::entropy& e_, uint8_t* p_, const size_t len_)
+  {
+    if (((e_.off + len_) > sizeof(e_.buf)) || (e_.gen != Uuid::generation()))
+    {
+      static pthread_once_t once = PTHREAD_ONCE_INIT;
+      pthread_once(&once, Uuid::atfork);
+
+      size_t cnt = 0;
+#ifdef SYS_getrandom
+      while (cnt < sizeof(e_.buf))
+      {
+        long n = syscall(SYS_getrandom, &e_.buf[cnt], (sizeof(e_.buf) - cnt), 0);
+        if (n > 0)
+        {
+          cnt += n;
+        }
+        else if (errno != EINTR)
+        {
+          break;
+        }
+      }
+#endif
+      // Without getrandom the buffer is filled by libuuid
+      while (cnt < sizeof(e_.buf))
+      {
+        uuid_t u;
+        size_t n = std::min(sizeof(u), (sizeof(e_.buf) - cnt));
+        uuid_generate_random(u);
+        memcpy(&e_.buf[cnt], u, n);
+        cnt += n;
+      }
+      e_.off = 0;
+      e_.gen = Uuid::generation();
+    }
+    memcpy(p_, &e_.buf[e_.off], len_);
+    e_.off += len_;
+  }
+
 };
 
 }
 }
 
-
 // This is required to be used as a key for std::unordered_map
 namespace std
 {
@@ -206,7 +479,7 @@ namespace std
   {
     size_t operator()(const zUtils::zUuid::Uuid& k) const
     {
-      return (size_t(k().u.u64[0]));
+      return (k.Hash());
     }
   };
 }
@@ -31,6 +31,8 @@
 
 #include <zutils/zCommand.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_COMMAND);
+
 namespace zUtils
 {
 namespace zCommand
@@ -56,37 +58,37 @@ Command::~Command()
 }
 
 bool
-Command::EventHandler(zEvent::Notification* notification_)
+Command::ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
 {
 
   bool status = false;
-  if (notification_ && (notification_->GetType() == zEvent::Event::TYPE_MSG))
+  if (n_.get() && (n_->GetType() == zEvent::Event::TYPE_MSG))
   {
-    status = this->EventHandler((MessageNotification*) notification_);
+    status = this->ObserveEvent(STATIC_CAST(MessageNotification)(n_));
   }
-  else if (notification_ && (notification_->GetType() == zEvent::Event::TYPE_COMMAND))
+  else if (n_.get() && (n_->GetType() == zEvent::Event::TYPE_COMMAND))
   {
-    status = this->EventHandler((zCommand::CommandNotification*) notification_);
+    status = this->ObserveEvent(STATIC_CAST(zCommand::CommandNotification)(n_));
   }
-  else
+  else if (n_.get())
   {
-    ZLOG_WARN("Unknown event: " + ZLOG_INT(notification_->GetType()));
+    ZLOG_WARN("Unknown event: " + ZLOG_INT(n_->GetType()));
   }
 
   return (status);
 }
 
 bool
-Command::EventHandler(MessageNotification* notification_)
+Command::ObserveEvent(SHARED_PTR(MessageNotification) n_)
 {
   bool status = false;
 
-  if (notification_->MessageType() == Message::TYPE_CMD)
+  if (n_->MessageType() == Message::TYPE_CMD)
   {
-    CommandMessage* cmdmsg = (CommandMessage*) notification_->GetMessage();
+    CommandMessage* cmdmsg = (CommandMessage*) n_->GetMessage();
     if (cmdmsg)
     {
-      switch (notification_->Id())
+      switch (n_->Id())
       {
       case MessageNotification::ID_MSG_RCVD:
       {
@@ -103,7 +105,7 @@ Command::EventHandler(MessageNotification* notification_)
             ack->SetDst(cmdmsg->GetSrc());
             ack->SetStatus((status) ? AckMessage::STATUS_PASS : AckMessage::STATUS_FAIL);
             ack->SetInfo(data.GetOutput());
-            status = notification_->Sock()->Send(*ack);
+            status = n_->Sock()->Send(*ack);
             delete (ack);
           }
         }
@@ -124,12 +126,12 @@ Command::EventHandler(MessageNotification* notification_)
 }
 
 bool
-Command::EventHandler(zCommand::CommandNotification* notification_)
+Command::ObserveEvent(SHARED_PTR(zCommand::CommandNotification) n_)
 {
   bool status = false;
-  if (notification_->GetCommandData() == *this)
+  if (n_->GetCommandData() == *this)
   {
-    status = this->Execute(notification_->GetCommandData());
+    status = this->Execute(n_->GetCommandData());
   }
   return (status);
 }
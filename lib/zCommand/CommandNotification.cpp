@@ -38,8 +38,8 @@ namespace zCommand
 // Class: CommandNotification
 //**********************************************************************
 
-CommandNotification::CommandNotification() :
-    _id(CommandNotification::ID_NONE)
+CommandNotification::CommandNotification(zEvent::Event& event_) :
+    zEvent::Notification(event_), _id(CommandNotification::ID_NONE)
 {
 }
 
@@ -29,6 +29,8 @@
 
 #include <zutils/zCommand.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_COMMAND);
+
 namespace zUtils
 {
 namespace zCommand
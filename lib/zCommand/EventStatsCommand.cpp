@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <map>
+
+#include <zutils/zEvent.h>
+#include <zutils/zCommand.h>
+
+namespace zUtils
+{
+namespace zCommand
+{
+
+//**********************************************************************
+// Class: EventStatsCommand
+//**********************************************************************
+
+const std::string EventStatsCommand::Name("eventstats");
+const std::string EventStatsCommand::EnableOption("enable");
+const std::string EventStatsCommand::DisableOption("disable");
+const std::string EventStatsCommand::ResetOption("reset");
+
+EventStatsCommand::EventStatsCommand()
+{
+  this->SetName(EventStatsCommand::Name);
+}
+
+EventStatsCommand::~EventStatsCommand()
+{
+}
+
+bool
+EventStatsCommand::Execute(CommandData& data_)
+{
+  zEvent::Statistics& stats = zEvent::Statistics::Instance();
+  std::map<std::string, CommandOption> opts = data_.GetOptions();
+
+  if (opts.count(EventStatsCommand::EnableOption))
+  {
+    stats.Enable();
+  }
+  if (opts.count(EventStatsCommand::DisableOption))
+  {
+    stats.Disable();
+  }
+
+  // Always report what was collected before any reset
+  bool status = data_.SetOutput(stats.Dump());
+
+  if (opts.count(EventStatsCommand::ResetOption))
+  {
+    stats.Reset();
+  }
+
+  return (status);
+}
+
+}
+}
@@ -14,6 +14,15 @@
  * limitations under the License.
  */
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <string>
 #include <list>
 #include <mutex>
@@ -21,22 +30,48 @@
 #include <fstream>
 #include <sstream>
 
+#include <zutils/zCompatibility.h>
+#include <zutils/zLog.h>
 #include <zutils/zData.h>
+#include <zutils/zDataBinary.h>
 #include <zutils/zEvent.h>
 #include <zutils/zConfig.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_CONFIG);
+
 namespace zUtils
 {
 
 namespace zConfig
 {
 
+static bool
+_write(const int fd_, const char* buf_, size_t len_)
+{
+  while (len_)
+  {
+    ssize_t n = write(fd_, buf_, len_);
+    if (n < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return (false);
+    }
+    buf_ += n;
+    len_ -= n;
+  }
+  return (true);
+}
+
 //**********************************************************************
 // Class: ConfigurationFileConnector
 //**********************************************************************
 
-ConfigurationFileConnector::ConfigurationFileConnector(const std::string &filename_) :
-    _filename(filename_)
+ConfigurationFileConnector::ConfigurationFileConnector(const std::string &filename_,
+    const zData::Data::FORMAT format_) :
+    _filename(filename_), _format(format_)
 {
 }
 
@@ -49,18 +84,27 @@ ConfigurationFileConnector::Load(ConfigData &data_)
 {
   bool status = false;
   std::fstream fs;
-  std::stringstream json;
+  std::stringstream buf;
 
   // Open configuration file and read into local string
-  fs.open(this->_filename.c_str(), std::fstream::in);
+  fs.open(this->_filename.c_str(), std::fstream::in | std::fstream::binary);
   if (fs.is_open())
   {
     // Read file contents into buffer
-    json << fs.rdbuf();
+    buf << fs.rdbuf();
     fs.close();
 
-    // Store to callers configuration data object
-    status = data_.SetJson(json.str());
+    // Store to callers configuration data object; binary files are
+    //   recognized by their first byte so either format loads
+    std::string str = buf.str();
+    if (zData::BinaryReader::Detect(str.data(), str.size()))
+    {
+      status = data_.SetBinary(str);
+    }
+    else
+    {
+      status = data_.SetJson(str);
+    }
   }
 
   // Return status
@@ -75,13 +119,23 @@ ConfigurationFileConnector::Store(ConfigData &data_)
   std::fstream fs;
 
   // Open configuration file and write configuration data
-  fs.open(this->_filename.c_str(), std::fstream::out);
+  fs.open(this->_filename.c_str(), std::fstream::out | std::fstream::binary);
   if (fs.is_open())
   {
-    fs << data_.GetJsonPretty();
+    status = true;
+    if (this->_format == zData::Data::FORMAT_BINARY)
+    {
+      std::string bin = data_.GetBinary();
+      fs.write(bin.data(), bin.size());
+      status = !bin.empty();
+    }
+    else
+    {
+      fs << data_.GetJsonPretty();
+    }
     fs.flush();
+    status = (status && fs.good());
     fs.close();
-    status = true;
   }
 
   // Return status
@@ -89,5 +143,282 @@ ConfigurationFileConnector::Store(ConfigData &data_)
 
 }
 
+//**********************************************************************
+// Class: ConfigurationAtomicFileConnector
+//**********************************************************************
+
+ConfigurationAtomicFileConnector::ConfigurationAtomicFileConnector(const std::string &filename_,
+    const zData::Data::FORMAT format_) :
+    _filename(filename_), _format(format_)
+{
+}
+
+ConfigurationAtomicFileConnector::~ConfigurationAtomicFileConnector()
+{
+}
+
+bool
+ConfigurationAtomicFileConnector::Load(ConfigData &data_)
+{
+  bool status = false;
+  struct stat st = { 0 };
+
+  int fd = open(this->_filename.c_str(), (O_RDONLY | O_CLOEXEC));
+  if (fd < 0)
+  {
+    return (false);
+  }
+
+  if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+  {
+    size_t len = st.st_size;
+    void* map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED)
+    {
+      madvise(map, len, MADV_SEQUENTIAL);
+
+      // Parse straight out of the mapping; either format loads
+      if (zData::BinaryReader::Detect(map, len))
+      {
+        status = data_.SetBinary(map, len);
+      }
+      else
+      {
+        status = data_.SetJson((const char*) map, len);
+      }
+      munmap(map, len);
+    }
+    else
+    {
+      ZLOG_ERR("Cannot map configuration file: " + this->_filename);
+    }
+  }
+
+  close(fd);
+
+  // Return status
+  return (status);
+
+}
+
+bool
+ConfigurationAtomicFileConnector::Store(ConfigData &data_)
+{
+  static ATOMIC(unsigned int) seq(0);
+  bool status = false;
+  std::string buf;
+  struct stat st = { 0 };
+
+  // Serialize first so a failure leaves the file untouched
+  if (this->_format == zData::Data::FORMAT_BINARY)
+  {
+    buf = data_.GetBinary();
+  }
+  else
+  {
+    buf = data_.GetJsonPretty();
+  }
+  if (buf.empty())
+  {
+    return (false);
+  }
+
+  // The temporary file lives in the same directory so the rename is atomic
+  std::string tmp = this->_filename + ".tmp." + zLog::IntStr(getpid()) + "." + zLog::IntStr(seq++);
+  int fd = open(tmp.c_str(), (O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC), 0666);
+  if (fd < 0)
+  {
+    ZLOG_ERR("Cannot create temporary configuration file: " + tmp);
+    return (false);
+  }
+
+  // Replacing a file keeps its permissions
+  if (stat(this->_filename.c_str(), &st) == 0)
+  {
+    fchmod(fd, (st.st_mode & 07777));
+  }
+
+  status = _write(fd, buf.data(), buf.size()) && (fsync(fd) == 0);
+  status = ((close(fd) == 0) && status);
+  status = status && (rename(tmp.c_str(), this->_filename.c_str()) == 0);
+
+  if (!status)
+  {
+    ZLOG_ERR("Cannot write configuration file: " + this->_filename);
+    unlink(tmp.c_str());
+    return (false);
+  }
+
+  // Sync the directory so the rename itself survives a crash
+  size_t pos = this->_filename.rfind('/');
+  std::string dir = (pos == std::string::npos) ? "." : this->_filename.substr(0, (pos ? pos : 1));
+  int dfd = open(dir.c_str(), (O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+  if (dfd >= 0)
+  {
+    status = (fsync(dfd) == 0);
+    close(dfd);
+  }
+
+  // Return status
+  return (status);
+
+}
+
+//**********************************************************************
+// Class: ConfigurationReloadConnector
+//**********************************************************************
+
+ConfigurationReloadConnector::ConfigurationReloadConnector(Configuration& config_,
+    const std::string &filename_, const uint32_t debounce_ms_, const zData::Data::FORMAT format_) :
+    ConfigurationAtomicFileConnector(filename_, format_), _config(config_), _dir("."),
+        _name(filename_), _debounce(debounce_ms_), _inotify(-1), _reloads(0), _thread(this, NULL)
+{
+  size_t pos = filename_.rfind('/');
+  if (pos != std::string::npos)
+  {
+    this->_dir = filename_.substr(0, (pos ? pos : 1));
+    this->_name = filename_.substr(pos + 1);
+  }
+}
+
+ConfigurationReloadConnector::~ConfigurationReloadConnector()
+{
+  this->Stop();
+}
+
+bool
+ConfigurationReloadConnector::Start()
+{
+  bool status = false;
+
+  if (this->_inotify < 0)
+  {
+    this->_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (this->_inotify < 0)
+    {
+      ZLOG_ERR("Cannot initialize inotify");
+      return (false);
+    }
+
+    // Watch the directory; editors and atomic writers replace the file
+    if (inotify_add_watch(this->_inotify, this->_dir.c_str(), (IN_CLOSE_WRITE | IN_MOVED_TO)) < 0)
+    {
+      ZLOG_ERR("Cannot watch configuration directory: " + this->_dir);
+      close(this->_inotify);
+      this->_inotify = -1;
+      return (false);
+    }
+
+    status = this->_thread.Start();
+  }
+
+  // Return status
+  return (status);
+}
+
+bool
+ConfigurationReloadConnector::Stop()
+{
+  bool status = false;
+  if (this->_inotify >= 0)
+  {
+    this->_thread.Stop();
+    close(this->_inotify);
+    this->_inotify = -1;
+    status = true;
+  }
+  return (status);
+}
+
+uint64_t
+ConfigurationReloadConnector::Reloads() const
+{
+  return (this->_reloads);
+}
+
+void
+ConfigurationReloadConnector::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+  uint64_t deadline = 0;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_inotify, (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<struct pollfd> fds;
+    int timeout = -1;
+
+    if (deadline)
+    {
+      uint64_t now = MonotonicMsecs();
+      timeout = (deadline > now) ? int(deadline - now) : 0;
+    }
+
+    // Wait on file descriptor set
+    this->Poll(fds, timeout);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_inotify) && (fd.revents == POLLIN))
+      {
+        // Each write to the file pushes the reload back by the debounce window
+        char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+        ssize_t len = 0;
+        while ((len = read(this->_inotify, buf, sizeof(buf))) > 0)
+        {
+          for (char* p = buf; p < (buf + len);)
+          {
+            struct inotify_event* ev = (struct inotify_event*) p;
+            if (ev->len && (this->_name == ev->name))
+            {
+              deadline = (MonotonicMsecs() + this->_debounce);
+            }
+            p += (sizeof(struct inotify_event) + ev->len);
+          }
+        }
+      }
+    }
+
+    if (!exit && deadline && (MonotonicMsecs() >= deadline))
+    {
+      deadline = 0;
+      this->reload();
+    }
+
+  }
+
+  this->UnregisterFd(this->_inotify);
+
+  return;
+}
+
+void
+ConfigurationReloadConnector::reload()
+{
+  ConfigData data;
+  if (this->Load(data))
+  {
+    this->_config.Load(data);
+  }
+  else
+  {
+    ZLOG_WARN("Cannot reload configuration file: " + this->_dir + "/" + this->_name);
+  }
+  this->_reloads++;
+}
+
 }
 }
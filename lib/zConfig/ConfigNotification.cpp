@@ -36,6 +36,12 @@ ConfigNotification::ConfigNotification(Configuration& config_, const ConfigNotif
 {
 }
 
+ConfigNotification::ConfigNotification(Configuration& config_, const ConfigNotification::ID id_,
+    const std::vector<std::string>& paths_) :
+    zEvent::Notification(config_), _id(id_), _paths(paths_)
+{
+}
+
 ConfigNotification::~ConfigNotification()
 {
 }
@@ -46,5 +52,11 @@ ConfigNotification::Id()
   return (this->_id);
 }
 
+const std::vector<std::string>&
+ConfigNotification::ChangedPaths() const
+{
+  return (this->_paths);
+}
+
 }
 }
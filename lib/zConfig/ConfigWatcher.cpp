@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+#include <poll.h>
+
+#include <zutils/zLog.h>
+#include <zutils/zConfig.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_CONFIG);
+
+namespace zUtils
+{
+namespace zConfig
+{
+
+// Paths are split exactly as Data splits them. DataPath puts its root in front
+//   of every path alike, so prefixes and changed paths still line up.
+static std::vector<std::string>
+_split(const std::string& path_)
+{
+  return (zData::CompiledPath(zData::DataPath(path_)).Keys());
+}
+
+//**********************************************************************
+// Class: ConfigWatcher
+//**********************************************************************
+
+ConfigWatcher::ConfigWatcher(Configuration& config_) :
+    _config(config_), _notify_lock(zSem::Mutex::LOCKED), _lock(zSem::Mutex::LOCKED), _size(0),
+        _thread(this, NULL)
+{
+  this->_lock.Unlock();
+  this->_notify_lock.Unlock();
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+  this->_thread.Stop();
+}
+
+bool
+ConfigWatcher::Add(const ConfigPath& prefix_, zEvent::Observer* obs_, const uint32_t debounce_ms_)
+{
+  bool status = false;
+
+  if (!obs_)
+  {
+    return (false);
+  }
+
+  std::vector<std::string> keys = _split(prefix_.Path());
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    node* n = &this->_root;
+    FOREACH (auto& key, keys)
+    {
+      SHARED_PTR(node)& child = n->children[key];
+      if (!child)
+      {
+        child.reset(new node);
+      }
+      n = child.get();
+    }
+
+    // An observer watches a prefix at most once
+    status = true;
+    FOREACH (auto& w, n->watches)
+    {
+      if (w->obs == obs_)
+      {
+        status = false;
+        break;
+      }
+    }
+
+    if (status)
+    {
+      SHARED_PTR(watch) w(new watch);
+      w->obs = obs_;
+      w->debounce = debounce_ms_;
+      w->deadline = 0;
+      n->watches.push_back(w);
+      this->_size++;
+    }
+
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  // Return status
+  return (status);
+}
+
+bool
+ConfigWatcher::Remove(const ConfigPath& prefix_, zEvent::Observer* obs_)
+{
+  bool status = false;
+  std::vector<std::string> keys = _split(prefix_.Path());
+
+  // Waits for any delivery in progress so the observer is not called once this returns
+  this->_notify_lock.Lock();
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    std::vector<std::pair<node*, std::string> > spine;
+    node* n = &this->_root;
+    FOREACH (auto& key, keys)
+    {
+      auto it = n->children.find(key);
+      if (it == n->children.end())
+      {
+        n = NULL;
+        break;
+      }
+      spine.push_back(std::make_pair(n, key));
+      n = it->second.get();
+    }
+
+    if (n)
+    {
+      for (auto it = n->watches.begin(); it != n->watches.end(); ++it)
+      {
+        if ((*it)->obs == obs_)
+        {
+          (*it)->obs = NULL;
+          (*it)->pending.clear();
+          this->_armed.remove(*it);
+          n->watches.erase(it);
+          this->_size--;
+          status = true;
+          break;
+        }
+      }
+
+      // Prune the branches left without watchers
+      while (!spine.empty() && n->watches.empty() && n->children.empty())
+      {
+        n = spine.back().first;
+        n->children.erase(spine.back().second);
+        spine.pop_back();
+      }
+    }
+
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  this->_notify_lock.Unlock();
+
+  // Return status
+  return (status);
+}
+
+size_t
+ConfigWatcher::Size() const
+{
+  size_t size = 0;
+  if (this->_lock.Lock())
+  {
+    size = this->_size;
+    this->_lock.Unlock();
+  }
+  return (size);
+}
+
+void
+ConfigWatcher::Notify(const std::vector<std::string>& paths_)
+{
+  std::map<SHARED_PTR(watch), std::set<std::string> > matched;
+  std::vector<std::pair<SHARED_PTR(watch), std::set<std::string> > > now;
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return;
+  }
+
+  // Only the branches along each changed path are visited: watchers on the way
+  //   down are above the change and the whole subtree at its end is below it
+  FOREACH (auto& path, paths_)
+  {
+    node* n = &this->_root;
+    FOREACH (auto& w, n->watches)
+    {
+      matched[w].insert(path);
+    }
+    FOREACH (auto& key, _split(path))
+    {
+      auto it = n->children.find(key);
+      if (it == n->children.end())
+      {
+        n = NULL;
+        break;
+      }
+      n = it->second.get();
+      FOREACH (auto& w, n->watches)
+      {
+        matched[w].insert(path);
+      }
+    }
+    if (n)
+    {
+      FOREACH (auto& child, n->children)
+      {
+        this->collect(*child.second, path, matched);
+      }
+    }
+  }
+
+  // Debounced watchers accumulate paths until their window closes; the window
+  //   opens with the first commit after the last notification
+  bool wake = false;
+  FOREACH (auto& m, matched)
+  {
+    if (!m.first->debounce)
+    {
+      now.push_back(m);
+    }
+    else
+    {
+      if (m.first->pending.empty())
+      {
+        m.first->deadline = (MonotonicMsecs() + m.first->debounce);
+        this->_armed.push_back(m.first);
+        wake = true;
+      }
+      m.first->pending.insert(m.second.begin(), m.second.end());
+    }
+  }
+
+  if (wake)
+  {
+    this->_thread.Start();
+    this->_wake.Post();
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  FOREACH (auto& n, now)
+  {
+    this->deliver(n.first, n.second);
+  }
+
+  return;
+}
+
+void
+ConfigWatcher::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_wake.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<std::pair<SHARED_PTR(watch), std::set<std::string> > > due;
+    std::vector<struct pollfd> fds;
+    int timeout = -1;
+
+    // Sleep until the earliest window closes or a new one opens
+    if (this->_lock.Lock())
+    {
+      uint64_t now = MonotonicMsecs();
+      FOREACH (auto& w, this->_armed)
+      {
+        int remain = (w->deadline > now) ? int(w->deadline - now) : 0;
+        if ((timeout < 0) || (remain < timeout))
+        {
+          timeout = remain;
+        }
+      }
+      this->_lock.Unlock();
+    }
+
+    this->Poll(fds, timeout);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_wake.GetFd()) && (fd.revents == POLLIN))
+      {
+        this->_wake.TryWait();
+      }
+    }
+
+    if (!exit && this->_lock.Lock())
+    {
+      uint64_t now = MonotonicMsecs();
+      for (auto it = this->_armed.begin(); it != this->_armed.end();)
+      {
+        if ((*it)->deadline <= now)
+        {
+          due.push_back(std::make_pair(*it, std::set<std::string>()));
+          due.back().second.swap((*it)->pending);
+          it = this->_armed.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+      this->_lock.Unlock();
+    }
+
+    FOREACH (auto& d, due)
+    {
+      this->deliver(d.first, d.second);
+    }
+
+  }
+
+  this->UnregisterFd(this->_wake.GetFd());
+
+  return;
+}
+
+void
+ConfigWatcher::collect(const node& node_, const std::string& path_,
+    std::map<SHARED_PTR(watch), std::set<std::string> >& matched_)
+{
+  FOREACH (auto& w, node_.watches)
+  {
+    matched_[w].insert(path_);
+  }
+  FOREACH (auto& child, node_.children)
+  {
+    this->collect(*child.second, path_, matched_);
+  }
+  return;
+}
+
+void
+ConfigWatcher::deliver(const SHARED_PTR(watch)& watch_, const std::set<std::string>& paths_)
+{
+  this->_notify_lock.Lock();
+  // Removal clears the observer while holding the notify lock
+  if (watch_->obs)
+  {
+    std::vector<std::string> paths(paths_.begin(), paths_.end());
+    SHARED_PTR(zEvent::Notification) n(
+        new ConfigNotification(this->_config, ConfigNotification::ID_COMMIT, paths));
+    watch_->obs->ObserveEvent(n);
+  }
+  this->_notify_lock.Unlock();
+  return;
+}
+
+}
+}
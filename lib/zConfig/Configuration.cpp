@@ -36,44 +36,49 @@ namespace zConfig
 
 Configuration::Configuration() :
     zEvent::Event(zEvent::Event::TYPE_CONFIG), _lock(zSem::Mutex::LOCKED),
-        _modified(false), _connector(NULL)
-
+        _modified(false), _connector(NULL), _watcher(NULL)
 {
+  this->publish();
   this->_lock.Unlock();
 }
 
 Configuration::Configuration(ConfigData &data_) :
     zEvent::Event(zEvent::Event::TYPE_CONFIG), _lock(zSem::Mutex::LOCKED),
-        _modified(false), _connector(NULL), _staging(data_), _working(data_)
+        _modified(false), _connector(NULL), _staging(data_), _working(data_), _watcher(NULL)
 {
+  this->publish();
   this->_lock.Unlock();
 }
 
 Configuration::Configuration(const ConfigData &data_) :
     zEvent::Event(zEvent::Event::TYPE_CONFIG), _lock(zSem::Mutex::LOCKED),
-        _modified(false), _connector(NULL), _staging(data_), _working(data_)
+        _modified(false), _connector(NULL), _staging(data_), _working(data_), _watcher(NULL)
 {
+  this->publish();
   this->_lock.Unlock();
 }
 
 Configuration::Configuration(Configuration &other_) :
     zEvent::Event(zEvent::Event::TYPE_CONFIG), _lock(zSem::Mutex::LOCKED),
         _modified(other_._modified), _connector(NULL), _staging(other_._staging),
-        _working(other_._working)
+        _working(other_._working), _changes(other_._changes), _watcher(NULL)
 {
+  this->publish();
   this->_lock.Unlock();
 }
 
 Configuration::Configuration(const Configuration &other_) :
     zEvent::Event(zEvent::Event::TYPE_CONFIG), _lock(zSem::Mutex::LOCKED),
         _modified(other_._modified), _connector(NULL), _staging(other_._staging),
-        _working(other_._working)
+        _working(other_._working), _changes(other_._changes), _watcher(NULL)
 {
+  this->publish();
   this->_lock.Unlock();
 }
 
 Configuration::~Configuration()
 {
+  delete (this->_watcher);
 }
 
 bool
@@ -123,13 +128,52 @@ Configuration::Load()
 
   ZLOG_INFO("Loading configuration");
 
-  if (this->_connector)
+  if (this->_connector && this->_lock.Lock())
   {
     status = this->_connector->Load(this->_staging);
+    if (status)
+    {
+      this->restage();
+      this->_modified = true;
+    }
+    this->_lock.Unlock();
   }
   return (status);
 }
 
+bool
+Configuration::Load(const ConfigData& data_)
+{
+  bool status = false;
+  std::vector<std::string> changed;
+
+  ZLOG_INFO("Reloading configuration");
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    this->_staging = data_;
+    changed = this->restage();
+    this->_modified = true;
+    status = true;
+    this->_lock.Unlock();
+  }
+
+  // Unchanged trees are not announced
+  if (status && !changed.empty())
+  {
+    SHARED_PTR(zEvent::Notification) n(
+        new ConfigNotification(*this, ConfigNotification::ID_LOAD, changed));
+    this->notifyHandlers(n);
+    status = this->Commit();
+    n.reset(new ConfigNotification(*this, ConfigNotification::ID_POSTLOAD, changed));
+    this->notifyHandlers(n);
+  }
+
+  // Return status
+  return (status);
+}
+
 bool
 Configuration::Store()
 {
@@ -163,21 +207,57 @@ bool
 Configuration::Commit()
 {
   bool status = false;
+  std::vector<std::string> changed;
+  ConfigWatcher* watcher = NULL;
 
   ZLOG_INFO("Committing configuration");
 
-  // Begin critical section
+  // Observers are told what is about to change before the commit; they are
+  //   notified outside the lock so they may read or stage configuration
+  if (this->_lock.Lock())
+  {
+    changed = this->diff();
+    this->_lock.Unlock();
+  }
+  if (!changed.empty())
+  {
+    SHARED_PTR(zEvent::Notification) n(
+        new ConfigNotification(*this, ConfigNotification::ID_PRECOMMIT, changed));
+    this->notifyHandlers(n);
+  }
+
+  // Begin critical section; the diff is taken again and installed under one
+  //   hold of the lock so no write staged in between is lost. Only staged
+  //   paths can differ so only those are compared, and installing the staged
+  //   tree is a reference, not a copy.
   if (this->_lock.Lock())
   {
+    changed = this->diff();
     this->_working = this->_staging;
     if (this->_working == this->_staging)
     {
+      this->publish();
+      this->_changes.clear();
       this->_modified = false;
       status = true;
     }
+    watcher = this->_watcher;
     this->_lock.Unlock();
   }
 
+  if (status && !changed.empty())
+  {
+    SHARED_PTR(zEvent::Notification) n(
+        new ConfigNotification(*this, ConfigNotification::ID_POSTCOMMIT, changed));
+    this->notifyHandlers(n);
+  }
+
+  // Watchers only hear about the changed paths that intersect their prefix
+  if (status && watcher && !changed.empty())
+  {
+    watcher->Notify(changed);
+  }
+
   // Return status
   return (status);
 }
@@ -193,11 +273,9 @@ Configuration::Restore()
   if (this->_lock.Lock())
   {
     this->_staging = this->_working;
-    if (this->_working == this->_staging)
-    {
-      this->_modified = false;
-      status = true;
-    }
+    this->_changes.clear();
+    this->_modified = false;
+    status = true;
     this->_lock.Unlock();
   }
 
@@ -210,15 +288,9 @@ Configuration::Get(ConfigData& child_) const
 {
   bool status = false;
 
-  ZLOG_DEBUG(std::string("Getting configuration: ") + this->_working.Path());
+  ZLOG_DEBUG(std::string("Getting configuration: ") + this->_path.Path());
 
-  // Begin critical section
-  if (this->_lock.Lock())
-  {
-    status = this->_working.GetChild(child_);
-    // End critical section
-    this->_lock.Unlock();
-  }
+  status = this->GetSnapshot()->GetChild(this->_path, child_);
 
   // Return status
   return (status);
@@ -231,13 +303,7 @@ Configuration::Get(ConfigPath& src_, ConfigData& child_) const
 
   ZLOG_DEBUG(std::string("Getting configuration: ") + src_.Path());
 
-  // Begin critical section
-  if (this->_lock.Lock())
-  {
-    status = this->_working.GetChild(src_, child_);
-    // End critical section
-    this->_lock.Unlock();
-  }
+  status = this->GetSnapshot()->GetChild(src_, child_);
 
   // Return status
   return (status);
@@ -250,18 +316,18 @@ Configuration::Get(ConfigPath& src_, ConfigPath& dst_, ConfigData& child_) const
 
   ZLOG_DEBUG(std::string("Getting configuration: ") + src_.Path());
 
-  // Begin critical section
-  if (this->_lock.Lock())
-  {
-    status = this->_working.GetChild(src_, dst_, child_);
-    // End critical section
-    this->_lock.Unlock();
-  }
+  status = this->GetSnapshot()->GetChild(src_, dst_, child_);
 
   // Return status
   return (status);
 }
 
+SHARED_PTR(const zData::Snapshot)
+Configuration::GetSnapshot() const
+{
+  return (ATOMIC_LOAD(this->_snapshot));
+}
+
 bool
 Configuration::Put(const ConfigData& child_)
 {
@@ -274,6 +340,7 @@ Configuration::Put(const ConfigData& child_)
   {
     if (this->_staging.PutChild(child_))
     {
+      this->stage(this->_staging);
       this->_modified = true;
       status = true;
     }
@@ -298,6 +365,7 @@ Configuration::Put(const ConfigPath& dst_, const ConfigData& child_)
   {
     if (this->_staging.PutChild(dst_, child_))
     {
+      this->stage(dst_);
       this->_modified = true;
       status = true;
     }
@@ -322,6 +390,7 @@ Configuration::Put(const ConfigPath& dst_, const ConfigPath& src_, const ConfigD
   {
     if (this->_staging.PutChild(dst_, src_, child_))
     {
+      this->stage(dst_);
       this->_modified = true;
       status = true;
     }
@@ -346,6 +415,7 @@ Configuration::Add(const ConfigData& child_)
   {
     if (this->_staging.AddChild(child_))
     {
+      this->stage(this->_staging);
       this->_modified = true;
       status = true;
     }
@@ -370,6 +440,7 @@ Configuration::Add(const ConfigPath& dst_, const ConfigData& child_)
   {
     if (this->_staging.AddChild(dst_, child_))
     {
+      this->stage(dst_);
       this->_modified = true;
       status = true;
     }
@@ -394,6 +465,7 @@ Configuration::Add(const ConfigPath& dst_, const ConfigPath& src_, const ConfigD
   {
     if (this->_staging.AddChild(dst_, src_, child_))
     {
+      this->stage(dst_);
       this->_modified = true;
       status = true;
     }
@@ -406,6 +478,51 @@ Configuration::Add(const ConfigPath& dst_, const ConfigPath& src_, const ConfigD
 
 }
 
+bool
+Configuration::Watch(const ConfigPath& prefix_, zEvent::Observer* obs_, const uint32_t debounce_ms_)
+{
+  bool status = false;
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    if (!this->_watcher)
+    {
+      this->_watcher = new ConfigWatcher(*this);
+    }
+    status = this->_watcher->Add(prefix_, obs_, debounce_ms_);
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  // Return status
+  return (status);
+}
+
+bool
+Configuration::Unwatch(const ConfigPath& prefix_, zEvent::Observer* obs_)
+{
+  bool status = false;
+  ConfigWatcher* watcher = NULL;
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    watcher = this->_watcher;
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  // Removal waits for deliveries in progress, which may be reading the configuration
+  if (watcher)
+  {
+    status = watcher->Remove(prefix_, obs_);
+  }
+
+  // Return status
+  return (status);
+}
+
 void
 Configuration::Display(const std::string& prefix_) const
 {
@@ -417,5 +534,58 @@ Configuration::Display(const std::string& prefix_) const
   this->_working.DisplayJson();
 }
 
+void
+Configuration::publish()
+{
+  // Caller holds the lock; readers still holding the previous snapshot keep it
+  ATOMIC_STORE(this->_snapshot, SHARED_PTR(const zData::Snapshot)(new zData::Snapshot(this->_working)));
+}
+
+void
+Configuration::stage(const zData::DataPath& path_)
+{
+  // Caller holds the lock
+  this->_changes.insert(std::make_pair(path_.Path(), path_));
+}
+
+std::vector<std::string>
+Configuration::restage()
+{
+  // Caller holds the lock. The whole staging tree was replaced; stage only
+  //   the subtrees that differ from the working tree.
+  std::vector<std::string> changed = this->_working.Diff(ConfigPath(), this->_staging);
+  this->_changes.clear();
+  FOREACH (auto& path, changed)
+  {
+    // Diff paths are full paths; the data path constructor adds the root
+    this->stage(zData::DataPath(path.substr(zData::DataPath::DataRoot.size() + 1)));
+  }
+  return (changed);
+}
+
+std::vector<std::string>
+Configuration::diff() const
+{
+  // Caller holds the lock. Paths come out sorted; a path below another
+  //   staged path is covered by its parent and not compared on its own.
+  std::vector<std::string> changed;
+  FOREACH (auto& change, this->_changes)
+  {
+    const std::string& path = change.first;
+    bool covered = false;
+    size_t dot = path.rfind('.');
+    while (!covered && (dot != std::string::npos) && (dot > 0))
+    {
+      covered = (this->_changes.count(path.substr(0, dot)) != 0);
+      dot = path.rfind('.', (dot - 1));
+    }
+    if (!covered && !this->_working.Compare(change.second, this->_staging))
+    {
+      changed.push_back(path);
+    }
+  }
+  return (changed);
+}
+
 }
 }
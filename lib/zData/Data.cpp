@@ -14,8 +14,13 @@
  * limitations under the License.
  */
 
+#include <functional>
+
 #include <zutils/zLog.h>
 #include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
+#include <zutils/zDataJson.h>
+#include <zutils/zDataBinary.h>
 
 ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_DATA);
 
@@ -68,68 +73,137 @@ ptJson(pt::ptree pt_)
   return(json.str());
 }
 
+static std::string
+docJson(const Document& doc_)
+{
+  std::string json;
+  JsonWriter::Write(doc_, json);
+  return (json);
+}
+
+static bool
+docObject(const Document& doc_)
+{
+  // A document converted from an empty tree has no object at its root yet
+  return (doc_.GetType(doc_.Root()) == Document::TYPE_OBJECT);
+}
+
 static void
 ptDisplay(pt::ptree pt_)
 {
   std::cout << ptJson(pt_) << std::endl;
 }
 
+static bool
+ptObject(const pt::ptree& pt_)
+{
+  // An object has only uniquely named children; anything else is compared whole
+  if (pt_.empty() || !pt_.data().empty())
+  {
+    return (false);
+  }
+  FOREACH (auto& child, pt_)
+  {
+    if (child.first.empty() || (pt_.count(child.first) != 1))
+    {
+      return (false);
+    }
+  }
+  return (true);
+}
+
+static void
+ptDiff(const pt::ptree* a_, const pt::ptree* b_, const std::string& path_,
+    std::vector<std::string>& paths_)
+{
+  if ((!a_ && !b_) || (a_ && b_ && (*a_ == *b_)))
+  {
+    return;
+  }
+  if (!a_ || !b_ || !ptObject(*a_) || !ptObject(*b_))
+  {
+    paths_.push_back(path_);
+    return;
+  }
+  FOREACH (auto& child, *a_)
+  {
+    pt::ptree::const_assoc_iterator it = b_->find(child.first);
+    ptDiff(&child.second, ((it == b_->not_found()) ? NULL : &it->second),
+        (path_ + "." + child.first), paths_);
+  }
+  FOREACH (auto& child, *b_)
+  {
+    if (a_->find(child.first) == a_->not_found())
+    {
+      paths_.push_back(path_ + "." + child.first);
+    }
+  }
+}
+
+static ATOMIC(uint64_t) _generations(0);
+
 //**********************************************************************
 // Class: zData::Data
 //**********************************************************************
 
 Data::Data(const std::string& path_) :
-    DataPath(path_)
+    DataPath(path_), _pt(new pt::ptree), _generation(0)
 {
   this->put(this->Path(), std::string(""));
   this->_lock.Unlock();
 }
 
 Data::Data(const zData::DataPath& path_) :
-    DataPath(path_)
+    DataPath(path_), _pt(new pt::ptree), _generation(0)
 {
   this->put(this->Path(), std::string(""));
   this->_lock.Unlock();
 }
 
 Data::Data(const pt::ptree& pt_) :
-    _pt(pt_)
+    _pt(new pt::ptree(pt_)), _generation(0)
 {
+  this->touch();
   this->_lock.Unlock();
 }
 
-Data::Data(Data &other_)
+Data::Data(Data &other_) :
+    _generation(0)
 {
   other_._lock.Lock();
   DataPath::operator =(other_.GetDataPath());
   this->_pt = other_._pt;
+  this->_doc = other_._doc;
+  this->touch();
   other_._lock.Unlock();
   this->_lock.Unlock();
 }
 
-Data::Data(const Data &other_)
+Data::Data(const Data &other_) :
+    _generation(0)
 {
   other_._lock.Lock();
   DataPath::operator =(other_.GetDataPath());
   this->_pt = other_._pt;
+  this->_doc = other_._doc;
+  this->touch();
   other_._lock.Unlock();
   this->_lock.Unlock();
 }
 
 Data::~Data()
 {
-  this->_pt.clear();
 }
 
 Data &
 Data::operator=(const Data &other_)
 {
-  other_._lock.Lock();
-  this->_lock.Lock();
+  this->lock(other_);
   DataPath::operator=(other_);
   this->_pt = other_._pt;
-  this->_lock.Unlock();
-  other_._lock.Unlock();
+  this->_doc = other_._doc;
+  this->touch();
+  this->unlock(other_);
   return (*this);
 }
 
@@ -146,12 +220,10 @@ bool
 Data::operator ==(const Data &other_) const
 {
   bool status = true;
-  other_._lock.Lock();
-  this->_lock.Lock();
+  this->lock(other_);
   status &= (this->Path() == other_.Path());
-  status &= (this->_pt == other_._pt);
-  this->_lock.Unlock();
-  other_._lock.Unlock();
+  status &= this->same(other_);
+  this->unlock(other_);
   return (status);
 }
 
@@ -159,12 +231,10 @@ bool
 Data::operator !=(const Data &other_) const
 {
   bool status = true;
-  other_._lock.Lock();
-  this->_lock.Lock();
+  this->lock(other_);
   status &= (this->Path() == other_.Path());
-  status &= (this->_pt == other_._pt);
-  this->_lock.Unlock();
-  other_._lock.Unlock();
+  status &= this->same(other_);
+  this->unlock(other_);
   return (!status);
 }
 
@@ -172,11 +242,19 @@ Data
 Data::operator ()(const std::string& path_) const
 {
   Data d(path_);
-  try
+  d.SetStore(this->GetStore());
+  pt::ptree scratch;
+  const pt::ptree* pt = NULL;
+  if (this->_lock.Lock())
   {
-    d.put(d.Path(), this->_pt.get_child(this->Path(path_)));
+    pt = this->child(this->Path(path_), scratch);
+    if (pt)
+    {
+      d.put(d.Path(), *pt);
+    }
+    this->_lock.Unlock();
   }
-  catch (pt::ptree_bad_path &e)
+  if (!pt)
   {
     ZLOG_WARN("Child does not exist: " + this->Path());
     ZLOG_INFO(this->GetJson());
@@ -190,13 +268,16 @@ Data::operator [](int pos_) const
   int i = 0;
 
   Data d(this->Key());
+  d.SetStore(this->GetStore());
 
   // Begin critical section
   if (this->_lock.Lock())
   {
-    try
+    pt::ptree scratch;
+    const pt::ptree* pt = this->child(this->Path(), scratch);
+    if (pt)
     {
-      FOREACH (auto& child, this->_pt.get_child(this->Path()))
+      FOREACH (auto& child, *pt)
       {
         if (i++ == pos_)
         {
@@ -205,7 +286,7 @@ Data::operator [](int pos_) const
         }
       }
     }
-    catch (pt::ptree_bad_path &e)
+    else
     {
       ZLOG_WARN("Child does not exist: " + this->Path());
     }
@@ -220,7 +301,14 @@ bool
 Data::Empty() const
 {
   bool status = false;
-  status = this->_pt.empty();
+  if (this->_doc)
+  {
+    status = (this->_doc->Size(this->_doc->Root()) == 0);
+  }
+  else
+  {
+    status = this->_pt->empty();
+  }
   return(status);
 }
 
@@ -229,13 +317,19 @@ Data::Size() const
 {
   ssize_t size = 0;
 
+  if (this->_doc)
+  {
+    Document::Node node = this->_doc->Find(Data::keys(this->Path()));
+    return ((node == Document::NoNode) ? -1 : ssize_t(this->_doc->Size(node)));
+  }
+
   try
   {
-    FOREACH (auto& item, this->_pt.get_child(this->Path()))
+    FOREACH (auto& item, this->_pt->get_child(this->Path()))
     {
       size++;
     }
-//    size = this->_pt.count(this->Path());
+//    size = this->_pt->count(this->Path());
   }
   catch (pt::ptree_bad_path &e)
   {
@@ -244,6 +338,60 @@ Data::Size() const
   return (size);
 }
 
+Data::STORE
+Data::GetStore() const
+{
+  return (this->_doc ? Data::STORE_DOCUMENT : Data::STORE_PTREE);
+}
+
+bool
+Data::SetStore(const Data::STORE store_)
+{
+  bool status = false;
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    switch (store_)
+    {
+    case Data::STORE_PTREE:
+      status = true;
+      if (this->_doc)
+      {
+        SHARED_PTR(pt::ptree) pt(new pt::ptree);
+        status = this->_doc->ToPtree(*pt);
+        if (status)
+        {
+          this->_pt = pt;
+          this->_doc.reset();
+          this->touch();
+        }
+      }
+      break;
+    case Data::STORE_DOCUMENT:
+      status = true;
+      if (!this->_doc)
+      {
+        SHARED_PTR(Document) doc(new Document);
+        status = doc->FromPtree(*this->_pt);
+        if (status)
+        {
+          this->_doc = doc;
+          this->_pt.reset();
+          this->touch();
+        }
+      }
+      break;
+    default:
+      break;
+    }
+    this->_lock.Unlock();
+  }
+
+  // Return status
+  return (status);
+}
+
 void
 Data::Clear()
 {
@@ -510,51 +658,134 @@ Data::Del(const DataPath& path_)
 
 }
 
+bool
+Data::Compare(const DataPath& path_, const Data& other_) const
+{
+  bool status = false;
+  this->lock(other_);
+  if ((this->_pt == other_._pt) && (this->_doc == other_._doc))
+  {
+    status = true;
+  }
+  else
+  {
+    pt::ptree a, b;
+    const pt::ptree* mine = this->child(path_.Path(), a);
+    const pt::ptree* theirs = other_.child(path_.Path(), b);
+    status = (mine && theirs) ? (*mine == *theirs) : (!mine && !theirs);
+  }
+  this->unlock(other_);
+  return (status);
+}
+
+std::vector<std::string>
+Data::Diff(const DataPath& path_, const Data& other_) const
+{
+  std::vector<std::string> paths;
+  this->lock(other_);
+  if ((this->_pt != other_._pt) || (this->_doc != other_._doc))
+  {
+    pt::ptree a, b;
+    const pt::ptree* mine = this->child(path_.Path(), a);
+    const pt::ptree* theirs = other_.child(path_.Path(), b);
+    ptDiff(mine, theirs, path_.Path(), paths);
+  }
+  this->unlock(other_);
+  return (paths);
+}
+
 std::string
 Data::GetJson() const
 {
-  std::stringstream json;
-  pt::write_json(json, this->_pt, false);
-  return (json.str());
+  std::string json;
+  if (this->_lock.Lock())
+  {
+    if (this->_doc && docObject(*this->_doc))
+    {
+      // Documents are written with their types
+      JsonWriter::Write(*this->_doc, json, false);
+      this->_lock.Unlock();
+      return (json);
+    }
+    pt::ptree scratch;
+    const pt::ptree& pt = *this->child(std::string(""), scratch);
+    if (!JsonWriter::Write(pt, json, false))
+    {
+      // Not representable; let the property tree writer report why. It
+      //   throws, so it works on a copy taken under the lock.
+      pt::ptree copy(pt);
+      this->_lock.Unlock();
+      std::stringstream ss;
+      pt::write_json(ss, copy, false);
+      return (ss.str());
+    }
+    this->_lock.Unlock();
+  }
+  return (json);
 }
 
 std::string
 Data::GetJsonPretty() const
 {
-  std::stringstream json;
-  pt::write_json(json, this->_pt, true);
-  return (json.str());
+  std::string json;
+  if (this->_lock.Lock())
+  {
+    if (this->_doc && docObject(*this->_doc))
+    {
+      JsonWriter::Write(*this->_doc, json, true);
+      this->_lock.Unlock();
+      return (json);
+    }
+    pt::ptree scratch;
+    const pt::ptree& pt = *this->child(std::string(""), scratch);
+    if (!JsonWriter::Write(pt, json, true))
+    {
+      pt::ptree copy(pt);
+      this->_lock.Unlock();
+      std::stringstream ss;
+      pt::write_json(ss, copy, true);
+      return (ss.str());
+    }
+    this->_lock.Unlock();
+  }
+  return (json);
 }
 
 bool
 Data::SetJson(const std::string &json_)
 {
-  bool status = false;
-  try
+  return (this->SetJson(json_.data(), json_.size()));
+}
+
+bool
+Data::SetJson(const char* json_, const size_t len_)
+{
+  JsonReader reader;
+
+  // A document store parses straight into a document so values keep their types
+  if (this->GetStore() == Data::STORE_DOCUMENT)
   {
-    std::stringstream json(json_);
-    pt::ptree pt;
-    // Convert json into property tree
-    pt::read_json(json, pt);
-    // Begin critical section
-    if (this->_lock.Lock())
+    Document doc;
+    DocumentJsonHandler handler(doc);
+    if (!reader.Parse(json_, len_, handler))
     {
-      // Copy only the root node
-      status = this->put(DataPath::DataRoot, pt.get_child(DataPath::DataRoot));
-      this->_lock.Unlock();
+      ZLOG_WARN(std::string("Parser error: ") + reader.ErrorMessage() + " at offset " +
+          ZLOG_INT(int(reader.ErrorOffset())));
+      return (false);
     }
+    return (this->set(doc));
   }
-  catch (pt::json_parser_error const &e)
-  {
-    ZLOG_WARN(std::string("Parser error: ") + e.what());
-    status = false;
-  }
-  catch (pt::ptree_bad_path const &e)
+
+  // Convert json into property tree
+  pt::ptree pt;
+  PtreeJsonHandler handler(pt);
+  if (!reader.Parse(json_, len_, handler))
   {
-    ZLOG_WARN(std::string("Path error: ") + e.what());
-    status = false;
+    ZLOG_WARN(std::string("Parser error: ") + reader.ErrorMessage() + " at offset " +
+        ZLOG_INT(int(reader.ErrorOffset())));
+    return (false);
   }
-  return (status);
+  return (this->set(pt));
 }
 
 void
@@ -563,11 +794,74 @@ Data::DisplayJson() const
   std::cout << std::endl << this->GetJsonPretty() << std::endl;
 }
 
+std::string
+Data::GetBinary() const
+{
+  std::string bin;
+  if (this->_lock.Lock())
+  {
+    pt::ptree scratch;
+    if (this->_doc && docObject(*this->_doc))
+    {
+      BinaryWriter::Write(*this->_doc, bin);
+    }
+    else if (!BinaryWriter::Write(*this->child(std::string(""), scratch), bin))
+    {
+      ZLOG_WARN("Data is not representable in binary form");
+      bin.clear();
+    }
+    this->_lock.Unlock();
+  }
+  return (bin);
+}
+
+bool
+Data::SetBinary(const std::string& bin_)
+{
+  return (this->SetBinary(bin_.data(), bin_.size()));
+}
+
+bool
+Data::SetBinary(const void* bin_, const size_t len_)
+{
+  BinaryReader reader;
+
+  // Same as SetJson()
+  if (this->GetStore() == Data::STORE_DOCUMENT)
+  {
+    Document doc;
+    DocumentJsonHandler handler(doc);
+    if (!reader.Parse(bin_, len_, handler))
+    {
+      ZLOG_WARN(std::string("Parser error: ") + reader.ErrorMessage() + " at offset " +
+          ZLOG_INT(int(reader.ErrorOffset())));
+      return (false);
+    }
+    return (this->set(doc));
+  }
+
+  // Convert binary into property tree
+  pt::ptree pt;
+  PtreeJsonHandler handler(pt);
+  if (!reader.Parse(bin_, len_, handler))
+  {
+    ZLOG_WARN(std::string("Parser error: ") + reader.ErrorMessage() + " at offset " +
+        ZLOG_INT(int(reader.ErrorOffset())));
+    return (false);
+  }
+  return (this->set(pt));
+}
+
 std::string
 Data::GetXml() const
 {
   std::stringstream xml;
-  pt::write_xml(xml, this->_pt);
+  if (this->_lock.Lock())
+  {
+    pt::ptree scratch;
+    pt::write_xml(xml, *this->child(std::string(""), scratch));
+    this->_lock.Unlock();
+  }
   return (xml.str());
 }
 
@@ -617,13 +911,25 @@ Data::get(const std::string &path_, pt::ptree &pt_) const
     ZLOG_DEBUG("getting pt: " + path_);
     try
     {
-      pt_ = this->_pt.get_child(path_);
-      status = true;
+      if (this->_doc)
+      {
+        Document::Node node = this->_doc->Find(Data::keys(path_));
+        if (node == Document::NoNode)
+        {
+          throw pt::ptree_bad_path("No such node", pt::ptree::path_type(path_));
+        }
+        status = this->_doc->ToPtree(node, pt_);
+      }
+      else
+      {
+        pt_ = this->_pt->get_child(path_);
+        status = true;
+      }
     }
     catch (pt::ptree_bad_path const &e)
     {
       ZLOG_WARN(std::string("Path error: ") + e.what());
-      ZLOG_DEBUG(ptJson(this->_pt));
+      ZLOG_DEBUG(this->_doc ? docJson(*this->_doc) : ptJson(*this->_pt));
       status = false;
     }
   }
@@ -641,8 +947,18 @@ Data::put(const std::string &path_, const pt::ptree &pt_)
     ZLOG_DEBUG("putting pt: " + path_);
     try
     {
-      this->_pt.put_child(path_, pt_);
-      status = true;
+      if (this->_doc)
+      {
+        Document& doc = this->doc();
+        status = doc.FromPtree(doc.Create(Data::keys(path_)), pt_);
+        doc.collect();
+      }
+      else
+      {
+        this->tree().put_child(path_, pt_);
+        status = true;
+      }
+      this->touch();
     }
     catch (pt::ptree_bad_path const &e)
     {
@@ -655,6 +971,74 @@ Data::put(const std::string &path_, const pt::ptree &pt_)
   return (status);
 }
 
+bool
+Data::put(const std::string& path_, const Document& doc_)
+{
+  bool status = false;
+
+  Document::Node node = doc_.Find(Data::keys(path_));
+  if (!path_.empty() && (node != Document::NoNode))
+  {
+    ZLOG_DEBUG("putting doc: " + path_);
+    if (this->_doc)
+    {
+      Document& doc = this->doc();
+      status = doc.Copy(doc.Create(Data::keys(path_)), doc_, node);
+      doc.collect();
+      this->touch();
+    }
+    else
+    {
+      pt::ptree pt;
+      status = (doc_.ToPtree(node, pt) && this->put(path_, pt));
+    }
+  }
+
+  return (status);
+}
+
+bool
+Data::set(const pt::ptree& pt_)
+{
+  bool status = false;
+
+  pt::ptree::const_assoc_iterator root = pt_.find(DataPath::DataRoot);
+  if (root == pt_.not_found())
+  {
+    ZLOG_WARN(std::string("Path error: No such node (") + DataPath::DataRoot + ")");
+    return (false);
+  }
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    // Copy only the root node
+    status = this->put(DataPath::DataRoot, root->second);
+    this->_lock.Unlock();
+  }
+  return (status);
+}
+
+bool
+Data::set(const Document& doc_)
+{
+  bool status = false;
+
+  if (doc_.Find(doc_.Root(), DataPath::DataRoot) == Document::NoNode)
+  {
+    ZLOG_WARN(std::string("Path error: No such node (") + DataPath::DataRoot + ")");
+    return (false);
+  }
+
+  // Begin critical section; the store may have changed since parsing
+  if (this->_lock.Lock())
+  {
+    status = this->put(DataPath::DataRoot, doc_);
+    this->_lock.Unlock();
+  }
+  return (status);
+}
+
 bool
 Data::add(const std::string &path_, const pt::ptree &pt_)
 {
@@ -691,6 +1075,340 @@ Data::del(const std::string &path_)
   return (status);
 }
 
+void
+Data::lock(const Data& other_) const
+{
+  // Two objects are always locked in address order so that a.Diff(b) and
+  //   b.Diff(a) running together cannot deadlock
+  const Data* first = std::less<const Data*>()(this, &other_) ? this : &other_;
+  const Data* second = (first == this) ? &other_ : this;
+  first->_lock.Lock();
+  if (second != first)
+  {
+    second->_lock.Lock();
+  }
+}
+
+void
+Data::unlock(const Data& other_) const
+{
+  if (&other_ != this)
+  {
+    other_._lock.Unlock();
+  }
+  this->_lock.Unlock();
+}
+
+void
+Data::touch()
+{
+  this->_generation = ++_generations;
+}
+
+pt::ptree&
+Data::tree()
+{
+  // Clone a shared tree before it is modified; the clone has new node
+  //   addresses so the generation moves on with it. Callers hold the lock,
+  //   so no copy of this object can take a new reference meanwhile.
+  if (this->_pt.use_count() > 1)
+  {
+    this->_pt = SHARED_PTR(pt::ptree)(new pt::ptree(*this->_pt));
+    this->touch();
+  }
+  return (*this->_pt);
+}
+
+Document&
+Data::doc()
+{
+  // Copy on write as for the property tree (see tree())
+  if (this->_doc.use_count() > 1)
+  {
+    this->_doc = SHARED_PTR(Document)(new Document(*this->_doc));
+  }
+  return (*this->_doc);
+}
+
+const pt::ptree*
+Data::child(const std::string& path_, pt::ptree& scratch_) const
+{
+  const pt::ptree* pt = NULL;
+  if (this->_doc)
+  {
+    Document::Node node = this->_doc->Find(Data::keys(path_));
+    if ((node != Document::NoNode) && this->_doc->ToPtree(node, scratch_))
+    {
+      pt = &scratch_;
+    }
+  }
+  else
+  {
+    const pt::ptree& root = *this->_pt;
+    boost::optional<const pt::ptree&> child = root.get_child_optional(path_);
+    if (child)
+    {
+      pt = &*child;
+    }
+  }
+  return (pt);
+}
+
+std::vector<std::string>
+Data::keys(const std::string& path_)
+{
+  std::vector<std::string> keys;
+  size_t start = 0;
+  while (start < path_.size())
+  {
+    size_t end = path_.find('.', start);
+    if (end == std::string::npos)
+    {
+      end = path_.size();
+    }
+    keys.push_back(path_.substr(start, (end - start)));
+    start = (end + 1);
+  }
+  return (keys);
+}
+
+bool
+Data::same(const Data& other_) const
+{
+  pt::ptree a, b;
+  if ((this->_pt == other_._pt) && (this->_doc == other_._doc))
+  {
+    return (true);
+  }
+  return (*this->child(std::string(""), a) == *other_.child(std::string(""), b));
+}
+
+bool
+Data::dget(const std::vector<std::string>& keys_, bool& value_) const
+{
+  return (this->_doc->GetValue(this->_doc->Find(keys_), value_));
+}
+
+bool
+Data::dget(const std::vector<std::string>& keys_, int& value_) const
+{
+  return (this->_doc->GetValue(this->_doc->Find(keys_), value_));
+}
+
+bool
+Data::dget(const std::vector<std::string>& keys_, unsigned int& value_) const
+{
+  return (this->_doc->GetValue(this->_doc->Find(keys_), value_));
+}
+
+bool
+Data::dget(const std::vector<std::string>& keys_, long& value_) const
+{
+  return (this->_doc->GetValue(this->_doc->Find(keys_), value_));
+}
+
+bool
+Data::dget(const std::vector<std::string>& keys_, unsigned long& value_) const
+{
+  return (this->_doc->GetValue(this->_doc->Find(keys_), value_));
+}
+
+bool
+Data::dget(const std::vector<std::string>& keys_, double& value_) const
+{
+  return (this->_doc->GetValue(this->_doc->Find(keys_), value_));
+}
+
+bool
+Data::dget(const std::vector<std::string>& keys_, std::string& value_) const
+{
+  return (this->_doc->GetValue(this->_doc->Find(keys_), value_));
+}
+
+template<typename T>
+  bool
+  Data::dset(const std::vector<std::string>& keys_, const T& value_)
+  {
+    Document& doc = this->doc();
+    Document::Node node = doc.Create(keys_);
+    bool status = ((node != Document::NoNode) && (doc.SetValue(doc.value(node), value_) != Document::NoNode));
+    doc.collect();
+    return (status);
+  }
+
+bool
+Data::dput(const std::vector<std::string>& keys_, const bool& value_)
+{
+  return (this->dset(keys_, Document::cast(value_)));
+}
+
+bool
+Data::dput(const std::vector<std::string>& keys_, const int& value_)
+{
+  return (this->dset(keys_, Document::cast(value_)));
+}
+
+bool
+Data::dput(const std::vector<std::string>& keys_, const unsigned int& value_)
+{
+  return (this->dset(keys_, Document::cast(value_)));
+}
+
+bool
+Data::dput(const std::vector<std::string>& keys_, const long& value_)
+{
+  return (this->dset(keys_, Document::cast(value_)));
+}
+
+bool
+Data::dput(const std::vector<std::string>& keys_, const unsigned long& value_)
+{
+  return (this->dset(keys_, Document::cast(value_)));
+}
+
+bool
+Data::dput(const std::vector<std::string>& keys_, const double& value_)
+{
+  return (this->dset(keys_, Document::cast(value_)));
+}
+
+bool
+Data::dput(const std::vector<std::string>& keys_, const std::string& value_)
+{
+  return (this->dset(keys_, value_));
+}
+
+pt::ptree*
+Data::resolve(const CompiledPath& path_) const
+{
+  pt::ptree* node = path_.cached(this->_generation);
+  if (!node)
+  {
+    node = this->_pt.get();
+    FOREACH (auto& key, path_._keys)
+    {
+      pt::ptree::assoc_iterator it = node->find(key);
+      if (it == node->not_found())
+      {
+        return (NULL);
+      }
+      node = &it->second;
+    }
+    path_.cache(this->_generation, node);
+  }
+  return (node);
+}
+
+pt::ptree*
+Data::create(const CompiledPath& path_)
+{
+  // Missing children are appended, which never frees or moves existing
+  //   nodes, so the tree generation is left as is
+  pt::ptree& root = this->tree();
+  pt::ptree* node = path_.cached(this->_generation);
+  if (!node)
+  {
+    node = &root;
+    FOREACH (auto& key, path_._keys)
+    {
+      pt::ptree::assoc_iterator it = node->find(key);
+      if (it == node->not_found())
+      {
+        node = &node->push_back(std::make_pair(key, pt::ptree()))->second;
+      }
+      else
+      {
+        node = &it->second;
+      }
+    }
+    path_.cache(this->_generation, node);
+  }
+  return (node);
+}
+
+//**********************************************************************
+// Class: zData::Snapshot
+//**********************************************************************
+
+Snapshot::Snapshot()
+{
+}
+
+Snapshot::Snapshot(const Data& data_)
+{
+  data_._lock.Lock();
+  if (data_._doc)
+  {
+    // A document is converted, leaving nothing for the Data to copy
+    pt::ptree* pt = new pt::ptree;
+    data_._doc->ToPtree(*pt);
+    this->_pt = SHARED_PTR(const pt::ptree)(pt);
+  }
+  else
+  {
+    this->_pt = data_._pt;
+  }
+  data_._lock.Unlock();
+}
+
+Snapshot::~Snapshot()
+{
+}
+
+bool
+Snapshot::Empty() const
+{
+  return (!this->_pt || this->_pt->empty());
+}
+
+bool
+Snapshot::GetChild(const DataPath& src_, Data& child_) const
+{
+  bool status = false;
+  boost::optional<const pt::ptree&> pt;
+  if (this->_pt)
+  {
+    pt = this->_pt->get_child_optional(src_.Path());
+  }
+  if (pt && child_._lock.Lock())
+  {
+    child_.Clear();
+    status = child_.put(child_.Root(), *pt);
+    child_._lock.Unlock();
+  }
+  return (status);
+}
+
+bool
+Snapshot::GetChild(const DataPath& src_, const DataPath& dst_, Data& child_) const
+{
+  bool status = false;
+  boost::optional<const pt::ptree&> pt;
+  if (this->_pt)
+  {
+    pt = this->_pt->get_child_optional(src_.Path());
+  }
+  if (pt && child_._lock.Lock())
+  {
+    child_.Clear();
+    status = child_.put(dst_.Path(), *pt);
+    child_._lock.Unlock();
+  }
+  return (status);
 }
+
+std::string
+Snapshot::GetJson() const
+{
+  std::string json;
+  if (this->_pt && !JsonWriter::Write(*this->_pt, json, false))
+  {
+    std::stringstream ss;
+    pt::write_json(ss, *this->_pt, false);
+    json = ss.str();
+  }
+  return (json);
 }
 
+}
+}
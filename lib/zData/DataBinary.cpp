@@ -0,0 +1,970 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+#include <zutils/zLog.h>
+#include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
+#include <zutils/zDataJson.h>
+#include <zutils/zDataBinary.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_DATA);
+
+namespace zUtils
+{
+namespace zData
+{
+
+// MessagePack type markers
+static const uint8_t MP_NIL = 0xc0;
+static const uint8_t MP_FALSE = 0xc2;
+static const uint8_t MP_TRUE = 0xc3;
+static const uint8_t MP_BIN8 = 0xc4;
+static const uint8_t MP_BIN16 = 0xc5;
+static const uint8_t MP_BIN32 = 0xc6;
+static const uint8_t MP_FLOAT32 = 0xca;
+static const uint8_t MP_FLOAT64 = 0xcb;
+static const uint8_t MP_UINT8 = 0xcc;
+static const uint8_t MP_UINT16 = 0xcd;
+static const uint8_t MP_UINT32 = 0xce;
+static const uint8_t MP_UINT64 = 0xcf;
+static const uint8_t MP_INT8 = 0xd0;
+static const uint8_t MP_INT16 = 0xd1;
+static const uint8_t MP_INT32 = 0xd2;
+static const uint8_t MP_INT64 = 0xd3;
+static const uint8_t MP_STR8 = 0xd9;
+static const uint8_t MP_STR16 = 0xda;
+static const uint8_t MP_STR32 = 0xdb;
+static const uint8_t MP_ARRAY16 = 0xdc;
+static const uint8_t MP_ARRAY32 = 0xdd;
+static const uint8_t MP_MAP16 = 0xde;
+static const uint8_t MP_MAP32 = 0xdf;
+
+static uint64_t
+_get(const uint8_t* p_, const unsigned int n_)
+{
+  uint64_t v = 0;
+  for (unsigned int i = 0; i < n_; i++)
+  {
+    v = ((v << 8) | p_[i]);
+  }
+  return (v);
+}
+
+static void
+_put(std::string& out_, const uint64_t v_, const unsigned int n_)
+{
+  for (unsigned int i = n_; i > 0; i--)
+  {
+    out_ += char((v_ >> ((i - 1) * 8)) & 0xff);
+  }
+}
+
+// Text of a double as the JSON form carries it, see JsonWriter
+static std::string
+_dtoa(const double d_)
+{
+  char buf[32] = { 0 };
+  snprintf(buf, sizeof(buf), "%.15g", d_);
+  if (strtod(buf, NULL) != d_)
+  {
+    snprintf(buf, sizeof(buf), "%.17g", d_);
+  }
+  std::string str(buf);
+  if (!strpbrk(buf, ".eEn"))
+  {
+    str += ".0";
+  }
+  return (str);
+}
+
+//**********************************************************************
+// Decoding
+//**********************************************************************
+
+struct _item
+{
+  Document::TYPE type;
+  // Length of a string or number of entries in a container
+  uint64_t len;
+  // String bytes or first container entry
+  const uint8_t* body;
+  bool b;
+  bool big;
+  int64_t i;
+  double d;
+};
+
+// Decodes the header of the value at p_. Returns the end of the value for
+//   scalars and strings, the first entry for containers, NULL if truncated
+//   or not supported.
+static const uint8_t*
+_decode(const uint8_t* p_, const uint8_t* end_, _item& item_)
+{
+  if (!p_ || (p_ >= end_))
+  {
+    return (NULL);
+  }
+  memset(&item_, 0, sizeof(item_));
+  uint8_t c = *p_++;
+  size_t avail = (end_ - p_);
+  unsigned int n = 0;
+
+  if (c <= 0x7f)
+  {
+    item_.type = Document::TYPE_INT;
+    item_.i = c;
+    return (p_);
+  }
+  if (c >= 0xe0)
+  {
+    item_.type = Document::TYPE_INT;
+    item_.i = int8_t(c);
+    return (p_);
+  }
+  if (c <= 0x8f)
+  {
+    item_.type = Document::TYPE_OBJECT;
+    item_.len = (c & 0x0f);
+    item_.body = p_;
+    return (p_);
+  }
+  if (c <= 0x9f)
+  {
+    item_.type = Document::TYPE_ARRAY;
+    item_.len = (c & 0x0f);
+    item_.body = p_;
+    return (p_);
+  }
+  if (c <= 0xbf)
+  {
+    item_.type = Document::TYPE_STRING;
+    item_.len = (c & 0x1f);
+    item_.body = p_;
+    return ((item_.len <= avail) ? (p_ + item_.len) : NULL);
+  }
+
+  switch (c)
+  {
+  case MP_NIL:
+    item_.type = Document::TYPE_NULL;
+    return (p_);
+  case MP_FALSE:
+  case MP_TRUE:
+    item_.type = Document::TYPE_BOOL;
+    item_.b = (c == MP_TRUE);
+    return (p_);
+  case MP_BIN8:
+  case MP_STR8:
+    n = 1;
+    break;
+  case MP_BIN16:
+  case MP_STR16:
+  case MP_ARRAY16:
+  case MP_MAP16:
+    n = 2;
+    break;
+  case MP_BIN32:
+  case MP_STR32:
+  case MP_ARRAY32:
+  case MP_MAP32:
+    n = 4;
+    break;
+  case MP_FLOAT32:
+  case MP_FLOAT64:
+  {
+    n = ((c == MP_FLOAT32) ? 4 : 8);
+    if (avail < n)
+    {
+      return (NULL);
+    }
+    item_.type = Document::TYPE_DOUBLE;
+    uint64_t bits = _get(p_, n);
+    if (c == MP_FLOAT32)
+    {
+      float f = 0;
+      uint32_t b32 = uint32_t(bits);
+      memcpy(&f, &b32, sizeof(f));
+      item_.d = f;
+    }
+    else
+    {
+      memcpy(&item_.d, &bits, sizeof(item_.d));
+    }
+    return (p_ + n);
+  }
+  case MP_UINT8:
+  case MP_UINT16:
+  case MP_UINT32:
+  case MP_UINT64:
+  {
+    n = (1 << (c - MP_UINT8));
+    if (avail < n)
+    {
+      return (NULL);
+    }
+    uint64_t u = _get(p_, n);
+    item_.type = Document::TYPE_INT;
+    item_.big = (u > uint64_t(INT64_MAX));
+    item_.i = int64_t(u);
+    return (p_ + n);
+  }
+  case MP_INT8:
+  case MP_INT16:
+  case MP_INT32:
+  case MP_INT64:
+  {
+    n = (1 << (c - MP_INT8));
+    if (avail < n)
+    {
+      return (NULL);
+    }
+    // Sign extend from the encoded width
+    unsigned int shift = (64 - (n * 8));
+    item_.type = Document::TYPE_INT;
+    item_.i = (int64_t(_get(p_, n) << shift) >> shift);
+    return (p_ + n);
+  }
+  default:
+    // Extension types are not supported
+    return (NULL);
+  }
+
+  // Length prefixed string, binary, array or map
+  if (avail < n)
+  {
+    return (NULL);
+  }
+  item_.len = _get(p_, n);
+  p_ += n;
+  avail -= n;
+  item_.body = p_;
+  if ((c == MP_ARRAY16) || (c == MP_ARRAY32))
+  {
+    item_.type = Document::TYPE_ARRAY;
+    return (p_);
+  }
+  if ((c == MP_MAP16) || (c == MP_MAP32))
+  {
+    item_.type = Document::TYPE_OBJECT;
+    return (p_);
+  }
+  item_.type = Document::TYPE_STRING;
+  return ((item_.len <= avail) ? (p_ + item_.len) : NULL);
+}
+
+// Returns the end of the value at p_, NULL if it is malformed
+static const uint8_t*
+_skip(const uint8_t* p_, const uint8_t* end_, const unsigned int depth_)
+{
+  _item item;
+  p_ = _decode(p_, end_, item);
+  if (p_ && ((item.type == Document::TYPE_ARRAY) || (item.type == Document::TYPE_OBJECT)))
+  {
+    if (depth_ >= BinaryReader::DefaultMaxDepth)
+    {
+      return (NULL);
+    }
+    uint64_t count = ((item.type == Document::TYPE_OBJECT) ? (item.len * 2) : item.len);
+    for (uint64_t i = 0; (i < count) && p_; i++)
+    {
+      p_ = _skip(p_, end_, (depth_ + 1));
+    }
+  }
+  return (p_);
+}
+
+//**********************************************************************
+// Class: BinaryReader
+//**********************************************************************
+
+const unsigned int BinaryReader::DefaultMaxDepth(256);
+
+BinaryReader::BinaryReader(const unsigned int depth_) :
+    _max_depth(depth_), _begin(NULL), _cur(NULL), _end(NULL), _handler(NULL), _err_off(0)
+{
+}
+
+BinaryReader::~BinaryReader()
+{
+}
+
+bool
+BinaryReader::Parse(const void* buf_, const size_t len_, JsonHandler& handler_)
+{
+  this->_begin = this->_cur = (const uint8_t*) buf_;
+  this->_end = (this->_begin + len_);
+  this->_handler = &handler_;
+  this->_err_off = 0;
+  this->_err_msg.clear();
+
+  if (!buf_ || !this->value(0))
+  {
+    if (this->_err_msg.empty())
+    {
+      this->error("aborted by handler");
+    }
+    return (false);
+  }
+  if (this->_cur != this->_end)
+  {
+    return (this->error("garbage after data"));
+  }
+  return (true);
+}
+
+bool
+BinaryReader::Parse(const std::string& buf_, JsonHandler& handler_)
+{
+  return (this->Parse(buf_.data(), buf_.size(), handler_));
+}
+
+size_t
+BinaryReader::ErrorOffset() const
+{
+  return (this->_err_off);
+}
+
+const std::string&
+BinaryReader::ErrorMessage() const
+{
+  return (this->_err_msg);
+}
+
+bool
+BinaryReader::Detect(const void* buf_, const size_t len_)
+{
+  if (!buf_ || !len_)
+  {
+    return (false);
+  }
+  uint8_t c = *(const uint8_t*) buf_;
+  return (((c >= 0x80) && (c <= 0x9f)) || ((c >= MP_ARRAY16) && (c <= MP_MAP32)));
+}
+
+bool
+BinaryReader::error(const char* msg_)
+{
+  if (this->_err_msg.empty())
+  {
+    this->_err_off = (this->_cur - this->_begin);
+    this->_err_msg = msg_;
+  }
+  return (false);
+}
+
+bool
+BinaryReader::number(const char* str_)
+{
+  return (this->_handler->Number(str_, strlen(str_), true));
+}
+
+bool
+BinaryReader::value(const unsigned int depth_)
+{
+  _item item;
+  const uint8_t* next = _decode(this->_cur, this->_end, item);
+  if (!next)
+  {
+    return (this->error((this->_cur < this->_end) ? "unsupported or truncated value" : "expected value"));
+  }
+
+  switch (item.type)
+  {
+  case Document::TYPE_NULL:
+    this->_cur = next;
+    return (this->_handler->Null());
+  case Document::TYPE_BOOL:
+    this->_cur = next;
+    return (this->_handler->Bool(item.b));
+  case Document::TYPE_INT:
+  {
+    char buf[32] = { 0 };
+    if (item.big)
+    {
+      snprintf(buf, sizeof(buf), "%llu", (unsigned long long) uint64_t(item.i));
+    }
+    else
+    {
+      snprintf(buf, sizeof(buf), "%lld", (long long) item.i);
+    }
+    this->_cur = next;
+    return (this->number(buf));
+  }
+  case Document::TYPE_DOUBLE:
+  {
+    this->_cur = next;
+    if (!isfinite(item.d))
+    {
+      // Not representable in the JSON form
+      return (this->_handler->Null());
+    }
+    std::string str = _dtoa(item.d);
+    return (this->_handler->Number(str.data(), str.size(), false));
+  }
+  case Document::TYPE_STRING:
+    this->_cur = next;
+    return (this->_handler->String((const char*) item.body, item.len));
+  case Document::TYPE_ARRAY:
+  case Document::TYPE_OBJECT:
+  {
+    if ((depth_ + 1) > this->_max_depth)
+    {
+      return (this->error("maximum depth exceeded"));
+    }
+    bool object = (item.type == Document::TYPE_OBJECT);
+    this->_cur = next;
+    if (!(object ? this->_handler->BeginObject() : this->_handler->BeginArray()))
+    {
+      return (false);
+    }
+    for (uint64_t i = 0; i < item.len; i++)
+    {
+      if (object)
+      {
+        _item key;
+        const uint8_t* val = _decode(this->_cur, this->_end, key);
+        if (!val || (key.type != Document::TYPE_STRING))
+        {
+          return (this->error("expected string key"));
+        }
+        if (!this->_handler->Key((const char*) key.body, key.len))
+        {
+          return (false);
+        }
+        this->_cur = val;
+      }
+      if (!this->value(depth_ + 1))
+      {
+        return (false);
+      }
+    }
+    return (object ? this->_handler->EndObject() : this->_handler->EndArray());
+  }
+  default:
+    return (this->error("unsupported value"));
+  }
+}
+
+//**********************************************************************
+// Class: BinaryWriter
+//**********************************************************************
+
+static void
+_str(std::string& out_, const char* str_, const size_t len_)
+{
+  if (len_ < 32)
+  {
+    out_ += char(0xa0 | len_);
+  }
+  else if (len_ <= UINT8_MAX)
+  {
+    out_ += char(MP_STR8);
+    _put(out_, len_, 1);
+  }
+  else if (len_ <= UINT16_MAX)
+  {
+    out_ += char(MP_STR16);
+    _put(out_, len_, 2);
+  }
+  else
+  {
+    out_ += char(MP_STR32);
+    _put(out_, len_, 4);
+  }
+  out_.append(str_, len_);
+}
+
+static void
+_container(std::string& out_, const bool array_, const size_t count_)
+{
+  if (count_ < 16)
+  {
+    out_ += char((array_ ? 0x90 : 0x80) | count_);
+  }
+  else if (count_ <= UINT16_MAX)
+  {
+    out_ += char(array_ ? MP_ARRAY16 : MP_MAP16);
+    _put(out_, count_, 2);
+  }
+  else
+  {
+    out_ += char(array_ ? MP_ARRAY32 : MP_MAP32);
+    _put(out_, count_, 4);
+  }
+}
+
+static void
+_int(std::string& out_, const int64_t i_)
+{
+  // Smallest encoding that holds the value
+  if ((i_ >= -32) && (i_ <= 127))
+  {
+    out_ += char(int8_t(i_));
+  }
+  else if (i_ > 0)
+  {
+    unsigned int n = ((i_ <= UINT8_MAX) ? 1 : (i_ <= UINT16_MAX) ? 2 : (i_ <= UINT32_MAX) ? 4 : 8);
+    out_ += char(MP_UINT8 + __builtin_ctz(n));
+    _put(out_, uint64_t(i_), n);
+  }
+  else
+  {
+    unsigned int n = ((i_ >= INT8_MIN) ? 1 : (i_ >= INT16_MIN) ? 2 : (i_ >= INT32_MIN) ? 4 : 8);
+    out_ += char(MP_INT8 + __builtin_ctz(n));
+    _put(out_, uint64_t(i_), n);
+  }
+}
+
+static bool
+_verify(const pt::ptree& pt_, const int depth_)
+{
+  // Same restrictions as the JSON form
+  if (!pt_.data().empty() && ((depth_ == 0) || !pt_.empty()))
+  {
+    return (false);
+  }
+  FOREACH (auto& child, pt_)
+  {
+    if (!_verify(child.second, (depth_ + 1)))
+    {
+      return (false);
+    }
+  }
+  return (true);
+}
+
+static void
+_write(const pt::ptree& pt_, std::string& out_, const int depth_)
+{
+  if ((depth_ > 0) && pt_.empty())
+  {
+    _str(out_, pt_.data().data(), pt_.data().size());
+    return;
+  }
+
+  bool array = (depth_ > 0) && (pt_.count(std::string()) == pt_.size());
+  _container(out_, array, pt_.size());
+  FOREACH (auto& child, pt_)
+  {
+    if (!array)
+    {
+      _str(out_, child.first.data(), child.first.size());
+    }
+    _write(child.second, out_, (depth_ + 1));
+  }
+}
+
+static void
+_write(const Document& doc_, const Document::Node node_, std::string& out_)
+{
+  switch (doc_.GetType(node_))
+  {
+  case Document::TYPE_BOOL:
+  {
+    bool b = false;
+    doc_.GetValue(node_, b);
+    out_ += char(b ? MP_TRUE : MP_FALSE);
+    break;
+  }
+  case Document::TYPE_INT:
+  {
+    long i = 0;
+    doc_.GetValue(node_, i);
+    _int(out_, i);
+    break;
+  }
+  case Document::TYPE_DOUBLE:
+  {
+    double d = 0.0;
+    uint64_t bits = 0;
+    doc_.GetValue(node_, d);
+    memcpy(&bits, &d, sizeof(bits));
+    out_ += char(MP_FLOAT64);
+    _put(out_, bits, 8);
+    break;
+  }
+  case Document::TYPE_STRING:
+  {
+    std::string str;
+    doc_.GetValue(node_, str);
+    _str(out_, str.data(), str.size());
+    break;
+  }
+  case Document::TYPE_ARRAY:
+  case Document::TYPE_OBJECT:
+  {
+    bool array = (doc_.GetType(node_) == Document::TYPE_ARRAY);
+    size_t size = doc_.Size(node_);
+    _container(out_, array, size);
+    for (size_t i = 0; i < size; i++)
+    {
+      Document::Node child = doc_.GetChild(node_, i);
+      if (!array)
+      {
+        std::string key = doc_.GetKey(child);
+        _str(out_, key.data(), key.size());
+      }
+      _write(doc_, child, out_);
+    }
+    break;
+  }
+  default:
+    out_ += char(MP_NIL);
+    break;
+  }
+}
+
+bool
+BinaryWriter::Write(const pt::ptree& pt_, std::string& out_)
+{
+  if (!_verify(pt_, 0))
+  {
+    return (false);
+  }
+  _write(pt_, out_, 0);
+  return (true);
+}
+
+bool
+BinaryWriter::Write(const Document& doc_, std::string& out_)
+{
+  _write(doc_, doc_.Root(), out_);
+  return (true);
+}
+
+//**********************************************************************
+// Class: BinaryView
+//**********************************************************************
+
+BinaryView::BinaryView() :
+    _begin(NULL), _end(NULL)
+{
+}
+
+BinaryView::BinaryView(const void* buf_, const size_t len_) :
+    _begin(NULL), _end(NULL)
+{
+  // Validate the whole buffer once so lookups can trust the encoding
+  const uint8_t* begin = (const uint8_t*) buf_;
+  const uint8_t* end = (begin + len_);
+  if (buf_ && (_skip(begin, end, 0) == end))
+  {
+    this->_begin = begin;
+    this->_end = end;
+  }
+}
+
+BinaryView::BinaryView(const uint8_t* begin_, const uint8_t* end_) :
+    _begin(begin_), _end(end_)
+{
+}
+
+BinaryView::~BinaryView()
+{
+}
+
+bool
+BinaryView::Valid() const
+{
+  return (this->_begin != NULL);
+}
+
+Document::TYPE
+BinaryView::GetType() const
+{
+  _item item;
+  if (!_decode(this->_begin, this->_end, item))
+  {
+    return (Document::TYPE_ERR);
+  }
+  return (item.type);
+}
+
+const uint8_t*
+BinaryView::body(size_t& count_) const
+{
+  _item item;
+  const uint8_t* p = _decode(this->_begin, this->_end, item);
+  if (!p || ((item.type != Document::TYPE_ARRAY) && (item.type != Document::TYPE_OBJECT)))
+  {
+    count_ = 0;
+    return (NULL);
+  }
+  count_ = item.len;
+  return (p);
+}
+
+size_t
+BinaryView::Size() const
+{
+  size_t count = 0;
+  this->body(count);
+  return (count);
+}
+
+BinaryView
+BinaryView::GetChild(const size_t index_) const
+{
+  size_t count = 0;
+  const uint8_t* p = this->body(count);
+  if (!p || (index_ >= count))
+  {
+    return (BinaryView());
+  }
+  bool object = (this->GetType() == Document::TYPE_OBJECT);
+  size_t skip = (object ? ((index_ * 2) + 1) : index_);
+  for (size_t i = 0; i < skip; i++)
+  {
+    p = _skip(p, this->_end, 0);
+  }
+  return (BinaryView(p, _skip(p, this->_end, 0)));
+}
+
+bool
+BinaryView::GetKey(const size_t index_, const char*& str_, size_t& len_) const
+{
+  size_t count = 0;
+  const uint8_t* p = this->body(count);
+  if (!p || (index_ >= count) || (this->GetType() != Document::TYPE_OBJECT))
+  {
+    return (false);
+  }
+  for (size_t i = 0; i < (index_ * 2); i++)
+  {
+    p = _skip(p, this->_end, 0);
+  }
+  return (BinaryView(p, _skip(p, this->_end, 0)).GetValue(str_, len_));
+}
+
+BinaryView
+BinaryView::Find(const std::string& key_) const
+{
+  size_t count = 0;
+  const uint8_t* p = this->body(count);
+  if (!p || (this->GetType() != Document::TYPE_OBJECT))
+  {
+    return (BinaryView());
+  }
+  for (size_t i = 0; i < count; i++)
+  {
+    _item key;
+    const uint8_t* val = _decode(p, this->_end, key);
+    const uint8_t* next = _skip(val, this->_end, 0);
+    if ((key.len == key_.size()) && !memcmp(key.body, key_.data(), key.len))
+    {
+      return (BinaryView(val, next));
+    }
+    p = next;
+  }
+  return (BinaryView());
+}
+
+BinaryView
+BinaryView::Find(const DataPath& path_) const
+{
+  BinaryView view(*this);
+  // Keys as Data splits them, so the view agrees with Data::GetValue()
+  std::vector<std::string> keys = CompiledPath(path_).Keys();
+  for (size_t i = 0; (i < keys.size()) && view.Valid(); i++)
+  {
+    view = view.Find(keys[i]);
+  }
+  return (view);
+}
+
+bool
+BinaryView::GetValue(const char*& str_, size_t& len_) const
+{
+  _item item;
+  if (!_decode(this->_begin, this->_end, item) || (item.type != Document::TYPE_STRING))
+  {
+    return (false);
+  }
+  str_ = (const char*) item.body;
+  len_ = item.len;
+  return (true);
+}
+
+bool
+BinaryView::GetValue(bool& value_) const
+{
+  _item item;
+  if (!_decode(this->_begin, this->_end, item))
+  {
+    return (false);
+  }
+  bool status = true;
+  switch (item.type)
+  {
+  case Document::TYPE_BOOL:
+    value_ = item.b;
+    break;
+  case Document::TYPE_INT:
+    value_ = (item.i != 0);
+    break;
+  case Document::TYPE_STRING:
+  {
+    std::string str((const char*) item.body, item.len);
+    if ((str == "true") || (str == "1"))
+    {
+      value_ = true;
+    }
+    else if ((str == "false") || (str == "0"))
+    {
+      value_ = false;
+    }
+    else
+    {
+      status = false;
+    }
+    break;
+  }
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+bool
+BinaryView::GetValue(int64_t& value_) const
+{
+  _item item;
+  if (!_decode(this->_begin, this->_end, item))
+  {
+    return (false);
+  }
+  bool status = true;
+  switch (item.type)
+  {
+  case Document::TYPE_BOOL:
+    value_ = item.b;
+    break;
+  case Document::TYPE_INT:
+    value_ = item.i;
+    status = !item.big;
+    break;
+  case Document::TYPE_DOUBLE:
+    value_ = int64_t(item.d);
+    break;
+  case Document::TYPE_STRING:
+  {
+    std::string str((const char*) item.body, item.len);
+    char* end = NULL;
+    errno = 0;
+    long long v = strtoll(str.c_str(), &end, 10);
+    status = (!str.empty() && !errno && end && !*end);
+    if (status)
+    {
+      value_ = v;
+    }
+    break;
+  }
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+bool
+BinaryView::GetValue(double& value_) const
+{
+  _item item;
+  if (!_decode(this->_begin, this->_end, item))
+  {
+    return (false);
+  }
+  bool status = true;
+  switch (item.type)
+  {
+  case Document::TYPE_INT:
+    value_ = (item.big ? double(uint64_t(item.i)) : double(item.i));
+    break;
+  case Document::TYPE_DOUBLE:
+    value_ = item.d;
+    break;
+  case Document::TYPE_STRING:
+  {
+    std::string str((const char*) item.body, item.len);
+    char* end = NULL;
+    errno = 0;
+    double v = strtod(str.c_str(), &end);
+    status = (!str.empty() && !errno && end && !*end);
+    if (status)
+    {
+      value_ = v;
+    }
+    break;
+  }
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+bool
+BinaryView::GetValue(std::string& value_) const
+{
+  _item item;
+  if (!_decode(this->_begin, this->_end, item))
+  {
+    return (false);
+  }
+  // Scalars read back as the text the decoded property tree would hold
+  bool status = true;
+  char buf[32] = { 0 };
+  switch (item.type)
+  {
+  case Document::TYPE_NULL:
+    value_ = "null";
+    break;
+  case Document::TYPE_BOOL:
+    value_ = (item.b ? "true" : "false");
+    break;
+  case Document::TYPE_INT:
+    if (item.big)
+    {
+      snprintf(buf, sizeof(buf), "%llu", (unsigned long long) uint64_t(item.i));
+    }
+    else
+    {
+      snprintf(buf, sizeof(buf), "%lld", (long long) item.i);
+    }
+    value_ = buf;
+    break;
+  case Document::TYPE_DOUBLE:
+    value_ = (isfinite(item.d) ? _dtoa(item.d) : std::string("null"));
+    break;
+  case Document::TYPE_STRING:
+    value_.assign((const char*) item.body, item.len);
+    break;
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+}
+}
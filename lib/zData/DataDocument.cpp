@@ -0,0 +1,976 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <zutils/zLog.h>
+#include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_DATA);
+
+namespace zUtils
+{
+namespace zData
+{
+
+static std::vector<std::string>
+_split(const std::string& path_)
+{
+  std::vector<std::string> keys;
+  size_t start = 0;
+  while (start < path_.size())
+  {
+    size_t end = path_.find('.', start);
+    if (end == std::string::npos)
+    {
+      end = path_.size();
+    }
+    if (end > start)
+    {
+      keys.push_back(path_.substr(start, (end - start)));
+    }
+    start = (end + 1);
+  }
+  return (keys);
+}
+
+static bool
+_str2int(const std::string& str_, int64_t& value_)
+{
+  if (str_.empty())
+  {
+    return (false);
+  }
+  char* end = NULL;
+  errno = 0;
+  long long v = strtoll(str_.c_str(), &end, 10);
+  if (errno || !end || *end)
+  {
+    return (false);
+  }
+  value_ = v;
+  return (true);
+}
+
+static bool
+_str2uint(const std::string& str_, uint64_t& value_)
+{
+  if (str_.empty() || (str_[0] == '-'))
+  {
+    return (false);
+  }
+  char* end = NULL;
+  errno = 0;
+  unsigned long long v = strtoull(str_.c_str(), &end, 10);
+  if (errno || !end || *end)
+  {
+    return (false);
+  }
+  value_ = v;
+  return (true);
+}
+
+static bool
+_str2double(const std::string& str_, double& value_)
+{
+  if (str_.empty())
+  {
+    return (false);
+  }
+  char* end = NULL;
+  errno = 0;
+  double v = strtod(str_.c_str(), &end);
+  if (errno || !end || *end)
+  {
+    return (false);
+  }
+  value_ = v;
+  return (true);
+}
+
+// Format exactly as the property tree would so conversions round trip
+template<typename T>
+  static std::string
+  _ptstr(const T value_)
+  {
+    pt::ptree pt;
+    pt.put_value<T>(value_);
+    return (pt.data());
+  }
+
+//**********************************************************************
+// Class: Document
+//**********************************************************************
+
+const Document::Node Document::NoNode(UINT32_MAX);
+
+Document::Document()
+{
+  this->Clear();
+}
+
+Document::Document(const Data& data_)
+{
+  this->Load(data_);
+}
+
+Document::~Document()
+{
+}
+
+void
+Document::Clear()
+{
+  this->_nodes.clear();
+  this->_kids.clear();
+  this->_chars.clear();
+  this->_keys.clear();
+  this->_key_index.clear();
+  this->intern(std::string(""));
+  this->reset(this->alloc(0), TYPE_OBJECT);
+  this->_mark = 0;
+}
+
+void
+Document::Compact()
+{
+  // Copy only reachable nodes, live strings and used child slots
+  Document doc;
+  doc._nodes.clear();
+  doc._nodes.reserve(this->_nodes.size());
+  doc.copy(*this, this->Root(), 0);
+  std::swap(this->_nodes, doc._nodes);
+  std::swap(this->_kids, doc._kids);
+  std::swap(this->_chars, doc._chars);
+  std::swap(this->_keys, doc._keys);
+  std::swap(this->_key_index, doc._key_index);
+  this->_mark = (this->_nodes.size() + this->_kids.size() + this->_chars.size());
+}
+
+size_t
+Document::NodeCount() const
+{
+  return (this->_nodes.size());
+}
+
+Document::Node
+Document::Root() const
+{
+  return (0);
+}
+
+Document::TYPE
+Document::GetType(const Node node_) const
+{
+  if (node_ >= this->_nodes.size())
+  {
+    return (TYPE_ERR);
+  }
+  return (Document::TYPE(this->_nodes[node_].type));
+}
+
+std::string
+Document::GetKey(const Node node_) const
+{
+  std::string key;
+  if (node_ < this->_nodes.size())
+  {
+    key = this->_keys[this->_nodes[node_].key];
+  }
+  return (key);
+}
+
+size_t
+Document::Size(const Node node_) const
+{
+  size_t size = 0;
+  TYPE type = this->GetType(node_);
+  if ((type == TYPE_ARRAY) || (type == TYPE_OBJECT))
+  {
+    size = this->_nodes[node_].u.kids.count;
+  }
+  return (size);
+}
+
+Document::Node
+Document::GetChild(const Node node_, const size_t index_) const
+{
+  Node child = NoNode;
+  if (index_ < this->Size(node_))
+  {
+    child = this->_kids[this->_nodes[node_].u.kids.begin + index_];
+  }
+  return (child);
+}
+
+Document::Node
+Document::Find(const Node node_, const std::string& key_) const
+{
+  // Keys are interned, so a key never seen cannot match and matching
+  //   children is an integer compare
+  if (this->GetType(node_) != TYPE_OBJECT)
+  {
+    return (NoNode);
+  }
+  uint32_t key = this->lookup(key_);
+  if (key == UINT32_MAX)
+  {
+    return (NoNode);
+  }
+  const node& n = this->_nodes[node_];
+  const Node* kids = this->_kids.data() + n.u.kids.begin;
+  for (uint32_t i = 0; i < n.u.kids.count; i++)
+  {
+    if (this->_nodes[kids[i]].key == key)
+    {
+      return (kids[i]);
+    }
+  }
+  return (NoNode);
+}
+
+Document::Node
+Document::Find(const DataPath& path_) const
+{
+  return (this->Find(_split(path_.Path())));
+}
+
+Document::Node
+Document::Find(const std::vector<std::string>& keys_) const
+{
+  Node node = this->Root();
+  for (size_t i = 0; (i < keys_.size()) && (node != NoNode); i++)
+  {
+    node = this->Find(node, keys_[i]);
+  }
+  return (node);
+}
+
+bool
+Document::GetValue(const Node node_, bool& value_) const
+{
+  bool status = true;
+  switch (this->GetType(node_))
+  {
+  case TYPE_BOOL:
+    value_ = this->_nodes[node_].u.b;
+    break;
+  case TYPE_INT:
+    value_ = (this->_nodes[node_].u.i != 0);
+    break;
+  case TYPE_STRING:
+  case TYPE_ARRAY:
+  case TYPE_OBJECT:
+  {
+    std::string str;
+    this->GetValue(node_, str);
+    if ((str == "true") || (str == "1"))
+    {
+      value_ = true;
+    }
+    else if ((str == "false") || (str == "0"))
+    {
+      value_ = false;
+    }
+    else
+    {
+      status = false;
+    }
+    break;
+  }
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+bool
+Document::GetValue(const Node node_, long& value_) const
+{
+  bool status = true;
+  switch (this->GetType(node_))
+  {
+  case TYPE_BOOL:
+    value_ = this->_nodes[node_].u.b;
+    break;
+  case TYPE_INT:
+    value_ = this->_nodes[node_].u.i;
+    break;
+  case TYPE_DOUBLE:
+    value_ = long(this->_nodes[node_].u.d);
+    break;
+  case TYPE_STRING:
+  case TYPE_ARRAY:
+  case TYPE_OBJECT:
+  {
+    std::string str;
+    int64_t v = 0;
+    this->GetValue(node_, str);
+    status = _str2int(str, v);
+    if (status)
+    {
+      value_ = v;
+    }
+    break;
+  }
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+bool
+Document::GetValue(const Node node_, int& value_) const
+{
+  long v = 0;
+  bool status = this->GetValue(node_, v);
+  if (status)
+  {
+    value_ = int(v);
+  }
+  return (status);
+}
+
+bool
+Document::GetValue(const Node node_, unsigned int& value_) const
+{
+  long v = 0;
+  bool status = this->GetValue(node_, v);
+  if (status)
+  {
+    value_ = (unsigned int) v;
+  }
+  return (status);
+}
+
+bool
+Document::GetValue(const Node node_, unsigned long& value_) const
+{
+  // Values beyond the signed range are stored as strings
+  std::string str;
+  uint64_t u = 0;
+  TYPE type = this->GetType(node_);
+  if (((type == TYPE_STRING) || (type == TYPE_ARRAY) || (type == TYPE_OBJECT)) && this->GetValue(node_, str)
+      && _str2uint(str, u))
+  {
+    value_ = u;
+    return (true);
+  }
+  long v = 0;
+  bool status = this->GetValue(node_, v);
+  if (status)
+  {
+    value_ = (unsigned long) v;
+  }
+  return (status);
+}
+
+bool
+Document::GetValue(const Node node_, double& value_) const
+{
+  bool status = true;
+  switch (this->GetType(node_))
+  {
+  case TYPE_INT:
+    value_ = double(this->_nodes[node_].u.i);
+    break;
+  case TYPE_DOUBLE:
+    value_ = this->_nodes[node_].u.d;
+    break;
+  case TYPE_STRING:
+  case TYPE_ARRAY:
+  case TYPE_OBJECT:
+  {
+    std::string str;
+    this->GetValue(node_, str);
+    status = _str2double(str, value_);
+    break;
+  }
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+bool
+Document::GetValue(const Node node_, std::string& value_) const
+{
+  bool status = true;
+  switch (this->GetType(node_))
+  {
+  case TYPE_NULL:
+    value_.clear();
+    break;
+  case TYPE_BOOL:
+    value_ = _ptstr<bool>(this->_nodes[node_].u.b);
+    break;
+  case TYPE_INT:
+    value_ = _ptstr<int64_t>(this->_nodes[node_].u.i);
+    break;
+  case TYPE_DOUBLE:
+    value_ = _ptstr<double>(this->_nodes[node_].u.d);
+    break;
+  case TYPE_STRING:
+  {
+    const node& n = this->_nodes[node_];
+    value_.assign((n.u.str.len ? &this->_chars[n.u.str.off] : ""), n.u.str.len);
+    break;
+  }
+  case TYPE_ARRAY:
+  case TYPE_OBJECT:
+    if (this->_nodes[node_].u.kids.text)
+    {
+      status = this->GetValue(this->_nodes[node_].u.kids.text, value_);
+    }
+    else
+    {
+      value_.clear();
+    }
+    break;
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+Document::Node
+Document::SetValue(const Node node_, const bool value_)
+{
+  Node node = this->reset(node_, TYPE_BOOL);
+  if (node != NoNode)
+  {
+    this->_nodes[node].u.b = value_;
+  }
+  return (node);
+}
+
+Document::Node
+Document::SetValue(const Node node_, const int64_t value_)
+{
+  Node node = this->reset(node_, TYPE_INT);
+  if (node != NoNode)
+  {
+    this->_nodes[node].u.i = value_;
+  }
+  return (node);
+}
+
+Document::Node
+Document::SetValue(const Node node_, const uint64_t value_)
+{
+  if (value_ > uint64_t(INT64_MAX))
+  {
+    return (this->SetValue(node_, _ptstr<uint64_t>(value_)));
+  }
+  return (this->SetValue(node_, int64_t(value_)));
+}
+
+Document::Node
+Document::SetValue(const Node node_, const double value_)
+{
+  Node node = this->reset(node_, TYPE_DOUBLE);
+  if (node != NoNode)
+  {
+    this->_nodes[node].u.d = value_;
+  }
+  return (node);
+}
+
+Document::Node
+Document::SetValue(const Node node_, const std::string& value_)
+{
+  Node node = this->reset(node_, TYPE_STRING);
+  if (node != NoNode)
+  {
+    this->_nodes[node].u.str.off = this->_chars.size();
+    this->_nodes[node].u.str.len = value_.size();
+    this->_chars.insert(this->_chars.end(), value_.begin(), value_.end());
+  }
+  return (node);
+}
+
+Document::Node
+Document::SetNull(const Node node_)
+{
+  return (this->reset(node_, TYPE_NULL));
+}
+
+Document::Node
+Document::SetArray(const Node node_)
+{
+  return (this->reset(node_, TYPE_ARRAY));
+}
+
+Document::Node
+Document::SetObject(const Node node_)
+{
+  return (this->reset(node_, TYPE_OBJECT));
+}
+
+Document::Node
+Document::Create(const Node node_, const std::string& key_)
+{
+  Node child = this->Find(node_, key_);
+  if ((child == NoNode) && (this->GetType(node_) == TYPE_OBJECT))
+  {
+    child = this->Append(node_);
+    if (child != NoNode)
+    {
+      this->_nodes[child].key = this->intern(key_);
+    }
+  }
+  return (child);
+}
+
+Document::Node
+Document::Create(const DataPath& path_)
+{
+  return (this->Create(_split(path_.Path())));
+}
+
+Document::Node
+Document::Create(const std::vector<std::string>& keys_)
+{
+  Node node = this->Root();
+  for (size_t i = 0; (i < keys_.size()) && (node != NoNode); i++)
+  {
+    node = this->Create(this->object(node), keys_[i]);
+  }
+  return (node);
+}
+
+Document::Node
+Document::Append(const Node node_)
+{
+  TYPE type = this->GetType(node_);
+  if ((type != TYPE_ARRAY) && (type != TYPE_OBJECT))
+  {
+    return (NoNode);
+  }
+
+  // Children are contiguous; a full slice moves to the end of the child
+  //   array with double the capacity, leaving the old slots for Compact()
+  if (this->_nodes[node_].u.kids.count == this->_nodes[node_].u.kids.cap)
+  {
+    uint32_t cap = this->_nodes[node_].u.kids.cap ? (this->_nodes[node_].u.kids.cap * 2) : 4;
+    uint32_t begin = this->_kids.size();
+    this->_kids.resize(begin + cap, NoNode);
+    for (uint32_t i = 0; i < this->_nodes[node_].u.kids.count; i++)
+    {
+      this->_kids[begin + i] = this->_kids[this->_nodes[node_].u.kids.begin + i];
+    }
+    this->_nodes[node_].u.kids.begin = begin;
+    this->_nodes[node_].u.kids.cap = cap;
+  }
+
+  Node child = this->alloc(0);
+  node& n = this->_nodes[node_];
+  this->_kids[n.u.kids.begin + n.u.kids.count++] = child;
+  return (child);
+}
+
+bool
+Document::Del(const Node node_, const std::string& key_)
+{
+  Node child = this->Find(node_, key_);
+  if (child == NoNode)
+  {
+    return (false);
+  }
+  node& n = this->_nodes[node_];
+  Node* kids = this->_kids.data() + n.u.kids.begin;
+  for (uint32_t i = 0; i < n.u.kids.count; i++)
+  {
+    if (kids[i] == child)
+    {
+      memmove(&kids[i], &kids[i + 1], (n.u.kids.count - i - 1) * sizeof(Node));
+      n.u.kids.count--;
+      break;
+    }
+  }
+  return (true);
+}
+
+bool
+Document::Del(const DataPath& path_)
+{
+  std::vector<std::string> keys = _split(path_.Path());
+  if (keys.empty())
+  {
+    return (false);
+  }
+  Node node = this->Root();
+  for (size_t i = 0; (i < (keys.size() - 1)) && (node != NoNode); i++)
+  {
+    node = this->Find(node, keys[i]);
+  }
+  return ((node != NoNode) && this->Del(node, keys.back()));
+}
+
+bool
+Document::Copy(const Node node_, const Document& src_, const Node from_)
+{
+  if ((&src_ == this) || (node_ >= this->_nodes.size()) || (from_ >= src_._nodes.size()))
+  {
+    return (false);
+  }
+  // The copy is made beside the node and moved in; its old slot is garbage
+  Node n = this->copy(src_, from_, this->_nodes[node_].key);
+  this->_nodes[node_] = this->_nodes[n];
+  return (true);
+}
+
+bool
+Document::FromPtree(const pt::ptree& pt_, const bool infer_)
+{
+  this->Clear();
+  return (this->from(this->Root(), pt_, infer_));
+}
+
+bool
+Document::ToPtree(pt::ptree& pt_) const
+{
+  return (this->ToPtree(this->Root(), pt_));
+}
+
+bool
+Document::FromPtree(const Node node_, const pt::ptree& pt_, const bool infer_)
+{
+  if (node_ >= this->_nodes.size())
+  {
+    return (false);
+  }
+  return (this->from(node_, pt_, infer_));
+}
+
+bool
+Document::ToPtree(const Node node_, pt::ptree& pt_) const
+{
+  pt_.clear();
+  return (this->to(node_, pt_));
+}
+
+bool
+Document::Load(const Data& data_, const bool infer_)
+{
+  bool status = false;
+  if (data_._lock.Lock())
+  {
+    if (data_._doc)
+    {
+      *this = *data_._doc;
+      status = true;
+    }
+    else
+    {
+      status = this->FromPtree(*data_._pt, infer_);
+    }
+    data_._lock.Unlock();
+  }
+  return (status);
+}
+
+bool
+Document::Store(Data& data_) const
+{
+  bool status = false;
+  if (data_._lock.Lock())
+  {
+    // Replace rather than modify, the tree may be shared with copies
+    if (data_._doc)
+    {
+      data_._doc = SHARED_PTR(Document)(new Document(*this));
+      status = true;
+    }
+    else
+    {
+      SHARED_PTR(pt::ptree) pt(new pt::ptree);
+      status = this->ToPtree(*pt);
+      if (status)
+      {
+        data_._pt = pt;
+      }
+    }
+    data_.touch();
+    data_._lock.Unlock();
+  }
+  return (status);
+}
+
+uint32_t
+Document::intern(const std::string& key_)
+{
+  std::unordered_map<std::string, uint32_t>::iterator it = this->_key_index.find(key_);
+  if (it != this->_key_index.end())
+  {
+    return (it->second);
+  }
+  uint32_t key = this->_keys.size();
+  this->_keys.push_back(key_);
+  this->_key_index[key_] = key;
+  return (key);
+}
+
+uint32_t
+Document::lookup(const std::string& key_) const
+{
+  std::unordered_map<std::string, uint32_t>::const_iterator it = this->_key_index.find(key_);
+  return ((it != this->_key_index.end()) ? it->second : UINT32_MAX);
+}
+
+Document::Node
+Document::alloc(const uint32_t key_)
+{
+  node n;
+  memset(&n, 0, sizeof(n));
+  n.type = TYPE_NULL;
+  n.key = key_;
+  this->_nodes.push_back(n);
+  return (this->_nodes.size() - 1);
+}
+
+Document::Node
+Document::reset(const Node node_, const TYPE type_)
+{
+  if (node_ >= this->_nodes.size())
+  {
+    return (NoNode);
+  }
+  // Previous contents, including any children, become garbage
+  node& n = this->_nodes[node_];
+  n.type = type_;
+  memset(&n.u, 0, sizeof(n.u));
+  return (node_);
+}
+
+Document::Node
+Document::object(const Node node_)
+{
+  // Turn a node into an object as the property tree would when adding a
+  //   child: keyless children of an array and any value are kept
+  Node text = 0;
+  switch (this->GetType(node_))
+  {
+  case TYPE_OBJECT:
+    return (node_);
+  case TYPE_ARRAY:
+    this->_nodes[node_].type = TYPE_OBJECT;
+    return (node_);
+  case TYPE_NULL:
+    break;
+  case TYPE_STRING:
+    if (!this->_nodes[node_].u.str.len)
+    {
+      break;
+    }
+    // no break
+  case TYPE_BOOL:
+  case TYPE_INT:
+  case TYPE_DOUBLE:
+    text = this->alloc(0);
+    this->_nodes[text].type = this->_nodes[node_].type;
+    this->_nodes[text].u = this->_nodes[node_].u;
+    break;
+  default:
+    return (NoNode);
+  }
+  this->reset(node_, TYPE_OBJECT);
+  this->_nodes[node_].u.kids.text = text;
+  return (node_);
+}
+
+Document::Node
+Document::value(const Node node_)
+{
+  // Arrays and objects keep their children and take the value beside them
+  TYPE type = this->GetType(node_);
+  if ((type != TYPE_ARRAY) && (type != TYPE_OBJECT))
+  {
+    return (node_);
+  }
+  Node text = this->alloc(0);
+  this->_nodes[node_].u.kids.text = text;
+  return (text);
+}
+
+void
+Document::collect()
+{
+  // Compact once the arenas have doubled since they were last compacted so
+  //   repeated writes do not grow them without bound
+  size_t size = (this->_nodes.size() + this->_kids.size() + this->_chars.size());
+  if (size > std::max(size_t(1024), (2 * this->_mark)))
+  {
+    this->Compact();
+  }
+}
+
+bool
+Document::from(const Node node_, const pt::ptree& pt_, const bool infer_)
+{
+  bool status = true;
+
+  if (pt_.empty())
+  {
+    // Leaf: the property tree only knows strings, optionally recover the type
+    const std::string& str = pt_.data();
+    int64_t i = 0;
+    double d = 0.0;
+    if (infer_ && ((str == "true") || (str == "false")))
+    {
+      this->SetValue(node_, bool(str == "true"));
+    }
+    else if (infer_ && _str2int(str, i) && (_ptstr<int64_t>(i) == str))
+    {
+      this->SetValue(node_, i);
+    }
+    else if (infer_ && _str2double(str, d) && (_ptstr<double>(d) == str))
+    {
+      this->SetValue(node_, d);
+    }
+    else
+    {
+      this->SetValue(node_, str);
+    }
+    return (status);
+  }
+
+  // Children all without keys form an array, anything else is an object
+  bool array = true;
+  FOREACH (auto& child, pt_)
+  {
+    array &= child.first.empty();
+  }
+  this->reset(node_, (array ? TYPE_ARRAY : TYPE_OBJECT));
+
+  // A node with children may still carry data
+  if (!pt_.data().empty())
+  {
+    Node text = this->alloc(0);
+    status &= this->from(text, pt::ptree(pt_.data()), infer_);
+    this->_nodes[node_].u.kids.text = text;
+  }
+
+  FOREACH (auto& child, pt_)
+  {
+    Node n = this->Append(node_);
+    this->_nodes[n].key = this->intern(child.first);
+    status &= this->from(n, child.second, infer_);
+  }
+
+  return (status);
+}
+
+bool
+Document::to(const Node node_, pt::ptree& pt_) const
+{
+  bool status = true;
+  switch (this->GetType(node_))
+  {
+  case TYPE_NULL:
+    pt_.data().clear();
+    break;
+  case TYPE_BOOL:
+    pt_.put_value<bool>(this->_nodes[node_].u.b);
+    break;
+  case TYPE_INT:
+    pt_.put_value<int64_t>(this->_nodes[node_].u.i);
+    break;
+  case TYPE_DOUBLE:
+    pt_.put_value<double>(this->_nodes[node_].u.d);
+    break;
+  case TYPE_STRING:
+  {
+    std::string str;
+    this->GetValue(node_, str);
+    pt_.put_value(str);
+    break;
+  }
+  case TYPE_ARRAY:
+  case TYPE_OBJECT:
+    if (this->_nodes[node_].u.kids.text)
+    {
+      std::string str;
+      status &= this->GetValue(this->_nodes[node_].u.kids.text, str);
+      pt_.put_value(str);
+    }
+    for (size_t i = 0; i < this->Size(node_); i++)
+    {
+      Node child = this->GetChild(node_, i);
+      pt::ptree cpt;
+      status &= this->to(child, cpt);
+      pt_.push_back(std::make_pair(this->GetKey(child), cpt));
+    }
+    break;
+  default:
+    status = false;
+    break;
+  }
+  return (status);
+}
+
+Document::Node
+Document::copy(const Document& src_, const Node node_, const uint32_t key_)
+{
+  Node dst = this->alloc(key_);
+  std::string str;
+  switch (src_.GetType(node_))
+  {
+  case TYPE_STRING:
+    src_.GetValue(node_, str);
+    this->SetValue(dst, str);
+    break;
+  case TYPE_ARRAY:
+  case TYPE_OBJECT:
+  {
+    uint32_t count = src_._nodes[node_].u.kids.count;
+    this->reset(dst, src_.GetType(node_));
+    this->_nodes[dst].u.kids.begin = this->_kids.size();
+    this->_nodes[dst].u.kids.count = count;
+    this->_nodes[dst].u.kids.cap = count;
+    this->_kids.resize(this->_kids.size() + count, NoNode);
+    for (uint32_t i = 0; i < count; i++)
+    {
+      Node child = src_.GetChild(node_, i);
+      Node n = this->copy(src_, child, this->intern(src_.GetKey(child)));
+      this->_kids[this->_nodes[dst].u.kids.begin + i] = n;
+    }
+    if (src_._nodes[node_].u.kids.text)
+    {
+      Node text = this->copy(src_, src_._nodes[node_].u.kids.text, 0);
+      this->_nodes[dst].u.kids.text = text;
+    }
+    break;
+  }
+  default:
+    this->_nodes[dst] = src_._nodes[node_];
+    this->_nodes[dst].key = key_;
+    break;
+  }
+  return (dst);
+}
+
+}
+}
@@ -0,0 +1,1011 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <zutils/zLog.h>
+#include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
+#include <zutils/zDataJson.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_DATA);
+
+namespace zUtils
+{
+namespace zData
+{
+
+// Returns the first character in [p_, end_) that ends a plain run inside a
+//   JSON string: a quote, a backslash or a control character
+static const char*
+_scan_string(const char* p_, const char* end_)
+{
+#ifdef __SSE2__
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i bslash = _mm_set1_epi8('\\');
+  const __m128i ctrl = _mm_set1_epi8(0x1f);
+  while ((end_ - p_) >= 16)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i*) p_);
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, bslash));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl), ctrl));
+    int mask = _mm_movemask_epi8(m);
+    if (mask)
+    {
+      return (p_ + __builtin_ctz(mask));
+    }
+    p_ += 16;
+  }
+#endif
+  while ((p_ < end_) && (*p_ != '"') && (*p_ != '\\') && ((unsigned char) *p_ >= 0x20))
+  {
+    p_++;
+  }
+  return (p_);
+}
+
+// Same as above for output: property tree JSON also escapes '/'
+static const char*
+_scan_escape(const char* p_, const char* end_)
+{
+#ifdef __SSE2__
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i bslash = _mm_set1_epi8('\\');
+  const __m128i slash = _mm_set1_epi8('/');
+  const __m128i ctrl = _mm_set1_epi8(0x1f);
+  while ((end_ - p_) >= 16)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i*) p_);
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, bslash));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, slash));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl), ctrl));
+    int mask = _mm_movemask_epi8(m);
+    if (mask)
+    {
+      return (p_ + __builtin_ctz(mask));
+    }
+    p_ += 16;
+  }
+#endif
+  while ((p_ < end_) && (*p_ != '"') && (*p_ != '\\') && (*p_ != '/') && ((unsigned char) *p_ >= 0x20))
+  {
+    p_++;
+  }
+  return (p_);
+}
+
+static int
+_hex(const char c_)
+{
+  if ((c_ >= '0') && (c_ <= '9'))
+  {
+    return (c_ - '0');
+  }
+  if ((c_ >= 'a') && (c_ <= 'f'))
+  {
+    return (c_ - 'a' + 10);
+  }
+  if ((c_ >= 'A') && (c_ <= 'F'))
+  {
+    return (c_ - 'A' + 10);
+  }
+  return (-1);
+}
+
+static void
+_utf8(const unsigned int cp_, std::string& out_)
+{
+  if (cp_ < 0x80)
+  {
+    out_ += char(cp_);
+  }
+  else if (cp_ < 0x800)
+  {
+    out_ += char(0xc0 | (cp_ >> 6));
+    out_ += char(0x80 | (cp_ & 0x3f));
+  }
+  else if (cp_ < 0x10000)
+  {
+    out_ += char(0xe0 | (cp_ >> 12));
+    out_ += char(0x80 | ((cp_ >> 6) & 0x3f));
+    out_ += char(0x80 | (cp_ & 0x3f));
+  }
+  else
+  {
+    out_ += char(0xf0 | (cp_ >> 18));
+    out_ += char(0x80 | ((cp_ >> 12) & 0x3f));
+    out_ += char(0x80 | ((cp_ >> 6) & 0x3f));
+    out_ += char(0x80 | (cp_ & 0x3f));
+  }
+}
+
+static void
+_indent(std::string& out_, const int indent_)
+{
+  out_.append((4 * indent_), ' ');
+}
+
+//**********************************************************************
+// Class: JsonHandler
+//**********************************************************************
+
+JsonHandler::~JsonHandler()
+{
+}
+
+//**********************************************************************
+// Class: JsonReader
+//**********************************************************************
+
+const unsigned int JsonReader::DefaultMaxDepth(256);
+
+JsonReader::JsonReader(const unsigned int depth_) :
+    _max_depth(depth_), _begin(NULL), _cur(NULL), _end(NULL), _handler(NULL), _err_off(0)
+{
+}
+
+JsonReader::~JsonReader()
+{
+}
+
+bool
+JsonReader::Parse(const char* json_, const size_t len_, JsonHandler& handler_)
+{
+  this->_begin = this->_cur = json_;
+  this->_end = (json_ + len_);
+  this->_handler = &handler_;
+  this->_err_off = 0;
+  this->_err_msg.clear();
+
+  if (!json_ || !this->value(0))
+  {
+    if (this->_err_msg.empty())
+    {
+      this->error("aborted by handler");
+    }
+    return (false);
+  }
+  this->skip();
+  if (this->_cur != this->_end)
+  {
+    return (this->error("garbage after data"));
+  }
+  return (true);
+}
+
+bool
+JsonReader::Parse(const std::string& json_, JsonHandler& handler_)
+{
+  return (this->Parse(json_.data(), json_.size(), handler_));
+}
+
+size_t
+JsonReader::ErrorOffset() const
+{
+  return (this->_err_off);
+}
+
+const std::string&
+JsonReader::ErrorMessage() const
+{
+  return (this->_err_msg);
+}
+
+bool
+JsonReader::error(const char* msg_)
+{
+  if (this->_err_msg.empty())
+  {
+    this->_err_off = (this->_cur - this->_begin);
+    this->_err_msg = msg_;
+  }
+  return (false);
+}
+
+void
+JsonReader::skip()
+{
+  while ((this->_cur < this->_end)
+      && ((*this->_cur == ' ') || (*this->_cur == '\n') || (*this->_cur == '\r') || (*this->_cur == '\t')))
+  {
+    this->_cur++;
+  }
+}
+
+bool
+JsonReader::value(const unsigned int depth_)
+{
+  this->skip();
+  if (this->_cur == this->_end)
+  {
+    return (this->error("expected value"));
+  }
+  switch (*this->_cur)
+  {
+  case '{':
+    return (this->object(depth_ + 1));
+  case '[':
+    return (this->array(depth_ + 1));
+  case '"':
+    return (this->string(false));
+  case 't':
+    return (this->literal("true", 4) && this->_handler->Bool(true));
+  case 'f':
+    return (this->literal("false", 5) && this->_handler->Bool(false));
+  case 'n':
+    return (this->literal("null", 4) && this->_handler->Null());
+  default:
+    return (this->number());
+  }
+}
+
+bool
+JsonReader::object(const unsigned int depth_)
+{
+  if (depth_ > this->_max_depth)
+  {
+    return (this->error("maximum depth exceeded"));
+  }
+  this->_cur++;
+  if (!this->_handler->BeginObject())
+  {
+    return (false);
+  }
+  this->skip();
+  if ((this->_cur < this->_end) && (*this->_cur == '}'))
+  {
+    this->_cur++;
+    return (this->_handler->EndObject());
+  }
+  for (;;)
+  {
+    this->skip();
+    if ((this->_cur == this->_end) || (*this->_cur != '"'))
+    {
+      return (this->error("expected key string"));
+    }
+    if (!this->string(true))
+    {
+      return (false);
+    }
+    this->skip();
+    if ((this->_cur == this->_end) || (*this->_cur != ':'))
+    {
+      return (this->error("expected ':'"));
+    }
+    this->_cur++;
+    if (!this->value(depth_))
+    {
+      return (false);
+    }
+    this->skip();
+    if ((this->_cur < this->_end) && (*this->_cur == ','))
+    {
+      this->_cur++;
+      continue;
+    }
+    if ((this->_cur < this->_end) && (*this->_cur == '}'))
+    {
+      this->_cur++;
+      return (this->_handler->EndObject());
+    }
+    return (this->error("expected '}' or ','"));
+  }
+}
+
+bool
+JsonReader::array(const unsigned int depth_)
+{
+  if (depth_ > this->_max_depth)
+  {
+    return (this->error("maximum depth exceeded"));
+  }
+  this->_cur++;
+  if (!this->_handler->BeginArray())
+  {
+    return (false);
+  }
+  this->skip();
+  if ((this->_cur < this->_end) && (*this->_cur == ']'))
+  {
+    this->_cur++;
+    return (this->_handler->EndArray());
+  }
+  for (;;)
+  {
+    if (!this->value(depth_))
+    {
+      return (false);
+    }
+    this->skip();
+    if ((this->_cur < this->_end) && (*this->_cur == ','))
+    {
+      this->_cur++;
+      continue;
+    }
+    if ((this->_cur < this->_end) && (*this->_cur == ']'))
+    {
+      this->_cur++;
+      return (this->_handler->EndArray());
+    }
+    return (this->error("expected ']' or ','"));
+  }
+}
+
+bool
+JsonReader::string(const bool key_)
+{
+  // Strings without escapes are handed over in place
+  const char* start = ++this->_cur;
+  const char* p = _scan_string(start, this->_end);
+  bool copied = false;
+
+  while (p < this->_end)
+  {
+    if (*p == '"')
+    {
+      this->_cur = (p + 1);
+      const char* str = start;
+      size_t len = (p - start);
+      if (copied)
+      {
+        this->_scratch.append(start, len);
+        str = this->_scratch.data();
+        len = this->_scratch.size();
+      }
+      return (key_ ? this->_handler->Key(str, len) : this->_handler->String(str, len));
+    }
+    if (*p != '\\')
+    {
+      this->_cur = p;
+      return (this->error("invalid character in string"));
+    }
+    if (!copied)
+    {
+      this->_scratch.clear();
+      copied = true;
+    }
+    this->_scratch.append(start, (p - start));
+    this->_cur = (p + 1);
+    if (!this->escape())
+    {
+      return (false);
+    }
+    start = this->_cur;
+    p = _scan_string(start, this->_end);
+  }
+
+  this->_cur = p;
+  return (this->error("unterminated string"));
+}
+
+bool
+JsonReader::escape()
+{
+  if (this->_cur == this->_end)
+  {
+    return (this->error("invalid escape sequence"));
+  }
+  switch (*this->_cur++)
+  {
+  case '"':
+    this->_scratch += '"';
+    return (true);
+  case '\\':
+    this->_scratch += '\\';
+    return (true);
+  case '/':
+    this->_scratch += '/';
+    return (true);
+  case 'b':
+    this->_scratch += '\b';
+    return (true);
+  case 'f':
+    this->_scratch += '\f';
+    return (true);
+  case 'n':
+    this->_scratch += '\n';
+    return (true);
+  case 'r':
+    this->_scratch += '\r';
+    return (true);
+  case 't':
+    this->_scratch += '\t';
+    return (true);
+  case 'u':
+    break;
+  default:
+    this->_cur--;
+    return (this->error("invalid escape sequence"));
+  }
+
+  unsigned int cp = 0;
+  for (int n = 0; n < 2; n++)
+  {
+    if ((this->_end - this->_cur) < 4)
+    {
+      return (this->error("invalid escape sequence"));
+    }
+    unsigned int quad = 0;
+    for (int i = 0; i < 4; i++)
+    {
+      int h = _hex(this->_cur[i]);
+      if (h < 0)
+      {
+        return (this->error("invalid escape sequence"));
+      }
+      quad = ((quad << 4) | h);
+    }
+    this->_cur += 4;
+
+    if (n == 0)
+    {
+      if ((quad & 0xfc00) == 0xdc00)
+      {
+        return (this->error("invalid codepoint, stray low surrogate"));
+      }
+      cp = quad;
+      if ((quad & 0xfc00) != 0xd800)
+      {
+        break;
+      }
+      if (((this->_end - this->_cur) < 2) || (this->_cur[0] != '\\') || (this->_cur[1] != 'u'))
+      {
+        return (this->error("invalid codepoint, stray high surrogate"));
+      }
+      this->_cur += 2;
+    }
+    else
+    {
+      if ((quad & 0xfc00) != 0xdc00)
+      {
+        return (this->error("expected low surrogate after high surrogate"));
+      }
+      cp = (0x10000 + (((cp & 0x3ff) << 10) | (quad & 0x3ff)));
+    }
+  }
+
+  _utf8(cp, this->_scratch);
+  return (true);
+}
+
+bool
+JsonReader::number()
+{
+  const char* start = this->_cur;
+  const char* p = this->_cur;
+  bool integer = true;
+
+  if ((p < this->_end) && (*p == '-'))
+  {
+    p++;
+  }
+  if ((p < this->_end) && (*p == '0'))
+  {
+    p++;
+  }
+  else if ((p < this->_end) && (*p >= '1') && (*p <= '9'))
+  {
+    while ((p < this->_end) && (*p >= '0') && (*p <= '9'))
+    {
+      p++;
+    }
+  }
+  else
+  {
+    this->_cur = p;
+    return (this->error((p == start) ? "expected value" : "expected digits after -"));
+  }
+
+  if ((p < this->_end) && (*p == '.'))
+  {
+    integer = false;
+    if ((++p == this->_end) || (*p < '0') || (*p > '9'))
+    {
+      this->_cur = p;
+      return (this->error("need at least one digit after '.'"));
+    }
+    while ((p < this->_end) && (*p >= '0') && (*p <= '9'))
+    {
+      p++;
+    }
+  }
+
+  if ((p < this->_end) && ((*p == 'e') || (*p == 'E')))
+  {
+    integer = false;
+    p++;
+    if ((p < this->_end) && ((*p == '+') || (*p == '-')))
+    {
+      p++;
+    }
+    if ((p == this->_end) || (*p < '0') || (*p > '9'))
+    {
+      this->_cur = p;
+      return (this->error("need at least one digit in exponent"));
+    }
+    while ((p < this->_end) && (*p >= '0') && (*p <= '9'))
+    {
+      p++;
+    }
+  }
+
+  this->_cur = p;
+  return (this->_handler->Number(start, (p - start), integer));
+}
+
+bool
+JsonReader::literal(const char* str_, const size_t len_)
+{
+  if ((size_t(this->_end - this->_cur) < len_) || memcmp(this->_cur, str_, len_))
+  {
+    return (this->error("expected value"));
+  }
+  this->_cur += len_;
+  return (true);
+}
+
+//**********************************************************************
+// Class: JsonWriter
+//**********************************************************************
+
+static bool
+_verify(const pt::ptree& pt_, const int depth_)
+{
+  // Same restrictions as pt::write_json(): no data on the root and never
+  //   both data and children on a node
+  if (!pt_.data().empty() && ((depth_ == 0) || !pt_.empty()))
+  {
+    return (false);
+  }
+  FOREACH (auto& child, pt_)
+  {
+    if (!_verify(child.second, (depth_ + 1)))
+    {
+      return (false);
+    }
+  }
+  return (true);
+}
+
+static void
+_write(const pt::ptree& pt_, std::string& out_, const int indent_, const bool pretty_)
+{
+  if ((indent_ > 0) && pt_.empty())
+  {
+    out_ += '"';
+    JsonWriter::Escape(pt_.data().data(), pt_.data().size(), out_);
+    out_ += '"';
+    return;
+  }
+
+  bool array = (indent_ > 0) && (pt_.count(std::string()) == pt_.size());
+  out_ += (array ? '[' : '{');
+  if (pretty_)
+  {
+    out_ += '\n';
+  }
+  for (pt::ptree::const_iterator it = pt_.begin(); it != pt_.end(); ++it)
+  {
+    if (pretty_)
+    {
+      _indent(out_, (indent_ + 1));
+    }
+    if (!array)
+    {
+      out_ += '"';
+      JsonWriter::Escape(it->first.data(), it->first.size(), out_);
+      out_ += "\":";
+      if (pretty_)
+      {
+        out_ += ' ';
+      }
+    }
+    _write(it->second, out_, (indent_ + 1), pretty_);
+    if (boost::next(it) != pt_.end())
+    {
+      out_ += ',';
+    }
+    if (pretty_)
+    {
+      out_ += '\n';
+    }
+  }
+  if (pretty_)
+  {
+    _indent(out_, indent_);
+  }
+  out_ += (array ? ']' : '}');
+}
+
+static void
+_write(const Document& doc_, const Document::Node node_, std::string& out_, const int indent_,
+    const bool pretty_)
+{
+  char buf[32] = { 0 };
+  switch (doc_.GetType(node_))
+  {
+  case Document::TYPE_BOOL:
+  {
+    bool b = false;
+    doc_.GetValue(node_, b);
+    out_ += (b ? "true" : "false");
+    break;
+  }
+  case Document::TYPE_INT:
+  {
+    long i = 0;
+    doc_.GetValue(node_, i);
+    snprintf(buf, sizeof(buf), "%ld", i);
+    out_ += buf;
+    break;
+  }
+  case Document::TYPE_DOUBLE:
+  {
+    double d = 0.0;
+    doc_.GetValue(node_, d);
+    if (!isfinite(d))
+    {
+      out_ += "null";
+      break;
+    }
+    // Shortest form that reads back exactly, always recognizable as a double
+    snprintf(buf, sizeof(buf), "%.15g", d);
+    if (strtod(buf, NULL) != d)
+    {
+      snprintf(buf, sizeof(buf), "%.17g", d);
+    }
+    out_ += buf;
+    if (!strpbrk(buf, ".eEn"))
+    {
+      out_ += ".0";
+    }
+    break;
+  }
+  case Document::TYPE_STRING:
+  {
+    std::string str;
+    doc_.GetValue(node_, str);
+    out_ += '"';
+    JsonWriter::Escape(str.data(), str.size(), out_);
+    out_ += '"';
+    break;
+  }
+  case Document::TYPE_ARRAY:
+  case Document::TYPE_OBJECT:
+  {
+    bool array = (doc_.GetType(node_) == Document::TYPE_ARRAY);
+    size_t size = doc_.Size(node_);
+    out_ += (array ? '[' : '{');
+    if (pretty_ && size)
+    {
+      out_ += '\n';
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+      Document::Node child = doc_.GetChild(node_, i);
+      if (pretty_)
+      {
+        _indent(out_, (indent_ + 1));
+      }
+      if (!array)
+      {
+        std::string key = doc_.GetKey(child);
+        out_ += '"';
+        JsonWriter::Escape(key.data(), key.size(), out_);
+        out_ += "\":";
+        if (pretty_)
+        {
+          out_ += ' ';
+        }
+      }
+      _write(doc_, child, out_, (indent_ + 1), pretty_);
+      if ((i + 1) < size)
+      {
+        out_ += ',';
+      }
+      if (pretty_)
+      {
+        out_ += '\n';
+      }
+    }
+    if (pretty_ && size)
+    {
+      _indent(out_, indent_);
+    }
+    out_ += (array ? ']' : '}');
+    break;
+  }
+  default:
+    out_ += "null";
+    break;
+  }
+}
+
+bool
+JsonWriter::Write(const pt::ptree& pt_, std::string& out_, const bool pretty_)
+{
+  if (!_verify(pt_, 0))
+  {
+    return (false);
+  }
+  _write(pt_, out_, 0, pretty_);
+  out_ += '\n';
+  return (true);
+}
+
+bool
+JsonWriter::Write(const Document& doc_, std::string& out_, const bool pretty_)
+{
+  _write(doc_, doc_.Root(), out_, 0, pretty_);
+  out_ += '\n';
+  return (true);
+}
+
+void
+JsonWriter::Escape(const char* str_, const size_t len_, std::string& out_)
+{
+  static const char* hex = "0123456789ABCDEF";
+  const char* end = (str_ + len_);
+  const char* p = str_;
+  while (p < end)
+  {
+    const char* q = _scan_escape(p, end);
+    out_.append(p, (q - p));
+    if (q == end)
+    {
+      break;
+    }
+    switch (*q)
+    {
+    case '\b':
+      out_ += "\\b";
+      break;
+    case '\f':
+      out_ += "\\f";
+      break;
+    case '\n':
+      out_ += "\\n";
+      break;
+    case '\r':
+      out_ += "\\r";
+      break;
+    case '\t':
+      out_ += "\\t";
+      break;
+    case '/':
+      out_ += "\\/";
+      break;
+    case '"':
+      out_ += "\\\"";
+      break;
+    case '\\':
+      out_ += "\\\\";
+      break;
+    default:
+      out_ += "\\u00";
+      out_ += hex[(*q >> 4) & 0x0f];
+      out_ += hex[*q & 0x0f];
+      break;
+    }
+    p = (q + 1);
+  }
+}
+
+//**********************************************************************
+// Class: PtreeJsonHandler
+//**********************************************************************
+
+PtreeJsonHandler::PtreeJsonHandler(pt::ptree& pt_) :
+    _pt(pt_)
+{
+}
+
+PtreeJsonHandler::~PtreeJsonHandler()
+{
+}
+
+pt::ptree*
+PtreeJsonHandler::node()
+{
+  // New child of the current container, or the root for a top level value
+  if (this->_stack.empty())
+  {
+    return (&this->_pt);
+  }
+  // Array elements have no key, exactly as pt::read_json() stores them
+  pt::ptree* parent = this->_stack.back();
+  const std::string& key = this->_arrays.back() ? std::string() : this->_key;
+  return (&parent->push_back(std::make_pair(key, pt::ptree()))->second);
+}
+
+bool
+PtreeJsonHandler::Null()
+{
+  this->node()->data() = "null";
+  return (true);
+}
+
+bool
+PtreeJsonHandler::Bool(const bool value_)
+{
+  this->node()->data() = (value_ ? "true" : "false");
+  return (true);
+}
+
+bool
+PtreeJsonHandler::Number(const char* str_, const size_t len_, const bool integer_)
+{
+  this->node()->data().assign(str_, len_);
+  return (true);
+}
+
+bool
+PtreeJsonHandler::String(const char* str_, const size_t len_)
+{
+  this->node()->data().assign(str_, len_);
+  return (true);
+}
+
+bool
+PtreeJsonHandler::Key(const char* str_, const size_t len_)
+{
+  this->_key.assign(str_, len_);
+  return (true);
+}
+
+bool
+PtreeJsonHandler::BeginObject()
+{
+  this->_stack.push_back(this->node());
+  this->_arrays.push_back(false);
+  return (true);
+}
+
+bool
+PtreeJsonHandler::EndObject()
+{
+  this->_stack.pop_back();
+  this->_arrays.pop_back();
+  return (true);
+}
+
+bool
+PtreeJsonHandler::BeginArray()
+{
+  this->_stack.push_back(this->node());
+  this->_arrays.push_back(true);
+  return (true);
+}
+
+bool
+PtreeJsonHandler::EndArray()
+{
+  this->_stack.pop_back();
+  this->_arrays.pop_back();
+  return (true);
+}
+
+//**********************************************************************
+// Class: DocumentJsonHandler
+//**********************************************************************
+
+DocumentJsonHandler::DocumentJsonHandler(Document& doc_) :
+    _doc(doc_)
+{
+}
+
+DocumentJsonHandler::~DocumentJsonHandler()
+{
+}
+
+Document::Node
+DocumentJsonHandler::node()
+{
+  if (this->_stack.empty())
+  {
+    return (this->_doc.Root());
+  }
+  Document::Node parent = this->_stack.back();
+  if (this->_doc.GetType(parent) == Document::TYPE_ARRAY)
+  {
+    return (this->_doc.Append(parent));
+  }
+  return (this->_doc.Create(parent, this->_key));
+}
+
+bool
+DocumentJsonHandler::Null()
+{
+  return (this->_doc.SetNull(this->node()) != Document::NoNode);
+}
+
+bool
+DocumentJsonHandler::Bool(const bool value_)
+{
+  return (this->_doc.SetValue(this->node(), value_) != Document::NoNode);
+}
+
+bool
+DocumentJsonHandler::Number(const char* str_, const size_t len_, const bool integer_)
+{
+  std::string str(str_, len_);
+  Document::Node node = this->node();
+  if (integer_)
+  {
+    errno = 0;
+    long long i = strtoll(str.c_str(), NULL, 10);
+    if (!errno)
+    {
+      return (this->_doc.SetValue(node, int64_t(i)) != Document::NoNode);
+    }
+  }
+  return (this->_doc.SetValue(node, strtod(str.c_str(), NULL)) != Document::NoNode);
+}
+
+bool
+DocumentJsonHandler::String(const char* str_, const size_t len_)
+{
+  return (this->_doc.SetValue(this->node(), std::string(str_, len_)) != Document::NoNode);
+}
+
+bool
+DocumentJsonHandler::Key(const char* str_, const size_t len_)
+{
+  this->_key.assign(str_, len_);
+  return (true);
+}
+
+bool
+DocumentJsonHandler::BeginObject()
+{
+  Document::Node node = this->_doc.SetObject(this->node());
+  this->_stack.push_back(node);
+  return (node != Document::NoNode);
+}
+
+bool
+DocumentJsonHandler::EndObject()
+{
+  this->_stack.pop_back();
+  return (true);
+}
+
+bool
+DocumentJsonHandler::BeginArray()
+{
+  Document::Node node = this->_doc.SetArray(this->node());
+  this->_stack.push_back(node);
+  return (node != Document::NoNode);
+}
+
+bool
+DocumentJsonHandler::EndArray()
+{
+  this->_stack.pop_back();
+  return (true);
+}
+
+}
+}
@@ -307,5 +307,75 @@ DataPath::DisplayPath() const
   std::cout << "Path: " << this->Path() << std::endl;
 }
 
+//**********************************************************************
+// Class: CompiledPath
+//**********************************************************************
+
+CompiledPath::CompiledPath(const DataPath& path_) :
+    _path(path_.Path()), _seq(0), _gen(0), _node(NULL)
+{
+  std::list<std::string> keys = path2list(this->_path);
+  this->_keys.assign(keys.begin(), keys.end());
+}
+
+CompiledPath::CompiledPath(const CompiledPath& other_) :
+    _keys(other_._keys), _path(other_._path), _seq(0), _gen(0), _node(NULL)
+{
+}
+
+CompiledPath::~CompiledPath()
+{
+}
+
+const std::vector<std::string>&
+CompiledPath::Keys() const
+{
+  return (this->_keys);
+}
+
+const std::string&
+CompiledPath::Path() const
+{
+  return (this->_path);
+}
+
+pt::ptree*
+CompiledPath::cached(const uint64_t gen_) const
+{
+  // Generation zero is never assigned to a tree
+  if (!gen_)
+  {
+    return (NULL);
+  }
+  uint32_t seq = this->_seq.load(std::memory_order_acquire);
+  if (seq & 1)
+  {
+    return (NULL);
+  }
+  uint64_t gen = this->_gen.load(std::memory_order_relaxed);
+  pt::ptree* node = this->_node.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if ((seq != this->_seq.load(std::memory_order_relaxed)) || (gen != gen_))
+  {
+    return (NULL);
+  }
+  return (node);
+}
+
+void
+CompiledPath::cache(const uint64_t gen_, pt::ptree* node_) const
+{
+  // Only one writer at a time; a concurrent writer simply skips caching
+  uint32_t seq = this->_seq.load(std::memory_order_relaxed);
+  if ((seq & 1) || !this->_seq.compare_exchange_strong(seq, (seq + 1), std::memory_order_acquire))
+  {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  this->_gen.store(gen_, std::memory_order_relaxed);
+  this->_node.store(node_, std::memory_order_relaxed);
+  this->_seq.store((seq + 2), std::memory_order_release);
+}
+
 }
 }
@@ -56,6 +56,10 @@ Event::notifyHandlers(SHARED_PTR(zEvent::Notification) noti_)
 {
   bool status = false;
 
+  // Sample the clock only when instrumentation is on; includes time spent waiting on the lock
+  Statistics& stats = Statistics::Instance();
+  uint64_t start = stats.IsEnabled() ? MonotonicNsecs() : 0;
+
   if (this->_event_lock.Lock())
   {
     status = true;
@@ -69,6 +73,12 @@ Event::notifyHandlers(SHARED_PTR(zEvent::Notification) noti_)
     this->_event_lock.Unlock();
 
   }
+
+  if (start)
+  {
+    stats.GetEventHistogram(this->_type).Record(MonotonicNsecs() - start);
+  }
+
   return (status);
 }
 
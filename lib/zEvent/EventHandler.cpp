@@ -39,6 +39,7 @@ Handler::~Handler()
     event->unregisterHandler(this);
   }
   this->_event_list.clear();
+  this->_obs_stats.clear();
 }
 
 bool
@@ -78,6 +79,7 @@ Handler::RegisterObserver(Observer *obs_)
     // Register observer
     this->_obs_list.push_back(obs_);
     this->_obs_list.unique();
+    this->_obs_stats[obs_] = Statistics::Instance().attachObserver(obs_);
     status = true;
     this->_event_lock.Unlock();
   }
@@ -92,6 +94,7 @@ Handler::UnregisterObserver(Observer *obs_)
   {
     // Unregister observer
     this->_obs_list.remove(obs_);
+    this->_obs_stats.erase(obs_);
     status = true;
     this->_event_lock.Unlock();
   }
@@ -110,9 +113,23 @@ Handler::notifyObservers(SHARED_PTR(zEvent::Notification) noti_)
   {
     status = true;
 
+    bool enabled = Statistics::Instance().IsEnabled();
     FOREACH (auto& obs, this->_obs_list)
     {
-      status &= obs->ObserveEvent(noti_);
+      if (enabled)
+      {
+        uint64_t start = MonotonicNsecs();
+        status &= obs->ObserveEvent(noti_);
+        auto it = this->_obs_stats.find(obs);
+        if ((it != this->_obs_stats.end()) && it->second)
+        {
+          it->second->Record(MonotonicNsecs() - start);
+        }
+      }
+      else
+      {
+        status &= obs->ObserveEvent(noti_);
+      }
     }
 
     this->_event_lock.Unlock();
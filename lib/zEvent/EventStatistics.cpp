@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <cxxabi.h>
+
+#include <typeinfo>
+#include <sstream>
+
+#include <zutils/zCompatibility.h>
+#include <zutils/zEvent.h>
+
+namespace zUtils
+{
+namespace zEvent
+{
+
+static const char* _type_names[Event::TYPE_LAST] =
+{
+  "none",
+  "test",
+  "timer",
+  "signal",
+  "config",
+  "gpio",
+  "serial",
+  "interface",
+  "socket",
+  "msg",
+  "temp",
+  "command"
+};
+
+static unsigned int
+_index(const uint64_t value_)
+{
+  if (value_ < Histogram::SubBuckets)
+  {
+    return (value_);
+  }
+  unsigned int msb = (63 - __builtin_clzll(value_));
+  if (msb >= Histogram::MaxValueBits)
+  {
+    return (Histogram::Buckets - 1);
+  }
+  unsigned int shift = (msb - Histogram::SubBucketBits);
+  return (((shift + 1) << Histogram::SubBucketBits) + ((value_ >> shift) - Histogram::SubBuckets));
+}
+
+static uint64_t
+_value(const unsigned int index_)
+{
+  // Returns the highest value that maps to the given bucket
+  if (index_ < Histogram::SubBuckets)
+  {
+    return (index_);
+  }
+  unsigned int shift = ((index_ >> Histogram::SubBucketBits) - 1);
+  uint64_t sub = ((index_ & (Histogram::SubBuckets - 1)) + Histogram::SubBuckets);
+  return ((sub << shift) + ((uint64_t(1) << shift) - 1));
+}
+
+static std::string
+_demangle(const char* name_)
+{
+  std::string name(name_);
+  int status = -1;
+  char* str = abi::__cxa_demangle(name_, NULL, NULL, &status);
+  if (str && (status == 0))
+  {
+    name = str;
+  }
+  free(str);
+  return (name);
+}
+
+//**********************************************************************
+// Class: Histogram
+//**********************************************************************
+
+const unsigned int Histogram::SubBucketBits;
+const unsigned int Histogram::SubBuckets;
+const unsigned int Histogram::MaxValueBits;
+const unsigned int Histogram::Buckets;
+
+Histogram::Histogram()
+{
+  this->Reset();
+}
+
+Histogram::~Histogram()
+{
+}
+
+void
+Histogram::Record(const uint64_t value_)
+{
+  this->_buckets[_index(value_)].fetch_add(1, std::memory_order_relaxed);
+  this->_count.fetch_add(1, std::memory_order_relaxed);
+  this->_sum.fetch_add(value_, std::memory_order_relaxed);
+
+  uint64_t min = this->_min.load(std::memory_order_relaxed);
+  while ((value_ < min) && !this->_min.compare_exchange_weak(min, value_, std::memory_order_relaxed))
+    ;
+  uint64_t max = this->_max.load(std::memory_order_relaxed);
+  while ((value_ > max) && !this->_max.compare_exchange_weak(max, value_, std::memory_order_relaxed))
+    ;
+}
+
+uint64_t
+Histogram::Count() const
+{
+  return (this->_count.load(std::memory_order_relaxed));
+}
+
+uint64_t
+Histogram::Min() const
+{
+  return (this->Count() ? this->_min.load(std::memory_order_relaxed) : 0);
+}
+
+uint64_t
+Histogram::Max() const
+{
+  return (this->_max.load(std::memory_order_relaxed));
+}
+
+uint64_t
+Histogram::Mean() const
+{
+  uint64_t count = this->Count();
+  return (count ? (this->_sum.load(std::memory_order_relaxed) / count) : 0);
+}
+
+uint64_t
+Histogram::Percentile(const double pct_) const
+{
+  // Snapshot the buckets first so the walk is consistent with its own total
+  uint64_t counts[Histogram::Buckets];
+  uint64_t total = 0;
+  for (unsigned int i = 0; i < Histogram::Buckets; i++)
+  {
+    counts[i] = this->_buckets[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0)
+  {
+    return (0);
+  }
+
+  double pct = (pct_ < 0.0) ? 0.0 : ((pct_ > 100.0) ? 100.0 : pct_);
+  uint64_t target = uint64_t((pct / 100.0) * total + 0.5);
+  if (target == 0)
+  {
+    target = 1;
+  }
+
+  uint64_t seen = 0;
+  for (unsigned int i = 0; i < Histogram::Buckets; i++)
+  {
+    seen += counts[i];
+    if (seen >= target)
+    {
+      // The last bucket also holds everything beyond its range
+      uint64_t max = this->Max();
+      uint64_t value = (i == (Histogram::Buckets - 1)) ? max : _value(i);
+      return ((value > max) ? max : value);
+    }
+  }
+  return (this->Max());
+}
+
+void
+Histogram::Reset()
+{
+  // Note: not atomic with respect to concurrent recorders; a sample
+  //   recorded during a reset may be partially counted
+  for (unsigned int i = 0; i < Histogram::Buckets; i++)
+  {
+    this->_buckets[i].store(0, std::memory_order_relaxed);
+  }
+  this->_count.store(0, std::memory_order_relaxed);
+  this->_sum.store(0, std::memory_order_relaxed);
+  this->_min.store(UINT64_MAX, std::memory_order_relaxed);
+  this->_max.store(0, std::memory_order_relaxed);
+}
+
+//**********************************************************************
+// Class: Statistics
+//**********************************************************************
+
+Statistics::Statistics() :
+    _enabled(false)
+{
+  this->_lock.Unlock();
+}
+
+bool
+Statistics::IsEnabled() const
+{
+  return (this->_enabled.load(std::memory_order_relaxed));
+}
+
+void
+Statistics::Enable()
+{
+  this->_enabled = true;
+}
+
+void
+Statistics::Disable()
+{
+  this->_enabled = false;
+}
+
+Histogram&
+Statistics::GetEventHistogram(const Event::TYPE type_)
+{
+  if ((type_ < Event::TYPE_NONE) || (type_ >= Event::TYPE_LAST))
+  {
+    return (this->_events[Event::TYPE_NONE]);
+  }
+  return (this->_events[type_]);
+}
+
+std::map<std::string, SHARED_PTR(Histogram)>
+Statistics::GetObserverHistograms()
+{
+  std::map<std::string, SHARED_PTR(Histogram)> hists;
+  if (this->_lock.Lock())
+  {
+    FOREACH (auto& obs, this->_observers)
+    {
+      char addr[32] = { 0 };
+      snprintf(addr, sizeof(addr), "@%p", (void*) obs.first);
+      hists[obs.second.first + std::string(addr)] = obs.second.second;
+    }
+    this->_lock.Unlock();
+  }
+  return (hists);
+}
+
+static void
+_dump(std::stringstream& ss_, const std::string& name_, const Histogram& hist_)
+{
+  ss_ << name_ << ": count=" << hist_.Count() << " min=" << hist_.Min() << " mean=" << hist_.Mean()
+      << " p50=" << hist_.Percentile(50.0) << " p99=" << hist_.Percentile(99.0)
+      << " p999=" << hist_.Percentile(99.9) << " max=" << hist_.Max() << std::endl;
+}
+
+std::string
+Statistics::Dump()
+{
+  std::stringstream ss;
+  ss << "Event latency (ns): " << (this->IsEnabled() ? "enabled" : "disabled") << std::endl;
+  for (int type = Event::TYPE_NONE; type < Event::TYPE_LAST; type++)
+  {
+    if (this->_events[type].Count())
+    {
+      _dump(ss, std::string("event.") + _type_names[type], this->_events[type]);
+    }
+  }
+  FOREACH (auto& obs, this->GetObserverHistograms())
+  {
+    if (obs.second->Count())
+    {
+      _dump(ss, std::string("observer.") + obs.first, *obs.second);
+    }
+  }
+  return (ss.str());
+}
+
+void
+Statistics::Reset()
+{
+  for (int type = Event::TYPE_NONE; type < Event::TYPE_LAST; type++)
+  {
+    this->_events[type].Reset();
+  }
+  if (this->_lock.Lock())
+  {
+    // Drop histograms of observers no longer registered with any handler
+    auto it = this->_observers.begin();
+    while (it != this->_observers.end())
+    {
+      if (it->second.second.use_count() == 1)
+      {
+        it = this->_observers.erase(it);
+      }
+      else
+      {
+        it->second.second->Reset();
+        ++it;
+      }
+    }
+    this->_lock.Unlock();
+  }
+}
+
+SHARED_PTR(Histogram)
+Statistics::attachObserver(Observer* obs_)
+{
+  SHARED_PTR(Histogram) hist;
+  if (obs_ && this->_lock.Lock())
+  {
+    // Share the histogram when an observer is registered with several handlers;
+    //   replace a stale entry left behind by a destroyed observer at the same address
+    auto it = this->_observers.find(obs_);
+    if ((it != this->_observers.end()) && (it->second.second.use_count() > 1))
+    {
+      hist = it->second.second;
+    }
+    else
+    {
+      hist = SHARED_PTR(Histogram)(new Histogram);
+      this->_observers[obs_] = std::make_pair(_demangle(typeid(*obs_).name()), hist);
+    }
+    this->_lock.Unlock();
+  }
+  return (hist);
+}
+
+}
+}
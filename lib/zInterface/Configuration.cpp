@@ -282,7 +282,18 @@ const std::string ConfigData::ConfigPromiscuousModeDisable("DISABLE");
 const std::string ConfigData::ConfigPromiscuousModeDefault(ConfigData::ConfigPromiscuousModeNone);
 
 ConfigData::ConfigData(const std::string& name_) :
-    _data(NULL)
+    _data(NULL),
+    _ifindex(ConfigPath(ConfigPath::ConfigIfIndexPath)),
+    _masterifindex(ConfigPath(ConfigPath::ConfigMasterIfIndexPath)),
+    _ifname(ConfigPath(ConfigPath::ConfigIfNamePath)),
+    _masterifname(ConfigPath(ConfigPath::ConfigMasterIfNamePath)),
+    _iftype(ConfigPath(ConfigPath::ConfigIfTypePath)),
+    _mtu(ConfigPath(ConfigPath::ConfigMtuPath)),
+    _hwaddr(ConfigPath(ConfigPath::ConfigHwAddressPath)),
+    _ipaddr(ConfigPath(ConfigPath::ConfigIpAddressPath)),
+    _netmask(ConfigPath(ConfigPath::ConfigNetmaskPath)),
+    _adminstate(ConfigPath(ConfigPath::ConfigAdminStatePath)),
+    _promiscuousmode(ConfigPath(ConfigPath::ConfigPromiscuousModePath))
 {
   ZLOG_DEBUG("zInterface::ConfigData::ConfigData(name_)");
   SHARED_PTR(zConfig::ConfigData) data(new zConfig::ConfigData(ConfigPath::ConfigRoot));
@@ -291,7 +302,18 @@ ConfigData::ConfigData(const std::string& name_) :
 }
 
 ConfigData::ConfigData(SHARED_PTR(zConfig::ConfigData) data_) :
-    _data(NULL)
+    _data(NULL),
+    _ifindex(ConfigPath(ConfigPath::ConfigIfIndexPath)),
+    _masterifindex(ConfigPath(ConfigPath::ConfigMasterIfIndexPath)),
+    _ifname(ConfigPath(ConfigPath::ConfigIfNamePath)),
+    _masterifname(ConfigPath(ConfigPath::ConfigMasterIfNamePath)),
+    _iftype(ConfigPath(ConfigPath::ConfigIfTypePath)),
+    _mtu(ConfigPath(ConfigPath::ConfigMtuPath)),
+    _hwaddr(ConfigPath(ConfigPath::ConfigHwAddressPath)),
+    _ipaddr(ConfigPath(ConfigPath::ConfigIpAddressPath)),
+    _netmask(ConfigPath(ConfigPath::ConfigNetmaskPath)),
+    _adminstate(ConfigPath(ConfigPath::ConfigAdminStatePath)),
+    _promiscuousmode(ConfigPath(ConfigPath::ConfigPromiscuousModePath))
 {
   ZLOG_DEBUG("zInterface::ConfigData::ConfigData(data_)");
   this->SetData(data_);
@@ -326,8 +348,7 @@ unsigned int
 ConfigData::GetIfIndex(const unsigned int index_) const
 {
   unsigned int val = 0;
-  ConfigPath path(ConfigPath::ConfigIfIndexPath);
-  if (!this->_data->GetValue(path, val))
+  if (!this->_data->GetValue(this->_ifindex, val))
   {
     val = index_;
   }
@@ -337,16 +358,14 @@ ConfigData::GetIfIndex(const unsigned int index_) const
 bool
 ConfigData::SetIfIndex(const unsigned int index_)
 {
-  ConfigPath path(ConfigPath::ConfigIfIndexPath);
-  return (this->_data->PutValue(path, index_));
+  return (this->_data->PutValue(this->_ifindex, index_));
 }
 
 std::string
 ConfigData::GetIfName(const std::string& name_) const
 {
   std::string str;
-  ConfigPath path(ConfigPath::ConfigIfNamePath);
-  if (!this->_data->GetValue(path, str))
+  if (!this->_data->GetValue(this->_ifname, str))
   {
     str = name_;
   }
@@ -356,16 +375,14 @@ ConfigData::GetIfName(const std::string& name_) const
 bool
 ConfigData::SetIfName(const std::string& name_)
 {
-  ConfigPath path(ConfigPath::ConfigIfNamePath);
-  return (this->_data->PutValue(path, name_));
+  return (this->_data->PutValue(this->_ifname, name_));
 }
 
 unsigned int
 ConfigData::GetMasterIfIndex(const unsigned int index_) const
 {
   unsigned int val = 0;
-  ConfigPath path(ConfigPath::ConfigMasterIfIndexPath);
-  if (!this->_data->GetValue(path, val))
+  if (!this->_data->GetValue(this->_masterifindex, val))
   {
     val = index_;
   }
@@ -375,16 +392,14 @@ ConfigData::GetMasterIfIndex(const unsigned int index_) const
 bool
 ConfigData::SetMasterIfIndex(const unsigned int index_)
 {
-  ConfigPath path(ConfigPath::ConfigMasterIfIndexPath);
-  return (this->_data->PutValue(path, index_));
+  return (this->_data->PutValue(this->_masterifindex, index_));
 }
 
 std::string
 ConfigData::GetMasterIfName(const std::string& name_) const
 {
   std::string str;
-  ConfigPath path(ConfigPath::ConfigMasterIfNamePath);
-  if (!this->_data->GetValue(path, str))
+  if (!this->_data->GetValue(this->_masterifname, str))
   {
     str = name_;
   }
@@ -394,8 +409,7 @@ ConfigData::GetMasterIfName(const std::string& name_) const
 bool
 ConfigData::SetMasterIfName(const std::string& name_)
 {
-  ConfigPath path(ConfigPath::ConfigMasterIfNamePath);
-  return (this->_data->PutValue(path, name_));
+  return (this->_data->PutValue(this->_masterifname, name_));
 }
 
 ConfigData::IFTYPE
@@ -403,10 +417,9 @@ ConfigData::GetIfType(const ConfigData::IFTYPE type_) const
 {
 
   ConfigData::IFTYPE type = type_;
-  ConfigPath path(ConfigPath::ConfigIfTypePath);
   std::string str;
 
-  if (this->_data->GetValue(path, str))
+  if (this->_data->GetValue(this->_iftype, str))
   {
     type = _str2iftype(str);
   }
@@ -417,9 +430,8 @@ ConfigData::GetIfType(const ConfigData::IFTYPE type_) const
 bool
 ConfigData::SetIfType(const ConfigData::IFTYPE type_)
 {
-  ConfigPath path(ConfigPath::ConfigIfTypePath);
   std::string str = _iftype2str(type_);
-  return (this->_data->PutValue(path, str));
+  return (this->_data->PutValue(this->_iftype, str));
 
 }
 
@@ -427,8 +439,7 @@ unsigned int
 ConfigData::GetMtu(const unsigned int mtu_) const
 {
   unsigned int val = 0;
-  ConfigPath path(ConfigPath::ConfigMtuPath);
-  if (!this->_data->GetValue(path, val))
+  if (!this->_data->GetValue(this->_mtu, val))
   {
     val = mtu_;
   }
@@ -438,16 +449,14 @@ ConfigData::GetMtu(const unsigned int mtu_) const
 bool
 ConfigData::SetMtu(const unsigned int mtu_)
 {
-  ConfigPath path(ConfigPath::ConfigMtuPath);
-  return (this->_data->PutValue(path, mtu_));
+  return (this->_data->PutValue(this->_mtu, mtu_));
 }
 
 std::string
 ConfigData::GetHwAddress(const std::string& addr_) const
 {
   std::string str;
-  ConfigPath path(ConfigPath::ConfigHwAddressPath);
-  if (!this->_data->GetValue(path, str))
+  if (!this->_data->GetValue(this->_hwaddr, str))
   {
     str = addr_;
   }
@@ -457,16 +466,14 @@ ConfigData::GetHwAddress(const std::string& addr_) const
 bool
 ConfigData::SetHwAddress(const std::string& addr_)
 {
-  ConfigPath path(ConfigPath::ConfigHwAddressPath);
-  return (this->_data->PutValue(path, addr_));
+  return (this->_data->PutValue(this->_hwaddr, addr_));
 }
 
 std::string
 ConfigData::GetIpAddress(const std::string& addr_) const
 {
   std::string str;
-  ConfigPath path(ConfigPath::ConfigIpAddressPath);
-  if (!this->_data->GetValue(path, str))
+  if (!this->_data->GetValue(this->_ipaddr, str))
   {
     str = addr_;
   }
@@ -476,16 +483,14 @@ ConfigData::GetIpAddress(const std::string& addr_) const
 bool
 ConfigData::SetIpAddress(const std::string& addr_)
 {
-  ConfigPath path(ConfigPath::ConfigIpAddressPath);
-  return (this->_data->PutValue(path, addr_));
+  return (this->_data->PutValue(this->_ipaddr, addr_));
 }
 
 std::string
 ConfigData::GetNetmask(const std::string& addr_) const
 {
   std::string str;
-  ConfigPath path(ConfigPath::ConfigNetmaskPath);
-  if (!this->_data->GetValue(path, str))
+  if (!this->_data->GetValue(this->_netmask, str))
   {
     str = addr_;
   }
@@ -495,17 +500,15 @@ ConfigData::GetNetmask(const std::string& addr_) const
 bool
 ConfigData::SetNetmask(const std::string& addr_)
 {
-  ConfigPath path(ConfigPath::ConfigNetmaskPath);
-  return (this->_data->PutValue(path, addr_));
+  return (this->_data->PutValue(this->_netmask, addr_));
 }
 
 ConfigData::STATE
 ConfigData::GetAdminState(const ConfigData::STATE state_) const
 {
   ConfigData::STATE state = state_;
-  ConfigPath path(ConfigPath::ConfigAdminStatePath);
   std::string str;
-  if (this->_data->GetValue(path, str))
+  if (this->_data->GetValue(this->_adminstate, str))
   {
     state = _str2state(str);
   }
@@ -515,18 +518,16 @@ ConfigData::GetAdminState(const ConfigData::STATE state_) const
 bool
 ConfigData::SetAdminState(const ConfigData::STATE state_)
 {
-  ConfigPath path(ConfigPath::ConfigAdminStatePath);
   std::string str = _state2str(state_);
-  return (this->_data->PutValue(path, str));
+  return (this->_data->PutValue(this->_adminstate, str));
 }
 
 ConfigData::PROMODE
 ConfigData::GetPromiscuousMode(const ConfigData::PROMODE mode_) const
 {
   ConfigData::PROMODE mode = mode_;
-  ConfigPath path(ConfigPath::ConfigPromiscuousModePath);
   std::string str;
-  if (this->_data->GetValue(path, str))
+  if (this->_data->GetValue(this->_promiscuousmode, str))
   {
     mode = _str2promode(str);
   }
@@ -536,9 +537,8 @@ ConfigData::GetPromiscuousMode(const ConfigData::PROMODE mode_) const
 bool
 ConfigData::SetPromiscuousMode(const ConfigData::PROMODE mode_)
 {
-  ConfigPath path(ConfigPath::ConfigPromiscuousModePath);
   std::string str = _promode2str(mode_);
-  return (this->_data->PutValue(path, str));
+  return (this->_data->PutValue(this->_promiscuousmode, str));
 }
 
 }
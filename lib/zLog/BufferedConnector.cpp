@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <spawn.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+
+#include <zutils/zLog.h>
+
+extern char **environ;
+
+namespace zUtils
+{
+namespace zLog
+{
+
+//*****************************************************************************
+// Class: FileCompressor
+//*****************************************************************************
+
+FileCompressor::FileCompressor() :
+    _thread(this, NULL)
+{
+}
+
+FileCompressor::~FileCompressor()
+{
+  this->_thread.Stop();
+}
+
+bool
+FileCompressor::Compress(const std::string& file_)
+{
+  bool status = false;
+  if (!file_.empty() && this->_file_queue.Push(file_))
+  {
+    status = true;
+    this->_thread.Start();
+  }
+  return (status);
+}
+
+void
+FileCompressor::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_file_queue.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<struct pollfd> fds;
+
+    // Wait on file descriptor set
+    this->Poll(fds);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_file_queue.GetFd()) && (fd.revents == POLLIN))
+      {
+        if (this->_file_queue.TryWait())
+        {
+          std::string file = this->_file_queue.Front();
+          this->_file_queue.Pop();
+
+          // Hand the rotated file to gzip; it replaces 'file' with 'file.gz'
+          pid_t pid = 0;
+          char *argv[] = { (char*) "gzip", (char*) "-f", (char*) file.c_str(), NULL };
+          if (posix_spawnp(&pid, "gzip", NULL, NULL, argv, environ) == 0)
+          {
+            int wstatus = 0;
+            waitpid(pid, &wstatus, 0);
+          }
+        }
+      }
+    }
+
+  }
+
+  this->UnregisterFd(this->_file_queue.GetFd());
+
+  return;
+
+}
+
+//*****************************************************************************
+// Class: BufferedFileConnector
+//*****************************************************************************
+
+const size_t BufferedFileConnector::DefaultFlushSize = (64 * 1024);
+const uint32_t BufferedFileConnector::DefaultFlushInterval = 1000;
+const size_t BufferedFileConnector::DefaultBufferLimit = (1024 * 1024);
+const unsigned int BufferedFileConnector::DefaultRotateCount = 5;
+
+BufferedFileConnector::BufferedFileConnector(const std::string& logfile_) :
+    _path(logfile_), _fd(-1), _file_size(0), _file_opened(0),
+    _buf_bytes(0), _dropped(0),
+    _flush_size(DefaultFlushSize), _flush_interval(DefaultFlushInterval),
+    _buf_limit(DefaultBufferLimit), _rotate_size(0), _rotate_interval(0),
+    _rotate_count(DefaultRotateCount), _compress(false),
+    _thread(this, this)
+{
+  if (this->_open())
+  {
+    this->Logger("************************************************************");
+    this->Logger("* Logging started");
+    this->Logger("************************************************************");
+  }
+  this->_buf_lock.Unlock();
+  this->_write_lock.Unlock();
+  this->_thread.Start();
+}
+
+BufferedFileConnector::~BufferedFileConnector()
+{
+  this->_thread.Stop();
+  this->Logger("************************************************************");
+  this->Logger("* Logging stopped");
+  this->Logger("************************************************************");
+  this->Flush();
+  this->_write_lock.Lock();
+  this->_close();
+}
+
+size_t
+BufferedFileConnector::GetFlushSize()
+{
+  return (this->_flush_size);
+}
+
+bool
+BufferedFileConnector::SetFlushSize(const size_t bytes_)
+{
+  bool status = false;
+  if (bytes_ && this->_buf_lock.Lock())
+  {
+    this->_flush_size = bytes_;
+    status = this->_buf_lock.Unlock();
+  }
+  return (status);
+}
+
+uint32_t
+BufferedFileConnector::GetFlushInterval()
+{
+  return (this->_flush_interval);
+}
+
+bool
+BufferedFileConnector::SetFlushInterval(const uint32_t msec_)
+{
+  bool status = false;
+  if (msec_ && this->_buf_lock.Lock())
+  {
+    this->_flush_interval = msec_;
+    status = this->_buf_lock.Unlock();
+  }
+  return (status);
+}
+
+size_t
+BufferedFileConnector::GetBufferLimit()
+{
+  return (this->_buf_limit);
+}
+
+bool
+BufferedFileConnector::SetBufferLimit(const size_t bytes_)
+{
+  bool status = false;
+  if (bytes_ && this->_buf_lock.Lock())
+  {
+    this->_buf_limit = bytes_;
+    status = this->_buf_lock.Unlock();
+  }
+  return (status);
+}
+
+size_t
+BufferedFileConnector::GetRotateSize()
+{
+  return (this->_rotate_size);
+}
+
+bool
+BufferedFileConnector::SetRotateSize(const size_t bytes_)
+{
+  bool status = false;
+  if (this->_write_lock.Lock())
+  {
+    this->_rotate_size = bytes_;
+    status = this->_write_lock.Unlock();
+  }
+  return (status);
+}
+
+uint32_t
+BufferedFileConnector::GetRotateInterval()
+{
+  return (this->_rotate_interval);
+}
+
+bool
+BufferedFileConnector::SetRotateInterval(const uint32_t sec_)
+{
+  bool status = false;
+  if (this->_write_lock.Lock())
+  {
+    this->_rotate_interval = sec_;
+    status = this->_write_lock.Unlock();
+  }
+  return (status);
+}
+
+unsigned int
+BufferedFileConnector::GetRotateCount()
+{
+  return (this->_rotate_count);
+}
+
+bool
+BufferedFileConnector::SetRotateCount(const unsigned int count_)
+{
+  bool status = false;
+  if (count_ && this->_write_lock.Lock())
+  {
+    this->_rotate_count = count_;
+    status = this->_write_lock.Unlock();
+  }
+  return (status);
+}
+
+bool
+BufferedFileConnector::GetCompress()
+{
+  return (this->_compress);
+}
+
+bool
+BufferedFileConnector::SetCompress(const bool flag_)
+{
+  bool status = false;
+  if (this->_write_lock.Lock())
+  {
+    this->_compress = flag_;
+    status = this->_write_lock.Unlock();
+  }
+  return (status);
+}
+
+uint64_t
+BufferedFileConnector::GetDropped()
+{
+  uint64_t dropped = 0;
+  if (this->_buf_lock.Lock())
+  {
+    dropped = this->_dropped;
+    this->_buf_lock.Unlock();
+  }
+  return (dropped);
+}
+
+bool
+BufferedFileConnector::Flush()
+{
+  bool status = false;
+  if (this->_write_lock.Lock())
+  {
+    status = this->_flush();
+    this->_write_lock.Unlock();
+  }
+  return (status);
+}
+
+void
+BufferedFileConnector::Logger(std::string msg_)
+{
+  bool post = false;
+  msg_ += "\n";
+  if (this->_buf_lock.Lock())
+  {
+    // Never block or grow without bound; drop and account for it instead
+    if ((this->_buf_bytes + msg_.size()) > this->_buf_limit)
+    {
+      this->_dropped++;
+    }
+    else
+    {
+      post = (this->_buf_bytes < this->_flush_size);
+      this->_buf_bytes += msg_.size();
+      this->_buf.push_back(MOVE(msg_));
+      post &= (this->_buf_bytes >= this->_flush_size);
+    }
+    this->_buf_lock.Unlock();
+  }
+
+  // Wake the writer only when the flush threshold is first crossed
+  if (post)
+  {
+    this->_flush_sem.Post();
+  }
+}
+
+void
+BufferedFileConnector::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_flush_sem.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<struct pollfd> fds;
+
+    // Wait for the flush threshold or the flush interval, whichever comes first
+    this->Poll(fds, this->_flush_interval);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+      }
+      else if ((fd.fd == this->_flush_sem.GetFd()) && (fd.revents == POLLIN))
+      {
+        this->_flush_sem.TryWait();
+      }
+    }
+
+    if (!exit)
+    {
+      this->Flush();
+    }
+
+  }
+
+  this->UnregisterFd(this->_flush_sem.GetFd());
+
+  return;
+
+}
+
+bool
+BufferedFileConnector::_open()
+{
+  bool status = false;
+  this->_fd = open(this->_path.c_str(), (O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC), 0644);
+  if (this->_fd >= 0)
+  {
+    struct stat st = { 0 };
+    this->_file_size = (fstat(this->_fd, &st) == 0) ? st.st_size : 0;
+    this->_file_opened = time_t(MonotonicMsecs() / 1000);
+    status = true;
+  }
+  else
+  {
+    fprintf(stderr, "Cannot open log file '%s': %s\n", this->_path.c_str(), strerror(errno));
+  }
+  return (status);
+}
+
+void
+BufferedFileConnector::_close()
+{
+  if (this->_fd >= 0)
+  {
+    close(this->_fd);
+    this->_fd = -1;
+  }
+}
+
+// Note: caller must hold the write lock
+bool
+BufferedFileConnector::_flush()
+{
+  bool status = true;
+  uint64_t dropped = 0;
+
+  // Swap out the producer buffer; producers only ever wait on this exchange
+  if (this->_buf_lock.Lock())
+  {
+    this->_pending.swap(this->_buf);
+    this->_buf_bytes = 0;
+    dropped = this->_dropped;
+    this->_dropped = 0;
+    this->_buf_lock.Unlock();
+  }
+
+  if (dropped)
+  {
+    this->_pending.push_back("* Dropped " + ZLOG_ULONG(dropped) + " messages\n");
+  }
+
+  if (!this->_pending.empty())
+  {
+    status = this->_write(this->_pending);
+    this->_pending.clear();
+  }
+
+  // Rotate once the active file has grown too large or too old
+  if (((this->_rotate_size != 0) && (this->_file_size >= this->_rotate_size)) ||
+      ((this->_rotate_interval != 0) && (this->_file_size != 0) &&
+          ((time_t(MonotonicMsecs() / 1000) - this->_file_opened) >= time_t(this->_rotate_interval))))
+  {
+    status &= this->_rotate();
+  }
+
+  return (status);
+}
+
+bool
+BufferedFileConnector::_write(std::vector<std::string>& buf_)
+{
+  bool status = true;
+  std::vector<struct iovec> iov;
+  iov.reserve(std::min(buf_.size(), size_t(IOV_MAX)));
+
+  size_t next = 0;
+  while ((this->_fd >= 0) && (next < buf_.size()))
+  {
+    // Gather up to IOV_MAX messages into a single system call
+    iov.clear();
+    size_t bytes = 0;
+    for (; (next < buf_.size()) && (iov.size() < IOV_MAX); next++)
+    {
+      struct iovec v = { (void*) buf_[next].data(), buf_[next].size() };
+      iov.push_back(v);
+      bytes += v.iov_len;
+    }
+
+    // Write, resuming where a short write left off
+    size_t index = 0;
+    while (bytes)
+    {
+      ssize_t n = writev(this->_fd, &iov[index], int(iov.size() - index));
+      if (n < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        fprintf(stderr, "Cannot write log file '%s': %s\n", this->_path.c_str(), strerror(errno));
+        return (false);
+      }
+      this->_file_size += n;
+      bytes -= n;
+      while (n && (size_t(n) >= iov[index].iov_len))
+      {
+        n -= iov[index].iov_len;
+        index++;
+      }
+      if (n)
+      {
+        iov[index].iov_base = (char*) iov[index].iov_base + n;
+        iov[index].iov_len -= n;
+      }
+    }
+  }
+
+  return (status);
+}
+
+// Note: caller must hold the write lock
+bool
+BufferedFileConnector::_rotate()
+{
+  this->_close();
+
+  // Shift older generations: <log>.N-1 -> <log>.N, ..., <log>.1 -> <log>.2
+  for (unsigned int i = this->_rotate_count; i > 1; i--)
+  {
+    std::string src = this->_path + "." + ZLOG_UINT(i - 1);
+    std::string dst = this->_path + "." + ZLOG_UINT(i);
+    rename(src.c_str(), dst.c_str());
+    rename((src + ".gz").c_str(), (dst + ".gz").c_str());
+  }
+
+  // Retire the active file and hand it off for compression if requested
+  std::string rotated = this->_path + ".1";
+  if (rename(this->_path.c_str(), rotated.c_str()) == 0)
+  {
+    if (this->_compress)
+    {
+      this->_compressor.Compress(rotated);
+    }
+  }
+
+  return (this->_open());
+}
+
+}
+}
@@ -22,6 +22,19 @@ namespace zUtils
 namespace zLog
 {
 
+//*****************************************************************************
+// Class: Connector
+//*****************************************************************************
+
+void
+Connector::LogMessage(const SHARED_PTR(Message)& msg_)
+{
+  if (msg_)
+  {
+    this->Logger(msg_->Str());
+  }
+}
+
 //*****************************************************************************
 // Class: FileConnector
 //*****************************************************************************
@@ -50,6 +50,12 @@ Log::~Log()
   zLog::Manager::Instance().UnregisterModule(this->_module);
 }
 
+const std::string&
+Log::GetModule() const
+{
+  return (this->_module);
+}
+
 Log::LEVEL
 Log::GetMaxLevel()
 {
@@ -28,7 +28,7 @@ namespace zLog
 //*****************************************************************************
 
 Manager::Manager() :
-    _thread(this, this)
+    _thread(this, this), _limiters_reported(0)
 {
   this->_conn.clear();
   this->_log_lock.Unlock();
@@ -39,6 +39,7 @@ Manager::~Manager()
   this->_thread.Stop();
   this->_log_lock.Lock();
   this->_conn.clear();
+  this->_limiters.clear();
   this->_mod_refcnt.clear();
   this->_max_level.clear();
 }
@@ -155,6 +156,50 @@ Manager::logMessage(const SHARED_PTR(zLog::Message)& message_)
   this->_msg_queue.Push(message_);
 }
 
+bool
+Manager::registerLimiter(RateLimiter* limiter_)
+{
+  bool status = false;
+  if (limiter_ && this->_log_lock.Lock())
+  {
+    this->_limiters.push_back(limiter_);
+    status = this->_log_lock.Unlock();
+  }
+  return (status);
+}
+
+bool
+Manager::unregisterLimiter(RateLimiter* limiter_)
+{
+  bool status = false;
+  if (limiter_ && this->_log_lock.Lock())
+  {
+    this->_limiters.remove(limiter_);
+    status = this->_log_lock.Unlock();
+  }
+  return (status);
+}
+
+void
+Manager::reportLimiters()
+{
+  uint64_t now = MonotonicNsecs();
+
+  // Sweep at most every 100ms so a message flood does not turn into a limiter walk per message
+  if ((now - this->_limiters_reported) >= 100000000)
+  {
+    this->_limiters_reported = now;
+    if (this->_log_lock.TimedLock(100))
+    {
+      FOREACH (auto& limiter, this->_limiters)
+      {
+        limiter->report(now);
+      }
+      this->_log_lock.Unlock();
+    }
+  }
+}
+
 void
 Manager::Run(zThread::ThreadArg *arg_)
 {
@@ -164,6 +209,9 @@ Manager::Run(zThread::ThreadArg *arg_)
   while (!this->Exit())
   {
 
+    // Log summaries for rate limited call sites that suppressed messages
+    this->reportLimiters();
+
     if (!this->_msg_queue.TimedWait(100))
     {
       continue;
@@ -181,15 +229,7 @@ Manager::Run(zThread::ThreadArg *arg_)
       {
         if (this->_conn.count(Log::LEVEL(level)) && this->_conn[Log::LEVEL(level)])
         {
-          std::stringstream ss;
-          ss << msg->GetTimestamp() << "\t";
-          ss << msg->GetProcessId() << "\t";
-          ss << msg->GetThreadId() << "\t";
-          ss << msg->GetModule() << "\t";
-          ss << Log::ToString(msg->GetLevel()) << "\t";
-          ss << msg->GetFile() << "[" << msg->GetLine() << "]\t";
-          ss << msg->GetMessage() << "\t";
-          this->_conn[level]->Logger(ss.str());
+          this->_conn[level]->LogMessage(msg);
         }
       }
       this->_log_lock.Unlock();
@@ -18,6 +18,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 #include <system_error>
@@ -29,6 +30,46 @@ namespace zUtils
 namespace zLog
 {
 
+static void
+_json_escape(std::string& out_, const std::string& str_)
+{
+  out_ += '"';
+  FOREACH (const char& c, str_)
+  {
+    switch (c)
+    {
+    case '"':
+      out_ += "\\\"";
+      break;
+    case '\\':
+      out_ += "\\\\";
+      break;
+    case '\n':
+      out_ += "\\n";
+      break;
+    case '\r':
+      out_ += "\\r";
+      break;
+    case '\t':
+      out_ += "\\t";
+      break;
+    default:
+      if ((unsigned char) c < 0x20)
+      {
+        char esc[8];
+        snprintf(esc, sizeof(esc), "\\u%04x", (unsigned int) c);
+        out_ += esc;
+      }
+      else
+      {
+        out_ += c;
+      }
+      break;
+    }
+  }
+  out_ += '"';
+}
+
 //*****************************************************************************
 // Class: Message
 //*****************************************************************************
@@ -131,5 +172,142 @@ Message::AddMessage(const std::string &message_)
   this->_message += message_;
 }
 
+const std::vector<Message::KeyValue>&
+Message::GetFields() const
+{
+  return (this->_fields);
+}
+
+Message&
+Message::Field(const std::string& key_, const std::string& value_)
+{
+  Message::KeyValue kv = { key_, value_, true };
+  this->_fields.push_back(kv);
+  return (*this);
+}
+
+Message&
+Message::Field(const std::string& key_, const char* value_)
+{
+  return (this->Field(key_, std::string(value_ ? value_ : "")));
+}
+
+Message&
+Message::Field(const std::string& key_, const int value_)
+{
+  Message::KeyValue kv = { key_, ZLOG_INT(value_), false };
+  this->_fields.push_back(kv);
+  return (*this);
+}
+
+Message&
+Message::Field(const std::string& key_, const unsigned int value_)
+{
+  Message::KeyValue kv = { key_, ZLOG_UINT(value_), false };
+  this->_fields.push_back(kv);
+  return (*this);
+}
+
+Message&
+Message::Field(const std::string& key_, const long value_)
+{
+  Message::KeyValue kv = { key_, ZLOG_LONG(value_), false };
+  this->_fields.push_back(kv);
+  return (*this);
+}
+
+Message&
+Message::Field(const std::string& key_, const unsigned long value_)
+{
+  Message::KeyValue kv = { key_, ZLOG_ULONG(value_), false };
+  this->_fields.push_back(kv);
+  return (*this);
+}
+
+Message&
+Message::Field(const std::string& key_, const double value_)
+{
+  char str[64];
+  snprintf(str, sizeof(str), "%.17g", value_);
+  // NaN and infinity are not valid JSON numbers
+  Message::KeyValue kv = { key_, str, !std::isfinite(value_) };
+  this->_fields.push_back(kv);
+  return (*this);
+}
+
+Message&
+Message::Field(const std::string& key_, const bool value_)
+{
+  Message::KeyValue kv = { key_, ZLOG_BOOL(value_), false };
+  this->_fields.push_back(kv);
+  return (*this);
+}
+
+std::string
+Message::Str() const
+{
+  std::stringstream ss;
+  ss << this->GetTimestamp() << "\t";
+  ss << this->GetProcessId() << "\t";
+  ss << this->GetThreadId() << "\t";
+  ss << this->GetModule() << "\t";
+  ss << Log::ToString(this->GetLevel()) << "\t";
+  ss << this->GetFile() << "[" << this->GetLine() << "]\t";
+  ss << this->GetMessage() << "\t";
+  FOREACH (const Message::KeyValue& kv, this->_fields)
+  {
+    ss << kv.Key << "=" << kv.Value << "\t";
+  }
+  return (ss.str());
+}
+
+std::string
+Message::GetJson() const
+{
+  // Built directly from the message fields; numeric fields are emitted unquoted
+  std::string json;
+  json.reserve(256 + this->_message.size());
+  json += "{\"timestamp\":";
+  json += this->_time;
+  json += ",\"pid\":";
+  json += this->_proc;
+  json += ",\"tid\":";
+  _json_escape(json, this->_thread);
+  json += ",\"module\":";
+  _json_escape(json, this->_module);
+  json += ",\"level\":";
+  _json_escape(json, Log::ToString(this->_level));
+  json += ",\"file\":";
+  _json_escape(json, this->_file);
+  json += ",\"line\":";
+  json += (this->_line.empty() ? std::string("0") : this->_line);
+  json += ",\"message\":";
+  _json_escape(json, this->_message);
+  if (!this->_fields.empty())
+  {
+    json += ",\"fields\":{";
+    for (size_t i = 0; i < this->_fields.size(); i++)
+    {
+      if (i)
+      {
+        json += ',';
+      }
+      _json_escape(json, this->_fields[i].Key);
+      json += ':';
+      if (this->_fields[i].Quoted)
+      {
+        _json_escape(json, this->_fields[i].Value);
+      }
+      else
+      {
+        json += this->_fields[i].Value;
+      }
+    }
+    json += '}';
+  }
+  json += '}';
+  return (json);
+}
+
 }
 }
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+
+#include <algorithm>
+
+#include <zutils/zLog.h>
+
+namespace zUtils
+{
+namespace zLog
+{
+
+//*****************************************************************************
+// Class: RateLimiter
+//*****************************************************************************
+
+RateLimiter::RateLimiter(const std::string& module_, const Log::LEVEL level_,
+    const uint32_t count_, const uint32_t period_, const std::string& file_,
+    const unsigned int line_) :
+    _module(module_), _level(level_), _line(line_), _count(count_),
+    _period(uint64_t(period_) * 1000000), _tokens(0), _last(MonotonicNsecs()),
+    _suppressed(0), _reported(_last)
+{
+  this->_file = file_.substr(file_.find_last_of("/") + 1);
+  this->_tokens = (this->_count * this->_period); // start with a full bucket
+  zLog::Manager::Instance().registerLimiter(this);
+}
+
+RateLimiter::~RateLimiter()
+{
+  zLog::Manager::Instance().unregisterLimiter(this);
+}
+
+bool
+RateLimiter::Allow()
+{
+  bool allow = false;
+  uint64_t now = MonotonicNsecs();
+
+  {
+    UNIQUE_LOCK(MUTEX) lock(this->_lock);
+
+    // Refill the bucket for the time elapsed since the last call
+    uint64_t elapsed = (now - this->_last);
+    this->_last = now;
+    if (elapsed >= this->_period)
+    {
+      this->_tokens = (this->_count * this->_period);
+    }
+    else
+    {
+      this->_tokens = std::min((this->_count * this->_period),
+          (this->_tokens + (elapsed * this->_count)));
+    }
+
+    // Each message costs one (scaled) token
+    if (this->_count && (this->_tokens >= this->_period))
+    {
+      this->_tokens -= this->_period;
+      allow = true;
+    }
+  }
+
+  if (!allow)
+  {
+    this->_suppressed++;
+  }
+
+  return (allow);
+}
+
+uint64_t
+RateLimiter::GetSuppressed() const
+{
+  return (this->_suppressed);
+}
+
+bool
+RateLimiter::report(const uint64_t now_)
+{
+  bool status = false;
+
+  // Summarize at most once per period
+  if (this->_suppressed && ((now_ - this->_reported) >= this->_period))
+  {
+    this->_reported = now_;
+    uint64_t cnt = this->_suppressed.exchange(0);
+    if (this->_level <= zLog::Manager::Instance().GetMaxLevel(this->_module))
+    {
+      SHARED_PTR(Message) msg(new Message(this->_module, this->_level));
+      msg->SetFile(this->_file);
+      msg->SetLine(this->_line);
+      msg->AddMessage("Suppressed " + ZLOG_ULONG(cnt) + " messages");
+      zLog::Manager::Instance().logMessage(msg);
+      status = true;
+    }
+  }
+
+  return (status);
+}
+
+//*****************************************************************************
+// Class: Sampler
+//*****************************************************************************
+
+Sampler::Sampler(const uint32_t n_) :
+    _n(n_), _cnt(0)
+{
+}
+
+Sampler::~Sampler()
+{
+}
+
+bool
+Sampler::Allow()
+{
+  return (this->_n && ((this->_cnt++ % this->_n) == 0));
+}
+
+}
+}
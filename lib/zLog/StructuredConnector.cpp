@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <zutils/zLog.h>
+
+namespace zUtils
+{
+namespace zLog
+{
+
+//*****************************************************************************
+// Class: JsonFileConnector
+//*****************************************************************************
+
+JsonFileConnector::JsonFileConnector(const std::string& logfile_) :
+    BufferedFileConnector(logfile_)
+{
+}
+
+JsonFileConnector::~JsonFileConnector()
+{
+}
+
+void
+JsonFileConnector::LogMessage(const SHARED_PTR(Message)& msg_)
+{
+  if (msg_)
+  {
+    this->Logger(msg_->GetJson());
+  }
+}
+
+//*****************************************************************************
+// Class: UnixConnector
+//*****************************************************************************
+
+UnixConnector::UnixConnector(const std::string& path_) :
+    _path(path_), _fd(-1), _connected(false), _dropped(0)
+{
+  this->_fd = socket(AF_UNIX, (SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC), 0);
+  if (this->_fd < 0)
+  {
+    fprintf(stderr, "Cannot create log socket: %s\n", strerror(errno));
+  }
+}
+
+UnixConnector::~UnixConnector()
+{
+  if (this->_fd >= 0)
+  {
+    close(this->_fd);
+    this->_fd = -1;
+  }
+}
+
+uint64_t
+UnixConnector::GetDropped() const
+{
+  return (this->_dropped);
+}
+
+void
+UnixConnector::Logger(std::string msg_)
+{
+  if (this->_fd < 0)
+  {
+    this->_dropped++;
+    return;
+  }
+
+  // (Re)connect lazily so the collector may start after, or restart under, the logger
+  if (!this->_connected)
+  {
+    struct sockaddr_un addr = { 0 };
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, this->_path.c_str(), (sizeof(addr.sun_path) - 1));
+    this->_connected = (connect(this->_fd, (struct sockaddr*) &addr, sizeof(addr)) == 0);
+  }
+
+  // One record per datagram; never block the log thread on a slow collector
+  if (!this->_connected || (send(this->_fd, msg_.data(), msg_.size(), MSG_DONTWAIT) < 0))
+  {
+    if ((errno == ECONNREFUSED) || (errno == ENOENT) || (errno == ENOTCONN))
+    {
+      this->_connected = false;
+    }
+    this->_dropped++;
+  }
+}
+
+void
+UnixConnector::LogMessage(const SHARED_PTR(Message)& msg_)
+{
+  if (msg_)
+  {
+    this->Logger(msg_->GetJson());
+  }
+}
+
+}
+}
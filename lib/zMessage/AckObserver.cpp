@@ -35,6 +35,8 @@
 #include <zutils/zMessageSocket.h>
 #include <zutils/zAckMessage.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
 namespace zUtils
 {
 namespace zMessage
@@ -44,24 +46,38 @@ namespace zMessage
 // Class: AckObserver
 //**********************************************************************
 
-AckObserver::AckObserver()
+AckObserver::AckObserver() :
+    _lock(zSem::Mutex::LOCKED)
 {
+  this->_lock.Unlock();
 }
 
 AckObserver::~AckObserver()
 {
+  this->_lock.Lock();
 }
 
 bool
 AckObserver::RegisterForAck(const std::string& msg_id_)
 {
-  return(!this->_ack_table[msg_id_].TryWait());
+  bool status = false;
+  if (this->_lock.Lock())
+  {
+    status = !this->_ack_table[msg_id_].TryWait();
+    this->_lock.Unlock();
+  }
+  return (status);
 }
 
 bool
 AckObserver::UnregisterForAck(const std::string& msg_id_)
 {
-  size_t count = this->_ack_table.erase(msg_id_);
+  size_t count = 0;
+  if (this->_lock.Lock())
+  {
+    count = this->_ack_table.erase(msg_id_);
+    this->_lock.Unlock();
+  }
   return ((count == 1) ? true : false);
 }
 
@@ -69,51 +85,63 @@ bool
 AckObserver::WaitForAck(const std::string& msg_id_, AckMessage& ack_, uint32_t ms_)
 {
   bool status = false;
-  AckMessageTable::iterator it = this->_ack_table.find(msg_id_);
-  if (it != this->_ack_table.end())
+  zQueue::Queue<AckMessage>* q = NULL;
+
+  // Waits outside the lock so acks can be delivered meanwhile
+  if (this->_lock.Lock())
   {
-    if (it->second.TimedWait(ms_))
+    AckMessageTable::iterator it = this->_ack_table.find(msg_id_);
+    if (it != this->_ack_table.end())
     {
-      ack_ = it->second.Front();
-      it->second.Pop();
-      status = true;
+      q = &it->second;
     }
+    this->_lock.Unlock();
+  }
+  if (q && q->TimedWait(ms_))
+  {
+    ack_ = q->Front();
+    q->Pop();
+    status = true;
   }
   return(status);
 }
 
 bool
-AckObserver::EventHandler(zEvent::Notification* notification_)
+AckObserver::ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
 {
 
   bool status = false;
-  if (notification_ && (notification_->GetType() == zEvent::Event::TYPE_MSG))
+  if (n_.get() && (n_->GetType() == zEvent::Event::TYPE_MSG))
   {
-    status = this->EventHandler(static_cast<zMessage::MessageNotification *>(notification_));
+    status = this->ObserveEvent(STATIC_CAST(zMessage::MessageNotification)(n_));
   }
 
   return (status);
 }
 
 bool
-AckObserver::EventHandler(zMessage::MessageNotification* notification_)
+AckObserver::ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_)
 {
 
   bool status = false;
-  switch (notification_->Id())
+  switch (n_->Id())
   {
   case zMessage::MessageNotification::ID_MSG_RCVD:
     {
-    if (notification_->MessageType() == zMessage::Message::TYPE_ACK)
+    if (n_->MessageType() == zMessage::Message::TYPE_ACK)
     {
-      AckMessage *ack = static_cast<AckMessage*>(notification_->GetMessage());
+      AckMessage *ack = static_cast<AckMessage*>(n_->GetMessage());
       if (ack)
       {
         ZLOG_INFO("Received ack from: " + ack->GetSrc());
-        AckMessageTable::iterator it = this->_ack_table.find(ack->GetId());
-        if (it != this->_ack_table.end())
+        if (this->_lock.Lock())
         {
-          it->second.Push(*ack);
+          AckMessageTable::iterator it = this->_ack_table.find(ack->GetId());
+          if (it != this->_ack_table.end())
+          {
+            it->second.Push(*ack);
+          }
+          this->_lock.Unlock();
         }
       }
     }
@@ -121,7 +149,7 @@ AckObserver::EventHandler(zMessage::MessageNotification* notification_)
   }
   case zMessage::MessageNotification::ID_MSG_SENT:
     {
-    if (notification_->MessageType() == zMessage::Message::TYPE_ACK)
+    if (n_->MessageType() == zMessage::Message::TYPE_ACK)
     {
       status = true;
     }
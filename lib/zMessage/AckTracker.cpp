@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+
+#include <string>
+#include <vector>
+
+#include <zutils/zLog.h>
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zUuid.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+#include <zutils/zAckMessage.h>
+#include <zutils/zAckTracker.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: AckTracker
+//**********************************************************************
+
+AckTracker::AckTracker(const uint32_t tick_ms_, const size_t slots_) :
+    _lock(zSem::Mutex::LOCKED), _tick_ms(tick_ms_ ? tick_ms_ : 1), _table(64),
+        _wheel(slots_, this->now()), _thread(this, NULL)
+{
+  this->_lock.Unlock();
+}
+
+AckTracker::~AckTracker()
+{
+  this->_thread.Stop();
+}
+
+bool
+AckTracker::Register(const std::string& msg_id_, AckHandler* handler_, const uint32_t timeout_ms_)
+{
+  bool status = false;
+  entry e = { { { { 0 } } }, 0, handler_, true };
+
+  if (!handler_ || !zUuid::Uuid::Parse(msg_id_, e.id))
+  {
+    return (false);
+  }
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    if (this->find(e.id) == this->_table.Capacity())
+    {
+      // Timeouts are rounded up to whole ticks, at least one
+      uint64_t ticks = ((uint64_t(timeout_ms_) + this->_tick_ms - 1) / this->_tick_ms);
+      e.expire = (this->now() + (ticks ? ticks : 1));
+      this->_table.Insert(e);
+      this->_wheel.Schedule(e.id, e.expire);
+
+      // The tracker thread sleeps while nothing is pending
+      if (this->_table.Size() == 1)
+      {
+        this->_thread.Start();
+        this->_wake.Post();
+      }
+      status = true;
+    }
+
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  return (status);
+}
+
+bool
+AckTracker::Cancel(const std::string& msg_id_)
+{
+  bool status = false;
+  zUuid::Uuid::uuid id = { { { 0 } } };
+
+  if (!zUuid::Uuid::Parse(msg_id_, id))
+  {
+    return (false);
+  }
+
+  // Begin critical section; the wheel entry is dropped when it comes due
+  if (this->_lock.Lock())
+  {
+    size_t pos = this->find(id);
+    if (pos != this->_table.Capacity())
+    {
+      this->_table.Erase(pos);
+      status = true;
+    }
+
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  return (status);
+}
+
+bool
+AckTracker::Complete(const AckMessage& ack_)
+{
+  AckHandler* handler = NULL;
+  zUuid::Uuid::uuid id = { { { 0 } } };
+  std::string msg_id = ack_.GetId();
+
+  if (!zUuid::Uuid::Parse(msg_id, id))
+  {
+    return (false);
+  }
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    size_t pos = this->find(id);
+    if (pos != this->_table.Capacity())
+    {
+      handler = this->_table[pos].handler;
+      this->_table.Erase(pos);
+    }
+
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  if (handler)
+  {
+    handler->AckCompleted(msg_id, &ack_);
+  }
+
+  return (handler != NULL);
+}
+
+size_t
+AckTracker::Size() const
+{
+  size_t size = 0;
+  if (this->_lock.Lock())
+  {
+    size = this->_table.Size();
+    this->_lock.Unlock();
+  }
+  return (size);
+}
+
+void
+AckTracker::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_wake.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<entry> expired;
+    std::vector<struct pollfd> fds;
+    int timeout = (this->Size() ? int(this->_tick_ms) : -1);
+
+    this->Poll(fds, timeout);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_wake.GetFd()) && (fd.revents == POLLIN))
+      {
+        this->_wake.TryWait();
+      }
+    }
+
+    if (!exit && this->_lock.Lock())
+    {
+      this->expire(this->now(), expired);
+      this->_lock.Unlock();
+    }
+
+    FOREACH (auto& e, expired)
+    {
+      std::string msg_id = zUuid::Uuid(e.id).Str();
+      ZLOG_INFO("Ack timed out: " + msg_id);
+      e.handler->AckCompleted(msg_id, NULL);
+    }
+
+  }
+
+  this->UnregisterFd(this->_wake.GetFd());
+
+  return;
+}
+
+uint64_t
+AckTracker::now() const
+{
+  return (MonotonicMsecs() / this->_tick_ms);
+}
+
+size_t
+AckTracker::find(const zUuid::Uuid::uuid& id_) const
+{
+  return (this->_table.Find(zUuid::Uuid::Hash(id_), [&](const entry& e_)
+  {
+    return (zUuid::Uuid::Equal(e_.id, id_));
+  }));
+}
+
+void
+AckTracker::expire(const uint64_t tick_, std::vector<entry>& expired_)
+{
+  this->_wheel.Turn(tick_, [&](const zUuid::Uuid::uuid& id_, const uint64_t expire_)
+  {
+    // Entries completed, cancelled or registered again are skipped
+    size_t pos = this->find(id_);
+    if ((pos != this->_table.Capacity()) && (this->_table[pos].expire == expire_))
+    {
+      expired_.push_back(this->_table[pos]);
+      this->_table.Erase(pos);
+    }
+  });
+  return;
+}
+
+}
+}
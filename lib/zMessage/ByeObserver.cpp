@@ -36,6 +36,8 @@
 #include <zutils/zByeMessage.h>
 #include <zutils/zAckMessage.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
 namespace zUtils
 {
 namespace zMessage
@@ -54,30 +56,30 @@ ByeObserver::~ByeObserver()
 }
 
 bool
-ByeObserver::EventHandler(zEvent::Notification* notification_)
+ByeObserver::ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
 {
 
   bool status = false;
-  if (notification_ && (notification_->GetType() == zEvent::Event::TYPE_MSG))
+  if (n_.get() && (n_->GetType() == zEvent::Event::TYPE_MSG))
   {
-    status = this->EventHandler(static_cast<zMessage::MessageNotification *>(notification_));
+    status = this->ObserveEvent(STATIC_CAST(zMessage::MessageNotification)(n_));
   }
 
   return (status);
 }
 
 bool
-ByeObserver::EventHandler(zMessage::MessageNotification* notification_)
+ByeObserver::ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_)
 {
 
   bool status = false;
-  switch (notification_->Id())
+  switch (n_->Id())
   {
   case zMessage::MessageNotification::ID_MSG_RCVD:
   {
-    if (notification_->MessageType() == zMessage::Message::TYPE_BYE)
+    if (n_->MessageType() == zMessage::Message::TYPE_BYE)
     {
-      ByeMessage *bye = static_cast<ByeMessage*>(notification_->GetMessage());
+      ByeMessage *bye = static_cast<ByeMessage*>(n_->GetMessage());
       if (bye)
       {
         ZLOG_INFO("Received bye from: " + bye->GetSrc());
@@ -87,7 +89,7 @@ ByeObserver::EventHandler(zMessage::MessageNotification* notification_)
           ack->SetId(bye->GetId());
           ack->SetSrc(bye->GetDst());
           ack->SetDst(bye->GetSrc());
-          status = notification_->Sock()->Send(*ack);
+          status = n_->Sock()->Send(*ack);
           delete(ack);
         }
       }
@@ -96,7 +98,7 @@ ByeObserver::EventHandler(zMessage::MessageNotification* notification_)
   }
   case zMessage::MessageNotification::ID_MSG_SENT:
   {
-    if (notification_->MessageType() == zMessage::Message::TYPE_BYE)
+    if (n_->MessageType() == zMessage::Message::TYPE_BYE)
     {
       status = true;
     }
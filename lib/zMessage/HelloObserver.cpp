@@ -36,6 +36,8 @@
 #include <zutils/zHelloMessage.h>
 #include <zutils/zAckMessage.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
 namespace zUtils
 {
 namespace zMessage
@@ -54,30 +56,30 @@ HelloObserver::~HelloObserver()
 }
 
 bool
-HelloObserver::EventHandler(zEvent::Notification* notification_)
+HelloObserver::ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
 {
 
   bool status = false;
-  if (notification_ && (notification_->GetType() == zEvent::Event::TYPE_MSG))
+  if (n_.get() && (n_->GetType() == zEvent::Event::TYPE_MSG))
   {
-    status = this->EventHandler(static_cast<zMessage::MessageNotification *>(notification_));
+    status = this->ObserveEvent(STATIC_CAST(zMessage::MessageNotification)(n_));
   }
 
   return (status);
 }
 
 bool
-HelloObserver::EventHandler(zMessage::MessageNotification* notification_)
+HelloObserver::ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_)
 {
 
   bool status = false;
-  switch (notification_->Id())
+  switch (n_->Id())
   {
   case zMessage::MessageNotification::ID_MSG_RCVD:
   {
-    if (notification_->MessageType() == zMessage::Message::TYPE_HELLO)
+    if (n_->MessageType() == zMessage::Message::TYPE_HELLO)
     {
-      HelloMessage *hello = static_cast<HelloMessage*>(notification_->GetMessage());
+      HelloMessage *hello = static_cast<HelloMessage*>(n_->GetMessage());
       if (hello)
       {
         ZLOG_INFO("Received hello from: " + hello->GetSrc());
@@ -87,7 +89,7 @@ HelloObserver::EventHandler(zMessage::MessageNotification* notification_)
           ack->SetId(hello->GetId());
           ack->SetSrc(hello->GetDst());
           ack->SetDst(hello->GetSrc());
-          status = notification_->Sock()->Send(*ack);
+          status = n_->Sock()->Send(*ack);
           delete(ack);
         }
       }
@@ -96,7 +98,7 @@ HelloObserver::EventHandler(zMessage::MessageNotification* notification_)
   }
   case zMessage::MessageNotification::ID_MSG_SENT:
   {
-    if (notification_->MessageType() == zMessage::Message::TYPE_HELLO)
+    if (n_->MessageType() == zMessage::Message::TYPE_HELLO)
     {
       status = true;
     }
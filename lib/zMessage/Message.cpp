@@ -33,6 +33,8 @@
 
 #include <zutils/zMessage.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
 namespace zUtils
 {
 namespace zMessage
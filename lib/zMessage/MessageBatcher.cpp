@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <time.h>
+#include <poll.h>
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include <zutils/zLog.h>
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zData.h>
+#include <zutils/zSocket.h>
+#include <zutils/zMessage.h>
+#include <zutils/zMessageFrame.h>
+#include <zutils/zMessageBatcher.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: MessageBatcher
+//**********************************************************************
+
+MessageBatcher::MessageBatcher(BatchTransport& transport_, const size_t mtu_, const uint32_t delay_ms_) :
+    _lock(zSem::Mutex::LOCKED), _transport(transport_), _mtu(mtu_), _delay(delay_ms_),
+        _thread(this, NULL)
+{
+  this->_lock.Unlock();
+}
+
+MessageBatcher::~MessageBatcher()
+{
+  this->_thread.Stop();
+  this->Flush();
+}
+
+bool
+MessageBatcher::Add(const zMessage::Message& msg_)
+{
+  std::vector<std::pair<std::string, std::string> > out;
+  std::string dst = msg_.GetDst();
+  std::string frame;
+
+  if (!MessageFrame::Encode(msg_, frame))
+  {
+    return (false);
+  }
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  batch& b = this->_batches[dst];
+  if (!b.buf.empty() && ((b.buf.size() + frame.size()) > this->_mtu))
+  {
+    out.push_back(std::make_pair(dst, std::string()));
+    out.back().second.swap(b.buf);
+  }
+
+  if (frame.size() >= this->_mtu)
+  {
+    out.push_back(std::make_pair(dst, frame));
+  }
+  else
+  {
+    if (b.buf.empty())
+    {
+      // The delay runs from the first message in the batch
+      b.buf.reserve(this->_mtu);
+      b.due = (MonotonicMsecs() + this->_delay);
+      this->_thread.Start();
+      this->_wake.Post();
+    }
+    b.buf.append(frame);
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  bool status = true;
+  FOREACH (auto& o, out)
+  {
+    status = (this->_transport.TransmitBatch(o.first, o.second) && status);
+  }
+
+  return (status);
+}
+
+bool
+MessageBatcher::Flush()
+{
+  std::vector<std::pair<std::string, std::string> > out;
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    FOREACH (auto& b, this->_batches)
+    {
+      if (!b.second.buf.empty())
+      {
+        out.push_back(std::make_pair(b.first, std::string()));
+        out.back().second.swap(b.second.buf);
+      }
+    }
+    this->_batches.clear();
+
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  bool status = true;
+  FOREACH (auto& o, out)
+  {
+    status = (this->_transport.TransmitBatch(o.first, o.second) && status);
+  }
+
+  return (status);
+}
+
+size_t
+MessageBatcher::GetMtu() const
+{
+  return (this->_mtu);
+}
+
+uint32_t
+MessageBatcher::GetDelay() const
+{
+  return (this->_delay);
+}
+
+void
+MessageBatcher::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+  int timeout = -1;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_wake.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<std::pair<std::string, std::string> > out;
+    std::vector<struct pollfd> fds;
+
+    this->Poll(fds, timeout);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_wake.GetFd()) && (fd.revents == POLLIN))
+      {
+        this->_wake.TryWait();
+      }
+    }
+
+    // Send the batches whose delay has passed and sleep until the next is due
+    timeout = -1;
+    if (!exit && this->_lock.Lock())
+    {
+      uint64_t now = MonotonicMsecs();
+      std::map<std::string, batch>::iterator it = this->_batches.begin();
+      while (it != this->_batches.end())
+      {
+        if (it->second.buf.empty())
+        {
+          this->_batches.erase(it++);
+          continue;
+        }
+        if (it->second.due <= now)
+        {
+          out.push_back(std::make_pair(it->first, std::string()));
+          out.back().second.swap(it->second.buf);
+          this->_batches.erase(it++);
+          continue;
+        }
+        int remain = int(it->second.due - now);
+        if ((timeout < 0) || (remain < timeout))
+        {
+          timeout = remain;
+        }
+        ++it;
+      }
+      this->_lock.Unlock();
+    }
+
+    FOREACH (auto& o, out)
+    {
+      this->_transport.TransmitBatch(o.first, o.second);
+    }
+
+  }
+
+  this->UnregisterFd(this->_wake.GetFd());
+
+  return;
+}
+
+}
+}
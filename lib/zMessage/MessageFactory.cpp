@@ -29,10 +29,13 @@
 #include <zutils/zQueue.h>
 #include <zutils/zEvent.h>
 #include <zutils/zData.h>
+#include <zutils/zDataBinary.h>
 #include <zutils/zSocket.h>
 
 #include <zutils/zUuid.h>
 #include <zutils/zMessage.h>
+#include <zutils/zMessageFrame.h>
+#include <zutils/zMessagePool.h>
 #include <zutils/zHelloMessage.h>
 #include <zutils/zByeMessage.h>
 #include <zutils/zAckMessage.h>
@@ -74,6 +77,8 @@ MessageFactory::Create(const Message::TYPE &type_)
     // No break
   case Message::TYPE_CFG:
     // No break
+  case Message::TYPE_NODE:
+    // No break
   case Message::TYPE_DATA:
     msg = new Message;
     msg->SetType(type_);
@@ -97,6 +102,25 @@ MessageFactory::Create(const std::string& json_)
   return (MessageFactory::Create(data));
 }
 
+zMessage::Message *
+MessageFactory::Create(const void* buf_, const size_t len_)
+{
+  if (MessageFrame::Detect(buf_, len_))
+  {
+    return (MessageFrame(buf_, len_).Decode());
+  }
+  zData::Data data(MessagePath::DataRoot);
+  if (zData::BinaryReader::Detect(buf_, len_))
+  {
+    data.SetBinary(buf_, len_);
+  }
+  else
+  {
+    data.SetJson((const char*) buf_, len_);
+  }
+  return (MessageFactory::Create(data));
+}
+
 zMessage::Message *
 MessageFactory::Create(const zData::Data& data_)
 {
@@ -115,6 +139,23 @@ MessageFactory::Create(const zMessage::Message& msg_)
   return (msg);
 }
 
+SHARED_PTR(zMessage::Message)
+MessageFactory::Acquire(const Message::TYPE& type_)
+{
+  return (MessagePool::Instance().Acquire(type_));
+}
+
+SHARED_PTR(zMessage::Message)
+MessageFactory::Acquire(const zMessage::Message& msg_)
+{
+  SHARED_PTR(zMessage::Message) msg = MessagePool::Instance().Acquire(msg_.GetType());
+  if (msg)
+  {
+    *msg = msg_;
+  }
+  return (msg);
+}
+
 }
 }
 
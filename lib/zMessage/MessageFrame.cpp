@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include <string>
+#include <algorithm>
+
+#include <zutils/zLog.h>
+#include <zutils/zUuid.h>
+#include <zutils/zData.h>
+#include <zutils/zSocket.h>
+#include <zutils/zMessage.h>
+#include <zutils/zMessageFrame.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+static const uint8_t _magic[2] = { 'z', 'M' };
+static const uint8_t _version = 1;
+
+enum
+{
+  OFF_MAGIC = 0,
+  OFF_VERSION = 2,
+  OFF_TYPE = 3,
+  OFF_ID = 4,
+  OFF_DSTLEN = 20,
+  OFF_SRCLEN = 21,
+  OFF_DATALEN = 24,
+  OFF_END = 28
+};
+
+// True if the header fields are ones this version decodes
+static bool
+_wellformed(const uint8_t* p_)
+{
+  return ((p_[OFF_VERSION] == _version) && (p_[OFF_TYPE] > Message::TYPE_NONE)
+      && (p_[OFF_TYPE] < Message::TYPE_LAST));
+}
+
+static uint32_t
+_get32(const uint8_t* p_)
+{
+  uint32_t n = 0;
+  memcpy(&n, p_, sizeof(n));
+  return (ntohl(n));
+}
+
+//**********************************************************************
+// Class: MessageFrame
+//**********************************************************************
+
+const size_t MessageFrame::HeaderSize(OFF_END);
+const size_t MessageFrame::MaxSize(1 << 20);
+
+MessageFrame::MessageFrame(const void* buf_, const size_t len_) :
+    _buf((const uint8_t*) buf_), _len(len_)
+{
+}
+
+MessageFrame::MessageFrame(const zSocket::Buffer& buf_) :
+    _buf(buf_.Data()), _len(buf_.Length())
+{
+}
+
+MessageFrame::~MessageFrame()
+{
+}
+
+bool
+MessageFrame::Valid() const
+{
+  size_t len = MessageFrame::Length(this->_buf, this->_len);
+  return (len && (len <= this->_len) && (len <= MessageFrame::MaxSize) && _wellformed(this->_buf));
+}
+
+size_t
+MessageFrame::Size() const
+{
+  return (this->Valid() ? MessageFrame::Length(this->_buf, this->_len) : 0);
+}
+
+Message::TYPE
+MessageFrame::GetType() const
+{
+  return (this->Valid() ? Message::TYPE(this->_buf[OFF_TYPE]) : Message::TYPE_ERR);
+}
+
+std::string
+MessageFrame::GetId() const
+{
+  std::string id;
+  if (this->Valid())
+  {
+    id = zUuid::Uuid(&this->_buf[OFF_ID]).Str();
+  }
+  return (id);
+}
+
+std::string
+MessageFrame::GetDst() const
+{
+  std::string dst;
+  if (this->Valid())
+  {
+    dst.assign((const char*) &this->_buf[OFF_END], this->_buf[OFF_DSTLEN]);
+  }
+  return (dst);
+}
+
+std::string
+MessageFrame::GetSrc() const
+{
+  std::string src;
+  if (this->Valid())
+  {
+    src.assign((const char*) &this->_buf[OFF_END + this->_buf[OFF_DSTLEN]], this->_buf[OFF_SRCLEN]);
+  }
+  return (src);
+}
+
+const uint8_t*
+MessageFrame::Data() const
+{
+  const uint8_t* data = NULL;
+  if (this->Valid())
+  {
+    data = &this->_buf[OFF_END + this->_buf[OFF_DSTLEN] + this->_buf[OFF_SRCLEN]];
+  }
+  return (data);
+}
+
+size_t
+MessageFrame::DataLength() const
+{
+  return (this->Valid() ? _get32(&this->_buf[OFF_DATALEN]) : 0);
+}
+
+Message*
+MessageFrame::Decode() const
+{
+  Message* msg = NULL;
+  if (this->Valid())
+  {
+    msg = MessageFactory::Create(this->GetType());
+    if (msg && !this->Decode(*msg))
+    {
+      delete (msg);
+      msg = NULL;
+    }
+  }
+  return (msg);
+}
+
+bool
+MessageFrame::Decode(Message& msg_) const
+{
+  if (!this->Valid())
+  {
+    return (false);
+  }
+
+  // The data carries everything but the header fields
+  zData::Data data(MessagePath::DataRoot);
+  if (this->DataLength() && !data.SetBinary(this->Data(), this->DataLength()))
+  {
+    ZLOG_WARN("Invalid message data in frame: " + this->GetId());
+    return (false);
+  }
+
+  if (this->DataLength())
+  {
+    msg_ = Message(data);
+  }
+  msg_.SetType(this->GetType());
+  msg_.SetId(this->GetId());
+  // Empty addresses are left unset, as they were before encoding
+  if (this->_buf[OFF_DSTLEN])
+  {
+    msg_.SetDst(this->GetDst());
+  }
+  if (this->_buf[OFF_SRCLEN])
+  {
+    msg_.SetSrc(this->GetSrc());
+  }
+  return (true);
+}
+
+bool
+MessageFrame::Encode(const Message& msg_, std::string& out_)
+{
+  uint8_t hdr[OFF_END] = { 0 };
+  zUuid::Uuid::uuid id;
+  std::string dst = msg_.GetDst();
+  std::string src = msg_.GetSrc();
+  Message::TYPE type = msg_.GetType();
+
+  if ((type <= Message::TYPE_NONE) || (type >= Message::TYPE_LAST) || (dst.size() > 0xff)
+      || (src.size() > 0xff) || !zUuid::Uuid::Parse(msg_.GetId(), id))
+  {
+    ZLOG_WARN("Cannot frame message: " + msg_.GetId());
+    return (false);
+  }
+
+  // Header fields are not repeated in the data; the copy shares the tree
+  //   until the fields are cleared
+  Message body(msg_);
+  body.Del(MessagePath(MessagePath::TypeDataPath));
+  body.Del(MessagePath(MessagePath::IdDataPath));
+  body.Del(MessagePath(MessagePath::DstDataPath));
+  body.Del(MessagePath(MessagePath::SrcDataPath));
+  std::string data = body.GetBinary();
+  if (data.empty() || ((sizeof(hdr) + dst.size() + src.size() + data.size()) > MessageFrame::MaxSize))
+  {
+    ZLOG_WARN("Cannot frame message: " + msg_.GetId());
+    return (false);
+  }
+
+  memcpy(&hdr[OFF_MAGIC], _magic, sizeof(_magic));
+  hdr[OFF_VERSION] = _version;
+  hdr[OFF_TYPE] = uint8_t(type);
+  memcpy(&hdr[OFF_ID], id.u.u8, sizeof(id.u.u8));
+  hdr[OFF_DSTLEN] = uint8_t(dst.size());
+  hdr[OFF_SRCLEN] = uint8_t(src.size());
+  uint32_t len = htonl(uint32_t(data.size()));
+  memcpy(&hdr[OFF_DATALEN], &len, sizeof(len));
+
+  out_.reserve(out_.size() + sizeof(hdr) + dst.size() + src.size() + data.size());
+  out_.append((const char*) hdr, sizeof(hdr));
+  out_.append(dst);
+  out_.append(src);
+  out_.append(data);
+  return (true);
+}
+
+bool
+MessageFrame::Detect(const void* buf_, const size_t len_)
+{
+  return (buf_ && (len_ >= sizeof(_magic)) && !memcmp(buf_, _magic, sizeof(_magic)));
+}
+
+size_t
+MessageFrame::Length(const void* buf_, const size_t len_)
+{
+  size_t len = 0;
+  if ((len_ >= MessageFrame::HeaderSize) && MessageFrame::Detect(buf_, len_))
+  {
+    const uint8_t* p = (const uint8_t*) buf_;
+    len = (MessageFrame::HeaderSize + p[OFF_DSTLEN] + p[OFF_SRCLEN] + _get32(&p[OFF_DATALEN]));
+  }
+  return (len);
+}
+
+bool
+MessageFrame::Partial(const void* buf_, const size_t len_)
+{
+  const uint8_t* p = (const uint8_t*) buf_;
+  if (!p || !len_ || memcmp(p, _magic, std::min(len_, sizeof(_magic))))
+  {
+    return (false);
+  }
+  if (len_ < MessageFrame::HeaderSize)
+  {
+    return (true);
+  }
+  size_t len = MessageFrame::Length(buf_, len_);
+  return ((len > len_) && (len <= MessageFrame::MaxSize) && _wellformed(p));
+}
+
+}
+}
@@ -43,8 +43,8 @@ namespace zMessage
 // Class: MessageNotification
 //**********************************************************************
 
-MessageNotification::MessageNotification(zMessage::MessageSocket *sock_) :
-    _id(MessageNotification::ID_NONE), zEvent::EventNotification(sock_)
+MessageNotification::MessageNotification(zMessage::MessageSocket& sock_) :
+    zEvent::Notification(sock_), _id(MessageNotification::ID_NONE), _type(Message::TYPE_NONE)
 {
 }
 
@@ -81,17 +81,23 @@ MessageNotification::type(Message::TYPE type_)
 zMessage::MessageSocket*
 MessageNotification::Sock() const
 {
-  return (static_cast<zMessage::MessageSocket*>(this->GetEvent()));
+  return (static_cast<zMessage::MessageSocket*>(&this->GetEvent()));
 }
 
 zMessage::Message*
 MessageNotification::GetMessage() const
+{
+  return (this->_msg.get());
+}
+
+SHARED_PTR(zMessage::Message)
+MessageNotification::GetMessagePtr() const
 {
   return (this->_msg);
 }
 
 bool
-MessageNotification::message(zMessage::Message* msg_)
+MessageNotification::message(SHARED_PTR(zMessage::Message) msg_)
 {
   this->_msg = msg_;
   return (true);
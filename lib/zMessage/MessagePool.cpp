@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <zutils/zCompatibility.h>
+#include <zutils/zSem.h>
+#include <zutils/zData.h>
+#include <zutils/zUuid.h>
+#include <zutils/zMessage.h>
+#include <zutils/zMessagePool.h>
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: MessagePool
+//**********************************************************************
+
+const size_t MessagePool::DefaultLimit(64);
+
+ATOMIC(bool) MessagePool::_destroyed(false);
+
+MessagePool::MessagePool() :
+    _lock(zSem::Mutex::LOCKED), _limit(MessagePool::DefaultLimit)
+{
+  for (int i = 0; i < Message::TYPE_LAST; i++)
+  {
+    this->_blank[i] = NULL;
+  }
+  this->_lock.Unlock();
+}
+
+MessagePool::~MessagePool()
+{
+  this->_lock.Lock();
+  _destroyed = true;
+  for (int i = 0; i < Message::TYPE_LAST; i++)
+  {
+    FOREACH (auto& msg, this->_free[i])
+    {
+      delete (msg);
+    }
+    this->_free[i].clear();
+    delete (this->_blank[i]);
+    this->_blank[i] = NULL;
+  }
+  this->_lock.Unlock();
+}
+
+SHARED_PTR(zMessage::Message)
+MessagePool::Acquire(const Message::TYPE& type_)
+{
+  SHARED_PTR(zMessage::Message) handle;
+  Message* msg = NULL;
+
+  if ((type_ <= Message::TYPE_NONE) || (type_ >= Message::TYPE_LAST))
+  {
+    return (handle);
+  }
+
+  // Begin critical section
+  if (this->_lock.Lock())
+  {
+    if (!this->_free[type_].empty())
+    {
+      msg = this->_free[type_].back();
+      this->_free[type_].pop_back();
+    }
+    // End critical section
+    this->_lock.Unlock();
+  }
+
+  if (msg == NULL)
+  {
+    msg = MessageFactory::Create(type_);
+  }
+
+  if (msg)
+  {
+    msg->SetId(zUuid::Uuid::Create());
+    handle = SHARED_PTR(zMessage::Message)(msg, MessagePool::recycle(type_));
+  }
+
+  return (handle);
+}
+
+size_t
+MessagePool::Free(const Message::TYPE& type_) const
+{
+  size_t cnt = 0;
+  if ((type_ > Message::TYPE_NONE) && (type_ < Message::TYPE_LAST) && this->_lock.Lock())
+  {
+    cnt = this->_free[type_].size();
+    this->_lock.Unlock();
+  }
+  return (cnt);
+}
+
+size_t
+MessagePool::GetLimit() const
+{
+  size_t limit = 0;
+  if (this->_lock.Lock())
+  {
+    limit = this->_limit;
+    this->_lock.Unlock();
+  }
+  return (limit);
+}
+
+bool
+MessagePool::SetLimit(const size_t limit_)
+{
+  std::vector<Message*> trimmed;
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  this->_limit = limit_;
+  for (int i = 0; i < Message::TYPE_LAST; i++)
+  {
+    while (this->_free[i].size() > this->_limit)
+    {
+      trimmed.push_back(this->_free[i].back());
+      this->_free[i].pop_back();
+    }
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  FOREACH (auto& msg, trimmed)
+  {
+    delete (msg);
+  }
+
+  return (true);
+}
+
+void
+MessagePool::release(Message* msg_, const Message::TYPE type_)
+{
+  Message* blank = NULL;
+
+  if (_destroyed)
+  {
+    delete (msg_);
+    return;
+  }
+
+  // The blank message of each type is made once; resetting a message to it
+  //   only shares its data, which is copied again on the first write
+  if (this->_lock.Lock())
+  {
+    blank = this->_blank[type_];
+    this->_lock.Unlock();
+  }
+
+  if (blank == NULL)
+  {
+    blank = MessageFactory::Create(type_);
+    if (blank)
+    {
+      blank->Del(MessagePath(MessagePath::IdDataPath));
+    }
+  }
+
+  // Begin critical section
+  if (!blank || !this->_lock.Lock())
+  {
+    delete (blank);
+    delete (msg_);
+    return;
+  }
+
+  if (this->_blank[type_] == NULL)
+  {
+    this->_blank[type_] = blank;
+  }
+  else if (this->_blank[type_] != blank)
+  {
+    // Lost the race to make the blank message
+    delete (blank);
+    blank = this->_blank[type_];
+  }
+
+  if (this->_free[type_].size() < this->_limit)
+  {
+    *msg_ = *blank;
+    this->_free[type_].push_back(msg_);
+    msg_ = NULL;
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  delete (msg_);
+
+  return;
+}
+
+}
+}
@@ -22,6 +22,7 @@
 #include <list>
 #include <mutex>
 #include <memory>
+#include <utility>
 
 #include <zutils/zLog.h>
 #include <zutils/zSem.h>
@@ -33,24 +34,45 @@
 
 #include <zutils/zMessage.h>
 #include <zutils/zMessageSocket.h>
+#include <zutils/zMessageFrame.h>
 
 #include <zutils/zHelloMessage.h>
 #include <zutils/zByeMessage.h>
 #include <zutils/zAckMessage.h>
+#include <zutils/zAckTracker.h>
+#include <zutils/zReliableChannel.h>
+#include <zutils/zMessageBatcher.h>
+#include <zutils/zMessageTopic.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
 
 namespace zUtils
 {
 namespace zMessage
 {
 
+// Decodes into a pooled message of the frame's type
+static SHARED_PTR(zMessage::Message)
+_decode(const MessageFrame& frame_)
+{
+  SHARED_PTR(zMessage::Message) msg = MessageFactory::Acquire(frame_.GetType());
+  if (msg && !frame_.Decode(*msg))
+  {
+    msg.reset();
+  }
+  return (msg);
+}
+
 //**********************************************************************
 // zMessage::Socket Class
 //**********************************************************************
 
 MessageSocket::MessageSocket() :
-    zEvent::Event(zEvent::Event::TYPE_MSG)
+    zEvent::Event(zEvent::Event::TYPE_MSG), _format(zData::Data::FORMAT_JSON), _framed(false),
+        _channel(NULL), _batcher(NULL), _topics(NULL), _lock(zSem::Mutex::LOCKED), _started(false)
 {
   ZLOG_DEBUG("Creating message socket: '" + ZLOG_P(this) + "'");
+  this->_lock.Unlock();
   this->_sock_handler.RegisterObserver(this);
   this->_msg_handler.RegisterObserver(&this->_hello_obs);
   this->_msg_handler.RegisterObserver(&this->_bye_obs);
@@ -62,21 +84,29 @@ MessageSocket::~MessageSocket()
 {
   ZLOG_DEBUG("Destroying message socket: '" + ZLOG_P(this) + "'");
   this->_sock_handler.UnregisterObserver(this);
+  FOREACH (auto& sock, this->_sock)
+  {
+    this->_sock_handler.UnregisterSocket(sock.second);
+  }
   this->_msg_handler.UnregisterEvent(this);
   this->_msg_handler.UnregisterObserver(&this->_hello_obs);
   this->_msg_handler.UnregisterObserver(&this->_bye_obs);
   this->_msg_handler.UnregisterObserver(&this->_ack_obs);
+  delete (this->_topics);
+  delete (this->_channel);
+  delete (this->_batcher);
 }
 
 bool
 MessageSocket::Listen(zSocket::Socket *sock_)
 {
   bool status = false;
-  if (sock_)
+  if (sock_ && this->_lock.Lock())
   {
-    this->_sock_handler.RegisterEvent(sock_);
     this->_sock[sock_->GetAddress().GetAddress()] = sock_;
-    status = true;
+    this->_started = true;
+    this->_lock.Unlock();
+    status = this->_sock_handler.RegisterSocket(sock_);
   }
   return (status);
 }
@@ -87,13 +117,23 @@ MessageSocket::Connect(const zSocket::Address& addr_, zSocket::Socket *sock_)
   ZLOG_INFO("Connecting to: " + addr_.GetAddress());
 
   bool status = false;
-  if (sock_)
+  if (sock_ && this->_lock.Lock())
   {
-    this->_sock_handler.RegisterEvent(sock_);
+    bool known = false;
+    FOREACH (auto& sock, this->_sock)
+    {
+      known |= (sock.second == sock_);
+    }
     this->_sock[addr_.GetAddress()] = sock_;
+    this->_started = true;
+    this->_lock.Unlock();
+    if (!known)
+    {
+      this->_sock_handler.RegisterSocket(sock_);
+    }
 
     // Say hello and wait for response
-    HelloMessage* hello = (HelloMessage*) MessageFactory::Create(Message::TYPE_HELLO);
+    SHARED_PTR(zMessage::Message) hello = MessageFactory::Acquire(Message::TYPE_HELLO);
     if (hello)
     {
       // Register for ACK
@@ -107,7 +147,12 @@ MessageSocket::Connect(const zSocket::Address& addr_, zSocket::Socket *sock_)
         status = this->_ack_obs.WaitForAck(hello->GetId(), ack, 500);
       }
       this->_ack_obs.UnregisterForAck(hello->GetId());
-      delete (hello);
+    }
+
+    // Exchange subscriptions with the new peer
+    if (status && this->_topics)
+    {
+      this->_topics->AddPeer(addr_.GetAddress());
     }
   }
 
@@ -122,7 +167,7 @@ MessageSocket::Disconnect(const zSocket::Address& addr_)
   bool status = false;
 
   // Say goodbye and wait for a response
-  ByeMessage* bye = (ByeMessage*) MessageFactory::Create(Message::TYPE_BYE);
+  SHARED_PTR(zMessage::Message) bye = MessageFactory::Acquire(Message::TYPE_BYE);
   if (bye)
   {
     // Register for ACK
@@ -136,9 +181,17 @@ MessageSocket::Disconnect(const zSocket::Address& addr_)
       status = this->_ack_obs.WaitForAck(bye->GetId(), ack, 100);
     }
     this->_ack_obs.UnregisterForAck(bye->GetId());
-    delete (bye);
   }
-  this->_sock.erase(addr_.GetAddress());
+  if (this->_topics)
+  {
+    this->_topics->RemovePeer(addr_.GetAddress());
+  }
+  if (this->_lock.Lock())
+  {
+    this->_sock.erase(addr_.GetAddress());
+    this->_partial.erase(addr_.GetAddress());
+    this->_lock.Unlock();
+  }
   return (status);
 }
 
@@ -162,22 +215,45 @@ MessageSocket::WaitForAck(const std::string& msg_id_, AckMessage& ack_, uint32_t
 
 bool
 MessageSocket::Send(zMessage::Message &msg_)
+{
+  return (this->_channel ? this->_channel->Send(msg_) : this->Transmit(msg_));
+}
+
+bool
+MessageSocket::Transmit(zMessage::Message &msg_)
 {
   bool status = false;
 
-  // Convert destination address
-  zSocket::Address* dst = zSocket::SocketAddressFactory::Create(msg_.GetDst());
-  if (dst)
+  // Look up the socket the destination is reached through
+  zSocket::Socket* sock = this->lookup(msg_.GetDst());
+  if (sock)
   {
-    std::map<std::string, zSocket::Socket*>::iterator it = this->_sock.find(dst->GetAddress());
-    if (it != this->_sock.end())
-    {
-      // Update the message source address
-      msg_.SetSrc(it->second->GetAddress().GetAddress());
+    zSocket::Address dst(sock->GetAddress().GetType(), msg_.GetDst());
 
-      // Send message
-      status = (it->second->Send(*dst, msg_.GetJson()) == msg_.GetJson().size());
-      delete (dst);
+    // Update the message source address
+    msg_.SetSrc(sock->GetAddress().GetAddress());
+
+    // Send message; serialize only once
+    if (this->_batcher)
+    {
+      status = this->_batcher->Add(msg_);
+    }
+    else
+    {
+      std::string buf;
+      if (this->_framed)
+      {
+        MessageFrame::Encode(msg_, buf);
+      }
+      else if (this->_format == zData::Data::FORMAT_BINARY)
+      {
+        buf = msg_.GetBinary();
+      }
+      else
+      {
+        buf = msg_.GetJson();
+      }
+      status = (!buf.empty() && sock->Send(dst, buf));
     }
   }
 
@@ -186,58 +262,185 @@ MessageSocket::Send(zMessage::Message &msg_)
 }
 
 bool
-MessageSocket::EventHandler(zEvent::Notification* notification_)
+MessageSocket::TransmitBatch(const std::string& dst_, const std::string& buf_)
 {
+  bool status = false;
+  zSocket::Socket* sock = this->lookup(dst_);
+  if (sock)
+  {
+    zSocket::Address dst(sock->GetAddress().GetType(), dst_);
+    status = sock->Send(dst, buf_);
+  }
+  return (status);
+}
 
-  ZLOG_DEBUG("Handling socket event");
+bool
+MessageSocket::Send(zMessage::Message &msg_, AckHandler* handler_, const uint32_t timeout_ms_)
+{
+  // Registered first so an early ack is not missed
+  bool status = this->_acks.Register(msg_.GetId(), handler_, timeout_ms_);
+  if (status && !(status = this->Send(msg_)))
+  {
+    this->_acks.Cancel(msg_.GetId());
+  }
+  return (status);
+}
+
+zData::Data::FORMAT
+MessageSocket::GetFormat() const
+{
+  return (this->_format);
+}
 
+bool
+MessageSocket::SetFormat(const zData::Data::FORMAT format_)
+{
   bool status = false;
-  if (notification_ && (notification_->GetType() == zEvent::Event::TYPE_SOCKET))
+  if ((format_ == zData::Data::FORMAT_JSON) || (format_ == zData::Data::FORMAT_BINARY))
   {
-    status = this->EventHandler((zSocket::Notification *) notification_);
+    this->_format = format_;
+    status = true;
   }
   return (status);
 }
 
 bool
-MessageSocket::EventHandler(zSocket::Notification* notification_)
+MessageSocket::IsFramed() const
+{
+  return (this->_framed);
+}
+
+bool
+MessageSocket::SetFramed(const bool framed_)
+{
+  this->_framed = framed_;
+  return (true);
+}
+
+bool
+MessageSocket::IsReliable() const
+{
+  return (this->_channel != NULL);
+}
+
+bool
+MessageSocket::SetReliable(const bool reliable_, const uint32_t window_)
 {
   bool status = false;
-  switch (notification_->GetSubType())
+  ReliableChannel* channel = (reliable_ ? new ReliableChannel(*this, window_) : NULL);
+
+  // The socket threads use the channel without the lock, so it is fixed once
+  //   the first socket is registered. Whichever channel is left over is
+  //   deleted outside the lock, its timer may be sending through lookup().
+  if (this->_lock.Lock())
   {
-  case zSocket::Notification::SUBTYPE_PKT_RCVD:
+    if (!this->_started)
+    {
+      std::swap(this->_channel, channel);
+      status = true;
+    }
+    this->_lock.Unlock();
+  }
+  delete (channel);
+
+  return (status);
+}
+
+bool
+MessageSocket::IsBatching() const
+{
+  return (this->_batcher != NULL);
+}
+
+bool
+MessageSocket::SetBatching(const bool batching_, const size_t mtu_, const uint32_t delay_ms_)
+{
+  bool status = false;
+  MessageBatcher* batcher = (batching_ ? new MessageBatcher(*this, mtu_, delay_ms_) : NULL);
+
+  // Same as SetReliable(); the batcher flushes from its own thread
+  if (this->_lock.Lock())
   {
-    zSocket::AddressBufferPair p = notification_->Pkt();
-    // Update address / socket mapping
-    this->_sock[p.first->GetAddress()] = (zSocket::Socket*) notification_->GetEvent();
-    // Create message from package string
-    zMessage::Message *msg = MessageFactory::Create(p.second->Str());
-    if (msg)
+    if (!this->_started)
     {
-      zMessage::MessageNotification notification(this);
-      notification.id(zMessage::MessageNotification::ID_MSG_RCVD);
-      notification.type(msg->GetType());
-      notification.message(msg);
-      this->NotifyHandlers(&notification);
-      delete (msg);
+      std::swap(this->_batcher, batcher);
       status = true;
     }
-    break;
+    this->_lock.Unlock();
   }
-  case zSocket::Notification::SUBTYPE_PKT_SENT:
+  delete (batcher);
+
+  return (status);
+}
+
+bool
+MessageSocket::IsPubSub() const
+{
+  return (this->_topics != NULL);
+}
+
+bool
+MessageSocket::SetPubSub(const bool pubsub_)
+{
+  bool status = false;
+  TopicChannel* topics = (pubsub_ ? new TopicChannel(*this, *this) : NULL);
+
+  // Same as SetReliable()
+  if (this->_lock.Lock())
   {
-    zSocket::AddressBufferPair p = notification_->Pkt();
-    zMessage::Message *msg = MessageFactory::Create(p.second->Str());
-    if (msg)
+    if (!this->_started)
     {
-      zMessage::MessageNotification notification(this);
-      notification.id(zMessage::MessageNotification::ID_MSG_SENT);
-      notification.type(msg->GetType());
-      notification.message(msg);
-      this->NotifyHandlers(&notification);
-      delete (msg);
+      std::swap(this->_topics, topics);
       status = true;
     }
+    this->_lock.Unlock();
+  }
+  delete (topics);
+
+  return (status);
+}
+
+bool
+MessageSocket::Subscribe(const std::string& filter_)
+{
+  return (this->_topics ? this->_topics->Subscribe(filter_) : false);
+}
+
+bool
+MessageSocket::Unsubscribe(const std::string& filter_)
+{
+  return (this->_topics ? this->_topics->Unsubscribe(filter_) : false);
+}
+
+size_t
+MessageSocket::Publish(const std::string& topic_, const zMessage::Message& msg_)
+{
+  return (this->_topics ? this->_topics->Publish(topic_, msg_) : 0);
+}
+
+bool
+MessageSocket::ObserveEvent(SHARED_PTR(zSocket::Notification) n_)
+{
+
+  ZLOG_DEBUG("Handling socket event");
+
+  bool status = false;
+  switch (n_->GetSubType())
+  {
+  case zSocket::Notification::SUBTYPE_PKT_RCVD:
+  {
+    // Update address / socket mapping
+    if (n_->GetSrcAddress() && this->_lock.Lock())
+    {
+      this->_sock[n_->GetSrcAddress()->GetAddress()] = &n_->GetSocket();
+      this->_lock.Unlock();
+    }
+    status = this->receive(n_);
+    break;
+  }
+  case zSocket::Notification::SUBTYPE_PKT_SENT:
+  {
+    status = this->receive(n_);
     break;
   }
   default:
@@ -247,6 +450,162 @@ MessageSocket::EventHandler(zSocket::Notification* notification_)
   return (status);
 }
 
+zSocket::Socket*
+MessageSocket::lookup(const std::string& addr_)
+{
+  zSocket::Socket* sock = NULL;
+  if (this->_lock.Lock())
+  {
+    std::map<std::string, zSocket::Socket*>::iterator it = this->_sock.find(addr_);
+    if (it != this->_sock.end())
+    {
+      sock = it->second;
+    }
+    this->_lock.Unlock();
+  }
+  return (sock);
+}
+
+bool
+MessageSocket::receive(SHARED_PTR(zSocket::Notification) n_)
+{
+  bool status = false;
+  SHARED_PTR(zSocket::Buffer) sb = n_->GetBuffer();
+  MessageNotification::ID id = MessageNotification::ID_MSG_SENT;
+  std::list<SHARED_PTR(zMessage::Message)> msgs;
+
+  if (!sb || !sb->Length())
+  {
+    return (false);
+  }
+
+  if (n_->GetSubType() == zSocket::Notification::SUBTYPE_PKT_RCVD)
+  {
+    id = MessageNotification::ID_MSG_RCVD;
+  }
+
+  // Only data received on a stream is reassembled, per peer; a datagram
+  //   holds whole frames and its truncated tail is dropped
+  bool stream = ((id == MessageNotification::ID_MSG_RCVD) && n_->GetSocket().IsStream());
+  std::string peer;
+  if (stream && n_->GetSrcAddress())
+  {
+    peer = n_->GetSrcAddress()->GetAddress();
+  }
+  this->_lock.Lock();
+
+  std::map<std::string, std::string>::iterator partial = this->_partial.end();
+  if (stream)
+  {
+    partial = this->_partial.find(peer);
+  }
+
+  if (partial != this->_partial.end())
+  {
+    // Continues a frame split across reads of a stream
+    partial->second.append((const char*) sb->Data(), sb->Length());
+  }
+  else if (MessageFrame::Detect(sb->Data(), sb->Length()))
+  {
+    // Frames are decoded straight from the socket buffer; only a trailing
+    //   partial frame is copied aside
+    const uint8_t* buf = sb->Data();
+    size_t len = sb->Length();
+    size_t off = 0;
+    MessageFrame frame(buf, len);
+    while (frame.Valid())
+    {
+      msgs.push_back(_decode(frame));
+      off += frame.Size();
+      frame = MessageFrame(&buf[off], (len - off));
+    }
+    if ((off < len) && stream && MessageFrame::Partial(&buf[off], (len - off)))
+    {
+      this->_partial[peer].assign((const char*) &buf[off], (len - off));
+    }
+  }
+  else
+  {
+    msgs.push_back(SHARED_PTR(zMessage::Message)(MessageFactory::Create(sb->Data(), sb->Length())));
+  }
+
+  if (partial != this->_partial.end())
+  {
+    std::string& buf = partial->second;
+    size_t off = 0;
+    MessageFrame frame(buf.data(), buf.size());
+    while (frame.Valid())
+    {
+      msgs.push_back(_decode(frame));
+      off += frame.Size();
+      frame = MessageFrame(&buf[off], (buf.size() - off));
+    }
+    buf.erase(0, off);
+    // Data that can never become a frame is dropped along with the stream
+    //   state: too large, or complete yet invalid
+    if (!MessageFrame::Partial(buf.data(), buf.size()))
+    {
+      this->_partial.erase(partial);
+    }
+  }
+  this->_lock.Unlock();
+
+  // Channel traffic is consumed by the channel, which releases data in order
+  if ((id == MessageNotification::ID_MSG_RCVD) && this->_channel)
+  {
+    std::list<SHARED_PTR(zMessage::Message)> ordered;
+    FOREACH (auto& msg, msgs)
+    {
+      std::vector<SHARED_PTR(zMessage::Message)> deliver;
+      if (msg && this->_channel->Receive(*msg, deliver))
+      {
+        ordered.insert(ordered.end(), deliver.begin(), deliver.end());
+      }
+      else
+      {
+        ordered.push_back(msg);
+      }
+    }
+    msgs.swap(ordered);
+  }
+
+  // Topic traffic is consumed by the topic channel, passing on publications
+  //   that match a local subscription
+  if ((id == MessageNotification::ID_MSG_RCVD) && this->_topics)
+  {
+    std::list<SHARED_PTR(zMessage::Message)>::iterator it = msgs.begin();
+    while (it != msgs.end())
+    {
+      bool deliver = false;
+      if (*it && this->_topics->Receive(**it, deliver) && !deliver)
+      {
+        it = msgs.erase(it);
+        continue;
+      }
+      ++it;
+    }
+  }
+
+  FOREACH (auto& msg, msgs)
+  {
+    if (msg)
+    {
+      if ((id == MessageNotification::ID_MSG_RCVD) && (msg->GetType() == Message::TYPE_ACK))
+      {
+        this->_acks.Complete(*static_cast<AckMessage*>(msg.get()));
+      }
+      SHARED_PTR(zMessage::MessageNotification) n(new zMessage::MessageNotification(*this));
+      n->id(id);
+      n->type(msg->GetType());
+      n->message(msg);
+      this->notifyHandlers(n);
+      status = true;
+    }
+  }
+
+  return (status);
+}
+
 }
 }
 
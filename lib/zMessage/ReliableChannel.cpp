@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <poll.h>
+
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <list>
+#include <map>
+
+#include <zutils/zLog.h>
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zUuid.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+#include <zutils/zReliableChannel.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+// Retransmission timeouts in milliseconds
+static const uint32_t _rto_init = 200;
+static const uint32_t _rto_min = 20;
+static const uint32_t _rto_max = 4000;
+
+// Acks for in order data wait this long to cover more messages
+static const uint32_t _ack_delay = 10;
+
+// Messages are resent when this many later messages have been acked
+static const uint32_t _fast_resend = 3;
+
+// A peer is given up on after this many sends of one message
+static const uint32_t _max_tries = 8;
+
+// Limit on out of order messages held per peer
+static const size_t _max_held = 1024;
+
+static uint32_t
+_seq(const Message& msg_)
+{
+  uint32_t seq = 0;
+  msg_.GetValue(MessagePath(ReliableChannel::SeqDataPath), seq);
+  return (seq);
+}
+
+//**********************************************************************
+// Class: ReliableChannel
+//**********************************************************************
+
+const std::string ReliableChannel::ChanDataPath("Chan");
+const std::string ReliableChannel::SeqDataPath("Seq");
+const std::string ReliableChannel::CumAckDataPath("CumAck");
+const std::string ReliableChannel::SackDataPath("Sack");
+
+ReliableChannel::ReliableChannel(ReliableTransport& transport_, const uint32_t window_) :
+    _lock(zSem::Mutex::LOCKED), _transport(transport_), _window(window_ ? window_ : 1),
+        _thread(this, NULL)
+{
+  this->_lock.Unlock();
+}
+
+ReliableChannel::~ReliableChannel()
+{
+  this->_thread.Stop();
+}
+
+bool
+ReliableChannel::Send(const zMessage::Message& msg_)
+{
+  std::vector<zMessage::Message> out;
+  std::string dst = msg_.GetDst();
+
+  if (dst.empty())
+  {
+    return (false);
+  }
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  std::map<std::string, sender>::iterator it = this->_senders.find(dst);
+  if (it == this->_senders.end())
+  {
+    sender s;
+    s.chan = zUuid::Uuid().Str();
+    s.next = 1;
+    s.srtt = 0;
+    s.rttvar = 0;
+    s.rto = _rto_init;
+    s.backoff = 1;
+    it = this->_senders.insert(std::make_pair(dst, s)).first;
+  }
+
+  zMessage::Message msg(msg_);
+  msg.PutValue(MessagePath(ReliableChannel::ChanDataPath), it->second.chan);
+  msg.PutValue(MessagePath(ReliableChannel::SeqDataPath), it->second.next++);
+  it->second.queue.push_back(msg);
+  this->fill(it->second, MonotonicMsecs(), out);
+
+  // The channel thread owns the retransmission timers
+  this->_thread.Start();
+  this->_wake.Post();
+
+  // End critical section
+  this->_lock.Unlock();
+
+  this->transmit(out);
+
+  return (true);
+}
+
+bool
+ReliableChannel::Receive(const zMessage::Message& msg_, std::vector<SHARED_PTR(zMessage::Message)>& deliver_)
+{
+  std::vector<zMessage::Message> out;
+  std::string peer = msg_.GetSrc();
+  std::string chan;
+  uint32_t seq = 0;
+
+  if (!msg_.GetValue(MessagePath(ReliableChannel::ChanDataPath), chan))
+  {
+    return (false);
+  }
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  uint64_t now = MonotonicMsecs();
+  if (msg_.GetValue(MessagePath(ReliableChannel::CumAckDataPath), seq))
+  {
+    // Acks from an older channel to the peer are stale
+    std::map<std::string, sender>::iterator it = this->_senders.find(peer);
+    if ((it != this->_senders.end()) && (it->second.chan == chan))
+    {
+      sender& s = it->second;
+
+      // Everything below the cumulative sequence has arrived ...
+      while (!s.flight.empty() && (s.flight.begin()->first < seq))
+      {
+        this->acked(s, s.flight.begin()->first, now);
+      }
+
+      // ... and so have the blocks listed beyond it
+      std::istringstream sack(msg_.GetValue<std::string>(ReliableChannel::SackDataPath));
+      std::string block;
+      uint32_t highest = 0;
+      while (std::getline(sack, block, ','))
+      {
+        uint32_t first = strtoul(block.c_str(), NULL, 10);
+        size_t dash = block.find('-');
+        uint32_t last = (dash == std::string::npos) ? first : strtoul(block.c_str() + dash + 1, NULL, 10);
+        for (std::map<uint32_t, outgoing>::iterator o = s.flight.lower_bound(first);
+            (o != s.flight.end()) && (o->first <= last);)
+        {
+          uint32_t n = (o++)->first;
+          this->acked(s, n, now);
+        }
+        highest = std::max(highest, last);
+      }
+
+      // Gaps with enough acked messages after them are resent right away
+      FOREACH (auto& o, s.flight)
+      {
+        if ((o.first + _fast_resend <= highest) && !o.second.fast)
+        {
+          o.second.fast = true;
+          o.second.sent = now;
+          o.second.tries++;
+          out.push_back(o.second.msg);
+        }
+      }
+
+      this->fill(s, now, out);
+    }
+  }
+  else if (msg_.GetValue(MessagePath(ReliableChannel::SeqDataPath), seq) && seq)
+  {
+    receiver& r = this->_receivers[peer];
+    if (r.chan != chan)
+    {
+      // A new channel from the peer starts over
+      r.chan = chan;
+      r.next = 1;
+      r.held.clear();
+      r.ack = false;
+    }
+
+    if (seq == r.next)
+    {
+      deliver_.push_back(MessageFactory::Acquire(msg_));
+      r.next++;
+      std::map<uint32_t, zMessage::Message>::iterator h;
+      while (((h = r.held.begin()) != r.held.end()) && (h->first == r.next))
+      {
+        deliver_.push_back(MessageFactory::Acquire(h->second));
+        r.held.erase(h);
+        r.next++;
+      }
+    }
+    else if ((seq > r.next) && (r.held.size() < _max_held))
+    {
+      r.held.insert(std::make_pair(seq, msg_));
+    }
+
+    // Duplicates are acked again in case the ack was lost; acks for out of
+    //   order data go out at once so the sender sees the gap
+    if (!r.ack)
+    {
+      r.ack = true;
+      r.ack_due = (now + _ack_delay);
+    }
+    if ((seq != (r.next - 1)) || !r.held.empty())
+    {
+      r.ack_due = now;
+      this->ack(peer, r, out);
+    }
+    else
+    {
+      this->_thread.Start();
+      this->_wake.Post();
+    }
+  }
+  else
+  {
+    this->_lock.Unlock();
+    return (false);
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  this->transmit(out);
+
+  return (true);
+}
+
+size_t
+ReliableChannel::Pending(const std::string& dst_) const
+{
+  size_t pending = 0;
+  if (this->_lock.Lock())
+  {
+    std::map<std::string, sender>::const_iterator it = this->_senders.find(dst_);
+    if (it != this->_senders.end())
+    {
+      pending = (it->second.flight.size() + it->second.queue.size());
+    }
+    this->_lock.Unlock();
+  }
+  return (pending);
+}
+
+uint32_t
+ReliableChannel::GetRto(const std::string& dst_) const
+{
+  uint32_t rto = _rto_init;
+  if (this->_lock.Lock())
+  {
+    std::map<std::string, sender>::const_iterator it = this->_senders.find(dst_);
+    if (it != this->_senders.end())
+    {
+      rto = it->second.rto;
+    }
+    this->_lock.Unlock();
+  }
+  return (rto);
+}
+
+void
+ReliableChannel::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+  int timeout = -1;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_wake.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<zMessage::Message> out;
+    std::vector<struct pollfd> fds;
+
+    this->Poll(fds, timeout);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_wake.GetFd()) && (fd.revents == POLLIN))
+      {
+        this->_wake.TryWait();
+      }
+    }
+
+    if (!exit && this->_lock.Lock())
+    {
+      timeout = this->poll(MonotonicMsecs(), out);
+      this->_lock.Unlock();
+    }
+
+    this->transmit(out);
+
+  }
+
+  this->UnregisterFd(this->_wake.GetFd());
+
+  return;
+}
+
+void
+ReliableChannel::fill(sender& sender_, const uint64_t now_, std::vector<zMessage::Message>& out_)
+{
+  while ((sender_.flight.size() < this->_window) && !sender_.queue.empty())
+  {
+    outgoing o = { sender_.queue.front(), now_, 1, false };
+    sender_.flight.insert(std::make_pair(_seq(o.msg), o));
+    out_.push_back(o.msg);
+    sender_.queue.pop_front();
+  }
+  return;
+}
+
+void
+ReliableChannel::acked(sender& sender_, const uint32_t seq_, const uint64_t now_)
+{
+  std::map<uint32_t, outgoing>::iterator it = sender_.flight.find(seq_);
+  if (it == sender_.flight.end())
+  {
+    return;
+  }
+
+  // Round trips are measured on messages sent once (RFC 6298)
+  if (it->second.tries == 1)
+  {
+    uint32_t rtt = uint32_t(now_ - it->second.sent);
+    if (!sender_.srtt)
+    {
+      sender_.srtt = (rtt ? rtt : 1);
+      sender_.rttvar = (rtt / 2);
+    }
+    else
+    {
+      uint32_t delta = (sender_.srtt > rtt) ? (sender_.srtt - rtt) : (rtt - sender_.srtt);
+      sender_.rttvar = (((3 * sender_.rttvar) + delta) / 4);
+      sender_.srtt = (((7 * sender_.srtt) + rtt) / 8);
+    }
+    sender_.rto = std::min(_rto_max, std::max(_rto_min, (sender_.srtt + (4 * sender_.rttvar))));
+    sender_.backoff = 1;
+  }
+
+  sender_.flight.erase(it);
+  return;
+}
+
+void
+ReliableChannel::ack(const std::string& peer_, receiver& receiver_, std::vector<zMessage::Message>& out_)
+{
+  zMessage::Message* ack = MessageFactory::Create(Message::TYPE_ACK);
+  if (ack)
+  {
+    // Held messages are listed as runs of consecutive sequence numbers
+    std::ostringstream sack;
+    std::map<uint32_t, zMessage::Message>::iterator it = receiver_.held.begin();
+    while (it != receiver_.held.end())
+    {
+      uint32_t first = it->first;
+      uint32_t last = first;
+      while ((++it != receiver_.held.end()) && (it->first == (last + 1)))
+      {
+        last++;
+      }
+      sack << ((sack.tellp() > 0) ? "," : "") << first;
+      if (last != first)
+      {
+        sack << "-" << last;
+      }
+    }
+
+    ack->SetDst(peer_);
+    ack->PutValue(MessagePath(ReliableChannel::ChanDataPath), receiver_.chan);
+    ack->PutValue(MessagePath(ReliableChannel::CumAckDataPath), receiver_.next);
+    ack->PutValue(MessagePath(ReliableChannel::SackDataPath), sack.str());
+    out_.push_back(*ack);
+    delete (ack);
+  }
+  receiver_.ack = false;
+  return;
+}
+
+int
+ReliableChannel::poll(const uint64_t now_, std::vector<zMessage::Message>& out_)
+{
+  uint64_t next = 0;
+
+  // Delayed acks
+  FOREACH (auto& r, this->_receivers)
+  {
+    if (r.second.ack)
+    {
+      if (r.second.ack_due <= now_)
+      {
+        this->ack(r.first, r.second, out_);
+      }
+      else if (!next || (r.second.ack_due < next))
+      {
+        next = r.second.ack_due;
+      }
+    }
+  }
+
+  // Retransmissions; the timeout doubles while nothing new is acked
+  std::map<std::string, sender>::iterator it = this->_senders.begin();
+  while (it != this->_senders.end())
+  {
+    sender& s = it->second;
+    bool lost = false;
+    uint64_t rto = (uint64_t(s.rto) * s.backoff);
+    bool expired = false;
+    FOREACH (auto& o, s.flight)
+    {
+      uint64_t due = (o.second.sent + rto);
+      if (due <= now_)
+      {
+        if (o.second.tries >= _max_tries)
+        {
+          lost = true;
+          break;
+        }
+        o.second.sent = now_;
+        o.second.tries++;
+        out_.push_back(o.second.msg);
+        expired = true;
+        due = (now_ + rto);
+      }
+      if (!next || (due < next))
+      {
+        next = due;
+      }
+    }
+
+    if (lost)
+    {
+      ZLOG_WARN("Giving up on peer: " + it->first);
+      this->_senders.erase(it++);
+      continue;
+    }
+    if (expired && ((uint64_t(s.rto) * s.backoff * 2) <= _rto_max))
+    {
+      s.backoff *= 2;
+    }
+    ++it;
+  }
+
+  return (next ? int(next - now_) : -1);
+}
+
+void
+ReliableChannel::transmit(std::vector<zMessage::Message>& out_)
+{
+  FOREACH (auto& msg, out_)
+  {
+    this->_transport.Transmit(msg);
+  }
+  return;
+}
+
+}
+}
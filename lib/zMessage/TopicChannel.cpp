@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include <zutils/zLog.h>
+#include <zutils/zSem.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+#include <zutils/zMessageFrame.h>
+#include <zutils/zReliableChannel.h>
+#include <zutils/zMessageBatcher.h>
+#include <zutils/zMessageTopic.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+//**********************************************************************
+// Class: TopicChannel
+//**********************************************************************
+
+const std::string TopicChannel::TopicDataPath("Topic");
+const std::string TopicChannel::SubsDataPath("Subs");
+
+TopicChannel::TopicChannel(ReliableTransport& transport_, BatchTransport& batch_) :
+    _lock(zSem::Mutex::LOCKED), _transport(transport_), _batch(batch_)
+{
+  this->_lock.Unlock();
+}
+
+TopicChannel::~TopicChannel()
+{
+}
+
+bool
+TopicChannel::Subscribe(const std::string& filter_)
+{
+  std::vector<zMessage::Message*> out;
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  bool status = this->_local.Add(filter_, std::string());
+  if (status)
+  {
+    this->_subs.insert(filter_);
+    FOREACH (auto& peer, this->_peers)
+    {
+      out.push_back(this->update(peer.first));
+    }
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  this->transmit(out);
+
+  return (status);
+}
+
+bool
+TopicChannel::Unsubscribe(const std::string& filter_)
+{
+  std::vector<zMessage::Message*> out;
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  bool status = this->_local.Remove(filter_, std::string());
+  if (status)
+  {
+    this->_subs.erase(filter_);
+    FOREACH (auto& peer, this->_peers)
+    {
+      out.push_back(this->update(peer.first));
+    }
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  this->transmit(out);
+
+  return (status);
+}
+
+bool
+TopicChannel::AddPeer(const std::string& addr_)
+{
+  std::vector<zMessage::Message*> out;
+
+  if (addr_.empty() || !this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  // Known peers are sent our subscriptions again
+  this->_peers[addr_];
+  out.push_back(this->update(addr_));
+
+  this->_lock.Unlock();
+
+  this->transmit(out);
+
+  return (true);
+}
+
+bool
+TopicChannel::RemovePeer(const std::string& addr_)
+{
+  bool status = false;
+  if (this->_lock.Lock())
+  {
+    std::map<std::string, std::set<std::string> >::iterator it = this->_peers.find(addr_);
+    if (it != this->_peers.end())
+    {
+      FOREACH (auto& filter, it->second)
+      {
+        this->_remote.Remove(filter, addr_);
+      }
+      this->_peers.erase(it);
+      status = true;
+    }
+    this->_lock.Unlock();
+  }
+  return (status);
+}
+
+size_t
+TopicChannel::Publish(const std::string& topic_, const zMessage::Message& msg_)
+{
+  std::set<std::string> peers;
+  std::string buf;
+  size_t cnt = 0;
+
+  if (!TopicTrie::ValidTopic(topic_))
+  {
+    ZLOG_WARN("Invalid topic: " + topic_);
+    return (0);
+  }
+
+  if (this->_lock.Lock())
+  {
+    this->_remote.Match(topic_, peers);
+    this->_lock.Unlock();
+  }
+
+  if (peers.empty())
+  {
+    return (0);
+  }
+
+  // One buffer goes to every subscriber, so it names no destination; the
+  //   caller's message is left as it was
+  zMessage::Message msg(msg_);
+  msg.SetDst(std::string());
+  msg.PutValue(MessagePath(TopicChannel::TopicDataPath), topic_);
+  if (!MessageFrame::Encode(msg, buf))
+  {
+    return (0);
+  }
+
+  FOREACH (auto& peer, peers)
+  {
+    if (this->_batch.TransmitBatch(peer, buf))
+    {
+      cnt++;
+    }
+  }
+
+  return (cnt);
+}
+
+bool
+TopicChannel::Receive(const zMessage::Message& msg_, bool& deliver_)
+{
+  std::vector<zMessage::Message*> out;
+  std::string topic;
+  std::string subs;
+
+  deliver_ = false;
+
+  if (msg_.GetValue(MessagePath(TopicChannel::TopicDataPath), topic))
+  {
+    if (this->_lock.Lock())
+    {
+      deliver_ = this->_local.Match(topic);
+      this->_lock.Unlock();
+    }
+    return (true);
+  }
+
+  if (!msg_.GetValue(MessagePath(TopicChannel::SubsDataPath), subs))
+  {
+    return (false);
+  }
+
+  std::string peer = msg_.GetSrc();
+  std::set<std::string> filters;
+  std::istringstream in(subs);
+  std::string filter;
+  while (std::getline(in, filter))
+  {
+    if (TopicTrie::ValidFilter(filter))
+    {
+      filters.insert(filter);
+    }
+  }
+
+  if (peer.empty() || !this->_lock.Lock())
+  {
+    return (true);
+  }
+
+  // Replace the peer's filters; a new peer is told ours in turn
+  std::map<std::string, std::set<std::string> >::iterator it = this->_peers.find(peer);
+  if (it == this->_peers.end())
+  {
+    ZLOG_INFO("New topic peer: " + peer);
+    it = this->_peers.insert(std::make_pair(peer, std::set<std::string>())).first;
+    out.push_back(this->update(peer));
+  }
+  FOREACH (auto& f, it->second)
+  {
+    if (!filters.count(f))
+    {
+      this->_remote.Remove(f, peer);
+    }
+  }
+  FOREACH (auto& f, filters)
+  {
+    if (!it->second.count(f))
+    {
+      this->_remote.Add(f, peer);
+    }
+  }
+  it->second.swap(filters);
+
+  this->_lock.Unlock();
+
+  this->transmit(out);
+
+  return (true);
+}
+
+size_t
+TopicChannel::Subscribers(const std::string& topic_) const
+{
+  std::set<std::string> peers;
+  if (this->_lock.Lock())
+  {
+    this->_remote.Match(topic_, peers);
+    this->_lock.Unlock();
+  }
+  return (peers.size());
+}
+
+zMessage::Message*
+TopicChannel::update(const std::string& dst_) const
+{
+  std::string subs;
+  FOREACH (auto& filter, this->_subs)
+  {
+    subs += (subs.empty() ? filter : ("\n" + filter));
+  }
+  zMessage::Message* msg = MessageFactory::Create(Message::TYPE_DATA);
+  if (msg)
+  {
+    msg->SetDst(dst_);
+    msg->PutValue(MessagePath(TopicChannel::SubsDataPath), subs);
+  }
+  return (msg);
+}
+
+void
+TopicChannel::transmit(std::vector<zMessage::Message*>& out_)
+{
+  FOREACH (auto& msg, out_)
+  {
+    if (msg)
+    {
+      this->_transport.Transmit(*msg);
+      delete (msg);
+    }
+  }
+  out_.clear();
+  return;
+}
+
+}
+}
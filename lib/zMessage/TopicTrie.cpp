@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include <zutils/zLog.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+#include <zutils/zMessageTopic.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_MESSAGE);
+
+namespace zUtils
+{
+namespace zMessage
+{
+
+static const std::string _one("+");
+static const std::string _any("#");
+
+static void
+_split(const std::string& topic_, std::vector<std::string>& levels_)
+{
+  size_t start = 0;
+  for (;;)
+  {
+    size_t end = topic_.find('/', start);
+    if (end == std::string::npos)
+    {
+      levels_.push_back(topic_.substr(start));
+      break;
+    }
+    levels_.push_back(topic_.substr(start, (end - start)));
+    start = (end + 1);
+  }
+  return;
+}
+
+//**********************************************************************
+// Class: TopicTrie
+//**********************************************************************
+
+TopicTrie::TopicTrie() :
+    _size(0)
+{
+}
+
+TopicTrie::~TopicTrie()
+{
+  TopicTrie::clear(this->_root);
+}
+
+bool
+TopicTrie::Add(const std::string& filter_, const std::string& sub_)
+{
+  std::vector<std::string> levels;
+
+  if (!TopicTrie::ValidFilter(filter_))
+  {
+    ZLOG_WARN("Invalid topic filter: " + filter_);
+    return (false);
+  }
+  _split(filter_, levels);
+
+  node* n = &this->_root;
+  FOREACH (auto& level, levels)
+  {
+    node*& child = n->children[level];
+    if (!child)
+    {
+      child = new node;
+    }
+    n = child;
+  }
+
+  bool status = n->subs.insert(sub_).second;
+  if (status)
+  {
+    this->_size++;
+  }
+  return (status);
+}
+
+bool
+TopicTrie::Remove(const std::string& filter_, const std::string& sub_)
+{
+  std::vector<std::string> levels;
+  std::vector<std::pair<node*, std::map<std::string, node*>::iterator> > path;
+
+  if (!TopicTrie::ValidFilter(filter_))
+  {
+    return (false);
+  }
+  _split(filter_, levels);
+
+  node* n = &this->_root;
+  FOREACH (auto& level, levels)
+  {
+    std::map<std::string, node*>::iterator it = n->children.find(level);
+    if (it == n->children.end())
+    {
+      return (false);
+    }
+    path.push_back(std::make_pair(n, it));
+    n = it->second;
+  }
+
+  if (!n->subs.erase(sub_))
+  {
+    return (false);
+  }
+  this->_size--;
+
+  // Prune the levels left with neither subscribers nor children
+  while (!path.empty())
+  {
+    node* child = path.back().second->second;
+    if (!child->subs.empty() || !child->children.empty())
+    {
+      break;
+    }
+    delete (child);
+    path.back().first->children.erase(path.back().second);
+    path.pop_back();
+  }
+
+  return (true);
+}
+
+size_t
+TopicTrie::Match(const std::string& topic_, std::set<std::string>& subs_) const
+{
+  std::vector<std::string> levels;
+  size_t size = subs_.size();
+  if (TopicTrie::ValidTopic(topic_))
+  {
+    _split(topic_, levels);
+    TopicTrie::match(this->_root, levels, 0, subs_);
+  }
+  return (subs_.size() - size);
+}
+
+bool
+TopicTrie::Match(const std::string& topic_) const
+{
+  std::set<std::string> subs;
+  return (this->Match(topic_, subs) != 0);
+}
+
+size_t
+TopicTrie::Size() const
+{
+  return (this->_size);
+}
+
+bool
+TopicTrie::ValidTopic(const std::string& topic_)
+{
+  return (!topic_.empty() && (topic_.find_first_of("+#\n") == std::string::npos));
+}
+
+bool
+TopicTrie::ValidFilter(const std::string& filter_)
+{
+  std::vector<std::string> levels;
+
+  if (filter_.empty() || (filter_.find('\n') != std::string::npos))
+  {
+    return (false);
+  }
+  _split(filter_, levels);
+
+  // Wildcards stand for whole levels and '#' only at the end
+  for (size_t i = 0; i < levels.size(); i++)
+  {
+    const std::string& level = levels[i];
+    if ((level == _any) && ((i + 1) != levels.size()))
+    {
+      return (false);
+    }
+    if ((level != _one) && (level != _any) && (level.find_first_of("+#") != std::string::npos))
+    {
+      return (false);
+    }
+  }
+  return (true);
+}
+
+void
+TopicTrie::clear(node& node_)
+{
+  FOREACH (auto& child, node_.children)
+  {
+    TopicTrie::clear(*child.second);
+    delete (child.second);
+  }
+  node_.children.clear();
+  node_.subs.clear();
+  return;
+}
+
+void
+TopicTrie::match(const node& node_, const std::vector<std::string>& levels_, const size_t level_,
+    std::set<std::string>& subs_)
+{
+  // A trailing '#' matches the rest of the topic, including nothing
+  std::map<std::string, node*>::const_iterator it = node_.children.find(_any);
+  if (it != node_.children.end())
+  {
+    subs_.insert(it->second->subs.begin(), it->second->subs.end());
+  }
+
+  if (level_ == levels_.size())
+  {
+    subs_.insert(node_.subs.begin(), node_.subs.end());
+    return;
+  }
+
+  it = node_.children.find(levels_[level_]);
+  if (it != node_.children.end())
+  {
+    TopicTrie::match(*it->second, levels_, (level_ + 1), subs_);
+  }
+  it = node_.children.find(_one);
+  if (it != node_.children.end())
+  {
+    TopicTrie::match(*it->second, levels_, (level_ + 1), subs_);
+  }
+
+  return;
+}
+
+}
+}
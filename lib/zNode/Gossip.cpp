@@ -0,0 +1,698 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <poll.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+
+#include <zutils/zLog.h>
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zUuid.h>
+#include <zutils/zData.h>
+#include <zutils/zMessage.h>
+#include <zutils/zReliableChannel.h>
+#include <zutils/zNode.h>
+
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_NODE);
+
+namespace zUtils
+{
+namespace zNode
+{
+
+// Each membership change is piggy-backed this many times the log of the
+//   member count, at most this many changes to a message
+static const uint32_t _spread = 3;
+static const size_t _max_updates = 8;
+
+// Dead members are remembered for this many suspicion timeouts so stale
+//   gossip does not bring them back
+static const uint32_t _forget = 10;
+
+static const std::string _op_ping("Ping");
+static const std::string _op_ack("Ack");
+static const std::string _op_ping_req("PingReq");
+
+static zMessage::MessagePath
+_path(const std::string &key_)
+{
+  zMessage::MessagePath path(Gossip::GossipDataPath);
+  path.Append(key_);
+  return (path);
+}
+
+static zMessage::MessagePath
+_path(const size_t index_, const std::string &key_)
+{
+  std::ostringstream key;
+  key << "Updates." << index_ << "." << key_;
+  return (_path(key.str()));
+}
+
+//**********************************************************************
+// zNode::Gossip Class
+//**********************************************************************
+
+const std::string Gossip::GossipDataPath("Gossip");
+
+Gossip::Gossip(zNode::Table &table_, zMessage::ReliableTransport &transport_, const zNode::Node &self_,
+    const uint32_t period_, const size_t indirect_, const uint32_t suspect_) :
+    _lock(zSem::Mutex::LOCKED), _table(table_), _transport(transport_), _id(self_.GetId()),
+        _addr(self_.GetAddress()), _period(period_ ? period_ : 1), _indirect(indirect_),
+        _suspect(suspect_ ? suspect_ : 1), _inc(0), _left(false), _next(0), _seq(0), _probe(0), _sent(0),
+        _acked(true), _asked(true), _round(0), _seed(0), _thread(this, NULL)
+{
+  zUuid::Uuid seed;
+  this->_seed = (unsigned int) seed.Hash();
+  this->_lock.Unlock();
+}
+
+Gossip::~Gossip()
+{
+  this->_thread.Stop();
+}
+
+bool
+Gossip::Join(const std::string &addr_)
+{
+  std::vector<zMessage::Message> out;
+
+  if (addr_.empty() || (addr_ == this->_addr))
+  {
+    return (false);
+  }
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  // Our own arrival is news to spread; the others learn of us from the
+  //   seed and make themselves known when they probe us
+  this->_left = false;
+  this->spread(this->_id);
+  out.push_back(this->message(_op_ping, addr_, ++this->_seq));
+  this->_thread.Start();
+  this->_wake.Post();
+
+  // End critical section
+  this->_lock.Unlock();
+
+  this->transmit(out);
+
+  return (true);
+}
+
+bool
+Gossip::Leave()
+{
+  std::vector<zMessage::Message> out;
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  // Members told directly spread the news of our death
+  this->_left = true;
+  this->spread(this->_id);
+  std::vector<std::string> ids;
+  FOREACH (auto& m, this->_members)
+  {
+    if (m.second.state == Gossip::STATE_ALIVE)
+    {
+      ids.push_back(m.first);
+    }
+  }
+  for (size_t i = 0; (i < this->_indirect) && !ids.empty(); i++)
+  {
+    size_t pick = (rand_r(&this->_seed) % ids.size());
+    out.push_back(this->message(_op_ping, this->_members[ids[pick]].addr, 0));
+    ids[pick] = ids.back();
+    ids.pop_back();
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  this->transmit(out);
+  this->_thread.Stop();
+
+  return (true);
+}
+
+bool
+Gossip::Receive(const zMessage::Message &msg_)
+{
+  std::vector<zMessage::Message> out;
+  std::vector<update> joined;
+  std::vector<update> updates;
+  update from = { std::string(), std::string(), 0, Gossip::STATE_ALIVE };
+  std::string op;
+  std::string target;
+  std::string target_addr;
+  uint32_t seq = 0;
+
+  if ((msg_.GetType() != zMessage::Message::TYPE_NODE) || !msg_.GetValue(_path("Op"), op)
+      || !msg_.GetValue(_path("From"), from.id) || !msg_.GetValue(_path("Addr"), from.addr)
+      || from.id.empty() || from.addr.empty())
+  {
+    return (false);
+  }
+  msg_.GetValue(_path("Inc"), from.inc);
+  msg_.GetValue(_path("Seq"), seq);
+  msg_.GetValue(_path("Target"), target);
+  msg_.GetValue(_path("TargetAddr"), target_addr);
+
+  for (size_t i = 0; i < _max_updates; i++)
+  {
+    update u = { std::string(), std::string(), 0, Gossip::STATE_NONE };
+    int state = 0;
+    if (!msg_.GetValue(_path(i, "Id"), u.id) || !msg_.GetValue(_path(i, "Addr"), u.addr)
+        || !msg_.GetValue(_path(i, "Inc"), u.inc) || !msg_.GetValue(_path(i, "State"), state))
+    {
+      break;
+    }
+    u.state = Gossip::STATE(state);
+    updates.push_back(u);
+  }
+
+  // Begin critical section
+  if (!this->_lock.Lock())
+  {
+    return (false);
+  }
+
+  uint64_t now = MonotonicMsecs();
+
+  // Hearing from a member is news of it being alive; a member saying it is
+  //   leaving is not
+  bool leaving = false;
+  FOREACH (auto& u, updates)
+  {
+    leaving = (leaving || ((u.id == from.id) && (u.state == Gossip::STATE_DEAD)));
+  }
+  if (!leaving)
+  {
+    // A member back from the dead is told so again, so it refutes it
+    std::map<std::string, member>::iterator it = this->_members.find(from.id);
+    if ((it != this->_members.end()) && (it->second.state == Gossip::STATE_DEAD) && (from.inc <= it->second.inc))
+    {
+      this->spread(from.id);
+    }
+    this->apply(from, now, joined);
+  }
+  FOREACH (auto& u, updates)
+  {
+    this->apply(u, now, joined);
+  }
+
+  if (op == _op_ping)
+  {
+    if (seq && !this->_left)
+    {
+      zMessage::Message ack = this->message(_op_ack, from.addr, seq);
+      ack.PutValue(_path("Target"), this->_id);
+      out.push_back(ack);
+    }
+  }
+  else if (op == _op_ping_req)
+  {
+    // Probes the target for the requester and relays the ack back
+    if (!target_addr.empty() && !this->_left)
+    {
+      uint32_t relay_seq = ++this->_seq;
+      relay r = { from.addr, seq, (now + this->_period) };
+      this->_relays[relay_seq] = r;
+      out.push_back(this->message(_op_ping, target_addr, relay_seq));
+    }
+  }
+  else if (op == _op_ack)
+  {
+    std::map<uint32_t, relay>::iterator it = this->_relays.find(seq);
+    if (it != this->_relays.end())
+    {
+      zMessage::Message ack = this->message(_op_ack, it->second.addr, it->second.seq);
+      ack.PutValue(_path("Target"), target);
+      out.push_back(ack);
+      this->_relays.erase(it);
+    }
+    else if (seq && (seq == this->_probe) && (target == this->_target))
+    {
+      this->_acked = true;
+    }
+  }
+
+  // Anyone talking to us gets probed in turn
+  if (!this->_left)
+  {
+    this->_thread.Start();
+  }
+
+  // End critical section
+  this->_lock.Unlock();
+
+  this->transmit(out);
+  this->enroll(joined, true);
+
+  return (true);
+}
+
+Gossip::STATE
+Gossip::GetState(const std::string &id_) const
+{
+  Gossip::STATE state = Gossip::STATE_ERR;
+  if (this->_lock.Lock())
+  {
+    std::map<std::string, member>::const_iterator it = this->_members.find(id_);
+    if (id_ == this->_id)
+    {
+      state = this->_left ? Gossip::STATE_DEAD : Gossip::STATE_ALIVE;
+    }
+    else if (it != this->_members.end())
+    {
+      state = it->second.state;
+    }
+    else
+    {
+      state = Gossip::STATE_NONE;
+    }
+    this->_lock.Unlock();
+  }
+  return (state);
+}
+
+uint32_t
+Gossip::GetIncarnation() const
+{
+  uint32_t inc = 0;
+  if (this->_lock.Lock())
+  {
+    inc = this->_inc;
+    this->_lock.Unlock();
+  }
+  return (inc);
+}
+
+size_t
+Gossip::Size() const
+{
+  size_t size = 0;
+  if (this->_lock.Lock())
+  {
+    FOREACH (auto& m, this->_members)
+    {
+      if (m.second.state != Gossip::STATE_DEAD)
+      {
+        size++;
+      }
+    }
+    this->_lock.Unlock();
+  }
+  return (size);
+}
+
+void
+Gossip::Run(zThread::ThreadArg *arg_)
+{
+
+  bool exit = false;
+  int timeout = 0;
+
+  // Setup for poll loop
+  this->RegisterFd(this->_wake.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<zMessage::Message> out;
+    std::vector<update> live;
+    std::vector<struct pollfd> fds;
+
+    this->Poll(fds, timeout);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_wake.GetFd()) && (fd.revents == POLLIN))
+      {
+        this->_wake.TryWait();
+      }
+    }
+
+    // Probes run on half period steps: the ping, then the indirect pings
+    timeout = int(this->_period / 2);
+    if (!exit && this->_lock.Lock())
+    {
+      uint64_t now = MonotonicMsecs();
+      this->tick(now, out, live);
+      uint64_t due = this->_asked ? this->_round : (this->_sent + (this->_period / 2));
+      timeout = (due > now) ? int(due - now) : 0;
+      this->_lock.Unlock();
+    }
+
+    this->transmit(out);
+    this->enroll(live, false);
+
+  }
+
+  this->UnregisterFd(this->_wake.GetFd());
+
+  return;
+}
+
+zMessage::Message
+Gossip::message(const std::string &op_, const std::string &dst_, const uint32_t seq_)
+{
+  zMessage::Message msg;
+  msg.SetType(zMessage::Message::TYPE_NODE);
+  msg.SetId(zUuid::Uuid::Create());
+  msg.SetDst(dst_);
+  msg.SetSrc(this->_addr);
+  msg.PutValue(_path("Op"), op_);
+  msg.PutValue(_path("From"), this->_id);
+  msg.PutValue(_path("Addr"), this->_addr);
+  msg.PutValue(_path("Inc"), this->_inc);
+  msg.PutValue(_path("Seq"), seq_);
+
+  // Piggy-back the changes sent the fewest times; each is dropped once it
+  //   has been sent enough times for the cluster size
+  size_t n = 0;
+  std::list<std::pair<std::string, uint32_t> >::iterator it = this->_updates.begin();
+  while ((it != this->_updates.end()) && (n < _max_updates))
+  {
+    update u = { it->first, this->_addr, this->_inc, (this->_left ? Gossip::STATE_DEAD : Gossip::STATE_ALIVE) };
+    std::map<std::string, member>::iterator m = this->_members.find(it->first);
+    if (it->first != this->_id)
+    {
+      if (m == this->_members.end())
+      {
+        it = this->_updates.erase(it);
+        continue;
+      }
+      u.addr = m->second.addr;
+      u.inc = m->second.inc;
+      u.state = m->second.state;
+    }
+    msg.PutValue(_path(n, "Id"), u.id);
+    msg.PutValue(_path(n, "Addr"), u.addr);
+    msg.PutValue(_path(n, "Inc"), u.inc);
+    msg.PutValue(_path(n, "State"), int(u.state));
+    n++;
+    if (--it->second == 0)
+    {
+      it = this->_updates.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  return (msg);
+}
+
+void
+Gossip::apply(const update &update_, const uint64_t now_, std::vector<update> &joined_)
+{
+  if (update_.id == this->_id)
+  {
+    // Suspicion of ourselves is refuted with a new incarnation
+    if (!this->_left && (update_.state != Gossip::STATE_ALIVE) && (update_.inc >= this->_inc))
+    {
+      this->_inc = (update_.inc + 1);
+      this->spread(this->_id);
+    }
+    return;
+  }
+
+  std::map<std::string, member>::iterator it = this->_members.find(update_.id);
+  if (it == this->_members.end())
+  {
+    if ((update_.state == Gossip::STATE_ALIVE) || (update_.state == Gossip::STATE_SUSPECT))
+    {
+      ZLOG_INFO("zNode::Gossip: New member: " + update_.id + " : " + update_.addr);
+      member m = { update_.addr, update_.inc, update_.state, now_ };
+      this->_members[update_.id] = m;
+      this->_order.push_back(update_.id);
+      this->spread(update_.id);
+      joined_.push_back(update_);
+    }
+    return;
+  }
+
+  // Alive overrides older incarnations, suspect overrides alive of the same
+  //   incarnation and dead overrides both
+  member& m = it->second;
+  bool changed = false;
+  switch (update_.state)
+  {
+  case Gossip::STATE_ALIVE:
+    changed = (update_.inc > m.inc);
+    break;
+  case Gossip::STATE_SUSPECT:
+    changed = ((m.state == Gossip::STATE_ALIVE) && (update_.inc >= m.inc))
+        || ((m.state == Gossip::STATE_SUSPECT) && (update_.inc > m.inc));
+    break;
+  case Gossip::STATE_DEAD:
+    changed = (m.state != Gossip::STATE_DEAD);
+    break;
+  default:
+    break;
+  }
+
+  if (changed)
+  {
+    if ((update_.state == Gossip::STATE_ALIVE) && (m.state == Gossip::STATE_DEAD))
+    {
+      this->_order.push_back(update_.id);
+      joined_.push_back(update_);
+    }
+    m.addr = update_.addr;
+    m.inc = update_.inc;
+    m.state = update_.state;
+    m.since = now_;
+    this->spread(update_.id);
+  }
+
+  return;
+}
+
+void
+Gossip::spread(const std::string &id_)
+{
+  // A new change of a member replaces the one still being spread
+  std::list<std::pair<std::string, uint32_t> >::iterator it = this->_updates.begin();
+  for (; it != this->_updates.end(); ++it)
+  {
+    if (it->first == id_)
+    {
+      this->_updates.erase(it);
+      break;
+    }
+  }
+  uint32_t log = 1;
+  for (size_t n = (this->_members.size() + 1); n > 1; n >>= 1)
+  {
+    log++;
+  }
+  this->_updates.push_front(std::make_pair(id_, (_spread * log)));
+  return;
+}
+
+void
+Gossip::tick(const uint64_t now_, std::vector<zMessage::Message> &out_, std::vector<update> &live_)
+{
+
+  // No ack in half a period; ask others to probe the target
+  if (!this->_asked && (now_ >= (this->_sent + (this->_period / 2))))
+  {
+    this->_asked = true;
+    std::map<std::string, member>::iterator t = this->_members.find(this->_target);
+    if (!this->_acked && (t != this->_members.end()))
+    {
+      std::vector<std::string> ids;
+      FOREACH (auto& m, this->_members)
+      {
+        if ((m.first != this->_target) && (m.second.state == Gossip::STATE_ALIVE))
+        {
+          ids.push_back(m.first);
+        }
+      }
+      for (size_t i = 0; (i < this->_indirect) && !ids.empty(); i++)
+      {
+        size_t pick = (rand_r(&this->_seed) % ids.size());
+        zMessage::Message req = this->message(_op_ping_req, this->_members[ids[pick]].addr, this->_probe);
+        req.PutValue(_path("Target"), this->_target);
+        req.PutValue(_path("TargetAddr"), t->second.addr);
+        out_.push_back(req);
+        ids[pick] = ids.back();
+        ids.pop_back();
+      }
+    }
+  }
+
+  if (now_ < this->_round)
+  {
+    return;
+  }
+
+  // End of the period: a target that never answered is suspected
+  this->_round = (now_ + this->_period);
+  std::vector<update> unused;
+  std::map<std::string, member>::iterator t = this->_members.find(this->_target);
+  if (!this->_acked && (t != this->_members.end()) && (t->second.state == Gossip::STATE_ALIVE))
+  {
+    ZLOG_INFO("zNode::Gossip: Suspecting member: " + this->_target);
+    update u = { this->_target, t->second.addr, t->second.inc, Gossip::STATE_SUSPECT };
+    this->apply(u, now_, unused);
+  }
+  this->_acked = true;
+  this->_asked = true;
+  this->_target.clear();
+
+  // Suspects not heard from in time are dead; the long dead are forgotten
+  std::map<std::string, member>::iterator it = this->_members.begin();
+  while (it != this->_members.end())
+  {
+    uint64_t timeout = (uint64_t(this->_suspect) * this->_period);
+    if ((it->second.state == Gossip::STATE_SUSPECT) && (now_ >= (it->second.since + timeout)))
+    {
+      ZLOG_INFO("zNode::Gossip: Member is dead: " + it->first);
+      update u = { it->first, it->second.addr, it->second.inc, Gossip::STATE_DEAD };
+      this->apply(u, now_, unused);
+    }
+    else if ((it->second.state == Gossip::STATE_DEAD) && (now_ >= (it->second.since + (timeout * _forget))))
+    {
+      this->_members.erase(it++);
+      continue;
+    }
+    else if (it->second.state == Gossip::STATE_ALIVE)
+    {
+      update u = { it->first, it->second.addr, it->second.inc, Gossip::STATE_ALIVE };
+      live_.push_back(u);
+    }
+    ++it;
+  }
+
+  // Indirect probes not answered by now are of no use to the requester
+  std::map<uint32_t, relay>::iterator r = this->_relays.begin();
+  while (r != this->_relays.end())
+  {
+    if (now_ >= r->second.expire)
+    {
+      this->_relays.erase(r++);
+      continue;
+    }
+    ++r;
+  }
+
+  // Probe the next member of a shuffled round robin
+  if (this->_left)
+  {
+    return;
+  }
+  while (this->_target.empty() && !this->_order.empty())
+  {
+    if (this->_next >= this->_order.size())
+    {
+      // Start a new round over the members that may still be alive
+      std::vector<std::string> order;
+      FOREACH (auto& m, this->_members)
+      {
+        if (m.second.state != Gossip::STATE_DEAD)
+        {
+          order.push_back(m.first);
+        }
+      }
+      for (size_t i = order.size(); i > 1; i--)
+      {
+        std::swap(order[i - 1], order[rand_r(&this->_seed) % i]);
+      }
+      this->_order.swap(order);
+      this->_next = 0;
+      if (this->_order.empty())
+      {
+        break;
+      }
+    }
+    std::map<std::string, member>::iterator m = this->_members.find(this->_order[this->_next++]);
+    if ((m != this->_members.end()) && (m->second.state != Gossip::STATE_DEAD))
+    {
+      this->_target = m->first;
+      this->_probe = ++this->_seq;
+      this->_sent = now_;
+      this->_acked = false;
+      this->_asked = false;
+      out_.push_back(this->message(_op_ping, m->second.addr, this->_seq));
+    }
+  }
+
+  return;
+}
+
+void
+Gossip::enroll(const std::vector<update> &nodes_, const bool add_)
+{
+  // Called without the lock held as the table notifies its observers
+  FOREACH (auto& u, nodes_)
+  {
+    if (add_ || !this->_table.Refresh(u.id))
+    {
+      zNode::Node node("", u.addr);
+      node.SetId(u.id);
+      node.SetState(zNode::Node::STATE_ONLINE);
+      if (!this->_table.Add(node))
+      {
+        this->_table.Refresh(u.id);
+      }
+    }
+  }
+  return;
+}
+
+void
+Gossip::transmit(std::vector<zMessage::Message> &out_)
+{
+  FOREACH (auto& msg, out_)
+  {
+    this->_transport.Transmit(msg);
+  }
+  return;
+}
+
+}
+}
+
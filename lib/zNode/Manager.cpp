@@ -14,8 +14,17 @@
  * limitations under the License.
  */
 
+#include <iostream>
+
+#include <zutils/zLog.h>
+#include <zutils/zData.h>
+#include <zutils/zEvent.h>
+#include <zutils/zMessage.h>
+#include <zutils/zMessageSocket.h>
 #include <zutils/zNode.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_NODE);
+
 namespace zUtils
 {
 namespace zNode
@@ -29,46 +38,42 @@ Manager::Manager() :
     _nodeTable(30000)
 {
   this->_nodeTable.Register(this);
+  this->_msgHandler.RegisterObserver(this);
 }
 
 Manager::~Manager()
 {
-  this->_nodeTable.Unregister(this);
-  std::list<zMessage::MessageHandler *>::iterator it = this->_messageHandlers.begin();
-  std::list<zMessage::MessageHandler *>::iterator end = this->_messageHandlers.end();
-  for (; it != end; ++it)
+  this->_msgHandler.UnregisterObserver(this);
+  FOREACH (auto& s, this->_messageSockets)
   {
-    (*it)->Unregister(zMessage::Message::TYPE_HELLO, this);
-    (*it)->Unregister(zMessage::Message::TYPE_BYE, this);
-    (*it)->Unregister(zMessage::Message::TYPE_ACK, this);
-    (*it)->Unregister(zMessage::Message::TYPE_NODE, this);
+    this->_msgHandler.UnregisterEvent(s.first);
   }
-  this->_messageHandlers.clear();
+  this->_messageSockets.clear();
+  this->_nodeTable.Unregister(this);
 }
 
 bool
-Manager::AddMessageHandler(zMessage::MessageHandler *handler_)
+Manager::AddMessageSocket(zMessage::MessageSocket *sock_, const std::string &dst_)
 {
   bool status = false;
 
-  // Add message handler to list
-  this->_messageHandlers.push_front(handler_);
+  if (!sock_ || dst_.empty())
+  {
+    return (false);
+  }
 
-  // Register with handler for messages of interest
-  handler_->Register(zMessage::Message::TYPE_HELLO, this);
-  handler_->Register(zMessage::Message::TYPE_BYE, this);
-  handler_->Register(zMessage::Message::TYPE_ACK, this);
-  handler_->Register(zMessage::Message::TYPE_NODE, this);
-  handler_->StartListener();
+  // Add message socket to list and listen for its messages
+  this->_messageSockets.push_front(std::make_pair(sock_, dst_));
+  this->_msgHandler.RegisterEvent(sock_);
 
   // Say hello to everyone on network
-  zNode::Message *HelloMsg = new zNode::Message(zMessage::Message::TYPE_HELLO, *this);
-  status = handler_->Broadcast(*HelloMsg);
-  delete (HelloMsg);
+  zNode::Message HelloMsg(zMessage::Message::TYPE_HELLO, *this);
+  HelloMsg.SetDst(dst_);
+  status = sock_->Send(HelloMsg);
 
   if (!status)
   {
-    ZLOG_ERR("zNode::Manger::AddMessageHandler(): Error broadcasting hello message");
+    ZLOG_ERR("zNode::Manger::AddMessageSocket(): Error sending hello message");
   }
 
   // Return status
@@ -77,29 +82,38 @@ Manager::AddMessageHandler(zMessage::MessageHandler *handler_)
 }
 
 bool
-Manager::RemMessageHandler(zMessage::MessageHandler *handler_)
+Manager::RemMessageSocket(zMessage::MessageSocket *sock_)
 {
   bool status = false;
 
-  // Say goodbye to everyone on network
-  zNode::Message *ByeMsg = new zNode::Message(zMessage::Message::TYPE_BYE, *this);
-  status = handler_->Broadcast(*ByeMsg);
-  delete (ByeMsg);
-
-  if (!status)
+  FOREACH (auto& s, this->_messageSockets)
   {
-    ZLOG_ERR("zNode::Manger::RemMessageHandler(): Error broadcasting bye message");
+    if (s.first == sock_)
+    {
+      // Say goodbye to everyone on network
+      zNode::Message ByeMsg(zMessage::Message::TYPE_BYE, *this);
+      ByeMsg.SetDst(s.second);
+      status = sock_->Send(ByeMsg);
+      if (!status)
+      {
+        ZLOG_ERR("zNode::Manger::RemMessageSocket(): Error sending bye message");
+      }
+      break;
+    }
   }
 
-  // Unregister for all messages
-  handler_->StopListener();
-  handler_->Unregister(zMessage::Message::TYPE_HELLO, this);
-  handler_->Unregister(zMessage::Message::TYPE_BYE, this);
-  handler_->Unregister(zMessage::Message::TYPE_ACK, this);
-  handler_->Unregister(zMessage::Message::TYPE_NODE, this);
-
-  // Remove handler from list
-  this->_messageHandlers.remove(handler_);
+  // Stop listening and remove socket from list
+  this->_msgHandler.UnregisterEvent(sock_);
+  std::list<std::pair<zMessage::MessageSocket *, std::string> >::iterator it = this->_messageSockets.begin();
+  while (it != this->_messageSockets.end())
+  {
+    if (it->first == sock_)
+    {
+      it = this->_messageSockets.erase(it);
+      continue;
+    }
+    ++it;
+  }
 
   // Return status
   return (status);
@@ -109,78 +123,57 @@ Manager::RemMessageHandler(zMessage::MessageHandler *handler_)
 bool
 Manager::Announce()
 {
-  zNode::Node bcast;
-  bcast.SetId("0");
-  bcast.SetName("all");
-
-  zNode::Message *HelloMsg = new zNode::Message(zMessage::Message::TYPE_HELLO, *this);
-
-  std::list<zMessage::MessageHandler *>::iterator it = this->_messageHandlers.begin();
-  std::list<zMessage::MessageHandler *>::iterator end = this->_messageHandlers.end();
-  for (; it != end; ++it)
-  {
-    if (!(*it)->Broadcast(*HelloMsg))
-    {
-      ZLOG_ERR("zNode::Manger::Announce(): Error sending hello message: ");
-    }
-  }
-  delete (HelloMsg);
+  return (this->_send(zMessage::Message::TYPE_HELLO));
 }
 
 bool
 Manager::Leave()
 {
-  zNode::Node bcast;
-  bcast.SetId("0");
-  bcast.SetName("all");
-
-  zMessage::Message *ByeMsg = zMessage::Factory::Create(zMessage::Message::TYPE_BYE);
+  return (this->_send(zMessage::Message::TYPE_BYE));
+}
 
-  std::list<zMessage::MessageHandler *>::iterator it = this->_messageHandlers.begin();
-  std::list<zMessage::MessageHandler *>::iterator end = this->_messageHandlers.end();
-  for (; it != end; ++it)
+bool
+Manager::ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
+{
+  bool status = false;
+  if (n_.get() && (n_->GetType() == zEvent::Event::TYPE_MSG))
   {
-    if (!(*it)->Broadcast(*ByeMsg))
-    {
-      ZLOG_ERR("zNode::Manger::Leave(): Error sending bye message: ");
-    }
+    status = this->ObserveEvent(STATIC_CAST(zMessage::MessageNotification)(n_));
   }
-  delete (ByeMsg);
+  return (status);
 }
 
 bool
-Manager::MessageRecv(zMessage::MessageHandler &handler_, zMessage::Message &msg_)
+Manager::ObserveEvent(SHARED_PTR(zMessage::MessageNotification) n_)
 {
   bool status = false;
 
-  ZLOG_INFO("zNode::Manager::MessageRecv(): Received message: " +
-      msg_.GetSrc() + " -> " + msg_.GetDst());
+  if ((n_->Id() != zMessage::MessageNotification::ID_MSG_RCVD) || !n_->GetMessage())
+  {
+    return (false);
+  }
+
+  ZLOG_INFO("zNode::Manager::ObserveEvent(): Received message: " +
+      n_->GetMessage()->GetSrc() + " -> " + n_->GetMessage()->GetDst());
 
   // Convert message to node message
-  zNode::Message *msg = new zNode::Message(msg_);
+  zNode::Message msg(*n_->GetMessage());
 
-  switch (msg_.GetType())
+  switch (n_->MessageType())
   {
   case zMessage::Message::TYPE_HELLO:
-    status = this->_helloMsgHandler(handler_, *msg);
+    status = this->_helloMsgHandler(msg);
     break;
   case zMessage::Message::TYPE_BYE:
-    status = this->_byeMsgHandler(handler_, *msg);
-    break;
-  case zMessage::Message::TYPE_ACK:
-    status = this->_ackMsgHandler(handler_, *msg);
+    status = this->_byeMsgHandler(msg);
     break;
   case zMessage::Message::TYPE_NODE:
-    status = this->_nodeMsgHandler(handler_, *msg);
+    status = this->_nodeMsgHandler(msg);
     break;
   default:
-    ZLOG_ERR("Received message of unknown type: " + ZLOG_INT( msg_.GetType() ))
     break;
   }
 
-  // Clean up
-  delete (msg);
-
   // Return status
   return (status);
 
@@ -231,51 +224,41 @@ Manager::EventHandler(zNode::Observer::EVENT event_, const zNode::Node &node_)
 }
 
 bool
-Manager::_helloMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_)
+Manager::_send(zMessage::Message::TYPE type_)
 {
-  bool status = false;
+  bool status = true;
 
-  // Lookup node identifier in table
-  if (!msg_.GetNode().GetId().empty())
+  zNode::Message msg(type_, *this);
+
+  FOREACH (auto& s, this->_messageSockets)
   {
-    zNode::Node *node = this->_nodeTable.Find(msg_.GetNode().GetId());
-    if (!node)
-    {
-      // Valid node, does not exist in table so add it
-      node = new zNode::Node(msg_.GetNode());
-      status = this->_nodeTable.Add(*node);
-      delete (node);
-    }
-    else
+    msg.SetDst(s.second);
+    if (!s.first->Send(msg))
     {
-      // Valid node, already exists in the table so update its state to online
-      status = node->SetState(zNode::Node::STATE_ONLINE);
+      ZLOG_ERR("zNode::Manger::_send(): Error sending message: " + s.second);
+      status = false;
     }
   }
 
-  // Return status
   return (status);
 }
 
 bool
-Manager::_ackMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_)
-{
-  return (false);
-}
-
-bool
-Manager::_byeMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_)
+Manager::_helloMsgHandler(zNode::Message &msg_)
 {
   bool status = false;
 
   // Lookup node identifier in table
   if (!msg_.GetNode().GetId().empty())
   {
-    zNode::Node *node = this->_nodeTable.Find(msg_.GetNode().GetId());
-    if (node)
+    // Valid node, if it already exists in the table update its state to online
+    status = this->_nodeTable.Refresh(msg_.GetNode().GetId());
+    if (!status)
     {
-      // Valid node, remove it from the table
-      this->_nodeTable.Remove(*node);
+      // Valid node, does not exist in table so add it
+      zNode::Node node(msg_.GetNode());
+      node.SetState(zNode::Node::STATE_ONLINE);
+      status = this->_nodeTable.Add(node);
     }
   }
 
@@ -284,7 +267,7 @@ Manager::_byeMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_
 }
 
 bool
-Manager::_nodeMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg_)
+Manager::_byeMsgHandler(zNode::Message &msg_)
 {
   bool status = false;
 
@@ -292,17 +275,10 @@ Manager::_nodeMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg
   if (!msg_.GetNode().GetId().empty())
   {
     zNode::Node *node = this->_nodeTable.Find(msg_.GetNode().GetId());
-    if (!node)
-    {
-      // Valid node, does not exist in table so add it
-      node = new zNode::Node(msg_.GetNode());
-      status = this->_nodeTable.Add(*node);
-      delete (node);
-    }
-    else
+    if (node)
     {
-      // Valid node, already exists in the table so update its state to online
-      status = node->SetState(zNode::Node::STATE_ONLINE);
+      // Valid node, remove it from the table
+      status = this->_nodeTable.Remove(*node);
     }
   }
 
@@ -310,5 +286,11 @@ Manager::_nodeMsgHandler(zMessage::MessageHandler &handler_, zNode::Message &msg
   return (status);
 }
 
+bool
+Manager::_nodeMsgHandler(zNode::Message &msg_)
+{
+  return (this->_helloMsgHandler(msg_));
+}
+
 }
 }
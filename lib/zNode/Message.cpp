@@ -22,19 +22,16 @@ namespace zUtils
 namespace zNode
 {
 
-const std::string Message::STR_NODE = "zNode";
-
 Message::Message(zMessage::Message::TYPE type_, zNode::Node &node_)
 {
-  zUuid::Uuid uuid;
-  this->SetId(uuid());
+  this->SetId(zUuid::Uuid::Create());
   this->SetType(type_);
   this->SetNode(node_);
 }
 
-Message::Message(zMessage::Message &msg_)
+Message::Message(zMessage::Message &msg_) :
+    zMessage::Message(msg_)
 {
-  this->SetJson(msg_.GetJson());
 }
 
 Message::~Message()
@@ -44,22 +41,14 @@ Message::~Message()
 zNode::Node
 Message::GetNode()
 {
-  zData::Data data;
-  this->GetData().GetChild(Message::STR_NODE, data);
-  zNode::Node node(data);
+  zNode::Node node(this->GetData());
   return (node);
 }
 
 bool
 Message::SetNode(zNode::Node &node_)
 {
-  bool status = false;
-
-  zData::Data data = this->GetData();
-  status = data.PutChild(Message::STR_NODE, node_);
-  status = this->SetData(data);
-
-  return (status);
+  return (this->SetData(node_));
 }
 
 }
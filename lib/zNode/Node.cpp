@@ -35,19 +35,27 @@ const std::string Node::NAME = "Name";
 const std::string Node::ID = "Id";
 const std::string Node::ADDRESS = "Address";
 
+// Path of a value below the node's own root
+static zData::DataPath
+_key(const Node &node_, const std::string &key_)
+{
+  zData::DataPath path(node_.GetDataPath());
+  path.Append(key_);
+  return (path);
+}
+
 Node::Node(const zData::Data &data_) :
     zData::Data(Node::ROOT), _state(Node::STATE_NONE)
 {
-  this->SetId(data_.GetValue(Node::ID));
-  this->SetName(data_.GetValue(Node::NAME));
-  this->SetAddress(data_.GetValue(Node::ADDRESS));
+  this->SetId(data_.GetValue<std::string>(Node::ID));
+  this->SetName(data_.GetValue<std::string>(Node::NAME));
+  this->SetAddress(data_.GetValue<std::string>(Node::ADDRESS));
 }
 
 Node::Node(const std::string &name_, const std::string &address_) :
     zData::Data(Node::ROOT), _state(Node::STATE_NONE)
 {
-  zUuid::Uuid uuid;
-  this->SetId(uuid());
+  this->SetId(zUuid::Uuid::Create());
   this->SetName(name_);
   this->SetAddress(address_);
   ZLOG_DEBUG("Creating new node: " + this->GetName() + "[" + this->GetId() + "]:"
@@ -72,13 +80,13 @@ Node::operator=(const Node &other_)
 bool
 Node::operator ==(const Node &other_) const
     {
-  return (this->_pt == other_._pt);
+  return (zData::Data::operator==(other_));
 }
 
 bool
 Node::operator !=(const Node &other_) const
     {
-  return (this->_pt != other_._pt);
+  return (zData::Data::operator!=(other_));
 }
 
 bool
@@ -134,37 +142,37 @@ Node::SetState(const Node::STATE state_)
 std::string
 Node::GetName() const
 {
-  return (this->GetValue(Node::NAME));
+  return (this->GetValue<std::string>(Node::NAME));
 }
 
 bool
 Node::SetName(const std::string &name_)
 {
-  return (this->SetValue(Node::NAME, name_));
+  return (this->PutValue(_key(*this, Node::NAME), name_));
 }
 
 std::string
 Node::GetId() const
 {
-  return (this->GetValue(Node::ID));
+  return (this->GetValue<std::string>(Node::ID));
 }
 
 bool
 Node::SetId(const std::string &id_)
 {
-  return (this->SetValue(Node::ID, id_));
+  return (this->PutValue(_key(*this, Node::ID), id_));
 }
 
 std::string
 Node::GetAddress() const
 {
-  return (this->GetValue(Node::ADDRESS));
+  return (this->GetValue<std::string>(Node::ADDRESS));
 }
 
 bool
 Node::SetAddress(const std::string &addr_)
 {
-  return (this->SetValue(Node::ADDRESS, addr_));
+  return (this->PutValue(_key(*this, Node::ADDRESS), addr_));
 }
 
 }
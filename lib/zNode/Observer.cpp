@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include <zutils/zNode.h>
+
+namespace zUtils
+{
+namespace zNode
+{
+
+//**********************************************************************
+// zNode::Observer Class
+//**********************************************************************
+
+void
+Observer::BatchHandler(const std::vector<Observer::Change> &changes_, const Observer::Summary &summary_)
+{
+  FOREACH (auto& c, changes_)
+  {
+    this->EventHandler(c.event, *c.node);
+  }
+  return;
+}
+
+}
+}
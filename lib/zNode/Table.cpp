@@ -16,33 +16,77 @@
 
 #include <errno.h>
 #include <string.h>
+#include <time.h>
+#include <poll.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <list>
 
 #include <zutils/zLog.h>
-#include <zutils/zTimer.h>
+#include <zutils/zSem.h>
+#include <zutils/zThread.h>
+#include <zutils/zUuid.h>
 #include <zutils/zNode.h>
 
+ZLOG_MODULE_INIT(zUtils::zLog::Log::MODULE_NODE);
+
 namespace zUtils
 {
 namespace zNode
 {
 
+// Periods between the state changes a node goes through while not refreshed
+static const uint64_t _step = 2;
+
+// States are odd once a step has passed; retiring follows offline
+static const uint8_t _retire = (zNode::Node::STATE_PENDING_RETIRE + 1);
+
+static zNode::Observer::EVENT
+_event(const uint8_t state_)
+{
+  switch (state_)
+  {
+  case zNode::Node::STATE_TARDY:
+    return (zNode::Observer::EVENT_TARDY);
+  case zNode::Node::STATE_STALE:
+    return (zNode::Observer::EVENT_STALE);
+  case zNode::Node::STATE_OFFLINE:
+    return (zNode::Observer::EVENT_OFFLINE);
+  case _retire:
+    return (zNode::Observer::EVENT_RETIRED);
+  default:
+    return (zNode::Observer::EVENT_NONE);
+  }
+}
+
 //**********************************************************************
 // NodeTable Class
 //**********************************************************************
-Table::Table(const uint32_t period_)
+Table::Table(const uint32_t period_) :
+    _lock(zSem::Mutex::LOCKED), _period(period_ ? period_ : 1), _table(64), _busy(0),
+        _wheel(16, this->now()), _thread(this, NULL)
 {
-  // Start timer
-  this->_timer.Register(this);
-  this->_timer.Start(period_ * 1000);
   this->_lock.Unlock();
 }
 
 Table::~Table()
 {
-  // Signal the Management thread to stop by stopping the timer thread
+  this->_thread.Stop();
   if (this->_lock.Lock())
   {
-    this->_timer.Start(0);
+    for (size_t pos = 0; pos < this->_table.Capacity(); pos++)
+    {
+      delete (this->_table[pos].node);
+      this->_table[pos].node = NULL;
+    }
+    FOREACH (auto& n, this->_removed)
+    {
+      delete (n);
+    }
+    this->_removed.clear();
+    this->_lock.Unlock();
   } // end if
 }
 
@@ -50,8 +94,17 @@ bool
 Table::Add(zNode::Node &node_)
 {
   bool status = false;
-  std::list<std::pair<zNode::Observer::EVENT, zNode::Node> > notifyList;
-  std::pair<zNode::Observer::EVENT, zNode::Node> notification;
+  std::vector<zNode::Observer::Change> notifyList;
+  record r = { { { { 0 } } }, 0, NULL, uint8_t(node_.GetState()), false };
+  std::string id = node_.GetId();
+
+  // Verify node identifier is valid
+  if (id.empty() || node_.GetAddress().empty())
+  {
+    ZLOG_ERR("zNode::Table::Add(): Invalid node: " + id + " : " + node_.GetAddress());
+    return (false);
+  }
+  r.digest = !Table::key(id, r.id);
 
   // Obtain lock
   if (!this->_lock.Lock())
@@ -60,17 +113,23 @@ Table::Add(zNode::Node &node_)
   } // end if
 
   // Verify node identifier is unique
-  if (!node_.GetId().empty() && !node_.GetAddress().empty())
+  if (this->find(r.id, id) == this->_table.Capacity())
   {
-    if (!this->_idMap.count(node_.GetId()))
+    ZLOG_INFO("Table::Add(): Adding new node: " + id);
+    r.node = new zNode::Node(node_);
+    zNode::Observer::Change c = { zNode::Observer::EVENT_NEW, r.node };
+    notifyList.push_back(c);
+    this->schedule(r, this->now());
+    this->_table.Insert(r);
+    this->_busy++;
+
+    // The aging thread sleeps while the table is empty
+    if (this->_table.Size() == 1)
     {
-      ZLOG_INFO("Table::Add(): Adding new node: " + node_.GetId());
-      notification = std::make_pair(zNode::Observer::EVENT_NEW, node_);
-      notifyList.push_back(notification);
-      this->_nodeList.push_front(node_);
-      this->_idMap[node_.GetId()] = &this->_nodeList.front();
-      status = true;
+      this->_thread.Start();
+      this->_wake.Post();
     }
+    status = true;
   }
 
   // Release lock
@@ -83,8 +142,7 @@ Table::Add(zNode::Node &node_)
   }
   else
   {
-    ZLOG_ERR("zNode::Table::Add(): Node already exists: " +
-        node_.GetId() + " : " + node_.GetAddress());
+    ZLOG_ERR("zNode::Table::Add(): Node already exists: " + id + " : " + node_.GetAddress());
   }
 
   // Return status
@@ -95,8 +153,15 @@ bool
 Table::Remove(zNode::Node &node_)
 {
   bool status = false;
-  std::list<std::pair<zNode::Observer::EVENT, zNode::Node> > notifyList;
-  std::pair<zNode::Observer::EVENT, zNode::Node> notification;
+  std::vector<zNode::Observer::Change> notifyList;
+  zUuid::Uuid::uuid k = { { { 0 } } };
+  std::string id = node_.GetId();
+
+  if (id.empty())
+  {
+    return (false);
+  }
+  Table::key(id, k);
 
   // Obtain lock
   if (!this->_lock.Lock())
@@ -104,20 +169,18 @@ Table::Remove(zNode::Node &node_)
     return (false);
   } // end if
 
-  // Remove node from identifier map
-  if (!node_.GetId().empty())
+  // Remove node; its wheel entry is dropped when it comes due and the node
+  //   is freed once observers are done with it
+  size_t pos = this->find(k, id);
+  if (pos != this->_table.Capacity())
   {
-    // Find identifier in map
-    std::map<std::string, zNode::Node *>::iterator it = this->_idMap.find(node_.GetId());
-    if (it != this->_idMap.end())
-    {
-      ZLOG_INFO("Table::Remove(): Removing node: " + node_.GetId());
-      notification = std::make_pair(zNode::Observer::EVENT_REMOVED, node_);
-      notifyList.push_back(notification);
-      this->_idMap.erase(it);
-      this->_nodeList.remove(node_);
-      status = true;
-    }
+    ZLOG_INFO("Table::Remove(): Removing node: " + id);
+    zNode::Observer::Change c = { zNode::Observer::EVENT_REMOVED, this->_table[pos].node };
+    notifyList.push_back(c);
+    this->_removed.push_back(this->_table[pos].node);
+    this->_table.Erase(pos);
+    this->_busy++;
+    status = true;
   }
 
   // Release lock
@@ -130,8 +193,7 @@ Table::Remove(zNode::Node &node_)
   }
   else
   {
-    ZLOG_ERR("zNode::Table::Remove(): Node does not exist: " +
-        node_.GetId() + " : " + node_.GetAddress());
+    ZLOG_ERR("zNode::Table::Remove(): Node does not exist: " + id + " : " + node_.GetAddress());
   }
 
   // Return status
@@ -142,17 +204,54 @@ zNode::Node *
 Table::Find(const std::string &id_)
 {
   zNode::Node *node = NULL;
-  if (!id_.empty())
+  zUuid::Uuid::uuid k = { { { 0 } } };
+  Table::key(id_, k);
+  if (!id_.empty() && this->_lock.Lock())
   {
-    std::map<std::string, zNode::Node *>::iterator it = this->_idMap.find(id_);
-    if (it != this->_idMap.end())
+    size_t pos = this->find(k, id_);
+    if (pos != this->_table.Capacity())
     {
-      node = it->second;
+      node = this->_table[pos].node;
     }
+    this->_lock.Unlock();
   }
   return (node);
 }
 
+bool
+Table::Refresh(const std::string &id_)
+{
+  bool status = false;
+  zUuid::Uuid::uuid k = { { { 0 } } };
+  Table::key(id_, k);
+  if (!id_.empty() && this->_lock.Lock())
+  {
+    size_t pos = this->find(k, id_);
+    if (pos != this->_table.Capacity())
+    {
+      record& r = this->_table[pos];
+      r.state = zNode::Node::STATE_ONLINE;
+      r.node->SetState(zNode::Node::STATE_ONLINE);
+      this->schedule(r, this->now());
+      status = true;
+    }
+    this->_lock.Unlock();
+  }
+  return (status);
+}
+
+size_t
+Table::Size() const
+{
+  size_t size = 0;
+  if (this->_lock.Lock())
+  {
+    size = this->_table.Size();
+    this->_lock.Unlock();
+  }
+  return (size);
+}
+
 void
 Table::Register(zNode::Observer *obs_)
 {
@@ -174,92 +273,220 @@ Table::Unregister(zNode::Observer *obs_)
 }
 
 void
-Table::TimerTick()
+Table::Run(zThread::ThreadArg *arg_)
 {
 
-  std::list<std::pair<zNode::Observer::EVENT, zNode::Node> > notifyList;
-  std::pair<zNode::Observer::EVENT, zNode::Node> notification;
+  bool exit = false;
 
-  // Obtain lock
-  if (!this->_lock.Lock())
+  // Setup for poll loop
+  this->RegisterFd(this->_wake.GetFd(), (POLLIN | POLLERR));
+
+  while (!exit)
+  {
+
+    std::vector<zNode::Observer::Change> notifyList;
+    std::vector<struct pollfd> fds;
+
+    // Wake at the start of the next tick so nodes change state on time
+    int timeout = (this->Size() ? int(this->_period - (MonotonicMsecs() % this->_period)) : -1);
+
+    this->Poll(fds, timeout);
+
+    FOREACH (auto& fd, fds)
+    {
+      if (this->IsExitFd(fd))
+      {
+        exit = true;
+        continue;
+      }
+      else if (this->IsReloadFd(fd))
+      {
+        continue;
+      }
+      else if ((fd.fd == this->_wake.GetFd()) && (fd.revents == POLLIN))
+      {
+        this->_wake.TryWait();
+      }
+    }
+
+    if (!exit && this->_lock.Lock())
+    {
+      this->expire(this->now(), notifyList);
+      if (!notifyList.empty())
+      {
+        this->_busy++;
+      }
+      this->_lock.Unlock();
+    }
+
+    // Notify observers
+    this->_notify(notifyList);
+
+  }
+
+  this->UnregisterFd(this->_wake.GetFd());
+
+  return;
+}
+
+void
+Table::_notify(const std::vector<zNode::Observer::Change> &changes_)
+{
+
+  // Called holding a batch taken under the lock, so none of the nodes can
+  //   be freed until it is released here
+  std::list<zNode::Observer *> observers;
+  std::vector<zNode::Node *> removed;
+  zNode::Observer::Summary summary = { 0 };
+
+  if (changes_.empty() || !this->_lock.Lock())
   {
     return;
-  } // end if
+  }
+  observers = this->_observers;
+  this->_lock.Unlock();
 
-  std::list<zNode::Node>::iterator it = this->_nodeList.begin();
-  std::list<zNode::Node>::iterator end = this->_nodeList.end();
-  for (; it != end; ++it)
+  summary.total = changes_.size();
+  FOREACH (auto& c, changes_)
   {
-    switch (it->GetState())
+    summary.events[c.event]++;
+  }
+
+  // Notify observers of events
+  FOREACH (auto& obs, observers)
+  {
+    obs->BatchHandler(changes_, summary);
+  } // end for
+
+  // Remove retired nodes from table
+  if (summary.events[zNode::Observer::EVENT_RETIRED])
+  {
+    this->retire(changes_);
+  }
+
+  // Release the batch; the last one out frees removed nodes
+  if (this->_lock.Lock())
+  {
+    if (--this->_busy == 0)
     {
-    case zNode::Node::STATE_ONLINE:
-      it->SetState(zNode::Node::STATE_PENDING_TARDY);
-      break;
-    case zNode::Node::STATE_PENDING_TARDY:
-      it->SetState(zNode::Node::STATE_TARDY);
-      notification = std::make_pair(zNode::Observer::EVENT_TARDY, *it);
-      notifyList.push_back(notification);
-      break;
-    case zNode::Node::STATE_TARDY:
-      it->SetState(zNode::Node::STATE_PENDING_STALE);
-      break;
-    case zNode::Node::STATE_PENDING_STALE:
-      it->SetState(zNode::Node::STATE_STALE);
-      notification = std::make_pair(zNode::Observer::EVENT_STALE, *it);
-      notifyList.push_back(notification);
-      break;
-    case zNode::Node::STATE_STALE:
-      it->SetState(zNode::Node::STATE_PENDING_OFFLINE);
-      break;
-    case zNode::Node::STATE_PENDING_OFFLINE:
-      it->SetState(zNode::Node::STATE_OFFLINE);
-      notification = std::make_pair(zNode::Observer::EVENT_OFFLINE, *it);
-      notifyList.push_back(notification);
-      break;
-    case zNode::Node::STATE_OFFLINE:
-      it->SetState(zNode::Node::STATE_PENDING_RETIRE);
-      break;
-    case zNode::Node::STATE_PENDING_RETIRE:
-      notification = std::make_pair(zNode::Observer::EVENT_RETIRED, *it);
-      notifyList.push_back(notification);
-      break;
-    default:
-      break;
+      removed.swap(this->_removed);
     }
-  } // end for
+    this->_lock.Unlock();
+  }
+  FOREACH (auto& n, removed)
+  {
+    delete (n);
+  }
 
-  // Release lock
-  this->_lock.Unlock();
+  return;
+}
 
-  // Notify observers
-  this->_notify(notifyList);
+uint64_t
+Table::now() const
+{
+  return (MonotonicMsecs() / this->_period);
+}
+
+bool
+Table::key(const std::string &id_, zUuid::Uuid::uuid &key_)
+{
+  if (zUuid::Uuid::Parse(id_, key_))
+  {
+    return (true);
+  }
+  // Other ids are digested; matches are confirmed against the node id
+  key_.u.u64[0] = std::hash<std::string>()(id_);
+  key_.u.u64[1] = id_.size();
+  return (false);
+}
 
-  // Return
+size_t
+Table::find(const zUuid::Uuid::uuid &key_, const std::string &id_) const
+{
+  return (this->_table.Find(zUuid::Uuid::Hash(key_), [&](const record& r_)
+  {
+    return (zUuid::Uuid::Equal(r_.id, key_) && (!r_.digest || id_.empty() || (r_.node->GetId() == id_)));
+  }));
+}
+
+void
+Table::schedule(record &record_, const uint64_t tick_)
+{
+  // Nodes never brought online do not age
+  if ((record_.state <= zNode::Node::STATE_NONE) || (record_.state >= _retire))
+  {
+    record_.deadline = 0;
+    return;
+  }
+
+  // From a pending state the next change is one period away
+  uint64_t ticks = (record_.state % 2) ? _step : (_step - 1);
+  record_.deadline = (tick_ + ticks);
+  this->_wheel.Schedule(record_.id, record_.deadline);
   return;
 }
 
 void
-Table::_notify(std::list<std::pair<zNode::Observer::EVENT, zNode::Node> > notifications_)
+Table::expire(const uint64_t tick_, std::vector<zNode::Observer::Change> &changes_)
 {
+  this->_wheel.Turn(tick_, [&](const zUuid::Uuid::uuid& id_, const uint64_t deadline_)
+  {
+    // Nodes removed or refreshed since are skipped
+    size_t pos = this->find(id_, std::string());
+    if ((pos != this->_table.Capacity()) && (this->_table[pos].deadline == deadline_))
+    {
+      record& r = this->_table[pos];
+      r.state = ((r.state % 2) ? (r.state + _step) : (r.state + 1));
+      if (r.state < _retire)
+      {
+        r.node->SetState(zNode::Node::STATE(r.state));
+      }
+      zNode::Observer::Change c = { _event(r.state), r.node };
+      changes_.push_back(c);
+      this->schedule(r, deadline_);
+    }
+  });
+  return;
+}
 
-  std::list<std::pair<zNode::Observer::EVENT, zNode::Node> >::iterator not_it;
-  std::list<zNode::Observer *>::iterator obs_it;
+void
+Table::retire(const std::vector<zNode::Observer::Change> &changes_)
+{
+  std::vector<zNode::Observer::Change> notifyList;
 
-  for (not_it = notifications_.begin(); not_it != notifications_.end(); ++not_it)
+  if (!this->_lock.Lock())
   {
+    return;
+  }
 
-    // Notify observers of event
-    for (obs_it = this->_observers.begin(); obs_it != this->_observers.end(); ++obs_it)
+  // Nodes removed or replaced since are left alone
+  FOREACH (auto& c, changes_)
+  {
+    if (c.event != zNode::Observer::EVENT_RETIRED)
     {
-      (*obs_it)->EventHandler(not_it->first, not_it->second);
-    } // end for
-
-    // Conditionally remove node from table
-    if (not_it->first == zNode::Observer::EVENT_RETIRED)
+      continue;
+    }
+    std::string id = c.node->GetId();
+    zUuid::Uuid::uuid k = { { { 0 } } };
+    Table::key(id, k);
+    size_t pos = this->find(k, id);
+    if ((pos != this->_table.Capacity()) && (this->_table[pos].node == c.node))
     {
-      this->Remove(not_it->second);
+      ZLOG_INFO("Table::Remove(): Removing node: " + id);
+      zNode::Observer::Change r = { zNode::Observer::EVENT_REMOVED, c.node };
+      notifyList.push_back(r);
+      this->_removed.push_back(this->_table[pos].node);
+      this->_table.Erase(pos);
     }
   }
+  if (!notifyList.empty())
+  {
+    this->_busy++;
+  }
+
+  this->_lock.Unlock();
+
+  this->_notify(notifyList);
 
   return;
 }
@@ -113,8 +113,17 @@ _sig2id(int sig_)
 static void
 _sigaction_func(int sig_, siginfo_t *info_, void *arg_)
 {
-  Signal::ID id = _sig2id(sig_);
-  Manager::Instance().Notify(id, info_);
+  // In signalfd mode only hand the signal number off to the reader; walking
+  //   handler and observer lists is not async-signal-safe
+  if (Manager::Instance().GetMode() == Handler::MODE_SIGNALFD)
+  {
+    Manager::Instance().Defer(sig_);
+  }
+  else
+  {
+    Signal::ID id = _sig2id(sig_);
+    Manager::Instance().Notify(id, info_);
+  }
 }
 
 //**********************************************************************
@@ -157,11 +166,13 @@ Signal::Count() const
 }
 
 bool
-Signal::Notify(siginfo_t *info_)
+Signal::Notify(siginfo_t *info_, const uint64_t count_)
 {
-  this->_count++;
+  this->_count += count_;
+  // The notification copies the siginfo, or keeps it zeroed without one
   SHARED_PTR(Notification) notification(new Notification(*this));
   notification->siginfo(info_);
+  notification->coalesced(count_);
   zEvent::Event::notifyHandlers(notification);
   return (true);
 }
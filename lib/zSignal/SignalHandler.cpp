@@ -15,7 +15,13 @@
  */
 
 #include <string.h>
+#include <errno.h>
 #include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/signalfd.h>
 
 #include <mutex>
 #include <list>
@@ -30,20 +36,35 @@ namespace zUtils
 namespace zSignal
 {
 
+int
+_id2sig(Signal::ID id_);
+
+Signal::ID
+_sig2id(int sig_);
+
 //**********************************************************************
 // Class: Handler
 //**********************************************************************
 
-Handler::Handler()
+Handler::Handler() :
+    _mode(Handler::MODE_ASYNC), _sfd(-1), _reader(NULL)
 {
+  this->_pipe[0] = this->_pipe[1] = -1;
+  sigemptyset(&this->_sigset);
   for (int i = 0; i < Signal::ID_LAST; i++)
   {
     this->_sigs[i] = new Signal(Signal::ID(i));
+    int sig = _id2sig(Signal::ID(i));
+    if (sig >= 0)
+    {
+      sigaddset(&this->_sigset, sig);
+    }
   }
 }
 
 Handler::~Handler()
 {
+  this->SetMode(Handler::MODE_ASYNC);
   for (int i = 0; i < Signal::ID_LAST; i++)
   {
     if (this->_sigs[i])
@@ -77,16 +98,198 @@ Handler::UnregisterObserver(Signal::ID id_, zEvent::Observer *obs_)
 }
 
 bool
-Handler::Notify(Signal::ID id_, siginfo_t *info_)
+Handler::Notify(Signal::ID id_, siginfo_t *info_, const uint64_t count_)
 {
   bool status = false;
   if ((id_ > Signal::ID_ERR) && (id_ < Signal::ID_LAST) && this->_sigs[id_])
   {
-    status = this->_sigs[id_]->Notify(info_);
+    status = this->_sigs[id_]->Notify(info_, count_);
+  }
+  return (status);
+}
+
+Handler::MODE
+Handler::GetMode() const
+{
+  return (Handler::MODE(int(this->_mode)));
+}
+
+bool
+Handler::SetMode(const Handler::MODE mode_, const bool reader_)
+{
+  bool status = false;
+
+  if (mode_ == this->GetMode())
+  {
+    status = true;
+  }
+  else if (mode_ == Handler::MODE_SIGNALFD)
+  {
+    // Block first so nothing is delivered asynchronously to this thread, or
+    //   any thread it creates, from here on
+    pthread_sigmask(SIG_BLOCK, &this->_sigset, NULL);
+    this->_sfd = signalfd(-1, &this->_sigset, (SFD_NONBLOCK | SFD_CLOEXEC));
+    if ((this->_sfd >= 0) && (pipe2(this->_pipe, (O_NONBLOCK | O_CLOEXEC)) == 0))
+    {
+      this->_mode = Handler::MODE_SIGNALFD;
+      if (reader_)
+      {
+        this->_reader = new std::thread(&Handler::_read, this);
+      }
+      status = true;
+    }
+    else
+    {
+      if (this->_sfd >= 0)
+      {
+        close(this->_sfd);
+        this->_sfd = -1;
+      }
+      pthread_sigmask(SIG_UNBLOCK, &this->_sigset, NULL);
+    }
+  }
+  else if (mode_ == Handler::MODE_ASYNC)
+  {
+    if (this->_reader)
+    {
+      this->_exit.Post();
+      this->_reader->join();
+      delete (this->_reader);
+      this->_reader = NULL;
+    }
+
+    // Deliver anything still queued before falling back to async delivery
+    this->Dispatch();
+    this->_mode = Handler::MODE_ASYNC;
+    close(this->_sfd);
+    this->_sfd = -1;
+    close(this->_pipe[0]);
+    close(this->_pipe[1]);
+    this->_pipe[0] = this->_pipe[1] = -1;
+    pthread_sigmask(SIG_UNBLOCK, &this->_sigset, NULL);
+    status = true;
   }
+
   return (status);
 }
 
+int
+Handler::GetFd() const
+{
+  return (this->_sfd);
+}
+
+bool
+Handler::Dispatch()
+{
+  uint64_t cnt[Signal::ID_LAST] = { 0 };
+  siginfo_t info[Signal::ID_LAST];
+  memset(info, 0, sizeof(info));
+
+  if (this->GetMode() != Handler::MODE_SIGNALFD)
+  {
+    return (false);
+  }
+
+  // Drain the signalfd, coalescing repeated signals into a single notification
+  struct signalfd_siginfo ssi[16];
+  ssize_t n = 0;
+  while ((n = read(this->_sfd, ssi, sizeof(ssi))) > 0)
+  {
+    for (size_t i = 0; i < (n / sizeof(ssi[0])); i++)
+    {
+      Signal::ID id = _sig2id(ssi[i].ssi_signo);
+      if ((id > Signal::ID_ERR) && (id < Signal::ID_LAST))
+      {
+        cnt[id]++;
+        info[id].si_signo = ssi[i].ssi_signo;
+        info[id].si_errno = ssi[i].ssi_errno;
+        info[id].si_code = ssi[i].ssi_code;
+        info[id].si_pid = ssi[i].ssi_pid;
+        info[id].si_uid = ssi[i].ssi_uid;
+        info[id].si_status = ssi[i].ssi_status;
+        info[id].si_value.sival_int = ssi[i].ssi_int;
+      }
+    }
+  }
+
+  // Drain signals caught by threads that did not have them blocked
+  int sigs[16];
+  while ((n = read(this->_pipe[0], sigs, sizeof(sigs))) > 0)
+  {
+    for (size_t i = 0; i < (n / sizeof(sigs[0])); i++)
+    {
+      Signal::ID id = _sig2id(sigs[i]);
+      if ((id > Signal::ID_ERR) && (id < Signal::ID_LAST))
+      {
+        cnt[id]++;
+        info[id].si_signo = sigs[i];
+      }
+    }
+  }
+
+  bool status = true;
+  for (int id = 0; id < Signal::ID_LAST; id++)
+  {
+    if (cnt[id])
+    {
+      status &= this->Notify(Signal::ID(id), &info[id], cnt[id]);
+    }
+  }
+  return (status);
+}
+
+bool
+Handler::Block(sigset_t *oldset_)
+{
+  bool status = false;
+  if (this->GetMode() == Handler::MODE_SIGNALFD)
+  {
+    status = (pthread_sigmask(SIG_BLOCK, &this->_sigset, oldset_) == 0);
+  }
+  return (status);
+}
+
+bool
+Handler::Defer(const int sig_)
+{
+  // Note: called from signal context; write() is async-signal-safe and a full
+  //   pipe simply drops the signal, which the reader would coalesce anyway
+  int err = errno;
+  bool status = (write(this->_pipe[1], &sig_, sizeof(sig_)) == sizeof(sig_));
+  errno = err;
+  return (status);
+}
+
+void
+Handler::_read()
+{
+  struct pollfd fds[3] = { { 0 } };
+  fds[0].fd = this->_exit.GetFd();
+  fds[0].events = POLLIN;
+  fds[1].fd = this->_sfd;
+  fds[1].events = POLLIN;
+  fds[2].fd = this->_pipe[0];
+  fds[2].events = POLLIN;
+
+  for (;;)
+  {
+    if (poll(fds, 3, -1) < 0)
+    {
+      continue;
+    }
+    if (fds[0].revents & POLLIN)
+    {
+      this->_exit.GetCount();
+      break;
+    }
+    if ((fds[1].revents | fds[2].revents) & POLLIN)
+    {
+      this->Dispatch();
+    }
+  }
+}
+
 }
 }
 
@@ -15,6 +15,7 @@
  */
 
 #include <signal.h>
+#include <string.h>
 
 #include <mutex>
 #include <list>
@@ -33,9 +34,10 @@ namespace zSignal
 // Class: SignalNotification
 //**********************************************************************
 Notification::Notification(Signal& signal_) :
-    zEvent::Notification(signal_), _id(signal_.Id()), _info(NULL),
-    _cnt(signal_.Count())
+    zEvent::Notification(signal_), _id(signal_.Id()), _cnt(signal_.Count()),
+    _coalesced(1)
 {
+  memset(&this->_info, 0, sizeof(this->_info));
 }
 
 Notification::~Notification()
@@ -51,13 +53,37 @@ Notification::Id() const
 const siginfo_t*
 Notification::SigInfo() const
 {
-  return (this->_info);
+  return (&this->_info);
+}
+
+uint64_t
+Notification::Count() const
+{
+  return (this->_cnt);
+}
+
+uint64_t
+Notification::Coalesced() const
+{
+  return (this->_coalesced);
 }
 
 void
 Notification::siginfo(const siginfo_t *info_)
 {
-  this->_info = info_;
+  // Each notification keeps its own copy; it may be handled after the
+  //   next signal arrives
+  if (info_)
+  {
+    this->_info = *info_;
+  }
+  return;
+}
+
+void
+Notification::coalesced(const uint64_t cnt_)
+{
+  this->_coalesced = cnt_;
   return;
 }
 
@@ -132,6 +132,9 @@ LoopSocket::send()
 //  fprintf(stderr, "LoopSocket::send(): Pushed to RX queue\n");
 //  rxn->Display("rxn\t");
 
+  // Looped back without error
+  txn->SetSubType(Notification::SUBTYPE_PKT_SENT);
+
   // Return send notification
   return (txn);
 
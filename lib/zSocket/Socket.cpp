@@ -66,6 +66,12 @@ Socket::GetType() const
   return (this->_type);
 }
 
+bool
+Socket::IsStream() const
+{
+  return (false);
+}
+
 const Address&
 Socket::GetAddress() const
 {
@@ -396,7 +396,7 @@ UdpSocket::recv()
       else
       {
         n->SetSubType(Notification::SUBTYPE_PKT_ERR);
-        ZLOG_ERR(std::string("Cannot receive packet: " + std::string(strerror(errno))));
+        ZLOG_ERR_RATELIMIT(10, 1000, std::string("Cannot receive packet: " + std::string(strerror(errno))));
       }
     }
   }
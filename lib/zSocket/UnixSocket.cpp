@@ -19,6 +19,7 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <linux/sockios.h>
 #include <sys/un.h>
 #include <netinet/in.h>
 #include <poll.h>
@@ -256,7 +257,7 @@ UnixSocket::recv()
       else
       {
         n->SetSubType(Notification::SUBTYPE_PKT_ERR);
-        ZLOG_ERR(std::string("Cannot receive packet: " + std::string(strerror(errno))));
+        ZLOG_ERR_RATELIMIT(10, 1000, std::string("Cannot receive packet: " + std::string(strerror(errno))));
       }
     }
   }
@@ -113,7 +113,7 @@ Ether2Frame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   // Disassemble lower level frame and validate
   if (!Frame::Disassemble(sb_, fcs_) || (this->GetSubtype() != Frame::SUBTYPE_ETHER2))
   {
-    ZLOG_ERR("Error disassembling frame: " + ZLOG_INT(this->GetSubtype()));
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame: " + ZLOG_INT(this->GetSubtype()));
     return (false);
   }
 
@@ -125,7 +125,7 @@ Ether2Frame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   else
   {
     sb_.Display();
-    ZLOG_ERR("Error disassembling frame: Unknown protocol: " + ZLOG_UINT(Frame::PROTO(be16toh(f->u.ether2.proto))));
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame: Unknown protocol: " + ZLOG_UINT(Frame::PROTO(be16toh(f->u.ether2.proto))));
     return(false);
   }
 
@@ -138,7 +138,7 @@ Ether2Frame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return(false);
   }
 
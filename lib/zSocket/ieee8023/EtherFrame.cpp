@@ -124,7 +124,7 @@ EtherFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_WARN("Error disassembling frame");
+    ZLOG_WARN_RATELIMIT(10, 1000, "Error disassembling frame");
     return(false);
   }
 
@@ -137,7 +137,7 @@ EtherFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_WARN("Error disassembling frame");
+    ZLOG_WARN_RATELIMIT(10, 1000, "Error disassembling frame");
     return(false);
   }
 
@@ -111,7 +111,7 @@ Frame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return (false);
   }
 
@@ -123,14 +123,14 @@ Frame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return (false);
   }
 
   // Verify presence of type field
   if (sb_.Length() < sizeof(f->u.type))
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return (false);
   }
 
@@ -15,6 +15,8 @@
  */
 
 #include <string.h>
+#include <signal.h>
+#include <pthread.h>
 #include <poll.h>
 
 #include <mutex>
@@ -125,7 +127,7 @@ ThreadFunction::Poll(std::vector<struct pollfd>& fds_, const int timeout_)
   }
 
   // Poll on file descriptors (note: includes the reload and exit semaphore file descriptors)
-  int ret = poll(fds_.data(), fds_.size(), -1);
+  int ret = poll(fds_.data(), fds_.size(), timeout_);
 
   // Automatically clear exit and reload semaphores in case the caller doesn't
   FOREACH (auto& fd, fds_)
@@ -184,7 +186,15 @@ Thread::Start()
   {
     zSignal::Manager::Instance().RegisterObserver(zSignal::Signal::ID_SIGTERM, this);
     zSignal::Manager::Instance().RegisterObserver(zSignal::Signal::ID_SIGINT, this);
+
+    // In signalfd mode make sure the new thread starts with the handled signals blocked
+    sigset_t oldset;
+    bool masked = zSignal::Manager::Instance().Block(&oldset);
     this->_thread = new std::thread(&ThreadFunction::Run, this->_func, this->_arg);
+    if (masked)
+    {
+      pthread_sigmask(SIG_SETMASK, &oldset, NULL);
+    }
     status = !!this->_thread;
   }
   return (status);
@@ -94,7 +94,7 @@ ControlFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   // Disassemble lower level frame and validate
   if (!Frame::Disassemble(sb_, fcs_) || (this->Type() != Frame::TYPE_CNTL))
   {
-    ZLOG_ERR("Error disassembling frame: " + ZLOG_INT(this->Type()));
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame: " + ZLOG_INT(this->Type()));
     return (false);
   }
 
@@ -106,7 +106,7 @@ ControlFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return (false);
   }
 
@@ -249,7 +249,7 @@ DataFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   // Disassemble lower level frame and validate
   if (!Frame::Disassemble(sb_, fcs_) || (this->Type() != Frame::TYPE_DATA))
   {
-    ZLOG_ERR("Error disassembling frame: " + ZLOG_INT(this->Type()));
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame: " + ZLOG_INT(this->Type()));
     return (false);
   }
 
@@ -271,7 +271,7 @@ DataFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return (false);
   }
 
@@ -284,7 +284,7 @@ DataFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
     }
     else
     {
-      ZLOG_ERR("Error disassembling frame");
+      ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
       return (false);
     }
   }
@@ -326,7 +326,7 @@ DataFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return (false);
   }
 
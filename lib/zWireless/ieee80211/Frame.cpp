@@ -146,7 +146,7 @@ Frame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return(false);
   }
 
@@ -164,7 +164,7 @@ Frame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return(false);
   }
 
@@ -121,7 +121,7 @@ ManagementFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   // Disassemble lower level frame and validate
   if (!Frame::Disassemble(sb_, fcs_) || (this->Type() != Frame::TYPE_MGMT))
   {
-    ZLOG_ERR("Error disassembling frame: " + ZLOG_INT(this->Type()));
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame: " + ZLOG_INT(this->Type()));
     return (false);
   }
 
@@ -143,7 +143,7 @@ ManagementFrame::Disassemble(zSocket::Buffer& sb_, bool fcs_)
   }
   else
   {
-    ZLOG_ERR("Error disassembling frame");
+    ZLOG_ERR_RATELIMIT(10, 1000, "Error disassembling frame");
     return (false);
   }
 
@@ -132,3 +132,44 @@ zCommandTest_CommandExecute(void* arg_)
   // Return success
   return (0);
 }
+
+int
+zCommandTest_EventStatsCommand(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zCommandTest_EventStatsCommand()");
+  ZLOG_DEBUG("#############################################################");
+
+  zEvent::Statistics& stats = zEvent::Statistics::Instance();
+  TEST_FALSE(stats.IsEnabled());
+
+  // Create new command and verify
+  zCommand::EventStatsCommand MyCommand;
+  TEST_EQ(zCommand::EventStatsCommand::Name, MyCommand.GetName());
+
+  // Enable and validate the report says so
+  zCommand::CommandData MyData;
+  TEST_TRUE(MyData.SetName(zCommand::EventStatsCommand::Name));
+  zCommand::CommandOption MyOption;
+  TEST_TRUE(MyOption.SetName(zCommand::EventStatsCommand::EnableOption));
+  TEST_TRUE(MyData.AddOption(MyOption));
+  TEST_TRUE(MyCommand.Execute(MyData));
+  TEST_TRUE(stats.IsEnabled());
+  TEST_TRUE(MyData.GetOutput().find("enabled") != std::string::npos);
+
+  // Disable, reset and validate
+  zCommand::CommandData MyData2;
+  TEST_TRUE(MyData2.SetName(zCommand::EventStatsCommand::Name));
+  TEST_TRUE(MyOption.SetName(zCommand::EventStatsCommand::DisableOption));
+  TEST_TRUE(MyData2.AddOption(MyOption));
+  TEST_TRUE(MyOption.SetName(zCommand::EventStatsCommand::ResetOption));
+  TEST_TRUE(MyData2.AddOption(MyOption));
+  TEST_TRUE(MyCommand.Execute(MyData2));
+  TEST_FALSE(stats.IsEnabled());
+  TEST_TRUE(MyData2.GetOutput().find("disabled") != std::string::npos);
+  TEST_EQ(uint64_t(0), stats.GetEventHistogram(zEvent::Event::TYPE_TEST).Count());
+
+  // Return success
+  return (0);
+}
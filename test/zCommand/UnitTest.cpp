@@ -48,6 +48,7 @@ main(int argc, const char **argv)
   UTEST_TEST(zCommandTest_CommandDefaults, 0);
   UTEST_TEST(zCommandTest_CommandDataGetSet, 0);
   UTEST_TEST(zCommandTest_CommandExecute, 0);
+  UTEST_TEST(zCommandTest_EventStatsCommand, 0);
 
   zLog::Manager::Instance().UnregisterConnector(zLog::Log::LEVEL_ALL);
 
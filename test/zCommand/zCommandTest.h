@@ -33,6 +33,8 @@ zCommandTest_CommandDataGetSet(void* arg_);
 
 int
 zCommandTest_CommandExecute(void* arg_);
+int
+zCommandTest_EventStatsCommand(void* arg_);
 
 using namespace Test;
 using namespace zUtils;
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zutils/zLog.h>
+using namespace zUtils;
+ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
+
+#include <thread>
+
+#include "UnitTest.h"
+#include "zConfTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+class CommitObserver : public zEvent::Observer
+{
+
+public:
+
+  std::vector<zConfig::ConfigNotification::ID> Ids;
+  std::vector<std::string> Paths;
+  std::string Working;
+
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
+  {
+    if (n_->GetType() != zEvent::Event::TYPE_CONFIG)
+    {
+      return (false);
+    }
+    zConfig::ConfigNotification* n = (zConfig::ConfigNotification*) n_.get();
+    zConfig::Configuration& config = (zConfig::Configuration&) n->GetEvent();
+    this->Ids.push_back(n->Id());
+    this->Paths = n->ChangedPaths();
+    // Observers may read the configuration while being notified
+    zConfig::ConfigPath path;
+    path.Append("Key1");
+    this->Working.clear();
+    config.Get(path, this->Working);
+    return (true);
+  }
+
+};
+
+// Stages another value when told of a commit
+class StagingObserver : public zEvent::Observer
+{
+
+public:
+
+  std::vector<std::string> Paths;
+
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
+  {
+    if (n_->GetType() != zEvent::Event::TYPE_CONFIG)
+    {
+      return (false);
+    }
+    zConfig::ConfigNotification* n = (zConfig::ConfigNotification*) n_.get();
+    zConfig::Configuration& config = (zConfig::Configuration&) n->GetEvent();
+    if (n->Id() == zConfig::ConfigNotification::ID_PRECOMMIT)
+    {
+      zConfig::ConfigPath path;
+      path.Append("Key3");
+      std::string val("Staged");
+      config.Put(path, val);
+    }
+    else
+    {
+      this->Paths = n->ChangedPaths();
+    }
+    return (true);
+  }
+
+};
+
+int
+zConfigTest_ConfigurationCommitNotify(void* arg_)
+{
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zConfigTest_ConfigurationCommitNotify()");
+  ZLOG_DEBUG("#############################################################");
+
+  zConfig::ConfigPath MyPath1;
+  TEST_TRUE(MyPath1.Append("Key1"));
+  zConfig::ConfigPath MyPath2;
+  TEST_TRUE(MyPath2.Append("Key2"));
+  zConfig::ConfigPath MyPath3;
+  TEST_TRUE(MyPath3.Append("Key2"));
+  TEST_TRUE(MyPath3.Append("Sub"));
+
+  zConfig::Configuration *MyConfig = new zConfig::Configuration;
+  TEST_ISNOT_NULL(MyConfig);
+  CommitObserver MyObserver;
+  zEvent::Handler MyHandler;
+  MyHandler.RegisterEvent(MyConfig);
+  MyHandler.RegisterObserver(&MyObserver);
+
+  // Commit of staged changes notifies before and after with the changed paths
+  std::string val1 = "Value1";
+  std::string val2 = "Value2";
+  TEST_TRUE(MyConfig->Put(MyPath1, val1));
+  TEST_TRUE(MyConfig->Put(MyPath3, val2));
+  TEST_TRUE(MyConfig->IsModified());
+  TEST_TRUE(MyConfig->Commit());
+  TEST_FALSE(MyConfig->IsModified());
+  TEST_EQ(2, MyObserver.Ids.size());
+  TEST_EQ(zConfig::ConfigNotification::ID_PRECOMMIT, MyObserver.Ids[0]);
+  TEST_EQ(zConfig::ConfigNotification::ID_POSTCOMMIT, MyObserver.Ids[1]);
+  TEST_EQ(2, MyObserver.Paths.size());
+  TEST_EQ(MyPath1.Path(), MyObserver.Paths[0]);
+  TEST_EQ(MyPath3.Path(), MyObserver.Paths[1]);
+  TEST_EQ(val1, MyObserver.Working);
+
+  // Writing the same values again changes nothing and notifies nobody
+  MyObserver.Ids.clear();
+  TEST_TRUE(MyConfig->Put(MyPath1, val1));
+  TEST_TRUE(MyConfig->IsModified());
+  TEST_TRUE(MyConfig->Commit());
+  TEST_FALSE(MyConfig->IsModified());
+  TEST_EQ(0, MyObserver.Ids.size());
+
+  // Before the commit observers still see the old value, after it the new one
+  std::string obs;
+  TEST_TRUE(MyConfig->Put(MyPath1, val2));
+  TEST_TRUE(MyConfig->Put(MyPath3, val2));
+  TEST_TRUE(MyConfig->Put(MyPath2, val1));
+  MyObserver.Ids.clear();
+  TEST_TRUE(MyConfig->Commit());
+  TEST_EQ(2, MyObserver.Ids.size());
+  TEST_EQ(val2, MyObserver.Working);
+  TEST_TRUE(MyConfig->Get(MyPath1, obs));
+  TEST_EQ(val2, obs);
+
+  // A parent path covers the paths below it
+  TEST_EQ(2, MyObserver.Paths.size());
+  TEST_EQ(MyPath1.Path(), MyObserver.Paths[0]);
+  TEST_EQ(MyPath2.Path(), MyObserver.Paths[1]);
+
+  // Restore drops staged changes
+  MyObserver.Ids.clear();
+  TEST_TRUE(MyConfig->Put(MyPath1, val1));
+  TEST_TRUE(MyConfig->Restore());
+  TEST_FALSE(MyConfig->IsModified());
+  TEST_TRUE(MyConfig->Commit());
+  TEST_EQ(0, MyObserver.Ids.size());
+  TEST_TRUE(MyConfig->Get(MyPath1, obs));
+  TEST_EQ(val2, obs);
+
+  // Writes staged while observers are told of a commit go in with it
+  MyHandler.UnregisterObserver(&MyObserver);
+  StagingObserver MyStager;
+  MyHandler.RegisterObserver(&MyStager);
+  zConfig::ConfigPath MyPath4;
+  TEST_TRUE(MyPath4.Append("Key3"));
+  TEST_TRUE(MyConfig->Put(MyPath1, val1));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_FALSE(MyConfig->IsModified());
+  TEST_EQ(2, MyStager.Paths.size());
+  TEST_EQ(MyPath1.Path(), MyStager.Paths[0]);
+  TEST_EQ(MyPath4.Path(), MyStager.Paths[1]);
+  TEST_TRUE(MyConfig->Get(MyPath4, obs));
+  TEST_EQ(std::string("Staged"), obs);
+
+  // Cleanup
+  MyHandler.UnregisterObserver(&MyStager);
+  MyHandler.UnregisterEvent(MyConfig);
+  delete (MyConfig);
+
+  // Return success
+  return (0);
+}
+
+static void
+_snapshot_reader(zConfig::Configuration* config_, ATOMIC(bool)* stop_, ATOMIC(int)* errors_)
+{
+  zConfig::ConfigPath path1;
+  path1.Append("Key1");
+  zConfig::ConfigPath path2;
+  path2.Append("Key2");
+  while (!*stop_)
+  {
+    // Both keys are committed together so one snapshot always has them equal
+    SHARED_PTR(const zData::Snapshot) snap = config_->GetSnapshot();
+    int val1 = -1;
+    int val2 = -2;
+    if (snap->GetValue(path1.GetDataPath(), val1) && (!snap->GetValue(path2.GetDataPath(), val2)
+        || (val1 != val2)))
+    {
+      (*errors_)++;
+    }
+  }
+}
+
+int
+zConfigTest_ConfigurationSnapshot(void* arg_)
+{
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zConfigTest_ConfigurationSnapshot()");
+  ZLOG_DEBUG("#############################################################");
+
+  zConfig::ConfigPath MyPath1;
+  TEST_TRUE(MyPath1.Append("Key1"));
+  zConfig::ConfigPath MyPath2;
+  TEST_TRUE(MyPath2.Append("Key2"));
+
+  zConfig::Configuration *MyConfig = new zConfig::Configuration;
+  TEST_ISNOT_NULL(MyConfig);
+
+  // A snapshot is the committed configuration and does not change after
+  SHARED_PTR(const zData::Snapshot) snap = MyConfig->GetSnapshot();
+  TEST_TRUE(snap != NULL);
+  int val = 1;
+  TEST_TRUE(MyConfig->Put(MyPath1, val));
+  TEST_TRUE(MyConfig->Put(MyPath2, val));
+  TEST_FALSE(MyConfig->Get(MyPath1, val));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_TRUE(MyConfig->Get(MyPath1, val));
+  TEST_EQ(1, val);
+  TEST_FALSE(snap->GetValue(MyPath1.GetDataPath(), val));
+  snap = MyConfig->GetSnapshot();
+  TEST_TRUE(snap->GetValue(MyPath1.GetDataPath(), val));
+
+  // Readers on other threads always see whole commits
+  ATOMIC(bool) stop(false);
+  ATOMIC(int) errors(0);
+  std::thread reader1(_snapshot_reader, MyConfig, &stop, &errors);
+  std::thread reader2(_snapshot_reader, MyConfig, &stop, &errors);
+  for (int i = 0; i < 200; i++)
+  {
+    TEST_TRUE(MyConfig->Put(MyPath1, i));
+    TEST_TRUE(MyConfig->Put(MyPath2, i));
+    TEST_TRUE(MyConfig->Commit());
+  }
+  stop = true;
+  reader1.join();
+  reader2.join();
+  TEST_EQ(0, errors);
+  TEST_TRUE(MyConfig->Get(MyPath2, val));
+  TEST_EQ(199, val);
+
+  // Cleanup
+  delete (MyConfig);
+
+  // Return success
+  return (0);
+}
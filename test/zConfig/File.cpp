@@ -93,3 +93,139 @@ zConfigTest_FileLoadStore(void* arg_)
   return (0);
 
 }
+
+int
+zConfigTest_FileLoadStoreBinary(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zConfigTest_FileLoadStoreBinary()");
+  ZLOG_DEBUG("#############################################################");
+
+  zConfig::ConfigPath MyPath1;
+  TEST_TRUE(MyPath1.Append("Key1"));
+
+  zConfig::ConfigPath MyPath2;
+  TEST_TRUE(MyPath2.Append("Key2"));
+
+  // Create configuration data
+  zConfig::ConfigData *ExpData = new zConfig::ConfigData;
+  TEST_ISNOT_NULL(ExpData);
+  TEST_TRUE(ExpData->PutValue(MyPath1.GetDataPath(), std::string("Value1")));
+  TEST_TRUE(ExpData->PutValue(MyPath2.GetDataPath(), 2));
+
+  // Store in binary form and load back
+  TestConnector *MyConnector = new TestConnector(zData::Data::FORMAT_BINARY);
+  TEST_ISNOT_NULL(MyConnector);
+  TEST_TRUE(MyConnector->Store(*ExpData));
+
+  zConfig::ConfigData *ObsData = new zConfig::ConfigData;
+  TEST_ISNOT_NULL(ObsData);
+  TEST_TRUE(MyConnector->Load(*ObsData));
+  TEST_TRUE(*ObsData == *ExpData);
+  delete (ObsData);
+
+  // A JSON connector loads the binary file as well
+  zConfig::ConfigurationFileConnector *JsonConnector =
+      new zConfig::ConfigurationFileConnector(TESTDIR + "/" + TESTFILE);
+  TEST_ISNOT_NULL(JsonConnector);
+  ObsData = new zConfig::ConfigData;
+  TEST_ISNOT_NULL(ObsData);
+  TEST_TRUE(JsonConnector->Load(*ObsData));
+  TEST_TRUE(*ObsData == *ExpData);
+  TEST_EQ(ExpData->GetJson(), ObsData->GetJson());
+
+  // Cleanup
+  delete (JsonConnector);
+  delete (MyConnector);
+  delete (ObsData);
+  delete (ExpData);
+
+  // Return success
+  return (0);
+
+}
+
+int
+zConfigTest_FileLoadStoreAtomic(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zConfigTest_FileLoadStoreAtomic()");
+  ZLOG_DEBUG("#############################################################");
+
+  struct stat st = { 0 };
+  std::string fileName = TESTDIR + "/" + TESTFILE;
+  mkdir(TESTDIR.c_str(), 0777);
+  unlink(fileName.c_str());
+
+  zConfig::ConfigPath MyPath1;
+  TEST_TRUE(MyPath1.Append("Key1"));
+
+  zConfig::ConfigPath MyPath2;
+  TEST_TRUE(MyPath2.Append("Key2"));
+
+  zConfig::ConfigData *ExpData = new zConfig::ConfigData;
+  TEST_ISNOT_NULL(ExpData);
+  TEST_TRUE(ExpData->PutValue(MyPath1.GetDataPath(), std::string("Value1")));
+  TEST_TRUE(ExpData->PutValue(MyPath2.GetDataPath(), 2));
+  zConfig::ConfigData *ObsData = new zConfig::ConfigData;
+  TEST_ISNOT_NULL(ObsData);
+
+  // Missing and empty files do not load
+  zConfig::ConfigurationAtomicFileConnector *MyConnector =
+      new zConfig::ConfigurationAtomicFileConnector(fileName);
+  TEST_ISNOT_NULL(MyConnector);
+  TEST_FALSE(MyConnector->Load(*ObsData));
+  std::fstream fs(fileName.c_str(), std::fstream::out);
+  fs.close();
+  TEST_FALSE(MyConnector->Load(*ObsData));
+
+  // Store replaces the file, keeping its permissions, and leaves nothing behind
+  chmod(fileName.c_str(), 0640);
+  TEST_TRUE(MyConnector->Store(*ExpData));
+  TEST_EQ(0, stat(fileName.c_str(), &st));
+  TEST_EQ(0640, (st.st_mode & 0777));
+  TEST_TRUE(MyConnector->Load(*ObsData));
+  TEST_TRUE(*ObsData == *ExpData);
+  TEST_EQ(-1, rmdir(TESTDIR.c_str()));
+  TEST_EQ(0, unlink(fileName.c_str()));
+  TEST_EQ(0, rmdir(TESTDIR.c_str()));
+  mkdir(TESTDIR.c_str(), 0777);
+
+  // Binary form round trips and is readable by the plain file connector
+  zConfig::ConfigurationAtomicFileConnector *BinConnector =
+      new zConfig::ConfigurationAtomicFileConnector(fileName, zData::Data::FORMAT_BINARY);
+  TEST_ISNOT_NULL(BinConnector);
+  TEST_TRUE(BinConnector->Store(*ExpData));
+  zConfig::ConfigData *BinData = new zConfig::ConfigData;
+  TEST_ISNOT_NULL(BinData);
+  TEST_TRUE(MyConnector->Load(*BinData));
+  TEST_TRUE(*BinData == *ExpData);
+  delete (BinData);
+  BinData = new zConfig::ConfigData;
+  TEST_ISNOT_NULL(BinData);
+  zConfig::ConfigurationFileConnector FileConnector(fileName);
+  TEST_TRUE(FileConnector.Load(*BinData));
+  TEST_TRUE(*BinData == *ExpData);
+
+  // A file that does not parse leaves the data unchanged
+  fs.open(fileName.c_str(), std::fstream::out);
+  fs << "{\"zData\":";
+  fs.close();
+  TEST_FALSE(MyConnector->Load(*BinData));
+  TEST_TRUE(*BinData == *ExpData);
+
+  // Cleanup
+  unlink(fileName.c_str());
+  rmdir(TESTDIR.c_str());
+  delete (BinData);
+  delete (BinConnector);
+  delete (MyConnector);
+  delete (ObsData);
+  delete (ExpData);
+
+  // Return success
+  return (0);
+
+}
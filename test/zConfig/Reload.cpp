@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zutils/zLog.h>
+using namespace zUtils;
+ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
+
+#include "UnitTest.h"
+#include "zConfTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+class ReloadObserver : public zEvent::Observer
+{
+
+public:
+
+  ReloadObserver() :
+      _lock(zSem::Mutex::LOCKED)
+  {
+    this->_lock.Unlock();
+  }
+
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
+  {
+    if (n_->GetType() != zEvent::Event::TYPE_CONFIG)
+    {
+      return (false);
+    }
+    zConfig::ConfigNotification* n = (zConfig::ConfigNotification*) n_.get();
+    this->_lock.Lock();
+    this->_ids.push_back(n->Id());
+    this->_paths = n->ChangedPaths();
+    this->_lock.Unlock();
+    return (true);
+  }
+
+  std::vector<zConfig::ConfigNotification::ID>
+  Ids()
+  {
+    this->_lock.Lock();
+    std::vector<zConfig::ConfigNotification::ID> ids(this->_ids);
+    this->_ids.clear();
+    this->_lock.Unlock();
+    return (ids);
+  }
+
+  std::vector<std::string>
+  Paths()
+  {
+    this->_lock.Lock();
+    std::vector<std::string> paths(this->_paths);
+    this->_lock.Unlock();
+    return (paths);
+  }
+
+private:
+
+  zSem::Mutex _lock;
+  std::vector<zConfig::ConfigNotification::ID> _ids;
+  std::vector<std::string> _paths;
+
+};
+
+// Waits for the connector to have reloaded count_ times in all, at most msecs_
+static bool
+_reloaded(const zConfig::ConfigurationReloadConnector* conn_, const uint64_t count_,
+    const int msecs_)
+{
+  for (int i = 0; (i < msecs_) && (conn_->Reloads() < count_); i++)
+  {
+    usleep(1000);
+  }
+  return (conn_->Reloads() >= count_);
+}
+
+int
+zConfigTest_FileReload(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zConfigTest_FileReload()");
+  ZLOG_DEBUG("#############################################################");
+
+  std::string fileName = TESTDIR + "/" + TESTFILE;
+  mkdir(TESTDIR.c_str(), 0777);
+  unlink(fileName.c_str());
+
+  zConfig::ConfigPath MyPath1;
+  TEST_TRUE(MyPath1.Append("Key1"));
+  zConfig::ConfigPath MyPath2;
+  TEST_TRUE(MyPath2.Append("Key2"));
+
+  zConfig::ConfigData MyData;
+  TEST_TRUE(MyData.PutValue(MyPath1.GetDataPath(), std::string("Value1")));
+  TEST_TRUE(MyData.PutValue(MyPath2.GetDataPath(), std::string("Value2")));
+  zConfig::ConfigurationAtomicFileConnector Writer(fileName);
+  TEST_TRUE(Writer.Store(MyData));
+
+  zConfig::Configuration *MyConfig = new zConfig::Configuration;
+  TEST_ISNOT_NULL(MyConfig);
+  ReloadObserver MyObserver;
+  zEvent::Handler MyHandler;
+  MyHandler.RegisterEvent(MyConfig);
+  MyHandler.RegisterObserver(&MyObserver);
+
+  zConfig::ConfigurationReloadConnector *MyConnector =
+      new zConfig::ConfigurationReloadConnector(*MyConfig, fileName, 200);
+  TEST_ISNOT_NULL(MyConnector);
+  TEST_TRUE(MyConfig->Connect(MyConnector));
+  TEST_TRUE(MyConfig->Load());
+  TEST_TRUE(MyConfig->Commit());
+  TEST_TRUE(MyConnector->Start());
+  TEST_FALSE(MyConnector->Start());
+  TEST_EQ(uint64_t(0), MyConnector->Reloads());
+  MyObserver.Ids();
+
+  // A burst of writes is reloaded once, staging only what changed
+  TEST_TRUE(MyData.PutValue(MyPath2.GetDataPath(), std::string("Value3")));
+  TEST_TRUE(Writer.Store(MyData));
+  TEST_TRUE(MyData.PutValue(MyPath2.GetDataPath(), std::string("Value4")));
+  TEST_TRUE(Writer.Store(MyData));
+  std::fstream fs(fileName.c_str(), std::fstream::out);
+  fs << MyData.GetJsonPretty();
+  fs.close();
+  TEST_TRUE(_reloaded(MyConnector, 1, 10000));
+  TEST_EQ(uint64_t(1), MyConnector->Reloads());
+
+  std::vector<zConfig::ConfigNotification::ID> ids = MyObserver.Ids();
+  TEST_EQ(4, ids.size());
+  TEST_EQ(zConfig::ConfigNotification::ID_LOAD, ids[0]);
+  TEST_EQ(zConfig::ConfigNotification::ID_PRECOMMIT, ids[1]);
+  TEST_EQ(zConfig::ConfigNotification::ID_POSTCOMMIT, ids[2]);
+  TEST_EQ(zConfig::ConfigNotification::ID_POSTLOAD, ids[3]);
+  TEST_EQ(1, MyObserver.Paths().size());
+  TEST_EQ(MyPath2.Path(), MyObserver.Paths()[0]);
+  std::string obs;
+  TEST_TRUE(MyConfig->Get(MyPath2, obs));
+  TEST_EQ(std::string("Value4"), obs);
+  TEST_FALSE(MyConfig->IsModified());
+
+  // Storing the configuration reloads an unchanged tree, which is not announced
+  TEST_TRUE(MyConfig->Store());
+  TEST_TRUE(_reloaded(MyConnector, 2, 10000));
+  TEST_EQ(0, MyObserver.Ids().size());
+
+  // Files that do not parse are ignored
+  fs.open(fileName.c_str(), std::fstream::out);
+  fs << "{\"zData\":";
+  fs.close();
+  TEST_TRUE(_reloaded(MyConnector, 3, 10000));
+  TEST_EQ(0, MyObserver.Ids().size());
+  TEST_TRUE(MyConfig->Get(MyPath2, obs));
+  TEST_EQ(std::string("Value4"), obs);
+
+  // Stopped connectors no longer watch the file
+  TEST_TRUE(MyConnector->Stop());
+  TEST_FALSE(MyConnector->Stop());
+  TEST_TRUE(MyData.PutValue(MyPath1.GetDataPath(), std::string("Value5")));
+  TEST_TRUE(Writer.Store(MyData));
+  TEST_EQ(uint64_t(3), MyConnector->Reloads());
+  TEST_EQ(0, MyObserver.Ids().size());
+
+  // Cleanup
+  MyHandler.UnregisterObserver(&MyObserver);
+  MyHandler.UnregisterEvent(MyConfig);
+  TEST_TRUE(MyConfig->Disconnect());
+  delete (MyConnector);
+  delete (MyConfig);
+  unlink(fileName.c_str());
+  rmdir(TESTDIR.c_str());
+
+  // Return success
+  return (0);
+
+}
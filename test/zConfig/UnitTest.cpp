@@ -42,11 +42,17 @@ main(int argc, const char **argv)
   UTEST_TEST(zConfigTest_ConfigDataGetPutChild, 0);
 
   UTEST_TEST(zConfigTest_FileLoadStore, 0);
+  UTEST_TEST(zConfigTest_FileLoadStoreBinary, 0);
+  UTEST_TEST(zConfigTest_FileLoadStoreAtomic, 0);
+  UTEST_TEST(zConfigTest_FileReload, 0);
 
   UTEST_TEST(zConfigTest_ConnectorDefaults, 0);
   UTEST_TEST(zConfigTest_ConfigurationCtor, 0);
   UTEST_TEST(zConfigTest_ConfigurationGetSetData, 0);
   UTEST_TEST(zConfigTest_ConfigurationCompare, 0);
+  UTEST_TEST(zConfigTest_ConfigurationCommitNotify, 0);
+  UTEST_TEST(zConfigTest_ConfigurationWatch, 0);
+  UTEST_TEST(zConfigTest_ConfigurationSnapshot, 0);
   UTEST_TEST(zConfigTest_ConfigurationDataArray, 0);
   UTEST_TEST(zConfigTest_ConfigurationLoadStore, 0);
 
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zutils/zLog.h>
+using namespace zUtils;
+ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
+
+#include "UnitTest.h"
+#include "zConfTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+class WatchObserver : public zEvent::Observer
+{
+
+public:
+
+  WatchObserver() :
+      Count(0), _lock(zSem::Mutex::LOCKED)
+  {
+    this->_lock.Unlock();
+  }
+
+  int Count;
+  std::vector<std::string> Paths;
+
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
+  {
+    if (n_->GetType() != zEvent::Event::TYPE_CONFIG)
+    {
+      return (false);
+    }
+    zConfig::ConfigNotification* n = (zConfig::ConfigNotification*) n_.get();
+    if (n->Id() != zConfig::ConfigNotification::ID_COMMIT)
+    {
+      return (false);
+    }
+    this->_lock.Lock();
+    this->Count++;
+    this->Paths = n->ChangedPaths();
+    this->_lock.Unlock();
+    return (true);
+  }
+
+  int
+  GetCount()
+  {
+    this->_lock.Lock();
+    int count = this->Count;
+    this->_lock.Unlock();
+    return (count);
+  }
+
+  // Waits for count_ notifications in all, at most msecs_
+  bool
+  WaitCount(const int count_, const int msecs_)
+  {
+    for (int i = 0; (i < msecs_) && (this->GetCount() < count_); i++)
+    {
+      usleep(1000);
+    }
+    return (this->GetCount() >= count_);
+  }
+
+  void
+  Clear()
+  {
+    this->_lock.Lock();
+    this->Count = 0;
+    this->Paths.clear();
+    this->_lock.Unlock();
+  }
+
+private:
+
+  zSem::Mutex _lock;
+
+};
+
+int
+zConfigTest_ConfigurationWatch(void* arg_)
+{
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zConfigTest_ConfigurationWatch()");
+  ZLOG_DEBUG("#############################################################");
+
+  zConfig::ConfigPath NetPath;
+  TEST_TRUE(NetPath.Append("Net"));
+  zConfig::ConfigPath AddrPath(NetPath);
+  TEST_TRUE(AddrPath.Append("Addr"));
+  zConfig::ConfigPath PortPath(NetPath);
+  TEST_TRUE(PortPath.Append("Port"));
+  zConfig::ConfigPath LogPath;
+  TEST_TRUE(LogPath.Append("Log"));
+
+  zConfig::Configuration *MyConfig = new zConfig::Configuration;
+  TEST_ISNOT_NULL(MyConfig);
+
+  WatchObserver NetObserver;
+  WatchObserver AddrObserver;
+  WatchObserver LogObserver;
+  TEST_TRUE(MyConfig->Watch(NetPath, &NetObserver));
+  TEST_FALSE(MyConfig->Watch(NetPath, &NetObserver));
+  TEST_TRUE(MyConfig->Watch(AddrPath, &AddrObserver));
+  TEST_TRUE(MyConfig->Watch(LogPath, &LogObserver));
+  TEST_FALSE(MyConfig->Watch(LogPath, NULL));
+
+  // Only watchers whose prefix intersects the changed paths are notified
+  std::string val1 = "Value1";
+  std::string val2 = "Value2";
+  TEST_TRUE(MyConfig->Put(PortPath, val1));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_EQ(1, NetObserver.GetCount());
+  TEST_EQ(1, NetObserver.Paths.size());
+  TEST_EQ(PortPath.Path(), NetObserver.Paths[0]);
+  TEST_EQ(0, AddrObserver.GetCount());
+  TEST_EQ(0, LogObserver.GetCount());
+
+  // A change above the prefix reaches the watchers below it
+  NetObserver.Clear();
+  zConfig::ConfigData NetData;
+  zConfig::ConfigPath DataAddrPath;
+  TEST_TRUE(DataAddrPath.Append("Addr"));
+  TEST_TRUE(NetData.PutValue(DataAddrPath, val2));
+  TEST_TRUE(MyConfig->Put(NetPath, (const zConfig::ConfigData&) NetData));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_EQ(1, NetObserver.GetCount());
+  TEST_EQ(1, AddrObserver.GetCount());
+  TEST_EQ(NetPath.Path(), AddrObserver.Paths[0]);
+  TEST_EQ(0, LogObserver.GetCount());
+
+  // Unchanged commits notify nobody and unwatched observers are not called
+  NetObserver.Clear();
+  AddrObserver.Clear();
+  TEST_TRUE(MyConfig->Unwatch(AddrPath, &AddrObserver));
+  TEST_FALSE(MyConfig->Unwatch(AddrPath, &AddrObserver));
+  TEST_TRUE(MyConfig->Put(AddrPath, val1));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_EQ(1, NetObserver.GetCount());
+  TEST_EQ(0, AddrObserver.GetCount());
+  NetObserver.Clear();
+  TEST_TRUE(MyConfig->Put(AddrPath, val1));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_EQ(0, NetObserver.GetCount());
+
+  // Commits inside the debounce window are coalesced into one notification
+  WatchObserver SlowObserver;
+  TEST_TRUE(MyConfig->Unwatch(NetPath, &NetObserver));
+  TEST_TRUE(MyConfig->Watch(NetPath, &SlowObserver, 1000));
+  TEST_TRUE(MyConfig->Put(AddrPath, val2));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_TRUE(MyConfig->Put(PortPath, val2));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_TRUE(MyConfig->Put(LogPath, val2));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_EQ(0, SlowObserver.GetCount());
+  TEST_EQ(1, LogObserver.GetCount());
+  TEST_TRUE(SlowObserver.WaitCount(1, 10000));
+  TEST_EQ(1, SlowObserver.GetCount());
+  TEST_EQ(2, SlowObserver.Paths.size());
+  TEST_EQ(AddrPath.Path(), SlowObserver.Paths[0]);
+  TEST_EQ(PortPath.Path(), SlowObserver.Paths[1]);
+
+  // A later commit opens a new window
+  TEST_TRUE(MyConfig->Put(PortPath, val1));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_TRUE(SlowObserver.WaitCount(2, 10000));
+  TEST_EQ(2, SlowObserver.GetCount());
+
+  // A pending notification is dropped when the watcher is removed; a watcher
+  //   with a longer window shows when the removed one would have fired
+  WatchObserver LateObserver;
+  TEST_TRUE(MyConfig->Watch(NetPath, &LateObserver, 1500));
+  TEST_TRUE(MyConfig->Put(PortPath, val2));
+  TEST_TRUE(MyConfig->Commit());
+  TEST_TRUE(MyConfig->Unwatch(NetPath, &SlowObserver));
+  TEST_TRUE(LateObserver.WaitCount(1, 10000));
+  TEST_EQ(2, SlowObserver.GetCount());
+
+  // Cleanup
+  delete (MyConfig);
+
+  // Return success
+  return (0);
+}
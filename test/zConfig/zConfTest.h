@@ -48,6 +48,12 @@ zConfigTest_ConfigDataGetPutChild(void* arg_);
 
 int
 zConfigTest_FileLoadStore(void* arg_);
+int
+zConfigTest_FileLoadStoreBinary(void* arg_);
+int
+zConfigTest_FileLoadStoreAtomic(void* arg_);
+int
+zConfigTest_FileReload(void* arg_);
 
 int
 zConfigTest_ConfigurationCtor(void* arg_);
@@ -56,6 +62,12 @@ zConfigTest_ConfigurationGetSetData(void* arg_);
 int
 zConfigTest_ConfigurationCompare(void* arg_);
 int
+zConfigTest_ConfigurationCommitNotify(void* arg_);
+int
+zConfigTest_ConfigurationWatch(void* arg_);
+int
+zConfigTest_ConfigurationSnapshot(void* arg_);
+int
 zConfigTest_ConfigurationDataArray(void* arg_);
 int
 zConfigTest_ConfigurationLoadStore(void* arg_);
@@ -70,8 +82,8 @@ class TestConnector : public zConfig::ConfigurationFileConnector
 {
 
 public:
-  TestConnector() :
-      zConfig::ConfigurationFileConnector(TESTDIR + "/" + TESTFILE)
+  TestConnector(const zData::Data::FORMAT format_ = zData::Data::FORMAT_JSON) :
+      zConfig::ConfigurationFileConnector(TESTDIR + "/" + TESTFILE, format_)
   {
     struct stat st = { 0 };
     std::fstream fs;
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zutils/zLog.h>
+using namespace zUtils;
+ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
+
+#include <zutils/zData.h>
+#include <zutils/zDataBinary.h>
+
+#include "UnitTest.h"
+#include "zDataTest.h"
+
+using namespace zUtils;
+
+int
+zDataTest_BinaryRoundTrip(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_BinaryRoundTrip()");
+  ZLOG_DEBUG("#############################################################");
+
+  const std::string json("{\"zData\":{\"Name\":\"a \\\"quoted\\\" name that is longer than thirty-one bytes\","
+      "\"Int\":\"-12\",\"Empty\":\"\",\"Array\":[\"1\",\"two\",{\"Three\":\"3\"}],"
+      "\"Nested\":{\"Key\":\"Value\"},\"Dup\":\"1\",\"Dup\":\"2\"}}\n");
+
+  // JSON to binary and back is lossless
+  zData::Data MyData;
+  TEST_TRUE(MyData.SetJson(json));
+  TEST_EQ(json, MyData.GetJson());
+
+  std::string bin = MyData.GetBinary();
+  TEST_FALSE(bin.empty());
+  TEST_TRUE(zData::BinaryReader::Detect(bin.data(), bin.size()));
+  TEST_FALSE(zData::BinaryReader::Detect(json.data(), json.size()));
+  TEST_TRUE(bin.size() < json.size());
+
+  zData::Data MyData2;
+  TEST_TRUE(MyData2.SetBinary(bin));
+  TEST_EQ(json, MyData2.GetJson());
+  TEST_TRUE(MyData == MyData2);
+  TEST_EQ(bin, MyData2.GetBinary());
+
+  // Large containers and strings use the wider encodings
+  zData::Data MyData3;
+  for (int i = 0; i < 300; i++)
+  {
+    TEST_TRUE(MyData3.PutValue(zData::DataPath("Key" + zLog::IntStr(i)), std::string(i, 'x')));
+  }
+  TEST_TRUE(MyData3.PutValue(zData::DataPath("Big"), std::string(70000, 'y')));
+  bin = MyData3.GetBinary();
+  TEST_TRUE(MyData2.SetBinary(bin.data(), bin.size()));
+  TEST_EQ(MyData3.GetJson(), MyData2.GetJson());
+
+  // Typed documents keep their types
+  zData::Document MyDoc;
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Bool"), true));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Small"), -5));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Large"), 5000000000L));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Negative"), -70000));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Double"), 0.1));
+  TEST_NEQ(zData::Document::NoNode, MyDoc.SetNull(MyDoc.Create(zData::DataPath("Null"))));
+  bin.clear();
+  TEST_TRUE(zData::BinaryWriter::Write(MyDoc, bin));
+
+  zData::Document MyDoc2;
+  zData::DocumentJsonHandler handler(MyDoc2);
+  zData::BinaryReader reader;
+  TEST_TRUE(reader.Parse(bin, handler));
+  std::string exp;
+  std::string obs;
+  TEST_TRUE(zData::JsonWriter::Write(MyDoc, exp));
+  TEST_TRUE(zData::JsonWriter::Write(MyDoc2, obs));
+  TEST_EQ(exp, obs);
+  double dval = 0.0;
+  TEST_TRUE(MyDoc2.GetValue(zData::DataPath("Double"), dval));
+  TEST_EQ(0.1, dval);
+  long lval = 0;
+  TEST_TRUE(MyDoc2.GetValue(zData::DataPath("Large"), lval));
+  TEST_EQ(5000000000L, lval);
+
+  // Malformed input is rejected
+  zData::pt::ptree pt;
+  zData::PtreeJsonHandler ph(pt);
+  TEST_FALSE(reader.Parse(bin.substr(0, bin.size() - 1), ph));
+  TEST_FALSE(reader.ErrorMessage().empty());
+  TEST_FALSE(MyData2.SetBinary(bin + '\x01'));
+  TEST_FALSE(MyData2.SetBinary(std::string("\x81\x01\x01", 3)));
+  TEST_FALSE(MyData2.SetBinary(std::string("\xd4\x00\x00", 3)));
+
+  // Return success
+  return (0);
+
+}
+
+int
+zDataTest_BinaryView(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_BinaryView()");
+  ZLOG_DEBUG("#############################################################");
+
+  zData::Data MyData;
+  TEST_TRUE(MyData.PutValue(zData::DataPath("Name"), std::string("Value")));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("Int"), 42));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("Flag"), true));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("Nested.Real"), 2.5));
+  std::string bin = MyData.GetBinary();
+
+  // Invalid buffers give an invalid view
+  zData::BinaryView BadView(bin.data(), (bin.size() - 1));
+  TEST_FALSE(BadView.Valid());
+  TEST_FALSE(BadView.Find(zData::DataPath("Name")).Valid());
+
+  zData::BinaryView MyView(bin.data(), bin.size());
+  TEST_TRUE(MyView.Valid());
+  TEST_EQ(zData::Document::TYPE_OBJECT, MyView.GetType());
+  TEST_EQ(1, MyView.Size());
+
+  // Strings are returned in place
+  const char* str = NULL;
+  size_t len = 0;
+  zData::BinaryView name = MyView.Find(zData::DataPath("Name"));
+  TEST_TRUE(name.Valid());
+  TEST_TRUE(name.GetValue(str, len));
+  TEST_EQ(5, len);
+  TEST_TRUE((str > bin.data()) && ((str + len) <= (bin.data() + bin.size())));
+  TEST_EQ(std::string("Value"), std::string(str, len));
+
+  // Values read through the same conversions as Data
+  int64_t ival = 0;
+  TEST_TRUE(MyView.GetValue(zData::DataPath("Int"), ival));
+  TEST_EQ(42, ival);
+  bool bval = false;
+  TEST_TRUE(MyView.GetValue(zData::DataPath("Flag"), bval));
+  TEST_TRUE(bval);
+  double dval = 0.0;
+  TEST_TRUE(MyView.GetValue(zData::DataPath("Nested.Real"), dval));
+  TEST_EQ(2.5, dval);
+  std::string sval;
+  TEST_FALSE(MyView.GetValue(zData::DataPath("Name"), ival));
+  TEST_FALSE(MyView.GetValue(zData::DataPath("Missing"), sval));
+  TEST_FALSE(MyView.GetValue(zData::DataPath("Nested"), sval));
+
+  // Children and keys by position
+  zData::BinaryView root = MyView.Find(std::string("zData"));
+  TEST_EQ(4, root.Size());
+  TEST_TRUE(root.GetKey(1, str, len));
+  TEST_EQ(std::string("Int"), std::string(str, len));
+  TEST_TRUE(root.GetChild(1).GetValue(sval));
+  TEST_EQ(std::string("42"), sval);
+  TEST_FALSE(root.GetChild(4).Valid());
+  TEST_FALSE(root.GetKey(4, str, len));
+
+  // Typed values from a document
+  zData::Document MyDoc;
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Neg"), -300));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Double"), 1.25));
+  bin.clear();
+  TEST_TRUE(zData::BinaryWriter::Write(MyDoc, bin));
+  zData::BinaryView DocView(bin.data(), bin.size());
+  TEST_EQ(zData::Document::TYPE_INT, DocView.Find(zData::DataPath("Neg")).GetType());
+  TEST_TRUE(DocView.GetValue(zData::DataPath("Neg"), ival));
+  TEST_EQ(-300, ival);
+  TEST_TRUE(DocView.GetValue(zData::DataPath("Neg"), sval));
+  TEST_EQ(std::string("-300"), sval);
+  TEST_EQ(zData::Document::TYPE_DOUBLE, DocView.Find(zData::DataPath("Double")).GetType());
+  TEST_TRUE(DocView.GetValue(zData::DataPath("Double"), sval));
+  TEST_EQ(std::string("1.25"), sval);
+
+  // Return success
+  return (0);
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zutils/zLog.h>
+using namespace zUtils;
+ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
+
+#include <zutils/zData.h>
+
+#include "UnitTest.h"
+#include "zDataTest.h"
+
+using namespace zUtils;
+
+int
+zDataTest_CompiledPath(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_CompiledPath()");
+  ZLOG_DEBUG("#############################################################");
+
+  zData::DataPath MyPath("Iface");
+  MyPath.Append("Mtu");
+  zData::CompiledPath MyCPath(MyPath);
+  TEST_EQ(MyPath.Path(), MyCPath.Path());
+  TEST_EQ(size_t(3), MyCPath.Keys().size());
+  TEST_EQ(zData::DataPath::DataRoot, MyCPath.Keys().front());
+  TEST_EQ(std::string("Mtu"), MyCPath.Keys().back());
+
+  // Missing values are not found
+  zData::Data MyData;
+  unsigned int mtu = 0;
+  TEST_FALSE(MyData.GetValue(MyCPath, mtu));
+
+  // Put through the compiled path and read back through both path types
+  TEST_TRUE(MyData.PutValue(MyCPath, 1500));
+  TEST_TRUE(MyData.GetValue(MyCPath, mtu));
+  TEST_EQ(1500, mtu);
+  mtu = 0;
+  TEST_TRUE(MyData.GetValue(MyPath, mtu));
+  TEST_EQ(1500, mtu);
+
+  // Repeated lookups use the cached node; value changes are seen
+  TEST_TRUE(MyData.PutValue(MyPath, 9000));
+  TEST_TRUE(MyData.GetValue(MyCPath, mtu));
+  TEST_EQ(9000, mtu);
+
+  // Replacing the subtree invalidates the cached node
+  zData::Data MyChild(zData::DataPath("Iface"));
+  TEST_TRUE(MyChild.PutValue(MyPath, 1280));
+  TEST_TRUE(MyData.PutChild(zData::DataPath("Iface"), MyChild));
+  TEST_TRUE(MyData.GetValue(MyCPath, mtu));
+  TEST_EQ(1280, mtu);
+  TEST_TRUE(MyData.Del(zData::DataPath("Iface")));
+  TEST_FALSE(MyData.GetValue(MyCPath, mtu));
+
+  // A compiled path may be shared between objects, including copies
+  TEST_TRUE(MyData.PutValue(MyCPath, 1500));
+  zData::Data MyCopy(MyData);
+  TEST_TRUE(MyCopy.PutValue(MyCPath, 576));
+  TEST_TRUE(MyData.GetValue(MyCPath, mtu));
+  TEST_EQ(1500, mtu);
+  TEST_TRUE(MyCopy.GetValue(MyCPath, mtu));
+  TEST_EQ(576, mtu);
+
+  // Conversion failures are reported rather than thrown
+  TEST_TRUE(MyData.PutValue(MyCPath, std::string("jumbo")));
+  TEST_FALSE(MyData.GetValue(MyCPath, mtu));
+
+  // Return success
+  return (0);
+
+}
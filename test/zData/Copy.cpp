@@ -14,11 +14,14 @@
  * limitations under the License.
  */
 
+#include <thread>
+
 #include <zutils/zLog.h>
 using namespace zUtils;
 ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
 
 #include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
 
 #include "UnitTest.h"
 #include "zDataTest.h"
@@ -76,3 +79,179 @@ zDataTest_DataCopy(void* arg)
 
 }
 
+int
+zDataTest_CopyOnWrite(void* arg)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_CopyOnWrite()");
+  ZLOG_DEBUG("#############################################################");
+
+  std::string obs;
+  zData::DataPath MyPath1("Key1");
+  zData::DataPath MyPath2("Key2");
+  zData::CompiledPath MyCompiled(MyPath1);
+
+  zData::Data MyData1;
+  TEST_TRUE(MyData1.PutValue(MyPath1, std::string("Value1")));
+  TEST_TRUE(MyData1.PutValue(MyPath2, std::string("Value2")));
+
+  // Copies are equal and independent once either side is modified
+  zData::Data MyData2(MyData1);
+  TEST_TRUE(MyData1 == MyData2);
+  TEST_TRUE(MyData2.PutValue(MyPath1, std::string("Changed")));
+  TEST_TRUE(MyData1.GetValue(MyPath1, obs));
+  TEST_EQ(std::string("Value1"), obs);
+  TEST_TRUE(MyData2.GetValue(MyPath1, obs));
+  TEST_EQ(std::string("Changed"), obs);
+  TEST_TRUE(MyData1 != MyData2);
+
+  zData::Data MyData3;
+  MyData3 = MyData1;
+  TEST_TRUE(MyData1 == MyData3);
+  TEST_TRUE(MyData1.Del(MyPath2));
+  TEST_TRUE(MyData3.GetValue(MyPath2, obs));
+  TEST_EQ(std::string("Value2"), obs);
+  TEST_TRUE(MyData1.GetValue(MyPath2, obs));
+  TEST_EQ(std::string(""), obs);
+
+  // Compiled paths follow the tree a copy is cloned into
+  TEST_TRUE(MyData1.GetValue(MyCompiled, obs));
+  TEST_EQ(std::string("Value1"), obs);
+  zData::Data MyData4(MyData1);
+  TEST_TRUE(MyData1.PutValue(MyCompiled, std::string("Compiled")));
+  TEST_TRUE(MyData4.GetValue(MyCompiled, obs));
+  TEST_EQ(std::string("Value1"), obs);
+  TEST_TRUE(MyData1.GetValue(MyCompiled, obs));
+  TEST_EQ(std::string("Compiled"), obs);
+  TEST_TRUE(MyData4.PutValue(MyCompiled, std::string("Other")));
+  TEST_TRUE(MyData1.GetValue(MyCompiled, obs));
+  TEST_EQ(std::string("Compiled"), obs);
+  TEST_TRUE(MyData4.GetValue(MyCompiled, obs));
+  TEST_EQ(std::string("Other"), obs);
+
+  // Replacing the contents of a copy leaves the original alone
+  zData::Data MyData5(MyData1);
+  TEST_TRUE(MyData5.SetJson(std::string("{\"zData\":{\"Key1\":\"Json\"}}")));
+  TEST_TRUE(MyData1.GetValue(MyPath1, obs));
+  TEST_EQ(std::string("Compiled"), obs);
+  zData::Document MyDoc(MyData3);
+  TEST_TRUE(MyDoc.PutValue(MyPath1, std::string("Document")));
+  zData::Data MyData6(MyData3);
+  TEST_TRUE(MyDoc.Store(MyData6));
+  TEST_TRUE(MyData6.GetValue(MyPath1, obs));
+  TEST_EQ(std::string("Document"), obs);
+  TEST_TRUE(MyData3.GetValue(MyPath1, obs));
+  TEST_EQ(std::string("Value1"), obs);
+
+  // Return success
+  return (0);
+
+}
+
+static void
+_diff_reader(zData::Data* a_, zData::Data* b_, int* diffs_)
+{
+  for (int i = 0; i < 2000; i++)
+  {
+    *diffs_ += a_->Diff(zData::DataPath(), *b_).size();
+    *diffs_ += !a_->Compare(zData::DataPath(), *b_);
+    *diffs_ += (*a_ != *b_);
+  }
+}
+
+int
+zDataTest_Diff(void* arg)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_Diff()");
+  ZLOG_DEBUG("#############################################################");
+
+  zData::Data MyData1;
+  TEST_TRUE(MyData1.PutValue(zData::DataPath("A.B"), std::string("1")));
+  TEST_TRUE(MyData1.PutValue(zData::DataPath("A.C"), std::string("2")));
+  TEST_TRUE(MyData1.PutValue(zData::DataPath("D"), std::string("3")));
+  TEST_TRUE(MyData1.AddValue(zData::DataPath("E"), std::string("4")));
+
+  // Shared and equal trees have no differences
+  zData::Data MyData2(MyData1);
+  TEST_TRUE(MyData1.Diff(zData::DataPath(), MyData2).empty());
+
+  // Only the changed leaves are reported, including added and removed keys
+  TEST_TRUE(MyData2.PutValue(zData::DataPath("A.C"), std::string("5")));
+  TEST_TRUE(MyData2.PutValue(zData::DataPath("F"), std::string("6")));
+  TEST_TRUE(MyData2.Del(zData::DataPath("D")));
+  std::vector<std::string> paths = MyData1.Diff(zData::DataPath(), MyData2);
+  TEST_EQ(3, paths.size());
+  TEST_EQ(zData::DataPath("A.C").Path(), paths[0]);
+  TEST_EQ(zData::DataPath("D").Path(), paths[1]);
+  TEST_EQ(zData::DataPath("F").Path(), paths[2]);
+
+  // Arrays are compared whole and missing subtrees on both sides are equal
+  TEST_TRUE(MyData2.AddValue(zData::DataPath("E"), std::string("7")));
+  paths = MyData1.Diff(zData::DataPath("E"), MyData2);
+  TEST_EQ(1, paths.size());
+  TEST_EQ(zData::DataPath("E").Path(), paths[0]);
+  TEST_TRUE(MyData1.Diff(zData::DataPath("G"), MyData2).empty());
+
+  // Comparing with itself and both ways at once cannot deadlock
+  TEST_TRUE(MyData1.Diff(zData::DataPath(), MyData1).empty());
+  TEST_TRUE(MyData1.Compare(zData::DataPath(), MyData1));
+  TEST_TRUE(MyData1 == MyData1);
+  int diffs1 = 0;
+  int diffs2 = 0;
+  std::thread reader1(_diff_reader, &MyData1, &MyData2, &diffs1);
+  std::thread reader2(_diff_reader, &MyData2, &MyData1, &diffs2);
+  reader1.join();
+  reader2.join();
+  TEST_EQ((2000 * 6), diffs1);
+  TEST_EQ(diffs1, diffs2);
+
+  // Return success
+  return (0);
+
+}
+
+int
+zDataTest_Snapshot(void* arg)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_Snapshot()");
+  ZLOG_DEBUG("#############################################################");
+
+  zData::Snapshot EmptySnap;
+  TEST_TRUE(EmptySnap.Empty());
+  std::string obs;
+  TEST_FALSE(EmptySnap.GetValue(zData::DataPath("Key"), obs));
+
+  zData::Data MyData;
+  TEST_TRUE(MyData.PutValue(zData::DataPath("Key"), std::string("Value1")));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("Child.Key"), 1));
+
+  // A snapshot keeps the values it was taken with
+  zData::Snapshot MySnap(MyData);
+  TEST_FALSE(MySnap.Empty());
+  TEST_EQ(MyData.GetJson(), MySnap.GetJson());
+  TEST_TRUE(MyData.PutValue(zData::DataPath("Key"), std::string("Value2")));
+  TEST_TRUE(MySnap.GetValue(zData::DataPath("Key"), obs));
+  TEST_EQ(std::string("Value1"), obs);
+  TEST_TRUE(MyData.GetValue(zData::DataPath("Key"), obs));
+  TEST_EQ(std::string("Value2"), obs);
+  int ival = 0;
+  TEST_TRUE(MySnap.GetValue(zData::DataPath("Child.Key"), ival));
+  TEST_EQ(1, ival);
+  TEST_FALSE(MySnap.GetValue(zData::DataPath("Missing"), obs));
+
+  // Children copy out of the snapshot
+  zData::Data MyChild(zData::DataPath("Copy"));
+  TEST_TRUE(MySnap.GetChild(zData::DataPath("Child"), MyChild));
+  TEST_TRUE(MyChild.GetValue(zData::DataPath("Copy.Key"), ival));
+  TEST_EQ(1, ival);
+  TEST_FALSE(MySnap.GetChild(zData::DataPath("Missing"), MyChild));
+
+  // Return success
+  return (0);
+
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zutils/zLog.h>
+using namespace zUtils;
+ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
+
+#include <zutils/zData.h>
+#include <zutils/zDataDocument.h>
+
+#include "UnitTest.h"
+#include "zDataTest.h"
+
+using namespace zUtils;
+
+int
+zDataTest_Document(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_Document()");
+  ZLOG_DEBUG("#############################################################");
+
+  zData::Document MyDoc;
+  TEST_EQ(zData::Document::TYPE_OBJECT, MyDoc.GetType(MyDoc.Root()));
+  TEST_IS_ZERO(MyDoc.Size(MyDoc.Root()));
+  TEST_EQ(zData::Document::NoNode, MyDoc.Find(zData::DataPath("Key")));
+
+  // Put typed values and validate they read back without conversion
+  zData::DataPath MyPath("Iface");
+  TEST_TRUE(MyDoc.PutValue(MyPath("Name"), std::string("eth0")));
+  TEST_TRUE(MyDoc.PutValue(MyPath("Mtu"), 1500));
+  TEST_TRUE(MyDoc.PutValue(MyPath("Up"), true));
+  TEST_TRUE(MyDoc.PutValue(MyPath("Ratio"), 0.5));
+  TEST_EQ(zData::Document::TYPE_STRING, MyDoc.GetType(MyDoc.Find(MyPath("Name"))));
+  TEST_EQ(zData::Document::TYPE_INT, MyDoc.GetType(MyDoc.Find(MyPath("Mtu"))));
+  TEST_EQ(zData::Document::TYPE_BOOL, MyDoc.GetType(MyDoc.Find(MyPath("Up"))));
+  TEST_EQ(zData::Document::TYPE_DOUBLE, MyDoc.GetType(MyDoc.Find(MyPath("Ratio"))));
+  TEST_EQ(size_t(4), MyDoc.Size(MyDoc.Find(MyPath)));
+
+  std::string name;
+  int mtu = 0;
+  bool up = false;
+  double ratio = 0.0;
+  std::string mtustr;
+  TEST_TRUE(MyDoc.GetValue(MyPath("Name"), name));
+  TEST_EQ(std::string("eth0"), name);
+  TEST_TRUE(MyDoc.GetValue(MyPath("Mtu"), mtu));
+  TEST_EQ(1500, mtu);
+  TEST_TRUE(MyDoc.GetValue(MyPath("Mtu"), mtustr));
+  TEST_EQ(std::string("1500"), mtustr);
+  TEST_TRUE(MyDoc.GetValue(MyPath("Up"), up));
+  TEST_TRUE(up);
+  TEST_TRUE(MyDoc.GetValue(MyPath("Ratio"), ratio));
+  TEST_EQ(0.5, ratio);
+  TEST_FALSE(MyDoc.GetValue(MyPath("Name"), mtu));
+  TEST_FALSE(MyDoc.GetValue(MyPath("Missing"), name));
+
+  // Overwrite and delete; garbage is reclaimed by compaction
+  TEST_TRUE(MyDoc.PutValue(MyPath("Name"), std::string("eth1")));
+  TEST_TRUE(MyDoc.Del(MyPath("Ratio")));
+  TEST_EQ(zData::Document::NoNode, MyDoc.Find(MyPath("Ratio")));
+  TEST_EQ(size_t(3), MyDoc.Size(MyDoc.Find(MyPath)));
+  size_t count = MyDoc.NodeCount();
+  MyDoc.Compact();
+  TEST_TRUE(MyDoc.NodeCount() < count);
+  TEST_TRUE(MyDoc.GetValue(MyPath("Name"), name));
+  TEST_EQ(std::string("eth1"), name);
+  TEST_TRUE(MyDoc.GetValue(MyPath("Mtu"), mtu));
+  TEST_EQ(1500, mtu);
+
+  // Arrays
+  zData::Document::Node arr = MyDoc.SetArray(MyDoc.Create(MyPath("Addrs")));
+  TEST_TRUE(arr != zData::Document::NoNode);
+  MyDoc.SetValue(MyDoc.Append(arr), std::string("10.0.0.1"));
+  MyDoc.SetValue(MyDoc.Append(arr), std::string("10.0.0.2"));
+  TEST_EQ(size_t(2), MyDoc.Size(arr));
+  TEST_TRUE(MyDoc.GetValue(MyDoc.GetChild(arr, 1), name));
+  TEST_EQ(std::string("10.0.0.2"), name);
+
+  // Round trip through Data and validate types are recovered
+  zData::Data MyData;
+  TEST_TRUE(MyDoc.Store(MyData));
+  TEST_EQ(std::string("eth1"), MyData.GetValue<std::string>("Iface.Name"));
+  TEST_EQ(1500, MyData.GetValue<int>("Iface.Mtu"));
+  TEST_EQ(std::string("true"), MyData.GetValue<std::string>("Iface.Up"));
+  TEST_EQ(ssize_t(2), MyData("Iface.Addrs").Size());
+
+  zData::Document MyDoc2(MyData);
+  TEST_EQ(zData::Document::TYPE_INT, MyDoc2.GetType(MyDoc2.Find(MyPath("Mtu"))));
+  TEST_EQ(zData::Document::TYPE_BOOL, MyDoc2.GetType(MyDoc2.Find(MyPath("Up"))));
+  TEST_EQ(zData::Document::TYPE_ARRAY, MyDoc2.GetType(MyDoc2.Find(MyPath("Addrs"))));
+  zData::Data MyData2;
+  TEST_TRUE(MyDoc2.Store(MyData2));
+  TEST_EQ(MyData.GetJson(), MyData2.GetJson());
+
+  // Without inference every leaf is a string, as in the property tree
+  zData::Document MyDoc3;
+  TEST_TRUE(MyDoc3.Load(MyData, false));
+  TEST_EQ(zData::Document::TYPE_STRING, MyDoc3.GetType(MyDoc3.Find(MyPath("Mtu"))));
+  TEST_TRUE(MyDoc3.GetValue(MyPath("Mtu"), mtu));
+  TEST_EQ(1500, mtu);
+
+  // A property tree node can have both data and children
+  zData::pt::ptree pt;
+  pt.put("Node", "value");
+  pt.put("Node.Child", "1");
+  zData::Document MyDoc4;
+  TEST_TRUE(MyDoc4.FromPtree(pt));
+  TEST_EQ(zData::Document::TYPE_OBJECT, MyDoc4.GetType(MyDoc4.Find(MyDoc4.Root(), "Node")));
+  TEST_TRUE(MyDoc4.GetValue(MyDoc4.Find(MyDoc4.Root(), "Node"), name));
+  TEST_EQ(std::string("value"), name);
+  MyDoc4.Compact();
+  zData::pt::ptree pt2;
+  TEST_TRUE(MyDoc4.ToPtree(pt2));
+  TEST_TRUE(pt == pt2);
+
+  // Unsigned values beyond the signed range do not wrap
+  unsigned long big = 0;
+  TEST_TRUE(MyDoc4.PutValue(MyPath("Big"), (unsigned long) UINT64_MAX));
+  TEST_TRUE(MyDoc4.GetValue(MyPath("Big"), big));
+  TEST_EQ((unsigned long) UINT64_MAX, big);
+  TEST_TRUE(MyDoc4.GetValue(MyPath("Big"), name));
+  TEST_EQ(std::string("18446744073709551615"), name);
+
+  // Nodes without children
+  zData::Document MyDoc5;
+  TEST_EQ(zData::Document::NoNode, MyDoc5.Find(MyDoc5.Root(), "Key"));
+  TEST_FALSE(MyDoc5.Del(MyDoc5.Root(), "Key"));
+
+  // Return success
+  return (0);
+
+}
+
+int
+zDataTest_DocumentStore(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_DocumentStore()");
+  ZLOG_DEBUG("#############################################################");
+
+  zData::DataPath MyPath("Iface");
+  zData::Data MyData(MyPath);
+  TEST_EQ(zData::Data::STORE_PTREE, MyData.GetStore());
+  TEST_TRUE(MyData.PutValue(MyPath("Name"), std::string("eth0")));
+  TEST_TRUE(MyData.PutValue(MyPath("Mtu"), 1500));
+  zData::Data MyOrig(MyData);
+
+  // Switching stores keeps the contents, values become typed
+  TEST_TRUE(MyData.SetStore(zData::Data::STORE_DOCUMENT));
+  TEST_EQ(zData::Data::STORE_DOCUMENT, MyData.GetStore());
+  TEST_TRUE(MyData == MyOrig);
+  TEST_EQ(std::string("{\"zData\":{\"Iface\":{\"Name\":\"eth0\",\"Mtu\":1500}}}\n"), MyData.GetJson());
+  TEST_EQ(ssize_t(2), MyData.Size());
+  TEST_FALSE(MyData.Empty());
+
+  // Values through the same API, including compiled paths
+  int mtu = 0;
+  std::string name;
+  zData::CompiledPath MtuPath(MyPath("Mtu"));
+  TEST_TRUE(MyData.GetValue(MtuPath, mtu));
+  TEST_EQ(1500, mtu);
+  TEST_TRUE(MyData.PutValue(MtuPath, 9000));
+  TEST_EQ(9000, MyData.GetValue<int>("Mtu"));
+  TEST_TRUE(MyData.GetValue(MyPath("Name"), name));
+  TEST_EQ(std::string("eth0"), name);
+  TEST_FALSE(MyData.GetValue(MyPath("Missing"), name));
+
+  // Missing children are logged from the document with debug logging on
+  zData::Data MyMissing;
+  zLog::Log::LEVEL level = zLog::Manager::Instance().GetMaxLevel(zLog::Log::MODULE_DATA);
+  zLog::Manager::Instance().SetMaxLevel(zLog::Log::MODULE_DATA, zLog::Log::LEVEL_DEBUG);
+  TEST_FALSE(MyData.GetChild(MyPath("Missing"), MyMissing));
+  zLog::Manager::Instance().SetMaxLevel(zLog::Log::MODULE_DATA, level);
+  TEST_TRUE(MyData.PutValue(MyPath("Big"), (unsigned long) UINT64_MAX));
+  TEST_EQ((unsigned long) UINT64_MAX, MyData.GetValue<unsigned long>("Big"));
+
+  // Copies share the document until written
+  zData::Data MyCopy(MyData);
+  TEST_EQ(zData::Data::STORE_DOCUMENT, MyCopy.GetStore());
+  TEST_TRUE(MyCopy == MyData);
+  TEST_TRUE(MyCopy.PutValue(MyPath("Name"), std::string("eth1")));
+  TEST_TRUE(MyCopy != MyData);
+  TEST_EQ(std::string("eth0"), MyData.GetValue<std::string>("Name"));
+  TEST_FALSE(MyData.Compare(MyPath("Name"), MyCopy));
+  TEST_TRUE(MyData.Compare(MyPath("Mtu"), MyCopy));
+  std::vector<std::string> diff = MyData.Diff(MyPath, MyCopy);
+  TEST_EQ(size_t(1), diff.size());
+  TEST_EQ(MyPath("Name").Path(), diff.front());
+
+  // Children keep the store of their parent
+  TEST_TRUE(MyData.PutValue(MyPath("Addr.Ip"), std::string("10.0.0.1")));
+  zData::Data MyAddr = MyData("Addr");
+  TEST_EQ(zData::Data::STORE_DOCUMENT, MyAddr.GetStore());
+  TEST_EQ(std::string("10.0.0.1"), MyAddr.GetValue<std::string>("Ip"));
+
+  // Encodings read back into either store
+  zData::Data MyData2(MyPath);
+  TEST_TRUE(MyData2.SetStore(zData::Data::STORE_DOCUMENT));
+  TEST_TRUE(MyData2.SetJson(MyData.GetJson()));
+  TEST_TRUE(MyData2 == MyData);
+  TEST_EQ(MyData.GetJson(), MyData2.GetJson());
+  TEST_TRUE(MyData2.SetStore(zData::Data::STORE_PTREE));
+  TEST_TRUE(MyData2 == MyData);
+  TEST_TRUE(MyData2.SetStore(zData::Data::STORE_DOCUMENT));
+  TEST_EQ(MyData.GetJson(), MyData2.GetJson());
+
+  // Repeated writes do not grow the document without bound
+  for (int i = 0; i < 10000; i++)
+  {
+    TEST_TRUE(MyData.PutValue(MtuPath, i));
+  }
+  zData::Document MyDoc(MyData);
+  TEST_TRUE(MyDoc.NodeCount() < 1000);
+  TEST_EQ(9999, MyData.GetValue<int>("Mtu"));
+
+  // A value put on a node with children keeps them
+  TEST_TRUE(MyData.PutValue(MyPath("Addr"), std::string("primary")));
+  TEST_EQ(std::string("primary"), MyData.GetValue<std::string>("Addr"));
+  TEST_EQ(std::string("10.0.0.1"), MyData.GetValue<std::string>("Addr.Ip"));
+
+  // Return success
+  return (0);
+
+}
+
+int
+zDataTest_DocumentTyped(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_DocumentTyped()");
+  ZLOG_DEBUG("#############################################################");
+
+  // Values put into a document store are encoded with their types
+  zData::Data MyData;
+  TEST_TRUE(MyData.SetStore(zData::Data::STORE_DOCUMENT));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("a"), 5));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("b"), true));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("c"), std::string("5")));
+  TEST_TRUE(MyData.PutValue(zData::DataPath("d"), 0.5));
+  std::string json("{\"zData\":{\"a\":5,\"b\":true,\"c\":\"5\",\"d\":0.5}}\n");
+  TEST_EQ(json, MyData.GetJson());
+
+  // JSON reads back into a document store with the same types
+  zData::Data MyJson;
+  TEST_TRUE(MyJson.SetStore(zData::Data::STORE_DOCUMENT));
+  TEST_TRUE(MyJson.SetJson(std::string("{\"zData\":{\"x\":1,\"y\":\"1\"}}")));
+  TEST_EQ(std::string("{\"zData\":{\"x\":1,\"y\":\"1\"}}\n"), MyJson.GetJson());
+  TEST_TRUE(MyJson.SetJson(json));
+  TEST_EQ(json, MyJson.GetJson());
+  zData::Document MyDoc(MyJson);
+  TEST_EQ(zData::Document::TYPE_INT, MyDoc.GetType(MyDoc.Find(zData::DataPath("a"))));
+  TEST_EQ(zData::Document::TYPE_BOOL, MyDoc.GetType(MyDoc.Find(zData::DataPath("b"))));
+  TEST_EQ(zData::Document::TYPE_STRING, MyDoc.GetType(MyDoc.Find(zData::DataPath("c"))));
+  TEST_EQ(zData::Document::TYPE_DOUBLE, MyDoc.GetType(MyDoc.Find(zData::DataPath("d"))));
+
+  // And through the binary encoding
+  zData::Data MyBin;
+  TEST_TRUE(MyBin.SetStore(zData::Data::STORE_DOCUMENT));
+  TEST_TRUE(MyBin.SetBinary(MyData.GetBinary()));
+  TEST_EQ(json, MyBin.GetJson());
+  TEST_EQ(MyData.GetBinary(), MyBin.GetBinary());
+
+  // A property tree store still reads typed encodings, as strings
+  zData::Data MyTree;
+  TEST_TRUE(MyTree.SetJson(json));
+  TEST_EQ(std::string("5"), MyTree.GetValue<std::string>("a"));
+  TEST_EQ(std::string("true"), MyTree.GetValue<std::string>("b"));
+  TEST_TRUE(MyTree == MyData);
+
+  // Return success
+  return (0);
+
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zutils/zLog.h>
+using namespace zUtils;
+ZLOG_MODULE_INIT(zLog::Log::MODULE_TEST);
+
+#include <string.h>
+
+#include <sstream>
+
+#include <zutils/zData.h>
+#include <zutils/zDataJson.h>
+
+#include "UnitTest.h"
+#include "zDataTest.h"
+
+using namespace zUtils;
+
+static std::string
+_boost_json(const zData::pt::ptree& pt_, const bool pretty_)
+{
+  std::stringstream ss;
+  zData::pt::write_json(ss, pt_, pretty_);
+  return (ss.str());
+}
+
+static zData::pt::ptree
+_boost_ptree(const std::string& json_)
+{
+  zData::pt::ptree pt;
+  std::stringstream ss(json_);
+  zData::pt::read_json(ss, pt);
+  return (pt);
+}
+
+static bool
+_equal(const zData::pt::ptree& a_, const zData::pt::ptree& b_)
+{
+  return ((a_ == b_) && (_boost_json(a_, false) == _boost_json(b_, false)));
+}
+
+int
+zDataTest_JsonWriter(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_JsonWriter()");
+  ZLOG_DEBUG("#############################################################");
+
+  std::string obs;
+  zData::pt::ptree pt;
+
+  // Empty tree and single empty node
+  obs.clear();
+  TEST_TRUE(zData::JsonWriter::Write(pt, obs));
+  TEST_EQ(_boost_json(pt, false), obs);
+  obs.clear();
+  TEST_TRUE(zData::JsonWriter::Write(pt, obs, true));
+  TEST_EQ(_boost_json(pt, true), obs);
+
+  // Nested objects, arrays, escapes and long strings
+  pt.put("zData.Name", "Test \"quoted\" \\ back/slash\ttab\nline\x01 end");
+  pt.put("zData.Long", std::string(100, 'x') + "\"" + std::string(37, 'y'));
+  pt.put("zData.Utf8", "caf\xc3\xa9");
+  pt.put("zData.Nested.Value", "1");
+  pt.put("zData.Nested.Empty", "");
+  zData::pt::ptree array;
+  for (int i = 0; i < 4; i++)
+  {
+    zData::pt::ptree elem;
+    elem.put_value(zLog::IntStr(i));
+    array.push_back(std::make_pair("", elem));
+  }
+  zData::pt::ptree obj;
+  obj.put("Key", "Value");
+  array.push_back(std::make_pair("", obj));
+  pt.add_child("zData.Array", array);
+
+  obs.clear();
+
+  TEST_TRUE(zData::JsonWriter::Write(pt, obs));
+  TEST_EQ(_boost_json(pt, false), obs);
+  obs.clear();
+  TEST_TRUE(zData::JsonWriter::Write(pt, obs, true));
+  TEST_EQ(_boost_json(pt, true), obs);
+
+  // Data wrappers match the property tree writer
+  zData::Data MyData(pt);
+  TEST_EQ(_boost_json(pt, false), MyData.GetJson());
+  TEST_EQ(_boost_json(pt, true), MyData.GetJsonPretty());
+
+  // Trees that JSON cannot represent are rejected
+  zData::pt::ptree bad;
+  bad.put("zData", "value");
+  bad.put("zData.Child", "value");
+  obs.clear();
+  TEST_FALSE(zData::JsonWriter::Write(bad, obs));
+
+  // Data leaves those to the property tree writer to report, unlocked
+  zData::Data MyBad(bad);
+  bool thrown = false;
+  try
+  {
+    MyBad.GetJson();
+  }
+  catch (zData::pt::json_parser_error const &e)
+  {
+    thrown = true;
+  }
+  TEST_TRUE(thrown);
+  TEST_TRUE(MyBad.PutValue(zData::DataPath("Child"), std::string("other")));
+
+  // Typed document output
+  zData::Document MyDoc;
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Bool"), true));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Int"), -42));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Double"), 2.5));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("Whole"), 3.0));
+  TEST_TRUE(MyDoc.PutValue(zData::DataPath("String"), std::string("a\"b")));
+  TEST_NEQ(zData::Document::NoNode, MyDoc.SetNull(MyDoc.Create(zData::DataPath("Null"))));
+  obs.clear();
+  TEST_TRUE(zData::JsonWriter::Write(MyDoc, obs));
+  TEST_EQ(std::string("{\"zData\":{\"Bool\":true,\"Int\":-42,\"Double\":2.5,\"Whole\":3.0,"
+      "\"String\":\"a\\\"b\",\"Null\":null}}\n"), obs);
+
+  // Data in a document store writes the same typed values
+  zData::Data MyTyped;
+  TEST_TRUE(MyTyped.SetStore(zData::Data::STORE_DOCUMENT));
+  TEST_TRUE(MyDoc.Store(MyTyped));
+  TEST_EQ(obs, MyTyped.GetJson());
+  obs.clear();
+  TEST_TRUE(zData::JsonWriter::Write(MyDoc, obs, true));
+  TEST_EQ(obs, MyTyped.GetJsonPretty());
+
+  // Return success
+  return (0);
+
+}
+
+int
+zDataTest_JsonReader(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zDataTest_JsonReader()");
+  ZLOG_DEBUG("#############################################################");
+
+  const std::string json("{ \"zData\" : { \"Str\": \"plain text longer than sixteen bytes\","
+      " \"Esc\": \"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\t\\u0041\\u00e9\\u20ac\\ud83d\\ude00 and more text\","
+      " \"Int\": -12, \"Real\": 1.5e+3, \"True\": true, \"False\": false, \"Null\": null,"
+      " \"Array\": [ 1, \"two\", { \"Three\": 3 }, [ ] ], \"Empty\": { }, \"Dup\": 1, \"Dup\": 2 } }");
+
+  // Reader produces the same tree as the property tree parser
+  zData::pt::ptree exp;
+  std::stringstream ss(json);
+  zData::pt::read_json(ss, exp);
+
+  zData::pt::ptree obs;
+  zData::PtreeJsonHandler handler(obs);
+  zData::JsonReader reader;
+  TEST_TRUE(reader.Parse(json, handler));
+  TEST_TRUE(_equal(exp, obs));
+
+  // Data parses from a raw buffer
+  zData::Data MyData;
+  TEST_TRUE(MyData.SetJson(json.data(), json.size()));
+  TEST_TRUE(_equal(exp, _boost_ptree(MyData.GetJson())));
+  std::string str;
+  TEST_TRUE(MyData.GetValue(zData::DataPath("Str"), str));
+  TEST_EQ(std::string("plain text longer than sixteen bytes"), str);
+
+  // Round trip through the writer
+  zData::Data MyData2;
+  TEST_TRUE(MyData2.SetJson(MyData.GetJson()));
+  TEST_EQ(MyData.GetJson(), MyData2.GetJson());
+
+  // Malformed input is rejected with an offset
+  const char* bad[] = { "", "{", "{\"zData\":}", "{\"zData\":\"abc}", "{\"zData\":tru}",
+      "{\"zData\":01}", "{\"zData\":\"\\x\"}", "{\"zData\":\"\\ud83d\"}", "{\"zData\":1} x",
+      "{\"zData\":[1,]}", "{\"zData\":\"a\x01\"}", NULL };
+  for (int i = 0; bad[i]; i++)
+  {
+    zData::pt::ptree tmp;
+    zData::PtreeJsonHandler h(tmp);
+    TEST_FALSE(reader.Parse(bad[i], strlen(bad[i]), h));
+    TEST_FALSE(reader.ErrorMessage().empty());
+    TEST_TRUE(reader.ErrorOffset() <= strlen(bad[i]));
+  }
+  TEST_FALSE(MyData2.SetJson(std::string("{\"zData\":")));
+  TEST_FALSE(MyData2.SetJson(std::string("{\"Other\":1}")));
+
+  // Nesting is bounded
+  zData::JsonReader shallow(4);
+  zData::pt::ptree deep;
+  zData::PtreeJsonHandler dh(deep);
+  TEST_FALSE(shallow.Parse(std::string("[[[[[[1]]]]]]"), dh));
+
+  // Typed document keeps types and round trips
+  zData::Document MyDoc;
+  zData::DocumentJsonHandler doch(MyDoc);
+  TEST_TRUE(reader.Parse(json, doch));
+  zData::Document::Node node = MyDoc.Find(zData::DataPath("Int"));
+  TEST_EQ(zData::Document::TYPE_INT, MyDoc.GetType(node));
+  int ival = 0;
+  TEST_TRUE(MyDoc.GetValue(node, ival));
+  TEST_EQ(-12, ival);
+  node = MyDoc.Find(zData::DataPath("Real"));
+  TEST_EQ(zData::Document::TYPE_DOUBLE, MyDoc.GetType(node));
+  double dval = 0.0;
+  TEST_TRUE(MyDoc.GetValue(node, dval));
+  TEST_EQ(1500.0, dval);
+  TEST_EQ(zData::Document::TYPE_BOOL, MyDoc.GetType(MyDoc.Find(zData::DataPath("True"))));
+  TEST_EQ(zData::Document::TYPE_NULL, MyDoc.GetType(MyDoc.Find(zData::DataPath("Null"))));
+  node = MyDoc.Find(zData::DataPath("Array"));
+  TEST_EQ(zData::Document::TYPE_ARRAY, MyDoc.GetType(node));
+  TEST_EQ(4, MyDoc.Size(node));
+  TEST_TRUE(MyDoc.GetValue(zData::DataPath("Esc"), str));
+  TEST_EQ(std::string("a\"b\\c/d\b\f\n\r\tA\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80 and more text"), str);
+
+  std::string out;
+  TEST_TRUE(zData::JsonWriter::Write(MyDoc, out));
+  zData::Document MyDoc2;
+  zData::DocumentJsonHandler doch2(MyDoc2);
+  TEST_TRUE(reader.Parse(out, doch2));
+  std::string out2;
+  TEST_TRUE(zData::JsonWriter::Write(MyDoc2, out2));
+  TEST_EQ(out, out2);
+
+  // Return success
+  return (0);
+
+}
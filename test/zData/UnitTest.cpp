@@ -52,11 +52,25 @@ main(int argc, const char **argv)
   UTEST_TEST(zDataTest_XmlSimple, 0);
 
   UTEST_TEST(zDataTest_DataCopy, 0);
+  UTEST_TEST(zDataTest_CopyOnWrite, 0);
+  UTEST_TEST(zDataTest_Diff, 0);
+  UTEST_TEST(zDataTest_Snapshot, 0);
 
   UTEST_TEST(zDataTest_Array, 0);
   
   UTEST_TEST(zDataTest_PopFront, 0);
   UTEST_TEST(zDataTest_PopBack, 0);
+  UTEST_TEST(zDataTest_CompiledPath, 0);
+
+  UTEST_TEST(zDataTest_Document, 0);
+  UTEST_TEST(zDataTest_DocumentStore, 0);
+  UTEST_TEST(zDataTest_DocumentTyped, 0);
+
+  UTEST_TEST(zDataTest_JsonWriter, 0);
+  UTEST_TEST(zDataTest_JsonReader, 0);
+
+  UTEST_TEST(zDataTest_BinaryRoundTrip, 0);
+  UTEST_TEST(zDataTest_BinaryView, 0);
   zLog::Manager::Instance().UnregisterConnector(zLog::Log::LEVEL_ALL);
 
   UTEST_FINI();
@@ -51,6 +51,12 @@ zDataTest_XmlSimple(void* arg_);
 
 int
 zDataTest_DataCopy(void* arg);
+int
+zDataTest_CopyOnWrite(void* arg);
+int
+zDataTest_Diff(void* arg);
+int
+zDataTest_Snapshot(void* arg);
 
 int
 zDataTest_Array(void* arg);
@@ -58,5 +64,26 @@ int
 zDataTest_PopFront(void* arg);
 int
 zDataTest_PopBack(void* arg);
+int
+zDataTest_CompiledPath(void* arg_);
+
+int
+zDataTest_Document(void* arg_);
+
+int
+zDataTest_DocumentStore(void* arg_);
+
+int
+zDataTest_DocumentTyped(void* arg_);
+
+int
+zDataTest_JsonWriter(void* arg_);
+int
+zDataTest_JsonReader(void* arg_);
+
+int
+zDataTest_BinaryRoundTrip(void* arg_);
+int
+zDataTest_BinaryView(void* arg_);
 #endif /* _ZDATATEST_H_ */
 
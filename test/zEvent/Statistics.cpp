@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zEventTest.h"
+
+int
+zEventTest_HistogramTest(void* arg_)
+{
+
+  zEvent::Histogram hist;
+  TEST_EQ(uint64_t(0), hist.Count());
+  TEST_EQ(uint64_t(0), hist.Min());
+  TEST_EQ(uint64_t(0), hist.Max());
+  TEST_EQ(uint64_t(0), hist.Percentile(50.0));
+
+  // Record 1..1000000, values are reported within 1/SubBuckets of their true value
+  for (uint64_t i = 1; i <= 1000000; i++)
+  {
+    hist.Record(i);
+  }
+  TEST_EQ(uint64_t(1000000), hist.Count());
+  TEST_EQ(uint64_t(1), hist.Min());
+  TEST_EQ(uint64_t(1000000), hist.Max());
+  TEST_EQ(uint64_t(500000), hist.Mean());
+  uint64_t p50 = hist.Percentile(50.0);
+  TEST_TRUE((p50 >= 500000) && (p50 <= (500000 + (500000 / zEvent::Histogram::SubBuckets))));
+  uint64_t p99 = hist.Percentile(99.0);
+  TEST_TRUE((p99 >= 990000) && (p99 <= 1000000));
+  TEST_EQ(uint64_t(1000000), hist.Percentile(100.0));
+
+  // Small values are exact; huge values are clamped into the last bucket
+  hist.Reset();
+  TEST_EQ(uint64_t(0), hist.Count());
+  hist.Record(3);
+  TEST_EQ(uint64_t(3), hist.Percentile(99.9));
+  hist.Record(UINT64_MAX);
+  TEST_EQ(UINT64_MAX, hist.Max());
+  TEST_EQ(UINT64_MAX, hist.Percentile(100.0));
+
+  // Return success
+  return (0);
+}
+
+int
+zEventTest_StatisticsTest(void* arg_)
+{
+
+  zEvent::Statistics& stats = zEvent::Statistics::Instance();
+  TEST_FALSE(stats.IsEnabled());
+  stats.Reset();
+
+  TestEvent *MyEvent = new TestEvent;
+  zEvent::Handler *MyHandler = new zEvent::Handler;
+  TestObserver *MyObserver = new TestObserver;
+  TEST_TRUE(MyHandler->RegisterEvent(MyEvent));
+  TEST_TRUE(MyHandler->RegisterObserver(MyObserver));
+
+  // Nothing is recorded while disabled
+  TEST_TRUE(MyEvent->Notify(1));
+  TEST_TRUE(MyObserver->TryWait());
+  MyObserver->Pop();
+  TEST_EQ(uint64_t(0), stats.GetEventHistogram(zEvent::Event::TYPE_TEST).Count());
+
+  // Enable and validate both the event and observer are recorded
+  stats.Enable();
+  TEST_TRUE(stats.IsEnabled());
+  TEST_TRUE(MyEvent->Notify(2));
+  TEST_TRUE(MyEvent->Notify(3));
+  TEST_EQ(uint64_t(2), stats.GetEventHistogram(zEvent::Event::TYPE_TEST).Count());
+  std::map<std::string, SHARED_PTR(zEvent::Histogram)> obs = stats.GetObserverHistograms();
+  TEST_EQ(size_t(1), obs.size());
+  TEST_TRUE(obs.begin()->first.find("TestObserver@") == 0);
+  TEST_EQ(uint64_t(2), obs.begin()->second->Count());
+  std::string dump = stats.Dump();
+  TEST_TRUE(dump.find("event.test: count=2") != std::string::npos);
+  TEST_TRUE(dump.find("observer.TestObserver@") != std::string::npos);
+
+  // Reset clears the counts
+  stats.Reset();
+  TEST_EQ(uint64_t(0), stats.GetEventHistogram(zEvent::Event::TYPE_TEST).Count());
+  TEST_EQ(uint64_t(0), obs.begin()->second->Count());
+  stats.Disable();
+
+  // Cleanup
+  TEST_TRUE(MyHandler->UnregisterObserver(MyObserver));
+  TEST_TRUE(MyHandler->UnregisterEvent(MyEvent));
+  obs.clear();
+  stats.Reset();
+  TEST_TRUE(stats.GetObserverHistograms().empty());
+  delete (MyObserver);
+  delete (MyHandler);
+  delete (MyEvent);
+
+  // Return success
+  return (0);
+}
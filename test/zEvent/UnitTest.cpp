@@ -28,6 +28,8 @@ main(int argc, const char **argv)
   UTEST_TEST(zEventTest_EventManagerDefaults, 0);
   UTEST_TEST(zEventTest_EventTest, 0);
   UTEST_TEST(zEventTest_EventHandlerTest, 0);
+  UTEST_TEST(zEventTest_HistogramTest, 0);
+  UTEST_TEST(zEventTest_StatisticsTest, 0);
 //  UTEST_TEST(zEventTest_EventManagerTest, 0);
   UTEST_FINI();
 
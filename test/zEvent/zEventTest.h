@@ -44,6 +44,10 @@ int
 zEventTest_EventHandlerTest(void* arg_);
 int
 zEventTest_EventManagerTest(void* arg_);
+int
+zEventTest_HistogramTest(void* arg_);
+int
+zEventTest_StatisticsTest(void* arg_);
 
 using namespace zUtils;
 using namespace Test;
@@ -74,3 +74,95 @@ zLogTest_FileConnector(void* arg_)
   return (0);
 }
 
+
+int
+zLogTest_BufferedFileConnector(void* arg_)
+{
+
+  zUtils::zLog::Log _zlogger(zLog::Log::MODULE_TEST);
+
+  // Log file names
+  const char *logName = "/tmp/bfconn-utest.log";
+  const char *rotName = "/tmp/bfconn-utest.log.1";
+
+  // Log file streams
+  std::ifstream logFile;
+
+  // Clean up from previous runs
+  remove(logName);
+  remove(rotName);
+  logFile.open(logName);
+  TEST_FALSE(logFile.is_open());
+
+  // Create buffered file connector and register
+  zLog::BufferedFileConnector *fileConn = new zLog::BufferedFileConnector(logName);
+  TEST_EQ(zLog::BufferedFileConnector::DefaultFlushSize, fileConn->GetFlushSize());
+  TEST_EQ(zLog::BufferedFileConnector::DefaultFlushInterval, fileConn->GetFlushInterval());
+  TEST_EQ(zLog::BufferedFileConnector::DefaultBufferLimit, fileConn->GetBufferLimit());
+  TEST_EQ(zLog::BufferedFileConnector::DefaultRotateCount, fileConn->GetRotateCount());
+  TEST_IS_ZERO(fileConn->GetRotateSize());
+  TEST_IS_ZERO(fileConn->GetRotateInterval());
+  TEST_FALSE(fileConn->GetCompress());
+  TEST_TRUE(fileConn->SetFlushInterval(50));
+  TEST_EQ(uint32_t(50), fileConn->GetFlushInterval());
+  zLog::Manager::Instance().RegisterConnector(zLog::Log::LEVEL_CRIT, fileConn);
+
+  // Verify the file is created but nothing has been written until the buffer is flushed
+  logFile.open(logName);
+  TEST_TRUE(logFile.is_open());
+  TEST_IS_ZERO(GetFileSize(logFile));
+  TEST_TRUE(fileConn->Flush());
+  int logSize = GetFileSize(logFile);
+  TEST_ISNOT_ZERO(logSize);
+
+  // Log message and validate it is written after the flush interval
+  ZLOG_CRIT("CRIT");
+  usleep(200000);
+  TEST_NEQ(logSize, GetFileSize(logFile));
+  logSize = GetFileSize(logFile);
+
+  // Crossing the flush size wakes the writer without waiting for the interval
+  TEST_TRUE(fileConn->SetFlushInterval(100000));
+  TEST_TRUE(fileConn->SetFlushSize(64));
+  fileConn->Logger(std::string(64, 'x'));
+  usleep(100000);
+  TEST_EQ((logSize + 65), GetFileSize(logFile));
+  logSize = GetFileSize(logFile);
+
+  // Messages over the buffer limit are dropped rather than blocking
+  TEST_TRUE(fileConn->SetFlushSize(1024));
+  TEST_TRUE(fileConn->SetBufferLimit(16));
+  fileConn->Logger(std::string(32, 'x'));
+  TEST_EQ(uint64_t(1), fileConn->GetDropped());
+  TEST_TRUE(fileConn->Flush());
+  TEST_IS_ZERO(fileConn->GetDropped());
+  TEST_LT(logSize, GetFileSize(logFile));
+  logFile.close();
+
+  // Rotate by size
+  TEST_TRUE(fileConn->SetBufferLimit(zLog::BufferedFileConnector::DefaultBufferLimit));
+  TEST_TRUE(fileConn->SetRotateSize(128));
+  fileConn->Logger(std::string(128, 'x'));
+  TEST_TRUE(fileConn->Flush());
+  logFile.open(rotName);
+  TEST_TRUE(logFile.is_open());
+  TEST_LT(128, GetFileSize(logFile));
+  logFile.close();
+  logFile.open(logName);
+  TEST_TRUE(logFile.is_open());
+  TEST_IS_ZERO(GetFileSize(logFile));
+  logFile.close();
+
+  // Cleanup
+  zLog::Manager::Instance().UnregisterConnector(zLog::Log::LEVEL_CRIT);
+  delete (fileConn);
+
+  // Clean up log files from /tmp
+  remove(logName);
+  remove(rotName);
+  logFile.open(logName);
+  TEST_FALSE(logFile.is_open());
+
+  // Return success
+  return (0);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+
+#include "zLogTest.h"
+
+using namespace zUtils;
+
+int
+zLogTest_RateLimit(void* arg_)
+{
+
+  // Create local logger on the stack
+  zUtils::zLog::Log _zlogger(zLog::Log::MODULE_TEST);
+
+  // Setup test connector
+  TestConnector conn;
+  TEST_IS_ZERO(conn.MsgQueue.Size());
+
+  // Register test connector
+  zLog::Manager::Instance().RegisterConnector(zLog::Log::LEVEL_CRIT, &conn);
+
+  // Log a burst from a single call site; only the first two should get through
+  for (int i = 0; i < 10; i++)
+  {
+    ZLOG_CRIT_RATELIMIT(2, 200, "CRIT");
+  }
+  TEST_TRUE(conn.MsgQueue.TimedWait(100));
+  TEST_TRUE(conn.MsgQueue.TimedWait(100));
+  TEST_EQ(2, conn.MsgQueue.Size());
+  TEST_TRUE(conn.MsgQueue.Pop());
+  TEST_TRUE(conn.MsgQueue.Pop());
+  TEST_FALSE(conn.MsgQueue.TimedWait(10));
+
+  // The manager summarizes the suppressed messages once the period has elapsed
+  TEST_TRUE(conn.MsgQueue.TimedWait(500));
+  TEST_EQ(1, conn.MsgQueue.Size());
+  TEST_NEQ(std::string::npos, conn.MsgQueue.Front().find("Suppressed 8 messages"));
+  TEST_TRUE(conn.MsgQueue.Pop());
+
+  // Cleanup
+  zLog::Manager::Instance().UnregisterConnector(zLog::Log::LEVEL_CRIT);
+
+  // Return success
+  return (0);
+}
+
+int
+zLogTest_EveryN(void* arg_)
+{
+
+  // Create local logger on the stack
+  zUtils::zLog::Log _zlogger(zLog::Log::MODULE_TEST);
+
+  // Setup test connector
+  TestConnector conn;
+  TEST_IS_ZERO(conn.MsgQueue.Size());
+
+  // Register test connector
+  zLog::Manager::Instance().RegisterConnector(zLog::Log::LEVEL_CRIT, &conn);
+
+  // Log from a single call site; only the 1st, 4th and 7th should get through
+  for (int i = 0; i < 8; i++)
+  {
+    ZLOG_CRIT_EVERY_N(3, "CRIT");
+  }
+  TEST_TRUE(conn.MsgQueue.TimedWait(100));
+  TEST_TRUE(conn.MsgQueue.TimedWait(100));
+  TEST_TRUE(conn.MsgQueue.TimedWait(100));
+  TEST_FALSE(conn.MsgQueue.TimedWait(100));
+  TEST_EQ(3, conn.MsgQueue.Size());
+
+  // Cleanup
+  zLog::Manager::Instance().UnregisterConnector(zLog::Log::LEVEL_CRIT);
+
+  // Return success
+  return (0);
+}
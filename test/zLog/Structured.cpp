@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "zLogTest.h"
+
+using namespace zUtils;
+
+int
+zLogTest_StructuredMessage(void* arg_)
+{
+
+  zLog::Message msg("TEST", zLog::Log::LEVEL_CRIT);
+  msg.SetFile("/path/to/File.cpp");
+  msg.SetLine(42);
+  msg.AddMessage("Hello \"world\"");
+  TEST_IS_ZERO(msg.GetFields().size());
+
+  // Attach typed fields using the builder interface
+  msg.Field("str", "a\tb").Field("int", -5).Field("uint", 5u).Field("bool", true).Field("dbl", 0.5);
+  TEST_EQ(size_t(5), msg.GetFields().size());
+  TEST_EQ(std::string("str"), msg.GetFields()[0].Key);
+  TEST_EQ(std::string("a\tb"), msg.GetFields()[0].Value);
+  TEST_TRUE(msg.GetFields()[0].Quoted);
+  TEST_EQ(std::string("-5"), msg.GetFields()[1].Value);
+  TEST_FALSE(msg.GetFields()[1].Quoted);
+
+  // Tab separated line keeps the legacy layout with fields appended
+  std::string str = msg.Str();
+  TEST_NEQ(std::string::npos, str.find("\tTEST\tCRIT\tFile.cpp[42]\tHello \"world\"\t"));
+  TEST_NEQ(std::string::npos, str.find("int=-5\t"));
+
+  // JSON record is built directly from the fields
+  std::string json = msg.GetJson();
+  TEST_EQ('{', json[0]);
+  TEST_EQ('}', json[json.size() - 1]);
+  TEST_NEQ(std::string::npos, json.find("\"module\":\"TEST\""));
+  TEST_NEQ(std::string::npos, json.find("\"level\":\"CRIT\""));
+  TEST_NEQ(std::string::npos, json.find("\"file\":\"File.cpp\""));
+  TEST_NEQ(std::string::npos, json.find("\"line\":42"));
+  TEST_NEQ(std::string::npos, json.find("\"message\":\"Hello \\\"world\\\"\""));
+  TEST_NEQ(std::string::npos,
+      json.find("\"fields\":{\"str\":\"a\\tb\",\"int\":-5,\"uint\":5,\"bool\":true,\"dbl\":0.5}"));
+
+  // Return success
+  return (0);
+}
+
+int
+zLogTest_UnixConnector(void* arg_)
+{
+
+  zUtils::zLog::Log _zlogger(zLog::Log::MODULE_TEST);
+
+  const char *sockName = "/tmp/uconn-utest.sock";
+  unlink(sockName);
+
+  // Create collector socket
+  int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  TEST_LT(0, fd);
+  struct sockaddr_un addr = { 0 };
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, sockName, (sizeof(addr.sun_path) - 1));
+  TEST_IS_ZERO(bind(fd, (struct sockaddr*) &addr, sizeof(addr)));
+
+  // Create connector and register
+  zLog::UnixConnector conn(sockName);
+  TEST_IS_ZERO(conn.GetDropped());
+  zLog::Manager::Instance().RegisterConnector(zLog::Log::LEVEL_CRIT, &conn);
+
+  // Log message with fields and validate one JSON record per datagram
+  ZLOG_CRIT_FIELDS("CRIT", .Field("key", 1).Field("name", "value"));
+  struct pollfd pfd = { fd, POLLIN, 0 };
+  TEST_EQ(1, poll(&pfd, 1, 1000));
+  char buf[1024] = { 0 };
+  ssize_t n = recv(fd, buf, (sizeof(buf) - 1), 0);
+  TEST_LT(ssize_t(0), n);
+  std::string json(buf, n);
+  TEST_EQ('{', json[0]);
+  TEST_EQ('}', json[json.size() - 1]);
+  TEST_NEQ(std::string::npos, json.find("\"level\":\"CRIT\""));
+  TEST_NEQ(std::string::npos, json.find("\"message\":\"CRIT\""));
+  TEST_NEQ(std::string::npos, json.find("\"fields\":{\"key\":1,\"name\":\"value\"}"));
+  TEST_IS_ZERO(conn.GetDropped());
+
+  // Cleanup
+  zLog::Manager::Instance().UnregisterConnector(zLog::Log::LEVEL_CRIT);
+  close(fd);
+  unlink(sockName);
+
+  // Return success
+  return (0);
+}
@@ -25,6 +25,11 @@ main(int argc, const char **argv)
 
   UTEST_TEST( zLogTest_Defaults, 0);
   UTEST_TEST( zLogTest_FileConnector, 0);
+  UTEST_TEST( zLogTest_BufferedFileConnector, 0);
+  UTEST_TEST( zLogTest_RateLimit, 0);
+  UTEST_TEST( zLogTest_EveryN, 0);
+  UTEST_TEST( zLogTest_StructuredMessage, 0);
+  UTEST_TEST( zLogTest_UnixConnector, 0);
 
   UTEST_FINI();
 
@@ -26,6 +26,16 @@ int
 zLogTest_Defaults(void* arg_);
 int
 zLogTest_FileConnector(void* arg_);
+int
+zLogTest_BufferedFileConnector(void* arg_);
+int
+zLogTest_RateLimit(void* arg_);
+int
+zLogTest_EveryN(void* arg_);
+int
+zLogTest_StructuredMessage(void* arg_);
+int
+zLogTest_UnixConnector(void* arg_);
 
 using namespace zUtils;
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zMessageTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+class TestAckHandler : public zMessage::AckHandler
+{
+
+public:
+
+  TestAckHandler() :
+      Acked(0), TimedOut(0), _lock(zSem::Mutex::LOCKED)
+  {
+    this->_lock.Unlock();
+  }
+
+  virtual void
+  AckCompleted(const std::string& msg_id_, const zMessage::AckMessage* ack_)
+  {
+    this->_lock.Lock();
+    if (ack_)
+    {
+      this->Acked++;
+    }
+    else
+    {
+      this->TimedOut++;
+    }
+    this->_lock.Unlock();
+  }
+
+  int
+  GetAcked()
+  {
+    this->_lock.Lock();
+    int count = this->Acked;
+    this->_lock.Unlock();
+    return (count);
+  }
+
+  int
+  GetTimedOut()
+  {
+    this->_lock.Lock();
+    int count = this->TimedOut;
+    this->_lock.Unlock();
+    return (count);
+  }
+
+  int Acked;
+  int TimedOut;
+
+private:
+
+  zSem::Mutex _lock;
+
+};
+
+int
+zMessageTest_AckTracker(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_AckTracker()");
+  ZLOG_DEBUG("#############################################################");
+
+  zMessage::AckTracker MyTracker(10, 16);
+  TestAckHandler MyHandler;
+  std::vector<std::string> ids;
+
+  // Thousands of pending messages, some with timeouts beyond a turn of the wheel
+  for (int i = 0; i < 2000; i++)
+  {
+    ids.push_back(zUuid::Uuid().Str());
+    TEST_TRUE(MyTracker.Register(ids.back(), &MyHandler, ((i % 2) ? 100 : 5000)));
+  }
+  TEST_EQ(2000, MyTracker.Size());
+  TEST_FALSE(MyTracker.Register(ids[0], &MyHandler, 100));
+  TEST_FALSE(MyTracker.Register("NotAUuid", &MyHandler, 100));
+  TEST_FALSE(MyTracker.Register(zUuid::Uuid().Str(), NULL, 100));
+
+  // Acks complete their message once
+  for (int i = 0; i < 2000; i += 2)
+  {
+    zMessage::AckMessage ack;
+    TEST_TRUE(ack.SetId(ids[i]));
+    TEST_TRUE(MyTracker.Complete(ack));
+    TEST_FALSE(MyTracker.Complete(ack));
+  }
+  TEST_EQ(1000, MyHandler.GetAcked());
+
+  // Cancelled messages are forgotten quietly; the rest time out
+  TEST_TRUE(MyTracker.Cancel(ids[1]));
+  TEST_FALSE(MyTracker.Cancel(ids[1]));
+  usleep(500000);
+  TEST_EQ(999, MyHandler.GetTimedOut());
+  TEST_EQ(1000, MyHandler.GetAcked());
+  TEST_EQ(0, MyTracker.Size());
+
+  // Ids may be registered again once completed
+  TEST_TRUE(MyTracker.Register(ids[0], &MyHandler, 50));
+  TEST_EQ(1, MyTracker.Size());
+  usleep(300000);
+  TEST_EQ(1000, MyHandler.GetTimedOut());
+
+  // Return success
+  return (0);
+
+}
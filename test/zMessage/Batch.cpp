@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zMessageTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+class TestBatchTransport : public zMessage::BatchTransport
+{
+
+public:
+
+  TestBatchTransport() :
+      _lock(zSem::Mutex::LOCKED)
+  {
+    this->_lock.Unlock();
+  }
+
+  virtual bool
+  TransmitBatch(const std::string& dst_, const std::string& buf_)
+  {
+    this->_lock.Lock();
+    this->_sent.push_back(std::make_pair(dst_, buf_));
+    this->_lock.Unlock();
+    return (true);
+  }
+
+  std::vector<std::pair<std::string, std::string> >
+  Sent()
+  {
+    this->_lock.Lock();
+    std::vector<std::pair<std::string, std::string> > sent;
+    sent.swap(this->_sent);
+    this->_lock.Unlock();
+    return (sent);
+  }
+
+private:
+
+  zSem::Mutex _lock;
+  std::vector<std::pair<std::string, std::string> > _sent;
+
+};
+
+static size_t
+_split(const std::string& buf_, std::vector<zMessage::Message*>& msgs_)
+{
+  size_t off = 0;
+  zMessage::MessageFrame frame(buf_.data(), buf_.size());
+  while (frame.Valid())
+  {
+    msgs_.push_back(frame.Decode());
+    off += frame.Size();
+    frame = zMessage::MessageFrame(&buf_[off], (buf_.size() - off));
+  }
+  return (off);
+}
+
+int
+zMessageTest_MessageBatcher(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_MessageBatcher()");
+  ZLOG_DEBUG("#############################################################");
+
+  TestBatchTransport MyTransport;
+  zMessage::MessageBatcher *MyBatcher = new zMessage::MessageBatcher(MyTransport, 512, 50);
+  TEST_ISNOT_NULL(MyBatcher);
+  TEST_EQ(512, MyBatcher->GetMtu());
+  TEST_EQ(50, MyBatcher->GetDelay());
+
+  zMessage::Message *myMessage = zMessage::MessageFactory::Create(zMessage::Message::TYPE_DATA);
+  TEST_ISNOT_NULL(myMessage);
+  std::string frame;
+  TEST_TRUE(myMessage->SetDst("dst1"));
+  TEST_TRUE(zMessage::MessageFrame::Encode(*myMessage, frame));
+  size_t per = (512 / frame.size());
+
+  // A burst to one destination fills datagrams up to the MTU
+  for (size_t i = 0; i < (per * 2); i++)
+  {
+    TEST_TRUE(MyBatcher->Add(*myMessage));
+  }
+  std::vector<std::pair<std::string, std::string> > sent = MyTransport.Sent();
+  TEST_EQ(1, sent.size());
+  TEST_EQ(std::string("dst1"), sent[0].first);
+  TEST_TRUE(sent[0].second.size() <= 512);
+  std::vector<zMessage::Message*> msgs;
+  TEST_EQ(sent[0].second.size(), _split(sent[0].second, msgs));
+  TEST_EQ(per, msgs.size());
+  FOREACH (auto& msg, msgs)
+  {
+    TEST_TRUE(*msg == *myMessage);
+    delete (msg);
+  }
+  msgs.clear();
+
+  // The rest goes out once the delay passes
+  usleep(200000);
+  sent = MyTransport.Sent();
+  TEST_EQ(1, sent.size());
+  TEST_EQ(sent[0].second.size(), _split(sent[0].second, msgs));
+  TEST_EQ(per, msgs.size());
+  FOREACH (auto& msg, msgs)
+  {
+    delete (msg);
+  }
+  msgs.clear();
+
+  // Destinations are batched apart and flushed on demand
+  TEST_TRUE(MyBatcher->Add(*myMessage));
+  TEST_TRUE(myMessage->SetDst("dst2"));
+  TEST_TRUE(MyBatcher->Add(*myMessage));
+  TEST_TRUE(MyBatcher->Flush());
+  sent = MyTransport.Sent();
+  TEST_EQ(2, sent.size());
+  TEST_EQ(std::string("dst1"), sent[0].first);
+  TEST_EQ(std::string("dst2"), sent[1].first);
+
+  // Messages larger than the MTU are sent alone
+  std::string big(1024, 'x');
+  TEST_TRUE(myMessage->PutValue(zMessage::MessagePath(std::string("Big")), big));
+  TEST_TRUE(MyBatcher->Add(*myMessage));
+  sent = MyTransport.Sent();
+  TEST_EQ(1, sent.size());
+  TEST_EQ(sent[0].second.size(), _split(sent[0].second, msgs));
+  TEST_EQ(1, msgs.size());
+  TEST_TRUE(*msgs[0] == *myMessage);
+  delete (msgs[0]);
+
+  // Pending batches are sent when the batcher goes away
+  TEST_TRUE(myMessage->SetDst("dst3"));
+  TEST_TRUE(myMessage->Del(zMessage::MessagePath(std::string("Big"))));
+  TEST_TRUE(MyBatcher->Add(*myMessage));
+  delete (MyBatcher);
+  sent = MyTransport.Sent();
+  TEST_EQ(1, sent.size());
+  TEST_EQ(std::string("dst3"), sent[0].first);
+
+  // Cleanup
+  delete (myMessage);
+
+  // Return success
+  return (0);
+
+}
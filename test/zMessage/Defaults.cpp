@@ -54,9 +54,33 @@ zMessageTest_MessageSocketDefaults(void* arg_)
   // Create new message socket and validate
   zMessage::MessageSocket *MyMsgSock = new zMessage::MessageSocket;
   TEST_ISNOT_NULL(MyMsgSock);
+  TEST_FALSE(MyMsgSock->IsReliable());
+  TEST_FALSE(MyMsgSock->IsBatching());
+  TEST_FALSE(MyMsgSock->IsPubSub());
+
+  // Delivery options are set before listening and fixed after
+  TEST_TRUE(MyMsgSock->SetReliable(true));
+  TEST_TRUE(MyMsgSock->IsReliable());
+  TEST_TRUE(MyMsgSock->SetBatching(true));
+  TEST_TRUE(MyMsgSock->SetBatching(false));
+  TEST_FALSE(MyMsgSock->IsBatching());
+  TEST_TRUE(MyMsgSock->SetPubSub(true));
+  TEST_TRUE(MyMsgSock->Subscribe("a.b"));
+  zSocket::LoopAddress MyAddr;
+  zSocket::LoopSocket *MySock = new zSocket::LoopSocket;
+  TEST_TRUE(MySock->Bind(MyAddr));
+  TEST_TRUE(MyMsgSock->Listen(MySock));
+  TEST_FALSE(MyMsgSock->SetReliable(false));
+  TEST_TRUE(MyMsgSock->IsReliable());
+  TEST_FALSE(MyMsgSock->SetBatching(true));
+  TEST_FALSE(MyMsgSock->IsBatching());
+  TEST_FALSE(MyMsgSock->SetPubSub(false));
+  TEST_TRUE(MyMsgSock->IsPubSub());
+  TEST_TRUE(MyMsgSock->Unsubscribe("a.b"));
 
   // Clean up
   delete (MyMsgSock);
+  delete (MySock);
 
   // Return success
   return (0);
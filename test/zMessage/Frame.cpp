@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zMessageTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+int
+zMessageTest_FrameEncodeDecode(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_FrameEncodeDecode()");
+  ZLOG_DEBUG("#############################################################");
+
+  zMessage::Message *myMessage = zMessage::MessageFactory::Create(zMessage::Message::TYPE_ACK);
+  TEST_ISNOT_NULL(myMessage);
+  TEST_TRUE(myMessage->SetDst("dst"));
+  TEST_TRUE(myMessage->SetSrc("src"));
+  TEST_TRUE(myMessage->PutValue(zMessage::MessagePath(std::string("Status")), std::string("Ok")));
+
+  std::string buf;
+  TEST_TRUE(zMessage::MessageFrame::Encode(*myMessage, buf));
+  TEST_TRUE(zMessage::MessageFrame::Detect(buf.data(), buf.size()));
+  TEST_EQ(buf.size(), zMessage::MessageFrame::Length(buf.data(), buf.size()));
+  TEST_EQ(0, zMessage::MessageFrame::Length(buf.data(), zMessage::MessageFrame::HeaderSize - 1));
+
+  // Routing fields are read from the header alone
+  zMessage::MessageFrame myFrame(buf.data(), buf.size());
+  TEST_TRUE(myFrame.Valid());
+  TEST_EQ(buf.size(), myFrame.Size());
+  TEST_EQ(zMessage::Message::TYPE_ACK, myFrame.GetType());
+  TEST_EQ(myMessage->GetId(), myFrame.GetId());
+  TEST_EQ(std::string("dst"), myFrame.GetDst());
+  TEST_EQ(std::string("src"), myFrame.GetSrc());
+  TEST_TRUE(myFrame.Data() != NULL);
+  TEST_NEQ(0, myFrame.DataLength());
+
+  zMessage::Message *myDecoded = myFrame.Decode();
+  TEST_ISNOT_NULL(myDecoded);
+  TEST_TRUE(*myMessage == *myDecoded);
+  delete (myDecoded);
+
+  // The factory recognizes frames
+  myDecoded = zMessage::MessageFactory::Create(buf.data(), buf.size());
+  TEST_ISNOT_NULL(myDecoded);
+  TEST_TRUE(*myMessage == *myDecoded);
+  delete (myDecoded);
+
+  // Truncated frames are not valid
+  zMessage::MessageFrame myShortFrame(buf.data(), (buf.size() - 1));
+  TEST_FALSE(myShortFrame.Valid());
+  TEST_IS_NULL(myShortFrame.Decode());
+  TEST_EQ(std::string(""), myShortFrame.GetDst());
+
+  // Ids must be UUIDs
+  TEST_TRUE(myMessage->SetId("NotAUuid"));
+  std::string bad;
+  TEST_FALSE(zMessage::MessageFrame::Encode(*myMessage, bad));
+  TEST_TRUE(bad.empty());
+
+  // Cleanup
+  delete (myMessage);
+
+  // Return success
+  return (0);
+
+}
+
+int
+zMessageTest_FrameStream(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_FrameStream()");
+  ZLOG_DEBUG("#############################################################");
+
+  zMessage::Message *myHello = zMessage::MessageFactory::Create(zMessage::Message::TYPE_HELLO);
+  TEST_ISNOT_NULL(myHello);
+  zMessage::Message *myBye = zMessage::MessageFactory::Create(zMessage::Message::TYPE_BYE);
+  TEST_ISNOT_NULL(myBye);
+
+  // Back to back frames split on their encoded lengths
+  std::string buf;
+  TEST_TRUE(zMessage::MessageFrame::Encode(*myHello, buf));
+  size_t len = buf.size();
+  TEST_TRUE(zMessage::MessageFrame::Encode(*myBye, buf));
+
+  zMessage::MessageFrame myFrame1(buf.data(), buf.size());
+  TEST_TRUE(myFrame1.Valid());
+  TEST_EQ(len, myFrame1.Size());
+  TEST_EQ(zMessage::Message::TYPE_HELLO, myFrame1.GetType());
+  TEST_EQ(myHello->GetId(), myFrame1.GetId());
+
+  zMessage::MessageFrame myFrame2(&buf[len], (buf.size() - len));
+  TEST_TRUE(myFrame2.Valid());
+  TEST_EQ((buf.size() - len), myFrame2.Size());
+  TEST_EQ(zMessage::Message::TYPE_BYE, myFrame2.GetType());
+  zMessage::Message *myDecoded = myFrame2.Decode();
+  TEST_ISNOT_NULL(myDecoded);
+  TEST_TRUE(*myBye == *myDecoded);
+  delete (myDecoded);
+
+  // Incomplete frames may still become valid; malformed or oversized ones
+  //   never will
+  TEST_TRUE(zMessage::MessageFrame::Partial(buf.data(), 1));
+  TEST_TRUE(zMessage::MessageFrame::Partial(buf.data(), (len - 1)));
+  TEST_FALSE(zMessage::MessageFrame::Partial(buf.data(), len));
+  TEST_FALSE(zMessage::MessageFrame::Partial("x", 1));
+  std::string bad(buf.substr(0, len));
+  bad[2] = char(0xff);
+  TEST_FALSE(zMessage::MessageFrame::Partial(bad.data(), (len - 1)));
+  TEST_FALSE(zMessage::MessageFrame(bad.data(), bad.size()).Valid());
+  std::string big(buf.substr(0, zMessage::MessageFrame::HeaderSize));
+  big[24] = 0x00;
+  big[25] = 0x20;
+  big[26] = 0x00;
+  big[27] = 0x00;
+  TEST_TRUE(zMessage::MessageFrame::Length(big.data(), big.size()) > zMessage::MessageFrame::MaxSize);
+  TEST_FALSE(zMessage::MessageFrame::Partial(big.data(), big.size()));
+
+  // Frames decode from socket buffers in place
+  zSocket::Buffer sb(buf.substr(0, len));
+  zMessage::MessageFrame myFrame3(sb);
+  TEST_TRUE(myFrame3.Valid());
+  TEST_EQ(myHello->GetId(), myFrame3.GetId());
+
+  // Cleanup
+  delete (myHello);
+  delete (myBye);
+
+  // Return success
+  return (0);
+
+}
@@ -36,7 +36,6 @@ zMessageTest_MessageLoopSocket(void* arg_)
   LoopAddress MyAddr;
   LoopSocket *MySock = new LoopSocket;
   TEST_ISNOT_NULL(MySock);
-  TEST_TRUE(MySock->Open());
   TEST_TRUE(MySock->Bind(MyAddr));
 
   // Create new message socket and validate
@@ -131,7 +130,6 @@ zMessageTest_MessageLoopSocket(void* arg_)
   delete (MyHandler);
   delete (MyObserver);
   delete (MsgSock);
-  MySock->Close();
   delete (MySock);
 
   // Return success
@@ -153,7 +151,6 @@ zMessageTest_MessageUnixSocket(void* arg_)
   UnixAddress ServerAddr("/tmp/server");
   UnixSocket *ServerSock = new UnixSocket;
   TEST_ISNOT_NULL(ServerSock);
-  TEST_TRUE(ServerSock->Open());
   TEST_TRUE(ServerSock->Bind(ServerAddr));
 
   // Create new message socket and validate
@@ -184,7 +181,6 @@ zMessageTest_MessageUnixSocket(void* arg_)
   UnixAddress ClientAddr("/tmp/client");
   UnixSocket *ClientSock = new UnixSocket;
   TEST_ISNOT_NULL(ClientSock);
-  TEST_TRUE(ClientSock->Open());
   TEST_TRUE(ClientSock->Bind(ClientAddr));
 
   // Create new message socket and validate
@@ -251,12 +247,10 @@ zMessageTest_MessageUnixSocket(void* arg_)
 
   // Clean up
   delete (MsgClient);
-  ClientSock->Close();
   delete (ClientSock);
 
   ServerMsgHandler->UnregisterEvent(MsgServer);
   delete (MsgServer);
-  ServerSock->Close();
   delete (ServerSock);
   ServerMsgHandler->UnregisterObserver(ServerMsgObs);
   delete (ServerMsgObs);
@@ -267,3 +261,120 @@ zMessageTest_MessageUnixSocket(void* arg_)
 
 }
 
+
+// Loop socket standing in for a stream, whose reads may split frames
+class StreamLoopSocket : public LoopSocket
+{
+public:
+
+  virtual bool
+  IsStream() const
+  {
+    return (true);
+  }
+
+};
+
+int
+zMessageTest_MessageSocketFrames(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_MessageSocketFrames()");
+  ZLOG_DEBUG("#############################################################");
+
+  // Setup network socket
+  LoopAddress MyAddr;
+  LoopSocket *MySock = new LoopSocket;
+  TEST_ISNOT_NULL(MySock);
+  TEST_TRUE(MySock->Bind(MyAddr));
+
+  // Create new framed message socket and validate
+  zMessage::MessageSocket *MsgSock = new zMessage::MessageSocket;
+  TEST_ISNOT_NULL(MsgSock);
+  TEST_TRUE(MsgSock->SetFramed(true));
+
+  // Create new handler and observer and validate
+  zEvent::Handler* MyHandler = new zEvent::Handler;
+  TEST_ISNOT_NULL(MyHandler);
+  MyHandler->RegisterEvent(MsgSock);
+  TestSocketObserver *MyObserver = new TestSocketObserver;
+  TEST_ISNOT_NULL(MyObserver);
+  MyHandler->RegisterObserver(MyObserver);
+
+  // Listen on socket
+  TEST_TRUE(MsgSock->Listen(MySock));
+
+  // Create message and frame it
+  zMessage::Message *DataMsg = zMessage::MessageFactory::Create(zMessage::Message::TYPE_DATA);
+  TEST_ISNOT_NULL(DataMsg);
+  TEST_TRUE(DataMsg->SetDst(MyAddr.GetAddress()));
+  std::string frame;
+  TEST_TRUE(zMessage::MessageFrame::Encode(*DataMsg, frame));
+
+  // A truncated datagram is dropped and does not corrupt the next one
+  TEST_TRUE(MySock->Send(MyAddr, frame.substr(0, 8)));
+  TEST_TRUE(MsgSock->Send(*DataMsg));
+  TEST_TRUE(MyObserver->RxSem.TimedWait(100));
+  TEST_EQ(DataMsg->GetId(), MyObserver->RxSem.Front()->GetId());
+  MyObserver->RxSem.Pop();
+  TEST_FALSE(MyObserver->RxSem.TryWait());
+
+  // Switch to a stream socket
+  MyHandler->UnregisterEvent(MsgSock);
+  delete (MsgSock);
+  delete (MySock);
+  MySock = new StreamLoopSocket;
+  TEST_ISNOT_NULL(MySock);
+  TEST_TRUE(MySock->Bind(MyAddr));
+  MsgSock = new zMessage::MessageSocket;
+  TEST_ISNOT_NULL(MsgSock);
+  TEST_TRUE(MsgSock->SetFramed(true));
+  MyHandler->RegisterEvent(MsgSock);
+  TEST_TRUE(MsgSock->Listen(MySock));
+
+  // A frame split across reads of a stream is reassembled
+  TEST_TRUE(MySock->Send(MyAddr, frame.substr(0, 8)));
+  TEST_TRUE(MySock->Send(MyAddr, frame.substr(8)));
+  TEST_TRUE(MyObserver->RxSem.TimedWait(100));
+  TEST_EQ(DataMsg->GetId(), MyObserver->RxSem.Front()->GetId());
+  MyObserver->RxSem.Pop();
+
+  // A header claiming more than the largest frame is not waited on
+  std::string big(frame.substr(0, zMessage::MessageFrame::HeaderSize));
+  big[24] = 0x00;
+  big[25] = 0x20;
+  big[26] = 0x00;
+  big[27] = 0x00;
+  TEST_TRUE(MySock->Send(MyAddr, big));
+  TEST_TRUE(MsgSock->Send(*DataMsg));
+  TEST_TRUE(MyObserver->RxSem.TimedWait(100));
+  TEST_EQ(DataMsg->GetId(), MyObserver->RxSem.Front()->GetId());
+  MyObserver->RxSem.Pop();
+
+  // A frame found malformed once complete drops the stream state
+  std::string bad(frame);
+  bad[2] = char(0xff);
+  TEST_TRUE(MySock->Send(MyAddr, bad.substr(0, 8)));
+  TEST_TRUE(MySock->Send(MyAddr, bad.substr(8)));
+  TEST_TRUE(MsgSock->Send(*DataMsg));
+  TEST_TRUE(MyObserver->RxSem.TimedWait(100));
+  TEST_EQ(DataMsg->GetId(), MyObserver->RxSem.Front()->GetId());
+  MyObserver->RxSem.Pop();
+
+  // No more messages should be waiting
+  TEST_FALSE(MyObserver->RxSem.TryWait());
+
+  // Clean up
+  delete (DataMsg);
+  MyHandler->UnregisterEvent(MsgSock);
+  MyHandler->UnregisterObserver(MyObserver);
+  delete (MyHandler);
+  delete (MyObserver);
+  delete (MsgSock);
+  delete (MySock);
+
+  // Return success
+  return (0);
+
+}
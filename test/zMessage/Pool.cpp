@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zMessageTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+// Constructed before the pool, so released only after the pool is destroyed
+static SHARED_PTR(zMessage::Message) _held;
+
+int
+zMessageTest_MessagePool(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_MessagePool()");
+  ZLOG_DEBUG("#############################################################");
+
+  zMessage::MessagePool& MyPool = zMessage::MessagePool::Instance();
+  zMessage::MessagePath NumPath(std::string("Num"));
+  TEST_EQ(zMessage::MessagePool::DefaultLimit, MyPool.GetLimit());
+
+  // Invalid types are not pooled
+  SHARED_PTR(zMessage::Message) myMessage = zMessage::MessageFactory::Acquire(zMessage::Message::TYPE_NONE);
+  TEST_TRUE(myMessage.get() == NULL);
+
+  // Pooled messages are typed and carry an id
+  size_t free = MyPool.Free(zMessage::Message::TYPE_ACK);
+  myMessage = zMessage::MessageFactory::Acquire(zMessage::Message::TYPE_ACK);
+  TEST_TRUE(myMessage.get() != NULL);
+  TEST_EQ(zMessage::Message::TYPE_ACK, myMessage->GetType());
+  TEST_TRUE(dynamic_cast<zMessage::AckMessage*>(myMessage.get()) != NULL);
+  TEST_FALSE(myMessage->GetId().empty());
+  TEST_TRUE(myMessage->SetDst("dst"));
+  TEST_TRUE(myMessage->PutValue(NumPath, 1));
+
+  // Releasing the last handle returns the message to its free list
+  zMessage::Message* raw = myMessage.get();
+  std::string id = myMessage->GetId();
+  SHARED_PTR(zMessage::Message) myCopy = myMessage;
+  myMessage.reset();
+  TEST_EQ(free, MyPool.Free(zMessage::Message::TYPE_ACK));
+  myCopy.reset();
+  TEST_EQ((free + 1), MyPool.Free(zMessage::Message::TYPE_ACK));
+
+  // Reused messages are reset to a blank message of their type
+  myMessage = zMessage::MessageFactory::Acquire(zMessage::Message::TYPE_ACK);
+  TEST_TRUE(myMessage.get() == raw);
+  TEST_EQ(free, MyPool.Free(zMessage::Message::TYPE_ACK));
+  TEST_EQ(zMessage::Message::TYPE_ACK, myMessage->GetType());
+  TEST_NEQ(id, myMessage->GetId());
+  TEST_TRUE(myMessage->GetDst().empty());
+  int num = 0;
+  TEST_FALSE(myMessage->GetValue(NumPath, num));
+
+  // Copies keep the contents of the original
+  zMessage::Message Orig;
+  TEST_TRUE(Orig.SetType(zMessage::Message::TYPE_DATA));
+  TEST_TRUE(Orig.SetId(id));
+  TEST_TRUE(Orig.PutValue(NumPath, 2));
+  myCopy = zMessage::MessageFactory::Acquire(Orig);
+  TEST_TRUE(myCopy.get() != NULL);
+  TEST_TRUE(*myCopy == Orig);
+
+  // Free lists are bounded by the limit
+  std::vector<SHARED_PTR(zMessage::Message)> msgs;
+  for (int i = 0; i < 8; i++)
+  {
+    msgs.push_back(zMessage::MessageFactory::Acquire(zMessage::Message::TYPE_CMD));
+  }
+  TEST_TRUE(MyPool.SetLimit(4));
+  TEST_EQ(4, MyPool.GetLimit());
+  msgs.clear();
+  TEST_EQ(4, MyPool.Free(zMessage::Message::TYPE_CMD));
+  TEST_TRUE(MyPool.SetLimit(2));
+  TEST_EQ(2, MyPool.Free(zMessage::Message::TYPE_CMD));
+  TEST_TRUE(MyPool.SetLimit(zMessage::MessagePool::DefaultLimit));
+
+  // Held until exit, where its release must not touch the destroyed pool
+  _held = zMessage::MessageFactory::Acquire(zMessage::Message::TYPE_DATA);
+  TEST_TRUE(_held.get() != NULL);
+
+  // Return success
+  return (0);
+
+}
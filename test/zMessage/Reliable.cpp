@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zMessageTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+// Delivers into the peer's queue, dropping every fifth message and
+//   reordering every seventh
+class TestLossyTransport : public zMessage::ReliableTransport
+{
+
+public:
+
+  TestLossyTransport(const std::string& addr_) :
+      Sent(0), _addr(addr_), _lock(zSem::Mutex::LOCKED)
+  {
+    this->_lock.Unlock();
+  }
+
+  virtual bool
+  Transmit(zMessage::Message& msg_)
+  {
+    msg_.SetSrc(this->_addr);
+    this->_lock.Lock();
+    if ((++this->Sent % 5) != 0)
+    {
+      if ((this->Sent % 7) == 0)
+      {
+        this->_queue.push_front(msg_);
+      }
+      else
+      {
+        this->_queue.push_back(msg_);
+      }
+    }
+    this->_lock.Unlock();
+    return (true);
+  }
+
+  std::list<zMessage::Message>
+  Drain()
+  {
+    std::list<zMessage::Message> msgs;
+    this->_lock.Lock();
+    msgs.swap(this->_queue);
+    this->_lock.Unlock();
+    return (msgs);
+  }
+
+  int Sent;
+
+private:
+
+  std::string _addr;
+  zSem::Mutex _lock;
+  std::list<zMessage::Message> _queue;
+
+};
+
+int
+zMessageTest_ReliableChannel(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_ReliableChannel()");
+  ZLOG_DEBUG("#############################################################");
+
+  TestLossyTransport LinkA("A");
+  TestLossyTransport LinkB("B");
+  zMessage::ReliableChannel ChanA(LinkA, 16);
+  zMessage::ReliableChannel ChanB(LinkB, 16);
+  zMessage::MessagePath NumPath(std::string("Num"));
+  std::vector<int> nums;
+
+  // Messages outside the channel are left to the caller
+  zMessage::Message Plain;
+  std::vector<SHARED_PTR(zMessage::Message)> deliver;
+  TEST_FALSE(ChanB.Receive(Plain, deliver));
+  TEST_TRUE(deliver.empty());
+
+  // Sends beyond the window are queued
+  for (int i = 0; i < 200; i++)
+  {
+    zMessage::Message *myMessage = zMessage::MessageFactory::Create(zMessage::Message::TYPE_DATA);
+    TEST_ISNOT_NULL(myMessage);
+    TEST_TRUE(myMessage->SetDst("B"));
+    TEST_TRUE(myMessage->PutValue(NumPath, i));
+    TEST_TRUE(ChanA.Send(*myMessage));
+    delete (myMessage);
+  }
+  TEST_EQ(200, ChanA.Pending("B"));
+  TEST_EQ(16, LinkA.Sent);
+
+  // Everything arrives once and in order despite loss and reordering
+  for (int i = 0; (i < 5000) && (nums.size() < 200); i++)
+  {
+    FOREACH (auto& msg, LinkA.Drain())
+    {
+      TEST_TRUE(ChanB.Receive(msg, deliver));
+    }
+    FOREACH (auto& msg, deliver)
+    {
+      int num = -1;
+      TEST_TRUE(msg->GetValue(NumPath, num));
+      TEST_EQ(zMessage::Message::TYPE_DATA, msg->GetType());
+      nums.push_back(num);
+    }
+    deliver.clear();
+    FOREACH (auto& msg, LinkB.Drain())
+    {
+      TEST_TRUE(ChanA.Receive(msg, deliver));
+      TEST_TRUE(deliver.empty());
+    }
+    usleep(1000);
+  }
+  TEST_EQ(200, nums.size());
+  for (int i = 0; i < 200; i++)
+  {
+    TEST_EQ(i, nums[i]);
+  }
+
+  // Round trips here are short, so the timeout settles low
+  TEST_TRUE(ChanA.GetRto("B") < 200);
+
+  // Return success
+  return (0);
+
+}
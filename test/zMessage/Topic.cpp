@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zMessageTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+// Queues subscription updates and published buffers for delivery by the test
+class TestTopicTransport : public zMessage::ReliableTransport, public zMessage::BatchTransport
+{
+
+public:
+
+  TestTopicTransport(const std::string& addr_) :
+      _addr(addr_)
+  {
+  }
+
+  virtual bool
+  Transmit(zMessage::Message& msg_)
+  {
+    msg_.SetSrc(this->_addr);
+    this->Msgs.push_back(msg_);
+    return (true);
+  }
+
+  virtual bool
+  TransmitBatch(const std::string& dst_, const std::string& buf_)
+  {
+    this->Bufs.push_back(std::make_pair(dst_, buf_));
+    return (true);
+  }
+
+  std::list<zMessage::Message> Msgs;
+  std::vector<std::pair<std::string, std::string> > Bufs;
+
+private:
+
+  std::string _addr;
+
+};
+
+int
+zMessageTest_TopicTrie(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_TopicTrie()");
+  ZLOG_DEBUG("#############################################################");
+
+  zMessage::TopicTrie MyTrie;
+  std::set<std::string> subs;
+  TEST_IS_ZERO(MyTrie.Size());
+  TEST_FALSE(MyTrie.Match("a/b"));
+
+  // Wildcards stand for whole levels and '#' only at the end
+  TEST_TRUE(zMessage::TopicTrie::ValidFilter("a/+/c"));
+  TEST_TRUE(zMessage::TopicTrie::ValidFilter("a/#"));
+  TEST_TRUE(zMessage::TopicTrie::ValidFilter("#"));
+  TEST_FALSE(zMessage::TopicTrie::ValidFilter(""));
+  TEST_FALSE(zMessage::TopicTrie::ValidFilter("a/#/c"));
+  TEST_FALSE(zMessage::TopicTrie::ValidFilter("a/b+"));
+  TEST_TRUE(zMessage::TopicTrie::ValidTopic("a/b/c"));
+  TEST_FALSE(zMessage::TopicTrie::ValidTopic("a/+"));
+  TEST_FALSE(MyTrie.Add("a/#/c", "s1"));
+
+  TEST_TRUE(MyTrie.Add("a/b/c", "s1"));
+  TEST_FALSE(MyTrie.Add("a/b/c", "s1"));
+  TEST_TRUE(MyTrie.Add("a/+/c", "s2"));
+  TEST_TRUE(MyTrie.Add("a/#", "s3"));
+  TEST_TRUE(MyTrie.Add("#", "s4"));
+  TEST_TRUE(MyTrie.Add("x/y", "s1"));
+  TEST_EQ(5, MyTrie.Size());
+
+  TEST_EQ(4, MyTrie.Match("a/b/c", subs));
+  TEST_EQ(1, subs.count("s1"));
+  TEST_EQ(1, subs.count("s2"));
+  subs.clear();
+  TEST_EQ(3, MyTrie.Match("a/z/c", subs));
+  TEST_EQ(0, subs.count("s1"));
+  subs.clear();
+  TEST_EQ(2, MyTrie.Match("a", subs));
+  TEST_EQ(1, subs.count("s3"));
+  subs.clear();
+  TEST_EQ(2, MyTrie.Match("x/y", subs));
+  subs.clear();
+  TEST_EQ(1, MyTrie.Match("x/y/z", subs));
+  TEST_EQ(1, subs.count("s4"));
+  subs.clear();
+
+  // Removing filters prunes their levels
+  TEST_FALSE(MyTrie.Remove("a/b/c", "s2"));
+  TEST_TRUE(MyTrie.Remove("a/b/c", "s1"));
+  TEST_TRUE(MyTrie.Remove("#", "s4"));
+  TEST_EQ(3, MyTrie.Size());
+  TEST_EQ(2, MyTrie.Match("a/b/c", subs));
+  TEST_EQ(0, subs.count("s1"));
+  subs.clear();
+  TEST_TRUE(MyTrie.Remove("a/+/c", "s2"));
+  TEST_TRUE(MyTrie.Remove("a/#", "s3"));
+  TEST_TRUE(MyTrie.Remove("x/y", "s1"));
+  TEST_IS_ZERO(MyTrie.Size());
+  TEST_FALSE(MyTrie.Match("a/b/c"));
+
+  // Return success
+  return (0);
+}
+
+static void
+_deliver(TestTopicTransport& from_, std::map<std::string, zMessage::TopicChannel*>& chans_,
+    std::map<std::string, int>& delivered_)
+{
+  std::list<zMessage::Message> msgs;
+  std::vector<std::pair<std::string, std::string> > bufs;
+  msgs.swap(from_.Msgs);
+  bufs.swap(from_.Bufs);
+  FOREACH (auto& msg, msgs)
+  {
+    bool deliver = false;
+    chans_[msg.GetDst()]->Receive(msg, deliver);
+  }
+  FOREACH (auto& buf, bufs)
+  {
+    bool deliver = false;
+    zMessage::MessageFrame frame(buf.second.data(), buf.second.size());
+    zMessage::Message* msg = frame.Decode();
+    if (msg && chans_[buf.first]->Receive(*msg, deliver) && deliver)
+    {
+      delivered_[buf.first]++;
+    }
+    delete (msg);
+  }
+}
+
+int
+zMessageTest_TopicChannel(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zMessageTest_TopicChannel()");
+  ZLOG_DEBUG("#############################################################");
+
+  TestTopicTransport LinkA("A");
+  TestTopicTransport LinkB("B");
+  TestTopicTransport LinkC("C");
+  zMessage::TopicChannel ChanA(LinkA, LinkA);
+  zMessage::TopicChannel ChanB(LinkB, LinkB);
+  zMessage::TopicChannel ChanC(LinkC, LinkC);
+  std::map<std::string, zMessage::TopicChannel*> chans;
+  std::map<std::string, int> delivered;
+  chans["A"] = &ChanA;
+  chans["B"] = &ChanB;
+  chans["C"] = &ChanC;
+
+  // Messages outside the channel are left to the caller
+  bool deliver = true;
+  zMessage::Message Plain;
+  TEST_FALSE(ChanA.Receive(Plain, deliver));
+  TEST_FALSE(deliver);
+
+  // B and C subscribe and then meet A, which learns their subscriptions
+  TEST_TRUE(ChanB.Subscribe("sensor/+/temp"));
+  TEST_FALSE(ChanB.Subscribe("sensor/+/temp"));
+  TEST_FALSE(ChanB.Subscribe("sensor/#/temp"));
+  TEST_TRUE(ChanC.Subscribe("sensor/#"));
+  TEST_TRUE(ChanB.AddPeer("A"));
+  TEST_TRUE(ChanC.AddPeer("A"));
+  for (int i = 0; i < 3; i++)
+  {
+    _deliver(LinkA, chans, delivered);
+    _deliver(LinkB, chans, delivered);
+    _deliver(LinkC, chans, delivered);
+  }
+  TEST_EQ(2, ChanA.Subscribers("sensor/1/temp"));
+  TEST_EQ(1, ChanA.Subscribers("sensor/1/humidity"));
+  TEST_IS_ZERO(ChanA.Subscribers("other"));
+
+  // A publication is encoded once and the same buffer goes to each subscriber
+  zMessage::Message *myMessage = zMessage::MessageFactory::Create(zMessage::Message::TYPE_DATA);
+  TEST_ISNOT_NULL(myMessage);
+  TEST_TRUE(myMessage->SetSrc("A"));
+  TEST_TRUE(myMessage->SetDst("D"));
+  TEST_EQ(2, ChanA.Publish("sensor/1/temp", *myMessage));
+  TEST_EQ(2, LinkA.Bufs.size());
+  TEST_EQ(LinkA.Bufs[0].second, LinkA.Bufs[1].second);
+
+  // Publishing leaves the caller's message unchanged, so it can be published again
+  std::string topic;
+  TEST_EQ(std::string("D"), myMessage->GetDst());
+  TEST_FALSE(myMessage->GetValue(zMessage::MessagePath(zMessage::TopicChannel::TopicDataPath), topic));
+  TEST_EQ(1, ChanA.Publish("sensor/1/humidity", *myMessage));
+  TEST_EQ(std::string("D"), myMessage->GetDst());
+  TEST_IS_ZERO(ChanA.Publish("other", *myMessage));
+  TEST_IS_ZERO(ChanA.Publish("sensor/+", *myMessage));
+  _deliver(LinkA, chans, delivered);
+  TEST_EQ(1, delivered["B"]);
+  TEST_EQ(2, delivered["C"]);
+
+  // Receivers match publications against their own subscriptions
+  TEST_TRUE(myMessage->PutValue(zMessage::MessagePath(zMessage::TopicChannel::TopicDataPath), std::string("other")));
+  TEST_TRUE(ChanB.Receive(*myMessage, deliver));
+  TEST_FALSE(deliver);
+
+  // Unsubscribing is passed on to peers
+  TEST_TRUE(ChanC.Unsubscribe("sensor/#"));
+  TEST_FALSE(ChanC.Unsubscribe("sensor/#"));
+  _deliver(LinkC, chans, delivered);
+  TEST_EQ(1, ChanA.Subscribers("sensor/1/temp"));
+  TEST_IS_ZERO(ChanA.Subscribers("sensor/1/humidity"));
+
+  // Peers removed are no longer sent to
+  TEST_TRUE(ChanA.RemovePeer("B"));
+  TEST_FALSE(ChanA.RemovePeer("B"));
+  TEST_IS_ZERO(ChanA.Publish("sensor/1/temp", *myMessage));
+
+  // Cleanup
+  delete (myMessage);
+
+  // Return success
+  return (0);
+}
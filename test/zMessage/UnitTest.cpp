@@ -43,11 +43,23 @@ main(int argc, const char **argv)
   UTEST_TEST(zMessageTest_FactoryCmd, 0);
   UTEST_TEST(zMessageTest_FactoryData, 0);
 
+  UTEST_TEST(zMessageTest_MessagePool, 0);
+
+  UTEST_TEST(zMessageTest_FrameEncodeDecode, 0);
+  UTEST_TEST(zMessageTest_FrameStream, 0);
+  UTEST_TEST(zMessageTest_MessageBatcher, 0);
+
+  UTEST_TEST(zMessageTest_AckTracker, 0);
+  UTEST_TEST(zMessageTest_ReliableChannel, 0);
+  UTEST_TEST(zMessageTest_TopicTrie, 0);
+  UTEST_TEST(zMessageTest_TopicChannel, 0);
+
   UTEST_TEST(zMessageTest_MessageGetSet, 0);
   UTEST_TEST(zMessageTest_MessageCopy, 0);
 
   UTEST_TEST(zMessageTest_MessageLoopSocket, 0);
   UTEST_TEST(zMessageTest_MessageUnixSocket, 0);
+  UTEST_TEST(zMessageTest_MessageSocketFrames, 0);
 
 //  UTEST_TEST(zMessageTest_MessageHandler, 0);
 
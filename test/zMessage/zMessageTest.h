@@ -38,6 +38,12 @@
 
 #include <zutils/zMessage.h>
 #include <zutils/zMessageSocket.h>
+#include <zutils/zMessageFrame.h>
+#include <zutils/zMessagePool.h>
+#include <zutils/zMessageBatcher.h>
+#include <zutils/zAckTracker.h>
+#include <zutils/zReliableChannel.h>
+#include <zutils/zMessageTopic.h>
 
 #include "UnitTest.h"
 
@@ -63,6 +69,25 @@ zMessageTest_FactoryCmd(void* arg_);
 int
 zMessageTest_FactoryData(void* arg_);
 
+int
+zMessageTest_MessagePool(void* arg_);
+
+int
+zMessageTest_FrameEncodeDecode(void* arg_);
+int
+zMessageTest_FrameStream(void* arg_);
+int
+zMessageTest_MessageBatcher(void* arg_);
+
+int
+zMessageTest_AckTracker(void* arg_);
+int
+zMessageTest_ReliableChannel(void* arg_);
+int
+zMessageTest_TopicTrie(void* arg_);
+int
+zMessageTest_TopicChannel(void* arg_);
+
 int
 zMessageTest_MessageGetSet(void* arg_);
 int
@@ -72,6 +97,8 @@ int
 zMessageTest_MessageLoopSocket(void* arg_);
 int
 zMessageTest_MessageUnixSocket(void* arg_);
+int
+zMessageTest_MessageSocketFrames(void* arg_);
 
 int
 zMessageTest_MessageHandler(void* arg_);
@@ -92,37 +119,33 @@ public:
 
   }
 
-  zQueue<zMessage::Message*> RxSem;
-  zQueue<zMessage::Message*> TxSem;
-  zQueue<zMessage::Message*> ErrSem;
+  zQueue::Queue<SHARED_PTR(zMessage::Message)> RxSem;
+  zQueue::Queue<SHARED_PTR(zMessage::Message)> TxSem;
+  zQueue::Queue<SHARED_PTR(zMessage::Message)> ErrSem;
 
 protected:
 
   virtual bool
-  EventHandler(zEvent::Notification* notification_)
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
   {
-    zMessage::MessageNotification *n = NULL;
     ZLOG_DEBUG("Handling socket event");
 
     bool status = false;
-    if (notification_ && (notification_->GetType() == zEvent::Event::TYPE_MSG))
+    if (n_ && (n_->GetType() == zEvent::Event::TYPE_MSG))
     {
-      n = (zMessage::MessageNotification *) notification_;
+      SHARED_PTR(zMessage::MessageNotification) n = STATIC_CAST(zMessage::MessageNotification)(n_);
       switch (n->Id())
       {
       case zMessage::MessageNotification::ID_MSG_RCVD:
-//        std::cout << "TestObserver: Received: " << std::endl;
-        this->RxSem.Push(n->GetMessage());
+        this->RxSem.Push(n->GetMessagePtr());
         status = true;
         break;
       case zMessage::MessageNotification::ID_MSG_SENT:
-//        std::cout << "TestObserver: Sent: " << std::endl;
-        this->TxSem.Push(n->GetMessage());
+        this->TxSem.Push(n->GetMessagePtr());
         status = true;
         break;
       default:
-//        std::cout << "TestObserver: Error: " << std::endl;
-        this->ErrSem.Push(n->GetMessage());
+        this->ErrSem.Push(n->GetMessagePtr());
         status = false;
         break;
       }
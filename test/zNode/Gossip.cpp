@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <time.h>
+
+#include <set>
+#include <sstream>
+#include <functional>
+
+#include "zNodeTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+// Carries messages between gossip members in this process; a cut link or
+//   a cut member loses all traffic
+class TestGossipHub : public zMessage::ReliableTransport
+{
+
+public:
+
+  TestGossipHub() :
+      _lock(zSem::Mutex::LOCKED)
+  {
+    this->_lock.Unlock();
+  }
+
+  virtual bool
+  Transmit(zMessage::Message& msg_)
+  {
+    this->_lock.Lock();
+    this->_queue.push_back(msg_);
+    this->_lock.Unlock();
+    return (true);
+  }
+
+  void
+  Attach(const std::string& addr_, zNode::Gossip* member_)
+  {
+    this->_members[addr_] = member_;
+  }
+
+  void
+  Cut(const std::string& a_, const std::string& b_ = std::string())
+  {
+    this->_cut.insert(std::make_pair(a_, b_));
+    this->_cut.insert(std::make_pair(b_, a_));
+  }
+
+  void
+  Heal()
+  {
+    this->_cut.clear();
+  }
+
+  // Delivers the traffic until done_ holds or the time is up; without
+  //   done_ for all of the time
+  bool
+  Run(const int msecs_, const std::function<bool()>& done_ = std::function<bool()>())
+  {
+    struct timespec start = { 0 };
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;)
+    {
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      if (done_ && done_())
+      {
+        return (true);
+      }
+      if ((((now.tv_sec - start.tv_sec) * 1000) + ((now.tv_nsec - start.tv_nsec) / 1000000)) >= msecs_)
+      {
+        break;
+      }
+      std::list<zMessage::Message> msgs;
+      this->_lock.Lock();
+      msgs.swap(this->_queue);
+      this->_lock.Unlock();
+      FOREACH (auto& msg, msgs)
+      {
+        std::string src = msg.GetSrc();
+        std::string dst = msg.GetDst();
+        if (!this->_cut.count(std::make_pair(src, dst)) && !this->_cut.count(std::make_pair(src, std::string()))
+            && !this->_cut.count(std::make_pair(dst, std::string())) && this->_members.count(dst))
+        {
+          this->_members[dst]->Receive(msg);
+        }
+      }
+      usleep(1000);
+    }
+    return (!done_ || done_());
+  }
+
+private:
+
+  zSem::Mutex _lock;
+  std::list<zMessage::Message> _queue;
+  std::map<std::string, zNode::Gossip*> _members;
+  std::set<std::pair<std::string, std::string> > _cut;
+
+};
+
+int
+zNodeTest_Gossip(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zNodeTest_Gossip()");
+  ZLOG_DEBUG("#############################################################");
+
+  const int n = 4;
+  TestGossipHub hub;
+  zNode::Node *nodes[n];
+  zNode::Table *tables[n];
+  TestObserver *obsvrs[n];
+  zNode::Gossip *members[n];
+
+  // Create members probing every 50ms, each with its own node table
+  for (int i = 0; i < n; i++)
+  {
+    std::ostringstream addr;
+    addr << "127.0.0.1:" << (9000 + i);
+    nodes[i] = new zNode::Node("", addr.str());
+    tables[i] = new zNode::Table(100);
+    obsvrs[i] = new TestObserver;
+    tables[i]->Register(obsvrs[i]);
+    members[i] = new zNode::Gossip(*tables[i], hub, *nodes[i], 50, 2, 3);
+    TEST_EQ(zNode::Gossip::STATE_ALIVE, members[i]->GetState(nodes[i]->GetId()));
+    TEST_EQ(zNode::Gossip::STATE_NONE, members[i]->GetState("unknown"));
+    TEST_IS_ZERO(members[i]->Size());
+    hub.Attach(addr.str(), members[i]);
+  }
+
+  // Join all through the first member and validate everyone learns of everyone
+  TEST_FALSE(members[0]->Join(nodes[0]->GetAddress()));
+  for (int i = 1; i < n; i++)
+  {
+    TEST_TRUE(members[i]->Join(nodes[0]->GetAddress()));
+  }
+  TEST_TRUE(hub.Run(5000, [&]()
+  {
+    for (int i = 0; i < n; i++)
+    {
+      if ((members[i]->Size() != size_t(n - 1)) || (tables[i]->Size() != size_t(n - 1)))
+      {
+        return (false);
+      }
+    }
+    return (true);
+  }));
+  for (int i = 0; i < n; i++)
+  {
+    TEST_EQ((n - 1), (int )members[i]->Size());
+    TEST_EQ((n - 1), (int )tables[i]->Size());
+    TEST_EQ((n - 1), obsvrs[i]->GetCount(zNode::Observer::EVENT_NEW));
+    TEST_IS_ZERO(obsvrs[i]->GetCount(zNode::Observer::EVENT_TARDY));
+  }
+
+  // Cut the link between two members; indirect probes keep them alive
+  hub.Cut(nodes[1]->GetAddress(), nodes[2]->GetAddress());
+  hub.Run(1000);
+  TEST_EQ(zNode::Gossip::STATE_ALIVE, members[1]->GetState(nodes[2]->GetId()));
+  TEST_EQ(zNode::Gossip::STATE_ALIVE, members[2]->GetState(nodes[1]->GetId()));
+  for (int i = 0; i < n; i++)
+  {
+    TEST_IS_ZERO(members[i]->GetIncarnation());
+    TEST_IS_ZERO(obsvrs[i]->GetCount(zNode::Observer::EVENT_TARDY));
+  }
+  hub.Heal();
+
+  // Cut the last member off; the others declare it dead and their tables
+  //   age it out
+  hub.Cut(nodes[n - 1]->GetAddress());
+  TEST_TRUE(hub.Run(10000, [&]()
+  {
+    for (int i = 0; i < (n - 1); i++)
+    {
+      if ((members[i]->GetState(nodes[n - 1]->GetId()) != zNode::Gossip::STATE_DEAD)
+          || (tables[i]->Size() != size_t(n - 2)) || !obsvrs[i]->GetCount(zNode::Observer::EVENT_RETIRED))
+      {
+        return (false);
+      }
+    }
+    return (true);
+  }));
+  for (int i = 0; i < (n - 1); i++)
+  {
+    TEST_EQ(zNode::Gossip::STATE_DEAD, members[i]->GetState(nodes[n - 1]->GetId()));
+    TEST_EQ((n - 2), (int )members[i]->Size());
+    TEST_EQ((n - 2), (int )tables[i]->Size());
+    TEST_EQ(1, obsvrs[i]->GetCount(zNode::Observer::EVENT_TARDY));
+    TEST_EQ(1, obsvrs[i]->GetCount(zNode::Observer::EVENT_STALE));
+    TEST_EQ(1, obsvrs[i]->GetCount(zNode::Observer::EVENT_OFFLINE));
+    TEST_EQ(1, obsvrs[i]->GetCount(zNode::Observer::EVENT_RETIRED));
+  }
+
+  // Bring it back; it refutes its death with a new incarnation
+  hub.Heal();
+  TEST_TRUE(members[n - 1]->Join(nodes[0]->GetAddress()));
+  TEST_TRUE(hub.Run(5000, [&]()
+  {
+    for (int i = 0; i < (n - 1); i++)
+    {
+      if ((members[i]->GetState(nodes[n - 1]->GetId()) != zNode::Gossip::STATE_ALIVE)
+          || (tables[i]->Size() != size_t(n - 1)))
+      {
+        return (false);
+      }
+    }
+    return (true);
+  }));
+  TEST_NEQ(0, (int )members[n - 1]->GetIncarnation());
+  for (int i = 0; i < (n - 1); i++)
+  {
+    TEST_EQ(zNode::Gossip::STATE_ALIVE, members[i]->GetState(nodes[n - 1]->GetId()));
+    TEST_EQ((n - 1), (int )tables[i]->Size());
+  }
+
+  // Leave and validate the others learn of it
+  TEST_TRUE(members[1]->Leave());
+  TEST_EQ(zNode::Gossip::STATE_DEAD, members[1]->GetState(nodes[1]->GetId()));
+  TEST_TRUE(hub.Run(5000, [&]()
+  {
+    for (int i = 0; i < n; i++)
+    {
+      if ((i != 1) && (members[i]->GetState(nodes[1]->GetId()) != zNode::Gossip::STATE_DEAD))
+      {
+        return (false);
+      }
+    }
+    return (true);
+  }));
+  for (int i = 0; i < n; i++)
+  {
+    if (i != 1)
+    {
+      TEST_EQ(zNode::Gossip::STATE_DEAD, members[i]->GetState(nodes[1]->GetId()));
+    }
+  }
+
+  // Clean up
+  for (int i = 0; i < n; i++)
+  {
+    delete (members[i]);
+  }
+  for (int i = 0; i < n; i++)
+  {
+    tables[i]->Unregister(obsvrs[i]);
+    delete (tables[i]);
+    delete (obsvrs[i]);
+    delete (nodes[i]);
+  }
+
+  // Return success
+  return (0);
+
+}
+
+// Waits for done_ to hold, at most the given time
+static bool
+_until(const int msecs_, const std::function<bool()>& done_)
+{
+  for (int i = 0; (i < msecs_) && !done_(); i++)
+  {
+    usleep(1000);
+  }
+  return (done_());
+}
+
+// Hands gossip received on a message socket to its member
+class TestGossipObserver : public zEvent::Observer
+{
+
+public:
+
+  TestGossipObserver(zNode::Gossip& member_) :
+      _member(member_)
+  {
+  }
+
+protected:
+
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
+  {
+    bool status = false;
+    if (n_.get() && (n_->GetType() == zEvent::Event::TYPE_MSG))
+    {
+      SHARED_PTR(zMessage::MessageNotification) n = STATIC_CAST(zMessage::MessageNotification)(n_);
+      if ((n->Id() == zMessage::MessageNotification::ID_MSG_RCVD) && n->GetMessage())
+      {
+        status = this->_member.Receive(*n->GetMessage());
+      }
+    }
+    return (status);
+  }
+
+private:
+
+  zNode::Gossip& _member;
+
+};
+
+int
+zNodeTest_GossipUdp(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zNodeTest_GossipUdp()");
+  ZLOG_DEBUG("#############################################################");
+
+  const int n = 2;
+  zSocket::Ipv4Address *addrs[n];
+  zSocket::UdpSocket *socks[n];
+  zMessage::MessageSocket *msgsocks[n];
+  zEvent::Handler *handlers[n];
+  zNode::Node *nodes[n];
+  zNode::Table *tables[n];
+  zNode::Gossip *members[n];
+  TestGossipObserver *obsvrs[n];
+
+  // Create members on loopback UDP message sockets
+  for (int i = 0; i < n; i++)
+  {
+    std::ostringstream addr;
+    addr << "127.0.0.1:" << (9600 + i);
+    addrs[i] = new zSocket::Ipv4Address(addr.str());
+    socks[i] = new zSocket::UdpSocket;
+    TEST_TRUE(socks[i]->Bind(*addrs[i]));
+    msgsocks[i] = new zMessage::MessageSocket;
+    TEST_TRUE(msgsocks[i]->Listen(socks[i]));
+    nodes[i] = new zNode::Node("", addrs[i]->GetAddress());
+    tables[i] = new zNode::Table(100);
+    members[i] = new zNode::Gossip(*tables[i], *msgsocks[i], *nodes[i], 50, 2, 3);
+    obsvrs[i] = new TestGossipObserver(*members[i]);
+    handlers[i] = new zEvent::Handler;
+    handlers[i]->RegisterObserver(obsvrs[i]);
+    handlers[i]->RegisterEvent(msgsocks[i]);
+  }
+
+  // Connect the second member to the first so each reaches the other and
+  //   validate both learn of each other
+  TEST_TRUE(msgsocks[1]->Connect(*addrs[0], socks[1]));
+  TEST_TRUE(members[1]->Join(nodes[0]->GetAddress()));
+  TEST_TRUE(_until(5000, [&]()
+  {
+    return ((members[0]->Size() == 1) && (members[1]->Size() == 1) && (tables[0]->Size() == 1)
+        && (tables[1]->Size() == 1));
+  }));
+  TEST_EQ(zNode::Gossip::STATE_ALIVE, members[0]->GetState(nodes[1]->GetId()));
+  TEST_EQ(zNode::Gossip::STATE_ALIVE, members[1]->GetState(nodes[0]->GetId()));
+  TEST_EQ(nodes[1]->GetAddress(), tables[0]->Find(nodes[1]->GetId())->GetAddress());
+
+  // Leave and validate the other learns of it
+  TEST_TRUE(members[1]->Leave());
+  TEST_TRUE(_until(5000, [&]()
+  {
+    return (members[0]->GetState(nodes[1]->GetId()) == zNode::Gossip::STATE_DEAD);
+  }));
+
+  // Clean up
+  for (int i = 0; i < n; i++)
+  {
+    handlers[i]->UnregisterEvent(msgsocks[i]);
+    handlers[i]->UnregisterObserver(obsvrs[i]);
+    delete (handlers[i]);
+    delete (obsvrs[i]);
+    delete (members[i]);
+  }
+  for (int i = 0; i < n; i++)
+  {
+    delete (msgsocks[i]);
+    delete (socks[i]);
+    delete (addrs[i]);
+    delete (tables[i]);
+    delete (nodes[i]);
+  }
+
+  // Return success
+  return (0);
+
+}
@@ -144,3 +144,130 @@ zNodeTest_NodeTableExpire(void* arg_)
   // Return success
   return (0);
 }
+
+int
+zNodeTest_NodeTableRefresh(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zNodeTest_NodeTableRefresh()");
+  ZLOG_DEBUG("#############################################################");
+
+  // Create new node table test observer and validate
+  TestObserver *MyObsvr = new TestObserver;
+  TEST_IS_ZERO(MyObsvr->GetCount());
+
+  // Create new node table and register observer
+  zNode::Table *MyNodeTable = new zNode::Table(100);
+  MyNodeTable->Register(MyObsvr);
+
+  // Add enough nodes to grow the table
+  std::vector<std::string> ids;
+  for (int i = 0; i < 200; i++)
+  {
+    zNode::Node MyNode("TestNode", "1.2.3.4:5");
+    TEST_TRUE(MyNode.SetState(zNode::Node::STATE_ONLINE));
+    TEST_TRUE(MyNodeTable->Add(MyNode));
+    ids.push_back(MyNode.GetId());
+  }
+  TEST_EQ(200, MyNodeTable->Size());
+  TEST_EQ(200, MyObsvr->GetCount());
+  FOREACH (auto& id, ids)
+  {
+    zNode::Node *node = MyNodeTable->Find(id);
+    TEST_ISNOT_NULL(node);
+    TEST_EQ(id, node->GetId());
+  }
+  TEST_FALSE(MyNodeTable->Refresh("abcdef56789"));
+
+  // Only the node kept refreshed outlives the others
+  for (int i = 0; i < 20; i++)
+  {
+    TEST_TRUE(MyNodeTable->Refresh(ids[0]));
+    usleep(50000);
+  }
+  TEST_EQ(1, MyNodeTable->Size());
+  TEST_EQ((200 + (199 * 5)), MyObsvr->GetCount());
+  zNode::Node *node = MyNodeTable->Find(ids[0]);
+  TEST_ISNOT_NULL(node);
+  TEST_EQ(zNode::Node::STATE_ONLINE, node->GetState());
+  TEST_IS_NULL(MyNodeTable->Find(ids[1]));
+  TEST_FALSE(MyNodeTable->Refresh(ids[1]));
+
+  // Once left alone it goes tardy
+  usleep(200000);
+  TEST_EQ(zNode::Node::STATE_TARDY, node->GetState());
+
+  // Cleanup
+  MyNodeTable->Unregister(MyObsvr);
+  delete (MyObsvr);
+  delete (MyNodeTable);
+
+  // Return success
+  return (0);
+}
+
+int
+zNodeTest_NodeTableBatch(void* arg_)
+{
+
+  ZLOG_DEBUG("#############################################################");
+  ZLOG_DEBUG("# zNodeTest_NodeTableBatch()");
+  ZLOG_DEBUG("#############################################################");
+
+  // Create new node table with a batching and a per node observer
+  TestBatchObserver *MyBatchObsvr = new TestBatchObserver;
+  TestObserver *MyObsvr = new TestObserver;
+  zNode::Table *MyNodeTable = new zNode::Table(100);
+  MyNodeTable->Register(MyBatchObsvr);
+  MyNodeTable->Register(MyObsvr);
+
+  // Each add is a batch of its own
+  for (int i = 0; i < 100; i++)
+  {
+    zNode::Node MyNode("TestNode", "1.2.3.4:5");
+    TEST_TRUE(MyNode.SetState(zNode::Node::STATE_ONLINE));
+    TEST_TRUE(MyNodeTable->Add(MyNode));
+  }
+  TEST_EQ(100, MyBatchObsvr->GetBatches());
+  TEST_EQ(100, MyBatchObsvr->GetCount(zNode::Observer::EVENT_NEW));
+
+  // Nodes changing state together arrive together
+  sleep(1);
+  TEST_IS_ZERO(MyNodeTable->Size());
+  TEST_EQ(600, MyBatchObsvr->GetCount());
+  TEST_EQ(600, MyBatchObsvr->GetTotal());
+  TEST_EQ(600, MyObsvr->GetCount());
+  TEST_LT(MyBatchObsvr->GetBatches(), 150);
+  TEST_EQ(100, MyBatchObsvr->GetCount(zNode::Observer::EVENT_TARDY));
+  TEST_EQ(100, MyBatchObsvr->GetCount(zNode::Observer::EVENT_STALE));
+  TEST_EQ(100, MyBatchObsvr->GetCount(zNode::Observer::EVENT_OFFLINE));
+  TEST_EQ(100, MyBatchObsvr->GetCount(zNode::Observer::EVENT_RETIRED));
+  TEST_EQ(100, MyBatchObsvr->GetCount(zNode::Observer::EVENT_REMOVED));
+  TEST_EQ(100, MyObsvr->GetCount(zNode::Observer::EVENT_REMOVED));
+
+  // Nodes removed while a batch is out are freed once it is done
+  TestRemoveObserver *MyRemoveObsvr = new TestRemoveObserver(*MyNodeTable);
+  MyNodeTable->Register(MyRemoveObsvr);
+  for (int i = 0; i < 10; i++)
+  {
+    zNode::Node MyNode("TestNode", "1.2.3.4:5");
+    TEST_TRUE(MyNode.SetState(zNode::Node::STATE_ONLINE));
+    TEST_TRUE(MyNodeTable->Add(MyNode));
+  }
+  TEST_EQ(10, MyRemoveObsvr->GetRemoved());
+  TEST_IS_ZERO(MyNodeTable->Size());
+  TEST_EQ(110, MyObsvr->GetCount(zNode::Observer::EVENT_REMOVED));
+  MyNodeTable->Unregister(MyRemoveObsvr);
+  delete (MyRemoveObsvr);
+
+  // Cleanup
+  MyNodeTable->Unregister(MyObsvr);
+  MyNodeTable->Unregister(MyBatchObsvr);
+  delete (MyNodeTable);
+  delete (MyObsvr);
+  delete (MyBatchObsvr);
+
+  // Return success
+  return (0);
+}
@@ -40,6 +40,11 @@ main(int argc, const char **argv)
 
   UTEST_TEST(zNodeTest_NodeTableAddRemove, 0);
   UTEST_TEST(zNodeTest_NodeTableExpire, 0);
+  UTEST_TEST(zNodeTest_NodeTableRefresh, 0);
+  UTEST_TEST(zNodeTest_NodeTableBatch, 0);
+
+  UTEST_TEST(zNodeTest_Gossip, 0);
+  UTEST_TEST(zNodeTest_GossipUdp, 0);
   UTEST_FINI();
 
 }
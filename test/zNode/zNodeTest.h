@@ -17,10 +17,17 @@
 #ifndef _ZNODETEST_H_
 #define _ZNODETEST_H_
 
-#include "UnitTest.h"
-
+#include <zutils/zLog.h>
+#include <zutils/zData.h>
+#include <zutils/zEvent.h>
+#include <zutils/zSocket.h>
+#include <zutils/zUdpSocket.h>
+#include <zutils/zMessage.h>
+#include <zutils/zMessageSocket.h>
 #include <zutils/zNode.h>
 
+#include "UnitTest.h"
+
 int
 zNodeTest_NodeDefaults(void* arg_);
 int
@@ -37,6 +44,15 @@ int
 zNodeTest_NodeTableAddRemove(void* arg_);
 int
 zNodeTest_NodeTableExpire(void* arg_);
+int
+zNodeTest_NodeTableRefresh(void* arg_);
+int
+zNodeTest_NodeTableBatch(void* arg_);
+
+int
+zNodeTest_Gossip(void* arg_);
+int
+zNodeTest_GossipUdp(void* arg_);
 
 using namespace Test;
 using namespace zUtils;
@@ -47,6 +63,10 @@ public:
   TestObserver() :
       _count(0)
   {
+    for (int i = 0; i < zNode::Observer::EVENT_LAST; i++)
+    {
+      this->_events[i] = 0;
+    }
   }
   virtual
   ~TestObserver()
@@ -59,15 +79,128 @@ public:
     return (this->_count);
   }
 
+  int
+  GetCount(zNode::Observer::EVENT event_)
+  {
+    return (this->_events[event_]);
+  }
+
 protected:
   virtual void
   EventHandler(zNode::Observer::EVENT event_, const zNode::Node &node_)
   {
     this->_count++;
+    this->_events[event_]++;
+  }
+
+private:
+  int _count;
+  int _events[zNode::Observer::EVENT_LAST];
+};
+
+class TestBatchObserver : public zNode::Observer
+{
+public:
+  TestBatchObserver() :
+      _batches(0), _count(0), _total(0)
+  {
+    for (int i = 0; i < zNode::Observer::EVENT_LAST; i++)
+    {
+      this->_events[i] = 0;
+    }
+  }
+  virtual
+  ~TestBatchObserver()
+  {
+  }
+
+  int
+  GetBatches()
+  {
+    return (this->_batches);
+  }
+
+  int
+  GetCount()
+  {
+    return (this->_count);
+  }
+
+  int
+  GetTotal()
+  {
+    return (this->_total);
+  }
+
+  int
+  GetCount(zNode::Observer::EVENT event_)
+  {
+    return (this->_events[event_]);
+  }
+
+protected:
+  virtual void
+  EventHandler(zNode::Observer::EVENT event_, const zNode::Node &node_)
+  {
+  }
+
+  virtual void
+  BatchHandler(const std::vector<zNode::Observer::Change> &changes_, const zNode::Observer::Summary &summary_)
+  {
+    this->_batches++;
+    this->_count += changes_.size();
+    this->_total += summary_.total;
+    for (int i = 0; i < zNode::Observer::EVENT_LAST; i++)
+    {
+      this->_events[i] += summary_.events[i];
+    }
   }
 
 private:
+  int _batches;
   int _count;
+  int _total;
+  int _events[zNode::Observer::EVENT_LAST];
+};
+
+// Removes each new node from within the batch announcing it
+class TestRemoveObserver : public zNode::Observer
+{
+public:
+  TestRemoveObserver(zNode::Table &table_) :
+      _table(table_), _removed(0)
+  {
+  }
+  virtual
+  ~TestRemoveObserver()
+  {
+  }
+
+  int
+  GetRemoved()
+  {
+    return (this->_removed);
+  }
+
+protected:
+  virtual void
+  EventHandler(zNode::Observer::EVENT event_, const zNode::Node &node_)
+  {
+    if (event_ == zNode::Observer::EVENT_NEW)
+    {
+      // The node must stay valid until this batch is done
+      std::string name = node_.GetName();
+      zNode::Node *node = this->_table.Find(node_.GetId());
+      if (node && this->_table.Remove(*node) && (node_.GetName() == name))
+      {
+        this->_removed++;
+      }
+    }
+  }
+
+private:
+  zNode::Table &_table;
+  int _removed;
 };
 
 #endif /* _ZNODETEST_H_ */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <pthread.h>
+
+#include <vector>
+
+#include <zutils/zSignal.h>
+
+#include "zThreadTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+class TestSignalObserver : public zEvent::Observer, public zSem::Semaphore
+{
+public:
+
+  TestSignalObserver() :
+      Coalesced(0)
+  {
+  }
+
+  virtual bool
+  ObserveEvent(SHARED_PTR(zEvent::Notification) n_)
+  {
+    if (n_ && (n_->GetType() == zEvent::Event::TYPE_SIGNAL))
+    {
+      SHARED_PTR(zSignal::Notification) n = STATIC_CAST(zSignal::Notification)(n_);
+      this->Coalesced += n->Coalesced();
+      this->Tid = std::this_thread::get_id();
+      this->Notes.push_back(n);
+      this->Post();
+    }
+    return (true);
+  }
+
+  uint64_t Coalesced;
+  std::thread::id Tid;
+  std::vector<SHARED_PTR(zSignal::Notification)> Notes;
+
+};
+
+class TestMaskFunction : public zThread::ThreadFunction, public zSem::Semaphore
+{
+public:
+
+  virtual void
+  Run(zThread::ThreadArg *arg_)
+  {
+    sigemptyset(&this->Mask);
+    pthread_sigmask(SIG_BLOCK, NULL, &this->Mask);
+    this->Post();
+  }
+
+  sigset_t Mask;
+
+};
+
+int
+zThreadTest_SignalFd(void* arg_)
+{
+
+  zSignal::Manager& mgr = zSignal::Manager::Instance();
+  TEST_EQ(zSignal::Handler::MODE_ASYNC, mgr.GetMode());
+  TEST_EQ(-1, mgr.GetFd());
+
+  // Switch to signalfd delivery
+  TEST_TRUE(mgr.SetMode(zSignal::Handler::MODE_SIGNALFD));
+  TEST_EQ(zSignal::Handler::MODE_SIGNALFD, mgr.GetMode());
+  TEST_LT(-1, mgr.GetFd());
+
+  TestSignalObserver obs;
+  TEST_TRUE(mgr.RegisterObserver(zSignal::Signal::ID_SIGUSR1, &obs));
+
+  // Signals are blocked in the calling thread and read by the reader thread
+  sigset_t mask;
+  pthread_sigmask(SIG_BLOCK, NULL, &mask);
+  TEST_TRUE(sigismember(&mask, SIGUSR1));
+  TEST_IS_ZERO(kill(getpid(), SIGUSR1));
+  TEST_TRUE(obs.TimedWait(1000));
+  TEST_EQ(uint64_t(1), obs.Coalesced);
+  TEST_TRUE(std::this_thread::get_id() != obs.Tid);
+
+  // Each notification keeps the siginfo of its own signal
+  union sigval val;
+  val.sival_int = 1;
+  TEST_IS_ZERO(sigqueue(getpid(), SIGUSR1, val));
+  TEST_TRUE(obs.TimedWait(1000));
+  val.sival_int = 2;
+  TEST_IS_ZERO(sigqueue(getpid(), SIGUSR1, val));
+  TEST_TRUE(obs.TimedWait(1000));
+  TEST_EQ(uint64_t(3), obs.Coalesced);
+  TEST_EQ(size_t(3), obs.Notes.size());
+  TEST_EQ(SIGUSR1, obs.Notes[1]->SigInfo()->si_signo);
+  TEST_EQ(1, obs.Notes[1]->SigInfo()->si_value.sival_int);
+  TEST_EQ(2, obs.Notes[2]->SigInfo()->si_value.sival_int);
+
+  // A notification without siginfo does not carry that of an earlier signal
+  TEST_TRUE(mgr.Notify(zSignal::Signal::ID_SIGUSR1, NULL));
+  TEST_TRUE(obs.TimedWait(1000));
+  TEST_EQ(uint64_t(4), obs.Coalesced);
+  TEST_EQ(size_t(4), obs.Notes.size());
+  TEST_IS_ZERO(obs.Notes[3]->SigInfo()->si_signo);
+  TEST_IS_ZERO(obs.Notes[3]->SigInfo()->si_value.sival_int);
+  TEST_EQ(2, obs.Notes[2]->SigInfo()->si_value.sival_int);
+
+  // Threads are always created with signals blocked, even if the creator unblocks them
+  sigset_t usr1;
+  sigemptyset(&usr1);
+  sigaddset(&usr1, SIGUSR1);
+  pthread_sigmask(SIG_UNBLOCK, &usr1, NULL);
+  TestMaskFunction func;
+  zThread::Thread thread(&func, NULL);
+  TEST_TRUE(thread.Start());
+  TEST_TRUE(func.TimedWait(1000));
+  TEST_TRUE(thread.Join());
+  TEST_TRUE(sigismember(&func.Mask, SIGUSR1));
+
+  // A signal caught by a thread that does not block it is handed off to the reader
+  TEST_IS_ZERO(kill(getpid(), SIGUSR1));
+  TEST_TRUE(obs.TimedWait(1000));
+  TEST_EQ(uint64_t(5), obs.Coalesced);
+  TEST_TRUE(std::this_thread::get_id() != obs.Tid);
+  pthread_sigmask(SIG_BLOCK, &usr1, NULL);
+
+  // Restore asynchronous delivery
+  TEST_TRUE(mgr.UnregisterObserver(zSignal::Signal::ID_SIGUSR1, &obs));
+  TEST_TRUE(mgr.SetMode(zSignal::Handler::MODE_ASYNC));
+  TEST_EQ(zSignal::Handler::MODE_ASYNC, mgr.GetMode());
+  TEST_EQ(-1, mgr.GetFd());
+  pthread_sigmask(SIG_BLOCK, NULL, &mask);
+  TEST_FALSE(sigismember(&mask, SIGUSR1));
+
+  // Return success
+  return (0);
+}
@@ -30,6 +30,7 @@ main(int argc, const char **argv)
   UTEST_TEST(zThreadTest_RunOnce, 0);
   UTEST_TEST(zThreadTest_RunMultiple, 0);
   UTEST_TEST(zThreadTest_Synchronize, 0);
+  UTEST_TEST(zThreadTest_SignalFd, 0);
   UTEST_FINI();
 
 }
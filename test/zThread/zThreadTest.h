@@ -31,6 +31,8 @@ int
 zThreadTest_RunMultiple(void* arg_);
 int
 zThreadTest_Synchronize(void* arg_);
+int
+zThreadTest_SignalFd(void* arg_);
 
 using namespace Test;
 using namespace zUtils;
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2014-2016 ZenoTec LLC (http://www.zenotec.net)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <set>
+#include <unordered_set>
+
+#include "zUuidTest.h"
+
+using namespace Test;
+using namespace zUtils;
+
+int
+zUuidTest_Version(void* arg_)
+{
+
+  std::set<zUuid::Uuid> uuids;
+
+  // Random UUIDs carry the version and variant and do not repeat
+  for (int i = 0; i < 1000; i++)
+  {
+    zUuid::Uuid uuid;
+    TEST_EQ(zUuid::Uuid::VERSION_4, uuid.GetVersion());
+    TEST_EQ(0x80, (uuid().u.u8[8] & 0xc0));
+    TEST_TRUE(uuids.insert(uuid).second);
+  }
+
+  // Time ordered UUIDs sort by creation, also within a millisecond
+  zUuid::Uuid last(zUuid::Uuid::VERSION_7);
+  TEST_EQ(zUuid::Uuid::VERSION_7, last.GetVersion());
+  for (int i = 0; i < 10000; i++)
+  {
+    zUuid::Uuid uuid(zUuid::Uuid::VERSION_7);
+    TEST_EQ(zUuid::Uuid::VERSION_7, uuid.GetVersion());
+    TEST_EQ(0x80, (uuid().u.u8[8] & 0xc0));
+    TEST_TRUE(last < uuid);
+    last = uuid();
+  }
+
+  // Return success
+  UTEST_RETURN;
+}
+
+int
+zUuidTest_Parse(void* arg_)
+{
+
+  zUuid::Uuid uuid1;
+  zUuid::Uuid uuid2(zUuid::Uuid::VERSION_7);
+  std::string str = uuid1.Str();
+
+  TEST_EQ(36, str.size());
+  TEST_TRUE(uuid2.Parse(str));
+  TEST_TRUE(uuid1 == uuid2);
+  TEST_EQ(str, uuid2.Str());
+  TEST_EQ(36, zUuid::Uuid::Create().size());
+
+  // Either case is accepted
+  TEST_TRUE(uuid2.Parse("000102F3-0405-0607-0809-0A0B0C0D0E0F"));
+  TEST_EQ(std::string("000102f3-0405-0607-0809-0a0b0c0d0e0f"), uuid2.Str());
+  TEST_EQ(0xf3, uuid2().u.u8[3]);
+
+  // Malformed strings leave the UUID as it was
+  TEST_FALSE(uuid2.Parse(""));
+  TEST_FALSE(uuid2.Parse("000102f3-0405-0607-0809-0a0b0c0d0e0"));
+  TEST_FALSE(uuid2.Parse("000102f3-0405-0607-0809-0a0b0c0d0e0f0"));
+  TEST_FALSE(uuid2.Parse("000102f3+0405-0607-0809-0a0b0c0d0e0f"));
+  TEST_FALSE(uuid2.Parse("000102g3-0405-0607-0809-0a0b0c0d0e0f"));
+  TEST_EQ(std::string("000102f3-0405-0607-0809-0a0b0c0d0e0f"), uuid2.Str());
+
+  // Return success
+  UTEST_RETURN;
+}
+
+int
+zUuidTest_Hash(void* arg_)
+{
+
+  zUuid::Uuid uuid1;
+  zUuid::Uuid uuid2(uuid1);
+  zUuid::Uuid::hash hash;
+
+  TEST_EQ(uuid1.Hash(), uuid2.Hash());
+  TEST_EQ(hash(uuid1), hash(uuid2()));
+  TEST_EQ(std::hash<zUuid::Uuid>()(uuid1), uuid1.Hash());
+
+  // Time ordered UUIDs made together still spread out
+  std::unordered_set<zUuid::Uuid, zUuid::Uuid::hash> uuids;
+  std::set<size_t> buckets;
+  for (int i = 0; i < 256; i++)
+  {
+    zUuid::Uuid uuid(zUuid::Uuid::VERSION_7);
+    TEST_TRUE(uuids.insert(uuid).second);
+    buckets.insert(uuid.Hash() & 0xff);
+  }
+  TEST_EQ(256, uuids.size());
+  TEST_TRUE(buckets.size() > 128);
+  TEST_TRUE(uuids.count(*uuids.begin()));
+
+  // Return success
+  UTEST_RETURN;
+}
@@ -29,6 +29,9 @@ main(int argc, const char **argv)
   UTEST_TEST(zUuidTest_Defaults, 0);
   UTEST_TEST(zUuidTest_Copy, 0);
   UTEST_TEST(zUuidTest_Compare, 0);
+  UTEST_TEST(zUuidTest_Version, 0);
+  UTEST_TEST(zUuidTest_Parse, 0);
+  UTEST_TEST(zUuidTest_Hash, 0);
   UTEST_FINI();
 
 }
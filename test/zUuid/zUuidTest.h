@@ -30,6 +30,15 @@ zUuidTest_Copy(void* arg_);
 int
 zUuidTest_Compare(void* arg_);
 
+int
+zUuidTest_Version(void* arg_);
+
+int
+zUuidTest_Parse(void* arg_);
+
+int
+zUuidTest_Hash(void* arg_);
+
 using namespace Test;
 using namespace zUtils;
 